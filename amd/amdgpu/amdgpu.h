@@ -77,6 +77,7 @@ extern int amdgpu_smc_load_fw;
 extern int amdgpu_aspm;
 extern int amdgpu_runtime_pm;
 extern unsigned amdgpu_ip_block_mask;
+extern int amdgpu_parallel_init;
 extern int amdgpu_bapm;
 extern int amdgpu_deep_color;
 extern int amdgpu_vm_size;
@@ -88,6 +89,8 @@ extern int amdgpu_sched_jobs;
 extern int amdgpu_sched_hw_submission;
 extern int amdgpu_powerplay;
 extern int amdgpu_powercontainment;
+extern int amdgpu_dpm_governor;
+extern unsigned amdgpu_telemetry_ms;
 extern int amdgpu_no_evict;
 extern unsigned amdgpu_pcie_gen_cap;
 extern unsigned amdgpu_pcie_lane_cap;
@@ -194,12 +197,27 @@ int amdgpu_wait_for_idle(struct amdgpu_device *adev,
 bool amdgpu_is_idle(struct amdgpu_device *adev,
 		    enum amd_ip_block_type block_type);
 
+/*
+ * IP block types whose hw_init/resume must have finished before a block
+ * starts.  Types that are absent or disabled count as finished.
+ */
+#define AMDGPU_IP_DEP(type)	(1 << AMD_IP_BLOCK_TYPE_##type)
+#define AMDGPU_IP_DEPS_BASE	(AMDGPU_IP_DEP(COMMON) | AMDGPU_IP_DEP(GMC) | \
+				 AMDGPU_IP_DEP(IH))
+/* the engines wait for the SMU to load their firmware */
+#define AMDGPU_IP_DEPS_ENGINE	(AMDGPU_IP_DEPS_BASE | AMDGPU_IP_DEP(SMC))
+/* display setup goes through the DRM core, keep it on its own */
+#define AMDGPU_IP_DEPS_DISPLAY	(AMDGPU_IP_DEPS_ENGINE | AMDGPU_IP_DEP(GFX) | \
+				 AMDGPU_IP_DEP(SDMA) | AMDGPU_IP_DEP(UVD) | \
+				 AMDGPU_IP_DEP(VCE) | AMDGPU_IP_DEP(ACP))
+
 struct amdgpu_ip_block_version {
 	enum amd_ip_block_type type;
 	u32 major;
 	u32 minor;
 	u32 rev;
 	const struct amd_ip_funcs *funcs;
+	u32 deps;
 };
 
 int amdgpu_ip_block_version_cmp(struct amdgpu_device *adev,
@@ -369,6 +387,9 @@ struct amdgpu_fence_driver {
 	unsigned			num_fences_mask;
 	spinlock_t			lock;
 	struct fence			**fences;
+	/* time with unsignaled fences, see amdgpu_fence_busy_time() */
+	atomic64_t			busy_ns;
+	u64				last_signaled_ns;
 };
 
 /* some special values for the owner field */
@@ -393,6 +414,7 @@ int amdgpu_fence_emit(struct amdgpu_ring *ring, struct fence **fence);
 void amdgpu_fence_process(struct amdgpu_ring *ring);
 int amdgpu_fence_wait_empty(struct amdgpu_ring *ring);
 unsigned amdgpu_fence_count_emitted(struct amdgpu_ring *ring);
+u64 amdgpu_fence_busy_time(struct amdgpu_ring *ring);
 
 /*
  * TTM.
@@ -904,6 +926,11 @@ struct amdgpu_vm_id {
 
 	uint32_t                current_gpu_reset_count;
 
+	/* last job resubmitted with this VMID by a GPU recovery */
+	struct fence		*last_resubmit;
+	struct amdgpu_ring	*last_resubmit_ring;
+	uint32_t		last_resubmit_count;
+
 	uint32_t		gds_base;
 	uint32_t		gds_size;
 	uint32_t		gws_base;
@@ -956,6 +983,8 @@ int amdgpu_vm_flush(struct amdgpu_ring *ring,
 		    uint32_t gws_base, uint32_t gws_size,
 		    uint32_t oa_base, uint32_t oa_size);
 void amdgpu_vm_reset_id(struct amdgpu_device *adev, unsigned vm_id);
+int amdgpu_vm_wait_resubmit(struct amdgpu_ring *ring, unsigned vm_id,
+			    struct fence *fence);
 uint64_t amdgpu_vm_map_gart(const dma_addr_t *pages_addr, uint64_t addr);
 int amdgpu_vm_update_page_directory(struct amdgpu_device *adev,
 				    struct amdgpu_vm *vm);
@@ -997,6 +1026,8 @@ struct amdgpu_ctx {
 	struct kref		refcount;
 	struct amdgpu_device    *adev;
 	unsigned		reset_counter;
+	/* set when a job of the context hung the GPU */
+	atomic_t		guilty;
 	spinlock_t		ring_lock;
 	struct fence            **fences;
 	struct amdgpu_ctx_ring	rings[AMDGPU_MAX_RINGS];
@@ -1220,10 +1251,6 @@ void amdgpu_ring_insert_nop(struct amdgpu_ring *ring, uint32_t count);
 void amdgpu_ring_generic_pad_ib(struct amdgpu_ring *ring, struct amdgpu_ib *ib);
 void amdgpu_ring_commit(struct amdgpu_ring *ring);
 void amdgpu_ring_undo(struct amdgpu_ring *ring);
-unsigned amdgpu_ring_backup(struct amdgpu_ring *ring,
-			    uint32_t **data);
-int amdgpu_ring_restore(struct amdgpu_ring *ring,
-			unsigned size, uint32_t *data);
 int amdgpu_ring_init(struct amdgpu_device *adev, struct amdgpu_ring *ring,
 		     unsigned ring_size, u32 nop, u32 align_mask,
 		     struct amdgpu_irq_src *irq_src, unsigned irq_type,
@@ -1277,6 +1304,8 @@ struct amdgpu_job {
 	uint64_t		ctx;
 	unsigned		vm_id;
 	uint64_t		vm_pd_addr;
+	/* page directory of the VM, vm_pd_addr may be AMDGPU_VM_NO_FLUSH */
+	uint64_t		vm_pd_base;
 	uint32_t		gds_base, gds_size;
 	uint32_t		gws_base, gws_size;
 	uint32_t		oa_base, oa_size;
@@ -1639,6 +1668,9 @@ struct amdgpu_dpm {
 	enum amdgpu_dpm_forced_level forced_level;
 };
 
+#include "amdgpu_governor.h"
+#include "amdgpu_telemetry.h"
+
 struct amdgpu_pm {
 	struct mutex		mutex;
 	u32                     current_sclk;
@@ -1664,6 +1696,8 @@ struct amdgpu_pm {
 	uint32_t                pcie_gen_mask;
 	uint32_t                pcie_mlw_mask;
 	struct amd_pp_display_configuration pm_display_cfg;/* set by DAL */
+	struct amdgpu_governor	governor;
+	struct amdgpu_telemetry	telemetry;
 };
 
 void amdgpu_get_pcie_info(struct amdgpu_device *adev);
@@ -1748,6 +1782,9 @@ struct amdgpu_firmware {
 	bool smu_load;
 	struct amdgpu_bo *fw_buf;
 	unsigned int fw_size;
+	/* firmware cache entries held until all blocks requested theirs */
+	struct amdgpu_ucode_entry **prefetch;
+	unsigned num_prefetch;
 };
 
 /*
@@ -1968,10 +2005,28 @@ typedef void (*amdgpu_wreg_t)(struct amdgpu_device*, uint32_t, uint32_t);
 typedef uint32_t (*amdgpu_block_rreg_t)(struct amdgpu_device*, uint32_t, uint32_t);
 typedef void (*amdgpu_block_wreg_t)(struct amdgpu_device*, uint32_t, uint32_t, uint32_t);
 
+/*
+ * GPU reset recovery, protected by gpu_reset_mutex
+ */
+struct amdgpu_reset_stats {
+	unsigned	count;
+	unsigned	failed;
+	unsigned	guilty;		/* resets with an identified hung job */
+	u32		last_us;
+	u32		max_us;
+	u64		resubmitted;	/* jobs run again after a reset */
+	u64		dropped;	/* jobs lost to a reset */
+	unsigned	last_resubmitted;
+	unsigned	last_dropped;
+};
+
 struct amdgpu_ip_block_status {
 	bool valid;
 	bool sw;
 	bool hw;
+	/* duration of the last hw_init/resume */
+	u32 hw_init_us;
+	u32 resume_us;
 };
 
 struct amdgpu_device {
@@ -2068,6 +2123,8 @@ struct amdgpu_device {
 	atomic64_t			gtt_usage;
 	atomic64_t			num_bytes_moved;
 	atomic_t			gpu_reset_counter;
+	struct mutex			gpu_reset_mutex;
+	struct amdgpu_reset_stats	reset_stats;
 
 	/* display */
 	struct amdgpu_mode_info		mode_info;
@@ -2388,6 +2445,12 @@ amdgpu_get_sdma_instance(struct amdgpu_ring *ring)
 #define amdgpu_dpm_force_clock_level(adev, type, level) \
 		(adev)->powerplay.pp_funcs->force_clock_level((adev)->powerplay.pp_handle, type, level)
 
+#define amdgpu_dpm_get_clock_levels(adev, type, clocks) \
+		(adev)->powerplay.pp_funcs->get_clock_levels((adev)->powerplay.pp_handle, type, clocks)
+
+#define amdgpu_dpm_read_sensors(adev, sensors) \
+		(adev)->powerplay.pp_funcs->read_sensors((adev)->powerplay.pp_handle, sensors)
+
 #define amdgpu_dpm_get_sclk_od(adev) \
 	(adev)->powerplay.pp_funcs->get_sclk_od((adev)->powerplay.pp_handle)
 
@@ -2407,6 +2470,7 @@ amdgpu_get_sdma_instance(struct amdgpu_ring *ring)
 
 /* Common functions */
 int amdgpu_gpu_reset(struct amdgpu_device *adev);
+int amdgpu_gpu_recover(struct amdgpu_device *adev, struct amdgpu_job *job);
 void amdgpu_pci_config_reset(struct amdgpu_device *adev);
 bool amdgpu_card_posted(struct amdgpu_device *adev);
 void amdgpu_update_display_priority(struct amdgpu_device *adev);
@@ -704,7 +704,7 @@ static int amdgpu_cgs_rel_firmware(struct cgs_device *cgs_device, enum cgs_ucode
 {
 	CGS_FUNC_ADEV;
 	if ((CGS_UCODE_ID_SMU == type) || (CGS_UCODE_ID_SMU_SK == type)) {
-		release_firmware(adev->pm.fw);
+		amdgpu_ucode_release(adev->pm.fw);
 		return 0;
 	}
 	/* cannot release other firmware because they are not created by cgs */
@@ -775,7 +775,7 @@ static int amdgpu_cgs_get_firmware_info(struct cgs_device *cgs_device,
 				return -EINVAL;
 			}
 
-			err = request_firmware(&adev->pm.fw, fw_name, adev->dev);
+			err = amdgpu_ucode_request(adev, &adev->pm.fw, fw_name);
 			if (err) {
 				DRM_ERROR("Failed to request firmware\n");
 				return err;
@@ -784,7 +784,7 @@ static int amdgpu_cgs_get_firmware_info(struct cgs_device *cgs_device,
 			err = amdgpu_ucode_validate(adev->pm.fw);
 			if (err) {
 				DRM_ERROR("Failed to load firmware \"%s\"", fw_name);
-				release_firmware(adev->pm.fw);
+				amdgpu_ucode_release(adev->pm.fw);
 				adev->pm.fw = NULL;
 				return err;
 			}
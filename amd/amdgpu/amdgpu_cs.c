@@ -666,6 +666,7 @@ static int amdgpu_cs_ib_vm_chunk(struct amdgpu_device *adev,
 		}
 	} else {
 		p->job->vm_pd_addr = amdgpu_bo_gpu_offset(vm->page_directory);
+		p->job->vm_pd_base = p->job->vm_pd_addr;
 
 		r = amdgpu_bo_vm_update_pte(p, vm);
 		if (r)
@@ -886,6 +887,13 @@ int amdgpu_cs_ioctl(struct drm_device *dev, void *data, struct drm_file *filp)
 		r = amdgpu_cs_handle_lockup(adev, r);
 		return r;
 	}
+
+	/* the context hung the GPU, its jobs were dropped by the reset */
+	if (parser.ctx && atomic_read(&parser.ctx->guilty)) {
+		r = -ECANCELED;
+		goto out;
+	}
+
 	r = amdgpu_cs_parser_bos(&parser, data);
 	if (r == -ENOMEM)
 		DRM_ERROR("Not enough memory for command submission!\n");
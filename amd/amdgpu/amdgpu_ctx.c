@@ -53,6 +53,7 @@ static int amdgpu_ctx_init(struct amdgpu_device *adev, struct amdgpu_ctx *ctx)
 					  rq, amdgpu_sched_jobs);
 		if (r)
 			break;
+		ctx->rings[i].entity.guilty = &ctx->guilty;
 	}
 
 	if (i < adev->num_rings) {
@@ -166,11 +167,12 @@ static int amdgpu_ctx_query(struct amdgpu_device *adev,
 
 	/* determine if a GPU reset has occured since the last call */
 	reset_counter = atomic_read(&adev->gpu_reset_counter);
-	/* TODO: this should ideally return NO, GUILTY, or INNOCENT. */
-	if (ctx->reset_counter == reset_counter)
+	if (atomic_read(&ctx->guilty))
+		out->state.reset_status = AMDGPU_CTX_GUILTY_RESET;
+	else if (ctx->reset_counter == reset_counter)
 		out->state.reset_status = AMDGPU_CTX_NO_RESET;
 	else
-		out->state.reset_status = AMDGPU_CTX_UNKNOWN_RESET;
+		out->state.reset_status = AMDGPU_CTX_INNOCENT_RESET;
 	ctx->reset_counter = reset_counter;
 
 	mutex_unlock(&mgr->lock);
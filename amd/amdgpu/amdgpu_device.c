@@ -28,6 +28,7 @@
 #include <linux/console.h>
 #include <linux/slab.h>
 #include <linux/debugfs.h>
+#include <linux/kthread.h>
 #include <drm/drmP.h>
 #include <drm/drm_crtc_helper.h>
 #include <drm/drm_atomic_helper.h>
@@ -49,6 +50,7 @@
 
 static int amdgpu_debugfs_regs_init(struct amdgpu_device *adev);
 static void amdgpu_debugfs_regs_cleanup(struct amdgpu_device *adev);
+static int amdgpu_debugfs_ip_timing_init(struct amdgpu_device *adev);
 
 static const char *amdgpu_asic_name[] = {
 	"BONAIRE",
@@ -1223,14 +1225,18 @@ static int amdgpu_early_init(struct amdgpu_device *adev)
 		return -EINVAL;
 	}
 
+	amdgpu_ucode_prefetch(adev, amdgpu_asic_name[adev->asic_type]);
+
 	adev->ip_block_status = kcalloc(adev->num_ip_blocks,
 					sizeof(struct amdgpu_ip_block_status), GFP_KERNEL);
-	if (adev->ip_block_status == NULL)
-		return -ENOMEM;
+	if (adev->ip_block_status == NULL) {
+		r = -ENOMEM;
+		goto failed;
+	}
 
 	if (adev->ip_blocks == NULL) {
 		DRM_ERROR("No IP blocks found!\n");
-		return r;
+		goto failed;
 	}
 
 	for (i = 0; i < adev->num_ip_blocks; i++) {
@@ -1244,7 +1250,7 @@ static int amdgpu_early_init(struct amdgpu_device *adev)
 					adev->ip_block_status[i].valid = false;
 				} else if (r) {
 					DRM_ERROR("early_init of IP block <%s> failed %d\n", adev->ip_blocks[i].funcs->name, r);
-					return r;
+					goto failed;
 				} else {
 					adev->ip_block_status[i].valid = true;
 				}
@@ -1258,10 +1264,159 @@ static int amdgpu_early_init(struct amdgpu_device *adev)
 	adev->pg_flags &= amdgpu_pg_mask;
 
 	return 0;
+
+failed:
+	amdgpu_ucode_prefetch_fini(adev);
+	return r;
+}
+
+/*
+ * With amdgpu_parallel_init set, every block whose dependencies (see
+ * amdgpu_ip_block_version.deps) are met runs concurrently with the others,
+ * otherwise the blocks run one after the other in ip_blocks order.
+ */
+struct amdgpu_ip_job {
+	struct work_struct	work;
+	struct amdgpu_device	*adev;
+	int			idx;
+	bool			resume;
+	int			r;
+};
+
+static int amdgpu_ip_block_hw_run(struct amdgpu_device *adev, int i,
+				  bool resume)
+{
+	const struct amd_ip_funcs *funcs = adev->ip_blocks[i].funcs;
+	const char *op = resume ? "resume" : "hw_init";
+	ktime_t start = ktime_get();
+	u32 us;
+	int r;
+
+	if (resume)
+		r = funcs->resume((void *)adev);
+	else
+		r = funcs->hw_init((void *)adev);
+
+	us = ktime_to_us(ktime_sub(ktime_get(), start));
+	if (resume)
+		adev->ip_block_status[i].resume_us = us;
+	else
+		adev->ip_block_status[i].hw_init_us = us;
+
+	if (r)
+		DRM_ERROR("%s of IP block <%s> failed %d\n", op, funcs->name, r);
+	else
+		DRM_DEBUG("%s of IP block <%s> took %u us\n", op, funcs->name, us);
+
+	return r;
+}
+
+static void amdgpu_ip_job_func(struct work_struct *work)
+{
+	struct amdgpu_ip_job *job =
+		container_of(work, struct amdgpu_ip_job, work);
+
+	job->r = amdgpu_ip_block_hw_run(job->adev, job->idx, job->resume);
+}
+
+/**
+ * amdgpu_ip_blocks_hw_run - run hw_init or resume over a set of IP blocks
+ *
+ * @adev: amdgpu_device pointer
+ * @pending: mask of the ip_blocks indices to run
+ * @resume: call resume instead of hw_init
+ *
+ * Runs the blocks in waves: each wave holds every pending block whose
+ * dependencies have finished, the first one runs in the caller and the
+ * rest on the unbound workqueue.  A failure stops the run once the
+ * current wave has finished.  Blocks that completed hw_init are marked hw.
+ * Returns 0 on success, error on failure.
+ */
+static int amdgpu_ip_blocks_hw_run(struct amdgpu_device *adev, u32 pending,
+				   bool resume)
+{
+	struct amdgpu_ip_job *jobs;
+	u32 pending_types, wave;
+	int i, n, r = 0;
+
+	if (!amdgpu_parallel_init) {
+		for (i = 0; i < adev->num_ip_blocks; i++) {
+			if (!(pending & (1 << i)))
+				continue;
+			r = amdgpu_ip_block_hw_run(adev, i, resume);
+			if (r)
+				return r;
+			if (!resume)
+				adev->ip_block_status[i].hw = true;
+		}
+		return 0;
+	}
+
+	jobs = kcalloc(adev->num_ip_blocks, sizeof(*jobs), GFP_KERNEL);
+	if (!jobs)
+		return -ENOMEM;
+
+	while (pending && !r) {
+		pending_types = 0;
+		for (i = 0; i < adev->num_ip_blocks; i++)
+			if (pending & (1 << i))
+				pending_types |= 1 << adev->ip_blocks[i].type;
+
+		wave = 0;
+		for (i = 0; i < adev->num_ip_blocks; i++) {
+			if ((pending & (1 << i)) &&
+			    !(adev->ip_blocks[i].deps & pending_types))
+				wave |= 1 << i;
+		}
+		if (!wave) {
+			DRM_ERROR("IP block dependencies can't be met\n");
+			r = -EINVAL;
+			break;
+		}
+
+		n = 0;
+		for (i = 0; i < adev->num_ip_blocks; i++) {
+			if (!(wave & (1 << i)))
+				continue;
+			jobs[i].adev = adev;
+			jobs[i].idx = i;
+			jobs[i].resume = resume;
+			jobs[i].r = 0;
+			INIT_WORK(&jobs[i].work, amdgpu_ip_job_func);
+			if (n++)
+				queue_work(system_unbound_wq, &jobs[i].work);
+		}
+
+		/* the first block of the wave runs here, then join the rest */
+		for (i = 0, n = 0; i < adev->num_ip_blocks; i++) {
+			if (!(wave & (1 << i)))
+				continue;
+			if (n++)
+				flush_work(&jobs[i].work);
+			else
+				amdgpu_ip_job_func(&jobs[i].work);
+		}
+
+		for (i = 0; i < adev->num_ip_blocks; i++) {
+			if (!(wave & (1 << i)))
+				continue;
+			if (jobs[i].r) {
+				r = r ? r : jobs[i].r;
+				continue;
+			}
+			if (!resume)
+				adev->ip_block_status[i].hw = true;
+		}
+		pending &= ~wave;
+	}
+
+	kfree(jobs);
+	return r;
 }
 
 static int amdgpu_init(struct amdgpu_device *adev)
 {
+	u32 pending = 0;
 	int i, r;
 
 	for (i = 0; i < adev->num_ip_blocks; i++) {
@@ -1280,11 +1435,9 @@ static int amdgpu_init(struct amdgpu_device *adev)
 				DRM_ERROR("amdgpu_vram_scratch_init failed %d\n", r);
 				return r;
 			}
-			r = adev->ip_blocks[i].funcs->hw_init((void *)adev);
-			if (r) {
-				DRM_ERROR("hw_init %d failed %d\n", i, r);
+			r = amdgpu_ip_block_hw_run(adev, i, false);
+			if (r)
 				return r;
-			}
 			r = amdgpu_wb_init(adev);
 			if (r) {
 				DRM_ERROR("amdgpu_wb_init failed %d\n", r);
@@ -1300,15 +1453,10 @@ static int amdgpu_init(struct amdgpu_device *adev)
 		/* gmc hw init is done early */
 		if (adev->ip_blocks[i].type == AMD_IP_BLOCK_TYPE_GMC)
 			continue;
-		r = adev->ip_blocks[i].funcs->hw_init((void *)adev);
-		if (r) {
-			DRM_ERROR("hw_init of IP block <%s> failed %d\n", adev->ip_blocks[i].funcs->name, r);
-			return r;
-		}
-		adev->ip_block_status[i].hw = true;
+		pending |= 1 << i;
 	}
 
-	return 0;
+	return amdgpu_ip_blocks_hw_run(adev, pending, false);
 }
 
 static int amdgpu_late_init(struct amdgpu_device *adev)
@@ -1380,6 +1528,8 @@ static int amdgpu_fini(struct amdgpu_device *adev)
 			adev->ip_blocks[i].funcs->late_fini((void *)adev);
 	}
 
+	amdgpu_ucode_prefetch_fini(adev);
+
 	return 0;
 }
 
@@ -1418,19 +1568,14 @@ static int amdgpu_suspend(struct amdgpu_device *adev)
 
 static int amdgpu_resume(struct amdgpu_device *adev)
 {
-	int i, r;
+	u32 pending = 0;
+	int i;
 
-	for (i = 0; i < adev->num_ip_blocks; i++) {
-		if (!adev->ip_block_status[i].valid)
-			continue;
-		r = adev->ip_blocks[i].funcs->resume(adev);
-		if (r) {
-			DRM_ERROR("resume of IP block <%s> failed %d\n", adev->ip_blocks[i].funcs->name, r);
-			return r;
-		}
-	}
+	for (i = 0; i < adev->num_ip_blocks; i++)
+		if (adev->ip_block_status[i].valid)
+			pending |= 1 << i;
 
-	return 0;
+	return amdgpu_ip_blocks_hw_run(adev, pending, true);
 }
 
 bool amdgpu_device_asic_has_dal_support(enum amd_asic_type asic_type)
@@ -1540,10 +1685,13 @@ int amdgpu_device_init(struct amdgpu_device *adev,
 	mutex_init(&adev->vm_manager.lock);
 	atomic_set(&adev->irq.ih.lock, 0);
 	mutex_init(&adev->pm.mutex);
+	amdgpu_governor_init(adev);
+	amdgpu_telemetry_init(adev);
 	mutex_init(&adev->gfx.gpu_clock_mutex);
 	mutex_init(&adev->srbm_mutex);
 	mutex_init(&adev->grbm_idx_mutex);
 	mutex_init(&adev->mn_lock);
+	mutex_init(&adev->gpu_reset_mutex);
 	hash_init(adev->mn_hash);
 
 	amdgpu_check_arguments(adev);
@@ -1659,6 +1807,8 @@ int amdgpu_device_init(struct amdgpu_device *adev,
 	drm_mode_config_init(adev->ddev);
 
 	r = amdgpu_init(adev);
+	/* every block has requested its firmware by now */
+	amdgpu_ucode_prefetch_fini(adev);
 	if (r) {
 		dev_err(adev->dev, "amdgpu_init failed\n");
 		amdgpu_fini(adev);
@@ -1689,6 +1839,11 @@ int amdgpu_device_init(struct amdgpu_device *adev,
 		DRM_ERROR("registering register debugfs failed (%d).\n", r);
 	}
 
+	r = amdgpu_debugfs_ip_timing_init(adev);
+	if (r) {
+		DRM_ERROR("registering ip timing debugfs failed (%d).\n", r);
+	}
+
 	r = amdgpu_debugfs_firmware_init(adev);
 	if (r) {
 		DRM_ERROR("registering firmware debugfs failed (%d).\n", r);
@@ -1726,6 +1881,8 @@ int amdgpu_device_init(struct amdgpu_device *adev,
 	return 0;
 
 failed:
+	/* amdgpu_init() may not have been reached */
+	amdgpu_ucode_prefetch_fini(adev);
 	if (runtime)
 		vga_switcheroo_fini_domain_pm_ops(adev->dev);
 	return r;
@@ -1999,17 +2156,64 @@ int amdgpu_resume_kms(struct drm_device *dev, bool resume, bool fbcon)
  */
 int amdgpu_gpu_reset(struct amdgpu_device *adev)
 {
-	struct drm_atomic_state *state = NULL;
-	unsigned ring_sizes[AMDGPU_MAX_RINGS];
-	uint32_t *ring_data[AMDGPU_MAX_RINGS] = {0};
-
-	bool saved = false;
+	return amdgpu_gpu_recover(adev, NULL);
+}
 
+/**
+ * amdgpu_gpu_recover - reset the asic and resubmit the pending jobs
+ *
+ * @adev: amdgpu device pointer
+ * @job: the job that timed out, NULL if unknown
+ *
+ * Reset the GPU and run the jobs that were on the hardware again from
+ * the scheduler mirror lists.  The context of @job is marked guilty and
+ * its jobs are dropped, the jobs of every other context are resubmitted.
+ * Without @job nothing is dropped, a hung job will time out again and be
+ * identified then.
+ * Returns 0 for success or an error on failure.
+ */
+int amdgpu_gpu_recover(struct amdgpu_device *adev, struct amdgpu_job *job)
+{
+	struct amdgpu_reset_stats *stats = &adev->reset_stats;
+	struct amd_sched_recovery recovery = {};
+	struct drm_atomic_state *state = NULL;
+	unsigned reset_counter;
+	bool guilty = false;
+	bool retried = false;
+	u64 start;
+	u32 us;
 	int i, r;
 	int resched;
 
+	reset_counter = atomic_read(&adev->gpu_reset_counter);
+	mutex_lock(&adev->gpu_reset_mutex);
+	/* another ring timed out at the same time and already reset the GPU */
+	if (job && reset_counter != atomic_read(&adev->gpu_reset_counter)) {
+		mutex_unlock(&adev->gpu_reset_mutex);
+		return 0;
+	}
+
+	start = ktime_to_ns(ktime_get());
 	atomic_inc(&adev->gpu_reset_counter);
 
+	/* block the schedulers and detach their jobs from the hardware */
+	for (i = 0; i < AMDGPU_MAX_RINGS; ++i) {
+		struct amdgpu_ring *ring = adev->rings[i];
+		if (!ring)
+			continue;
+
+		kthread_park(ring->sched.thread);
+		if (amd_sched_hw_job_reset(&ring->sched,
+					   job && job->ring == ring ?
+					   &job->base : NULL)) {
+			DRM_ERROR("ring %s hung, context %llu is guilty\n",
+				  ring->name, job->ctx);
+			guilty = true;
+		}
+	}
+	/* the hardware fences are meaningless now, signal them all */
+	amdgpu_fence_driver_force_completion(adev);
+
 	/* block TTM */
 	resched = ttm_bo_lock_delayed_workqueue(&adev->mman.bdev);
 	/* store modesetting */
@@ -2020,19 +2224,6 @@ int amdgpu_gpu_reset(struct amdgpu_device *adev)
 	amdgpu_atombios_scratch_regs_save(adev);
 	r = amdgpu_suspend(adev);
 
-	for (i = 0; i < AMDGPU_MAX_RINGS; ++i) {
-		struct amdgpu_ring *ring = adev->rings[i];
-		if (!ring)
-			continue;
-
-		ring_sizes[i] = amdgpu_ring_backup(ring, &ring_data[i]);
-		if (ring_sizes[i]) {
-			saved = true;
-			dev_info(adev->dev, "Saved %d dwords of commands "
-				 "on ring %d.\n", ring_sizes[i], i);
-		}
-	}
-
 retry:
 	/* Disable fb access */
 	if (adev->mode_info.num_crtc) {
@@ -2052,35 +2243,34 @@ retry:
 	/* restore scratch */
 	amdgpu_atombios_scratch_regs_restore(adev);
 	if (!r) {
-		for (i = 0; i < AMDGPU_MAX_RINGS; ++i) {
-			struct amdgpu_ring *ring = adev->rings[i];
-			if (!ring)
-				continue;
-
-			amdgpu_ring_restore(ring, ring_sizes[i], ring_data[i]);
-			ring_sizes[i] = 0;
-			ring_data[i] = NULL;
-		}
-
 		r = amdgpu_ib_ring_tests(adev);
 		if (r) {
 			dev_err(adev->dev, "ib ring test failed (%d).\n", r);
-			if (saved) {
-				saved = false;
+			if (!retried) {
+				retried = true;
 				r = amdgpu_suspend(adev);
 				goto retry;
 			}
 		}
-	} else {
-		amdgpu_fence_driver_force_completion(adev);
-		for (i = 0; i < AMDGPU_MAX_RINGS; ++i) {
-			if (adev->rings[i])
-				kfree(ring_data[i]);
-		}
 	}
 
+	/* resubmit the innocent jobs, or drop everything if the reset failed */
+	for (i = 0; i < AMDGPU_MAX_RINGS; ++i) {
+		struct amdgpu_ring *ring = adev->rings[i];
+		if (!ring)
+			continue;
+
+		amd_sched_job_recovery(&ring->sched, !r, &recovery);
+		kthread_unpark(ring->sched.thread);
+	}
+
+	/* r keeps the reset result, a display restore failure is only logged */
 	if (amdgpu_device_has_dal_support(adev)) {
-		r = drm_atomic_helper_resume(adev->ddev, state);
+		int ret = drm_atomic_helper_resume(adev->ddev, state);
+
+		if (ret)
+			DRM_ERROR("failed to restore the display state (%d)\n",
+				  ret);
 		amdgpu_dm_display_resume(adev);
 	} else
 		drm_helper_resume_force_mode(adev->ddev);
@@ -2092,6 +2282,22 @@ retry:
 	}
 	amdgpu_irq_gpu_reset_resume_helper(adev);
 
+	us = div_u64(ktime_to_ns(ktime_get()) - start, NSEC_PER_USEC);
+	stats->count++;
+	if (r)
+		stats->failed++;
+	if (guilty)
+		stats->guilty++;
+	stats->last_us = us;
+	stats->max_us = max(stats->max_us, us);
+	stats->last_resubmitted = recovery.resubmitted;
+	stats->last_dropped = recovery.dropped;
+	stats->resubmitted += recovery.resubmitted;
+	stats->dropped += recovery.dropped;
+	dev_info(adev->dev, "GPU recovery took %u us, %u jobs resubmitted, "
+		 "%u dropped\n", us, recovery.resubmitted, recovery.dropped);
+	mutex_unlock(&adev->gpu_reset_mutex);
+
 	return r;
 }
 
@@ -2644,6 +2850,38 @@ static void amdgpu_debugfs_regs_cleanup(struct amdgpu_device *adev)
 	}
 }
 
+static int amdgpu_debugfs_ip_timing(struct seq_file *m, void *data)
+{
+	struct drm_info_node *node = (struct drm_info_node *) m->private;
+	struct drm_device *dev = node->minor->dev;
+	struct amdgpu_device *adev = dev->dev_private;
+	struct amdgpu_ip_block_status *status;
+	int i;
+
+	seq_printf(m, "parallel init: %s\n",
+		   amdgpu_parallel_init ? "enabled" : "disabled");
+	for (i = 0; i < adev->num_ip_blocks; i++) {
+		status = &adev->ip_block_status[i];
+		if (!status->valid)
+			continue;
+		seq_printf(m, "%-16s hw_init %8u us, resume %8u us\n",
+			   adev->ip_blocks[i].funcs->name,
+			   status->hw_init_us, status->resume_us);
+	}
+
+	return 0;
+}
+
+static const struct drm_info_list amdgpu_debugfs_ip_timing_list[] = {
+	{"amdgpu_ip_timing", amdgpu_debugfs_ip_timing, 0, NULL},
+};
+
+static int amdgpu_debugfs_ip_timing_init(struct amdgpu_device *adev)
+{
+	return amdgpu_debugfs_add_files(adev, amdgpu_debugfs_ip_timing_list,
+					ARRAY_SIZE(amdgpu_debugfs_ip_timing_list));
+}
+
 int amdgpu_debugfs_init(struct drm_minor *minor)
 {
 	return 0;
@@ -2658,4 +2896,8 @@ static int amdgpu_debugfs_regs_init(struct amdgpu_device *adev)
 	return 0;
 }
 static void amdgpu_debugfs_regs_cleanup(struct amdgpu_device *adev) { }
+static int amdgpu_debugfs_ip_timing_init(struct amdgpu_device *adev)
+{
+	return 0;
+}
 #endif
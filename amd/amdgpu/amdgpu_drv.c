@@ -72,6 +72,7 @@ int amdgpu_smc_load_fw = 1;
 int amdgpu_aspm = -1;
 int amdgpu_runtime_pm = -1;
 unsigned amdgpu_ip_block_mask = 0xffffffff;
+int amdgpu_parallel_init = 0;
 int amdgpu_bapm = -1;
 int amdgpu_deep_color = 0;
 int amdgpu_vm_size = 64;
@@ -85,6 +86,8 @@ int amdgpu_sched_hw_submission = 2;
 int amdgpu_powerplay = -1;
 int amdgpu_no_evict = 0;
 int amdgpu_powercontainment = 1;
+int amdgpu_dpm_governor = 0;
+unsigned amdgpu_telemetry_ms = 0;
 int amdgpu_sclk_deep_sleep_en = 1;
 unsigned amdgpu_pcie_gen_cap = 0;
 unsigned amdgpu_pcie_lane_cap = 0;
@@ -136,6 +139,9 @@ module_param_named(runpm, amdgpu_runtime_pm, int, 0444);
 MODULE_PARM_DESC(ip_block_mask, "IP Block Mask (all blocks enabled (default))");
 module_param_named(ip_block_mask, amdgpu_ip_block_mask, uint, 0444);
 
+MODULE_PARM_DESC(parallel_init, "Run independent IP block hw init and resume concurrently (1 = enable, 0 = disable (default))");
+module_param_named(parallel_init, amdgpu_parallel_init, int, 0444);
+
 MODULE_PARM_DESC(bapm, "BAPM support (1 = enable, 0 = disable, -1 = auto)");
 module_param_named(bapm, amdgpu_bapm, int, 0444);
 
@@ -172,6 +178,12 @@ module_param_named(powerplay, amdgpu_powerplay, int, 0444);
 
 MODULE_PARM_DESC(powercontainment, "Power Containment (1 = enable (default), 0 = disable)");
 module_param_named(powercontainment, amdgpu_powercontainment, int, 0444);
+
+MODULE_PARM_DESC(dpm_governor, "Utilization based DPM governor (1 = enable, 0 = disable (default))");
+module_param_named(dpm_governor, amdgpu_dpm_governor, int, 0444);
+
+MODULE_PARM_DESC(telemetry_ms, "Power telemetry sampling interval in ms (0 = disable (default))");
+module_param_named(telemetry_ms, amdgpu_telemetry_ms, uint, 0444);
 #endif
 
 MODULE_PARM_DESC(no_evict, "Support pinning request from user space (1 = enable, 0 = disable (default))");
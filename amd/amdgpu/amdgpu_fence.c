@@ -52,6 +52,7 @@ struct amdgpu_fence {
 
 	/* RB, DMA, etc. */
 	struct amdgpu_ring		*ring;
+	u64				emitted_ns;
 };
 
 static struct kmem_cache *amdgpu_fence_slab;
@@ -143,6 +144,7 @@ int amdgpu_fence_emit(struct amdgpu_ring *ring, struct fence **f)
 
 	seq = ++ring->fence_drv.sync_seq;
 	fence->ring = ring;
+	fence->emitted_ns = ktime_to_ns(ktime_get());
 	fence_init(&fence->base, &amdgpu_fence_ops,
 		   &ring->fence_drv.lock,
 		   adev->fence_context + ring->idx,
@@ -180,6 +182,31 @@ static void amdgpu_fence_schedule_fallback(struct amdgpu_ring *ring)
 		  jiffies + AMDGPU_FENCE_JIFFIES_TIMEOUT);
 }
 
+/**
+ * amdgpu_fence_account_busy - account the execution time of a fence
+ *
+ * @drv: fence driver of the ring
+ * @f: fence which just signaled
+ * @now: signal timestamp in ns
+ *
+ * A ring executes its fences in order, so a fence kept the ring busy from
+ * the later of its emission and the previous fence signaling until now.
+ */
+static void amdgpu_fence_account_busy(struct amdgpu_fence_driver *drv,
+				      struct fence *f, u64 now)
+{
+	struct amdgpu_fence *fence = to_amdgpu_fence(f);
+	u64 start;
+
+	if (!fence)
+		return;
+
+	start = max(fence->emitted_ns, ACCESS_ONCE(drv->last_signaled_ns));
+	if (now > start)
+		atomic64_add(now - start, &drv->busy_ns);
+	drv->last_signaled_ns = now;
+}
+
 /**
  * amdgpu_fence_process - check for fence activity
  *
@@ -193,6 +220,7 @@ void amdgpu_fence_process(struct amdgpu_ring *ring)
 {
 	struct amdgpu_fence_driver *drv = &ring->fence_drv;
 	uint32_t seq, last_seq;
+	u64 now = 0;
 	int r;
 
 	do {
@@ -204,6 +232,9 @@ void amdgpu_fence_process(struct amdgpu_ring *ring)
 	if (seq != ring->fence_drv.sync_seq)
 		amdgpu_fence_schedule_fallback(ring);
 
+	if (last_seq != seq)
+		now = ktime_to_ns(ktime_get());
+
 	while (last_seq != seq) {
 		struct fence *fence, **ptr;
 
@@ -221,6 +252,7 @@ void amdgpu_fence_process(struct amdgpu_ring *ring)
 		else
 			BUG();
 
+		amdgpu_fence_account_busy(drv, fence, now);
 		fence_put(fence);
 	}
 }
@@ -294,6 +326,46 @@ unsigned amdgpu_fence_count_emitted(struct amdgpu_ring *ring)
 	return lower_32_bits(emitted);
 }
 
+/**
+ * amdgpu_fence_busy_time - get the time a ring spent executing
+ *
+ * @ring: ring to query
+ *
+ * Returns the accumulated time in ns the ring had unsignaled fences,
+ * including the part of the oldest pending fence executed so far.  The
+ * value is derived from fence emission and signal timestamps and is only
+ * meaningful as a difference between two calls.  Used by the dpm governor
+ * to estimate engine utilization.
+ */
+u64 amdgpu_fence_busy_time(struct amdgpu_ring *ring)
+{
+	struct amdgpu_fence_driver *drv = &ring->fence_drv;
+	struct amdgpu_fence *fence;
+	struct fence *f, **ptr;
+	u64 busy, start, now;
+	uint32_t seq;
+
+	amdgpu_fence_process(ring);
+	busy = atomic64_read(&drv->busy_ns);
+	seq = atomic_read(&drv->last_seq);
+	if (seq == ACCESS_ONCE(drv->sync_seq))
+		return busy;
+
+	now = ktime_to_ns(ktime_get());
+	ptr = &drv->fences[(seq + 1) & drv->num_fences_mask];
+	rcu_read_lock();
+	f = rcu_dereference(*ptr);
+	fence = f ? to_amdgpu_fence(f) : NULL;
+	if (fence) {
+		start = max(fence->emitted_ns, ACCESS_ONCE(drv->last_signaled_ns));
+		if (now > start)
+			busy += now - start;
+	}
+	rcu_read_unlock();
+
+	return busy;
+}
+
 /**
  * amdgpu_fence_driver_start_ring - make the fence driver
  * ready for use on the requested ring.
@@ -361,6 +433,8 @@ int amdgpu_fence_driver_init_ring(struct amdgpu_ring *ring,
 	ring->fence_drv.sync_seq = 0;
 	atomic_set(&ring->fence_drv.last_seq, 0);
 	ring->fence_drv.initialized = false;
+	atomic64_set(&ring->fence_drv.busy_ns, 0);
+	ring->fence_drv.last_signaled_ns = 0;
 
 	setup_timer(&ring->fence_drv.fallback_timer, amdgpu_fence_fallback,
 		    (unsigned long)ring);
@@ -642,16 +716,41 @@ static int amdgpu_debugfs_gpu_reset(struct seq_file *m, void *data)
 	return 0;
 }
 
+/**
+ * amdgpu_debugfs_reset_info - recovery time and job counts of GPU resets
+ */
+static int amdgpu_debugfs_reset_info(struct seq_file *m, void *data)
+{
+	struct drm_info_node *node = (struct drm_info_node *) m->private;
+	struct drm_device *dev = node->minor->dev;
+	struct amdgpu_device *adev = dev->dev_private;
+	struct amdgpu_reset_stats *stats = &adev->reset_stats;
+
+	mutex_lock(&adev->gpu_reset_mutex);
+	seq_printf(m, "resets: %u (%u failed, %u with a guilty job)\n",
+		   stats->count, stats->failed, stats->guilty);
+	seq_printf(m, "last recovery: %u us, %u jobs resubmitted, %u dropped\n",
+		   stats->last_us, stats->last_resubmitted,
+		   stats->last_dropped);
+	seq_printf(m, "max recovery: %u us\n", stats->max_us);
+	seq_printf(m, "total: %llu jobs resubmitted, %llu dropped\n",
+		   stats->resubmitted, stats->dropped);
+	mutex_unlock(&adev->gpu_reset_mutex);
+
+	return 0;
+}
+
 static const struct drm_info_list amdgpu_debugfs_fence_list[] = {
 	{"amdgpu_fence_info", &amdgpu_debugfs_fence_info, 0, NULL},
-	{"amdgpu_gpu_reset", &amdgpu_debugfs_gpu_reset, 0, NULL}
+	{"amdgpu_gpu_reset", &amdgpu_debugfs_gpu_reset, 0, NULL},
+	{"amdgpu_reset_info", &amdgpu_debugfs_reset_info, 0, NULL}
 };
 #endif
 
 int amdgpu_debugfs_fence_init(struct amdgpu_device *adev)
 {
 #if defined(CONFIG_DEBUG_FS)
-	return amdgpu_debugfs_add_files(adev, amdgpu_debugfs_fence_list, 2);
+	return amdgpu_debugfs_add_files(adev, amdgpu_debugfs_fence_list, 3);
 #else
 	return 0;
 #endif
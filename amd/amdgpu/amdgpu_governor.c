@@ -0,0 +1,887 @@
+/*
+ * Copyright 2016 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE COPYRIGHT HOLDER(S) OR AUTHOR(S) BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+#include <linux/ctype.h>
+#include <linux/debugfs.h>
+#include <linux/seq_file.h>
+#include <linux/uaccess.h>
+#include <drm/drmP.h>
+#include "amdgpu.h"
+#include "amdgpu_pm.h"
+
+/*
+ * DPM governor
+ *
+ * Engine utilization is taken from the fence timestamps of the gfx and
+ * compute rings, memory utilization from the SDMA rings and the number of
+ * bytes TTM moved in and out of VRAM.  Every interval the governor raises
+ * or lowers the forced sclk/mclk level; raising is immediate and lowering
+ * waits for a few quiet samples, so bursty latency sensitive work does not
+ * wait for the clocks to ramp up.
+ *
+ * The samples are kept in a small ring which can be dumped through debugfs
+ * and fed back into the simulator to compare parameter sets offline.
+ */
+
+static const struct amdgpu_gov_params amdgpu_gov_default_params = {
+	.interval_ms = 50,
+	.sclk_up = 80,
+	.sclk_down = 30,
+	.mclk_up = 70,
+	.mclk_down = 20,
+	.up_hold = 1,
+	.down_hold = 4,
+	.move_bw = 2048,
+};
+
+#define AMDGPU_GOV_PARAM(n)	{ #n, offsetof(struct amdgpu_gov_params, n) }
+
+static const struct {
+	const char	*name;
+	size_t		offset;
+} amdgpu_gov_param_names[] = {
+	AMDGPU_GOV_PARAM(interval_ms),
+	AMDGPU_GOV_PARAM(sclk_up),
+	AMDGPU_GOV_PARAM(sclk_down),
+	AMDGPU_GOV_PARAM(mclk_up),
+	AMDGPU_GOV_PARAM(mclk_down),
+	AMDGPU_GOV_PARAM(up_hold),
+	AMDGPU_GOV_PARAM(down_hold),
+	AMDGPU_GOV_PARAM(move_bw),
+};
+
+static unsigned *amdgpu_gov_param(struct amdgpu_gov_params *p, unsigned i)
+{
+	return (unsigned *)((char *)p + amdgpu_gov_param_names[i].offset);
+}
+
+static bool amdgpu_gov_params_valid(const struct amdgpu_gov_params *p)
+{
+	return p->interval_ms >= 10 && p->interval_ms <= 1000 &&
+	       p->sclk_down < p->sclk_up && p->sclk_up <= 100 &&
+	       p->mclk_down < p->mclk_up && p->mclk_up <= 100 &&
+	       p->up_hold && p->down_hold && p->move_bw;
+}
+
+static int amdgpu_gov_parse_param(struct amdgpu_gov_params *p,
+				  const char *buf)
+{
+	struct amdgpu_gov_params tmp = *p;
+	char name[16];
+	unsigned i, value;
+
+	if (sscanf(buf, "%15s %u", name, &value) != 2)
+		return -EINVAL;
+
+	for (i = 0; i < ARRAY_SIZE(amdgpu_gov_param_names); i++) {
+		if (strcmp(name, amdgpu_gov_param_names[i].name))
+			continue;
+
+		*amdgpu_gov_param(&tmp, i) = value;
+		if (!amdgpu_gov_params_valid(&tmp))
+			return -EINVAL;
+		*p = tmp;
+		return 0;
+	}
+
+	return -EINVAL;
+}
+
+static unsigned amdgpu_gov_percent(u64 part, u64 total)
+{
+	if (!total)
+		return 0;
+	if (part >= total)
+		return 100;
+	return div64_u64(part * 100, total);
+}
+
+/*
+ * Level helpers, levels the SMC has disabled are reported with a clock of 0
+ * and are never selected.
+ */
+static unsigned amdgpu_gov_clock(const struct amdgpu_gov_domain *d,
+				 unsigned level)
+{
+	return level < d->levels.count ? d->levels.clock[level] : 0;
+}
+
+static unsigned amdgpu_gov_highest(const struct amdgpu_gov_domain *d)
+{
+	unsigned i = d->levels.count;
+
+	while (i--)
+		if (d->levels.clock[i])
+			return i;
+	return 0;
+}
+
+static unsigned amdgpu_gov_lower(const struct amdgpu_gov_domain *d,
+				 unsigned level)
+{
+	unsigned i = min(level, d->levels.count);
+
+	while (i--)
+		if (d->levels.clock[i])
+			return i;
+	return level;
+}
+
+/**
+ * amdgpu_gov_update - pick the level for the next interval
+ *
+ * @d: clock domain, updated in place
+ * @util: busy percentage measured at the current level
+ * @up: threshold above which the clock is raised
+ * @down: threshold below which the clock is lowered
+ * @p: governor parameters
+ *
+ * Raising jumps straight to the lowest level expected to bring the load
+ * back under @up, or to the top level when the engine was saturated.
+ * Lowering steps one level at a time, and only if the load projected onto
+ * the lower level stays under @up, which keeps the governor from bouncing
+ * between two levels.  Shared by the governor and the simulator.
+ * Returns true if the level changed.
+ */
+static bool amdgpu_gov_update(struct amdgpu_gov_domain *d, unsigned util,
+			      unsigned up, unsigned down,
+			      const struct amdgpu_gov_params *p)
+{
+	unsigned cur = amdgpu_gov_clock(d, d->level);
+	unsigned next, target, i;
+
+	if (util > up) {
+		d->below = 0;
+		if (++d->above < p->up_hold)
+			return false;
+
+		next = amdgpu_gov_highest(d);
+		if (util < 100) {
+			target = DIV_ROUND_UP(cur * util, up);
+			for (i = d->level + 1; i < next; i++) {
+				if (d->levels.clock[i] >= target) {
+					next = i;
+					break;
+				}
+			}
+		}
+	} else if (util < down) {
+		d->above = 0;
+		if (++d->below < p->down_hold)
+			return false;
+
+		next = amdgpu_gov_lower(d, d->level);
+		if (cur * util > amdgpu_gov_clock(d, next) * up)
+			next = d->level;
+	} else {
+		d->above = 0;
+		d->below = 0;
+		return false;
+	}
+
+	d->above = 0;
+	d->below = 0;
+	if (next == d->level)
+		return false;
+
+	d->level = next;
+	d->transitions++;
+	return true;
+}
+
+static int amdgpu_gov_read_levels(struct amdgpu_device *adev)
+{
+	struct amdgpu_governor *gov = &adev->pm.governor;
+	struct amdgpu_gov_domain *domains[] = { &gov->sclk, &gov->mclk };
+	enum pp_clock_type types[] = { PP_SCLK, PP_MCLK };
+	unsigned i;
+	int r;
+
+	if (!adev->powerplay.pp_funcs->get_clock_levels)
+		return -EINVAL;
+
+	for (i = 0; i < ARRAY_SIZE(domains); i++) {
+		struct amdgpu_gov_domain *d = domains[i];
+
+		r = amdgpu_dpm_get_clock_levels(adev, types[i], &d->levels);
+		if (r)
+			return r;
+		if (!amdgpu_gov_clock(d, amdgpu_gov_highest(d)))
+			return -EINVAL;
+		if (!amdgpu_gov_clock(d, d->level))
+			d->level = amdgpu_gov_highest(d);
+	}
+
+	return 0;
+}
+
+static void amdgpu_gov_apply(struct amdgpu_device *adev, bool sclk, bool mclk)
+{
+	struct amdgpu_governor *gov = &adev->pm.governor;
+
+	if (sclk)
+		amdgpu_dpm_force_clock_level(adev, PP_SCLK, 1 << gov->sclk.level);
+	if (mclk)
+		amdgpu_dpm_force_clock_level(adev, PP_MCLK, 1 << gov->mclk.level);
+}
+
+static void amdgpu_gov_reset_counters(struct amdgpu_device *adev)
+{
+	struct amdgpu_governor *gov = &adev->pm.governor;
+	unsigned i;
+
+	for (i = 0; i < AMDGPU_MAX_RINGS; i++) {
+		struct amdgpu_ring *ring = adev->rings[i];
+
+		if (ring && ring->fence_drv.initialized)
+			gov->ring_busy[i] = amdgpu_fence_busy_time(ring);
+	}
+	gov->bytes_moved = atomic64_read(&adev->num_bytes_moved);
+	gov->last_ns = ktime_to_ns(ktime_get());
+}
+
+static u64 amdgpu_gov_sample(struct amdgpu_device *adev,
+			     unsigned *sclk_util, unsigned *mclk_util)
+{
+	struct amdgpu_governor *gov = &adev->pm.governor;
+	u64 now = ktime_to_ns(ktime_get());
+	u64 interval = now - gov->last_ns;
+	u64 busy, delta, moved;
+	unsigned i, util;
+
+	*sclk_util = 0;
+	*mclk_util = 0;
+
+	for (i = 0; i < AMDGPU_MAX_RINGS; i++) {
+		struct amdgpu_ring *ring = adev->rings[i];
+
+		if (!ring || !ring->fence_drv.initialized)
+			continue;
+
+		busy = amdgpu_fence_busy_time(ring);
+		delta = busy > gov->ring_busy[i] ? busy - gov->ring_busy[i] : 0;
+		gov->ring_busy[i] = max(busy, gov->ring_busy[i]);
+		util = amdgpu_gov_percent(delta, interval);
+
+		switch (ring->type) {
+		case AMDGPU_RING_TYPE_GFX:
+		case AMDGPU_RING_TYPE_COMPUTE:
+			*sclk_util = max(*sclk_util, util);
+			break;
+		case AMDGPU_RING_TYPE_SDMA:
+			*mclk_util = max(*mclk_util, util);
+			break;
+		default:
+			break;
+		}
+	}
+
+	/* move_bw is in MB/s, which is bytes per us */
+	moved = atomic64_read(&adev->num_bytes_moved);
+	util = amdgpu_gov_percent(moved - gov->bytes_moved,
+				  (u64)gov->params.move_bw *
+				  div_u64(interval, NSEC_PER_USEC));
+	*mclk_util = max(*mclk_util, util);
+	gov->bytes_moved = moved;
+	gov->last_ns = now;
+
+	return interval;
+}
+
+static void amdgpu_gov_record(struct amdgpu_governor *gov, u64 interval,
+			      unsigned sclk_util, unsigned mclk_util)
+{
+	struct amdgpu_gov_sample *s = &gov->trace[gov->trace_head];
+
+	s->interval_us = min_t(u64, div_u64(interval, NSEC_PER_USEC), U32_MAX);
+	s->sclk_util = sclk_util;
+	s->sclk_level = gov->sclk.level;
+	s->mclk_util = mclk_util;
+	s->mclk_level = gov->mclk.level;
+
+	gov->trace_head = (gov->trace_head + 1) % AMDGPU_GOV_TRACE_SIZE;
+	if (gov->trace_count < AMDGPU_GOV_TRACE_SIZE)
+		gov->trace_count++;
+}
+
+static void amdgpu_gov_work_handler(struct work_struct *work)
+{
+	struct amdgpu_governor *gov =
+		container_of(work, struct amdgpu_governor, work.work);
+	struct amdgpu_device *adev =
+		container_of(gov, struct amdgpu_device, pm.governor);
+	unsigned sclk_util, mclk_util;
+	bool sclk, mclk;
+	u64 interval;
+	int r;
+
+	mutex_lock(&gov->mutex);
+	if (!gov->enabled)
+		goto out;
+
+	interval = amdgpu_gov_sample(adev, &sclk_util, &mclk_util);
+	amdgpu_gov_record(gov, interval, sclk_util, mclk_util);
+
+	/* power state changes drop back to auto and rewrite the masks */
+	if (amdgpu_dpm_get_performance_level(adev) != AMD_DPM_FORCED_LEVEL_MANUAL)
+		gov->stale = true;
+	if (gov->stale) {
+		/* leave the levels stale and try again on the next sample */
+		r = amdgpu_gov_read_levels(adev);
+		if (r) {
+			DRM_DEBUG_DRIVER("governor: reading dpm levels failed (%d)\n",
+					 r);
+			goto reschedule;
+		}
+		amdgpu_dpm_force_performance_level(adev,
+						   AMD_DPM_FORCED_LEVEL_MANUAL);
+	}
+
+	sclk = amdgpu_gov_update(&gov->sclk, sclk_util, gov->params.sclk_up,
+				 gov->params.sclk_down, &gov->params);
+	mclk = amdgpu_gov_update(&gov->mclk, mclk_util, gov->params.mclk_up,
+				 gov->params.mclk_down, &gov->params);
+	amdgpu_gov_apply(adev, sclk || gov->stale, mclk || gov->stale);
+	gov->stale = false;
+
+reschedule:
+	schedule_delayed_work(&gov->work,
+			      msecs_to_jiffies(gov->params.interval_ms));
+out:
+	mutex_unlock(&gov->mutex);
+}
+
+/**
+ * amdgpu_governor_init - set up the governor state
+ *
+ * @adev: amdgpu_device pointer
+ *
+ * The governor stays idle until amdgpu_governor_start() is called.
+ */
+void amdgpu_governor_init(struct amdgpu_device *adev)
+{
+	struct amdgpu_governor *gov = &adev->pm.governor;
+
+	mutex_init(&gov->mutex);
+	INIT_DELAYED_WORK(&gov->work, amdgpu_gov_work_handler);
+	gov->params = amdgpu_gov_default_params;
+}
+
+/**
+ * amdgpu_governor_fini - tear down the governor
+ *
+ * @adev: amdgpu_device pointer
+ */
+void amdgpu_governor_fini(struct amdgpu_device *adev)
+{
+	struct amdgpu_governor *gov = &adev->pm.governor;
+
+	amdgpu_governor_stop(adev);
+
+	debugfs_remove(gov->sim_ent);
+	gov->sim_ent = NULL;
+	kfree(gov->sim);
+	gov->sim = NULL;
+}
+
+/**
+ * amdgpu_governor_start - hand the clock levels to the governor
+ *
+ * @adev: amdgpu_device pointer
+ *
+ * Switches powerplay to the manual performance level, starts from the
+ * highest levels and lets the load pull the clocks down.  Requires the
+ * asic to report its dpm levels.  Returns 0 on success, error on failure.
+ */
+int amdgpu_governor_start(struct amdgpu_device *adev)
+{
+	struct amdgpu_governor *gov = &adev->pm.governor;
+	int r = 0;
+
+	if (!adev->pp_enabled || !adev->pm.dpm_enabled)
+		return -EINVAL;
+
+	mutex_lock(&gov->mutex);
+	if (gov->enabled)
+		goto out;
+
+	r = amdgpu_gov_read_levels(adev);
+	if (r)
+		goto out;
+
+	gov->sclk.level = amdgpu_gov_highest(&gov->sclk);
+	gov->sclk.above = gov->sclk.below = 0;
+	gov->mclk.level = amdgpu_gov_highest(&gov->mclk);
+	gov->mclk.above = gov->mclk.below = 0;
+
+	amdgpu_dpm_force_performance_level(adev, AMD_DPM_FORCED_LEVEL_MANUAL);
+	amdgpu_gov_apply(adev, true, true);
+	amdgpu_gov_reset_counters(adev);
+	gov->stale = false;
+	gov->enabled = true;
+
+	schedule_delayed_work(&gov->work,
+			      msecs_to_jiffies(gov->params.interval_ms));
+out:
+	mutex_unlock(&gov->mutex);
+	return r;
+}
+
+/**
+ * amdgpu_governor_stop - stop the governor
+ *
+ * @adev: amdgpu_device pointer
+ *
+ * The last forced levels stay in place until the caller selects a new
+ * performance level.
+ */
+void amdgpu_governor_stop(struct amdgpu_device *adev)
+{
+	struct amdgpu_governor *gov = &adev->pm.governor;
+	bool enabled;
+
+	mutex_lock(&gov->mutex);
+	enabled = gov->enabled;
+	gov->enabled = false;
+	mutex_unlock(&gov->mutex);
+
+	if (!enabled)
+		return;
+
+	cancel_delayed_work_sync(&gov->work);
+
+	/* a start() that got in before the cancel just lost its work */
+	mutex_lock(&gov->mutex);
+	if (gov->enabled)
+		schedule_delayed_work(&gov->work,
+				      msecs_to_jiffies(gov->params.interval_ms));
+	mutex_unlock(&gov->mutex);
+}
+
+void amdgpu_governor_suspend(struct amdgpu_device *adev)
+{
+	cancel_delayed_work_sync(&adev->pm.governor.work);
+}
+
+void amdgpu_governor_resume(struct amdgpu_device *adev)
+{
+	struct amdgpu_governor *gov = &adev->pm.governor;
+
+	mutex_lock(&gov->mutex);
+	if (gov->enabled) {
+		gov->stale = true;
+		amdgpu_gov_reset_counters(adev);
+		schedule_delayed_work(&gov->work,
+				      msecs_to_jiffies(gov->params.interval_ms));
+	}
+	mutex_unlock(&gov->mutex);
+}
+
+/**
+ * amdgpu_governor_invalidate - note that the forced levels were dropped
+ *
+ * @adev: amdgpu_device pointer
+ *
+ * Called after power state changes, the next sample forces the current
+ * levels again.
+ */
+void amdgpu_governor_invalidate(struct amdgpu_device *adev)
+{
+	struct amdgpu_governor *gov = &adev->pm.governor;
+
+	mutex_lock(&gov->mutex);
+	gov->stale = true;
+	mutex_unlock(&gov->mutex);
+}
+
+ssize_t amdgpu_governor_show_params(struct amdgpu_device *adev, char *buf)
+{
+	struct amdgpu_governor *gov = &adev->pm.governor;
+	ssize_t size = 0;
+	unsigned i;
+
+	mutex_lock(&gov->mutex);
+	for (i = 0; i < ARRAY_SIZE(amdgpu_gov_param_names); i++)
+		size += snprintf(buf + size, PAGE_SIZE - size, "%s %u\n",
+				 amdgpu_gov_param_names[i].name,
+				 *amdgpu_gov_param(&gov->params, i));
+	mutex_unlock(&gov->mutex);
+
+	return size;
+}
+
+int amdgpu_governor_set_param(struct amdgpu_device *adev, const char *buf)
+{
+	struct amdgpu_governor *gov = &adev->pm.governor;
+	int r;
+
+	mutex_lock(&gov->mutex);
+	r = amdgpu_gov_parse_param(&gov->params, buf);
+	mutex_unlock(&gov->mutex);
+
+	return r;
+}
+
+/*
+ * Debugfs info
+ */
+#if defined(CONFIG_DEBUG_FS)
+
+/*
+ * Simulator
+ *
+ * Replays a recorded trace against the current dpm levels for three
+ * policies: the governor with the parameters given at the start of the
+ * trace, the levels as recorded, and the highest level.  The work of an
+ * interval is the recorded utilization times the recorded clock; work the
+ * simulated clock cannot finish carries over and counts as delay.  Energy
+ * is modelled as executed cycles times f^2 (voltage tracks the clock) plus
+ * a static part proportional to f, and is only meant to rank policies.
+ */
+
+/* idle power at the top level, in percent of full load power */
+#define AMDGPU_GOV_SIM_STATIC_PCT	25
+
+enum amdgpu_gov_sim_policy_id {
+	AMDGPU_GOV_SIM_GOVERNOR,
+	AMDGPU_GOV_SIM_RECORDED,
+	AMDGPU_GOV_SIM_HIGHEST,
+	AMDGPU_GOV_SIM_NUM_POLICIES
+};
+
+static const char *amdgpu_gov_sim_policy_names[] = {
+	"governor",
+	"recorded",
+	"highest",
+};
+
+struct amdgpu_gov_sim_policy {
+	struct amdgpu_gov_domain	d;
+	u64				backlog;	/* MHz * us */
+	u64				energy;
+	u64				delay_us;
+};
+
+struct amdgpu_gov_sim {
+	struct amdgpu_gov_params	params;
+	struct amdgpu_gov_sim_policy	sclk[AMDGPU_GOV_SIM_NUM_POLICIES];
+	struct amdgpu_gov_sim_policy	mclk[AMDGPU_GOV_SIM_NUM_POLICIES];
+	u64				samples;
+	u64				time_us;
+	bool				error;
+	unsigned			line_len;
+	char				line[64];
+};
+
+static unsigned amdgpu_gov_sim_mhz(const struct amdgpu_gov_domain *d,
+				   unsigned level)
+{
+	unsigned clock = amdgpu_gov_clock(d, level);
+
+	if (!clock)
+		clock = amdgpu_gov_clock(d, amdgpu_gov_highest(d));
+	return max(clock / 100, 1u);
+}
+
+static void amdgpu_gov_sim_step(struct amdgpu_gov_sim *sim,
+				struct amdgpu_gov_sim_policy *pol,
+				enum amdgpu_gov_sim_policy_id id,
+				unsigned up, unsigned down, u32 interval,
+				unsigned util, unsigned level)
+{
+	struct amdgpu_gov_domain *d = &pol->d;
+	unsigned f_max = amdgpu_gov_sim_mhz(d, amdgpu_gov_highest(d));
+	unsigned f_rec = amdgpu_gov_sim_mhz(d, level);
+	u64 work, capacity, done;
+	unsigned f;
+
+	if (id == AMDGPU_GOV_SIM_RECORDED)
+		d->level = amdgpu_gov_clock(d, level) ? level :
+			amdgpu_gov_highest(d);
+	f = amdgpu_gov_sim_mhz(d, d->level);
+
+	work = div_u64((u64)min(util, 100u) * f_rec * interval, 100);
+	capacity = (u64)f * interval;
+	work += pol->backlog;
+	done = min(work, capacity);
+	pol->backlog = work - done;
+
+	pol->energy += div_u64(div_u64(done * f, f_max) * f, f_max);
+	pol->energy += div_u64((u64)AMDGPU_GOV_SIM_STATIC_PCT * f * interval,
+			       100);
+	pol->delay_us += div_u64(pol->backlog, f);
+
+	if (id == AMDGPU_GOV_SIM_GOVERNOR)
+		amdgpu_gov_update(d, pol->backlog ? 100 :
+				  amdgpu_gov_percent(done, capacity),
+				  up, down, &sim->params);
+}
+
+static int amdgpu_gov_sim_line(struct amdgpu_gov_sim *sim, const char *line)
+{
+	unsigned sclk_util, sclk_level, mclk_util, mclk_level, i;
+	u32 interval;
+
+	line = skip_spaces(line);
+	if (!*line || *line == '#')
+		return 0;
+
+	/* parameter overrides are only accepted ahead of the samples */
+	if (isalpha(*line))
+		return sim->samples ? -EINVAL :
+			amdgpu_gov_parse_param(&sim->params, line);
+
+	if (sscanf(line, "%u %u %u %u %u", &interval, &sclk_util, &sclk_level,
+		   &mclk_util, &mclk_level) != 5)
+		return -EINVAL;
+
+	for (i = 0; i < AMDGPU_GOV_SIM_NUM_POLICIES; i++) {
+		amdgpu_gov_sim_step(sim, &sim->sclk[i], i, sim->params.sclk_up,
+				    sim->params.sclk_down, interval,
+				    sclk_util, sclk_level);
+		amdgpu_gov_sim_step(sim, &sim->mclk[i], i, sim->params.mclk_up,
+				    sim->params.mclk_down, interval,
+				    mclk_util, mclk_level);
+	}
+	sim->samples++;
+	sim->time_us += interval;
+
+	return 0;
+}
+
+static void amdgpu_gov_sim_flush(struct amdgpu_gov_sim *sim)
+{
+	if (!sim->line_len)
+		return;
+
+	sim->line[sim->line_len] = '\0';
+	sim->line_len = 0;
+	if (amdgpu_gov_sim_line(sim, sim->line))
+		sim->error = true;
+}
+
+static unsigned amdgpu_gov_sim_permille(u64 value, u64 base)
+{
+	return base ? div64_u64(value * 1000, base) : 0;
+}
+
+static void amdgpu_gov_sim_print(struct seq_file *m, const char *domain,
+				 struct amdgpu_gov_sim_policy *pol, u64 time_us)
+{
+	struct amdgpu_gov_sim_policy *base = &pol[AMDGPU_GOV_SIM_HIGHEST];
+	unsigned i, energy, elapsed;
+
+	for (i = 0; i < AMDGPU_GOV_SIM_NUM_POLICIES; i++) {
+		energy = amdgpu_gov_sim_permille(pol[i].energy, base->energy);
+		elapsed = amdgpu_gov_sim_permille(time_us + pol[i].delay_us,
+						  time_us + base->delay_us);
+		seq_printf(m, "%s %-8s: energy %4u, delay %8llu ms, edp %4u, transitions %llu\n",
+			   domain, amdgpu_gov_sim_policy_names[i], energy,
+			   div_u64(pol[i].delay_us, USEC_PER_MSEC),
+			   energy * elapsed / 1000, pol[i].d.transitions);
+	}
+}
+
+static int amdgpu_gov_sim_show(struct seq_file *m, void *data)
+{
+	struct amdgpu_device *adev = m->private;
+	struct amdgpu_governor *gov = &adev->pm.governor;
+	struct amdgpu_gov_sim *sim;
+
+	mutex_lock(&gov->mutex);
+	sim = gov->sim;
+	if (!sim) {
+		seq_printf(m, "no trace replayed\n");
+		goto out;
+	}
+
+	amdgpu_gov_sim_flush(sim);
+	if (sim->error)
+		seq_printf(m, "trace contained invalid lines\n");
+	seq_printf(m, "%llu samples, %llu ms\n", sim->samples,
+		   div_u64(sim->time_us, USEC_PER_MSEC));
+	seq_printf(m, "energy and edp in permille of the highest level\n");
+	amdgpu_gov_sim_print(m, "sclk", sim->sclk, sim->time_us);
+	amdgpu_gov_sim_print(m, "mclk", sim->mclk, sim->time_us);
+out:
+	mutex_unlock(&gov->mutex);
+	return 0;
+}
+
+static int amdgpu_gov_sim_reset(struct amdgpu_device *adev)
+{
+	struct amdgpu_governor *gov = &adev->pm.governor;
+	struct amdgpu_gov_sim *sim;
+	unsigned i;
+	int r = 0;
+
+	sim = kzalloc(sizeof(*sim), GFP_KERNEL);
+	if (!sim)
+		return -ENOMEM;
+
+	mutex_lock(&gov->mutex);
+	if (!gov->enabled)
+		r = amdgpu_gov_read_levels(adev);
+	if (r) {
+		mutex_unlock(&gov->mutex);
+		kfree(sim);
+		return r;
+	}
+
+	sim->params = gov->params;
+	for (i = 0; i < AMDGPU_GOV_SIM_NUM_POLICIES; i++) {
+		sim->sclk[i].d.levels = gov->sclk.levels;
+		sim->sclk[i].d.level = amdgpu_gov_highest(&gov->sclk);
+		sim->mclk[i].d.levels = gov->mclk.levels;
+		sim->mclk[i].d.level = amdgpu_gov_highest(&gov->mclk);
+	}
+	kfree(gov->sim);
+	gov->sim = sim;
+	mutex_unlock(&gov->mutex);
+
+	return 0;
+}
+
+static int amdgpu_gov_sim_open(struct inode *inode, struct file *f)
+{
+	struct amdgpu_device *adev = inode->i_private;
+	int r;
+
+	if (f->f_mode & FMODE_WRITE) {
+		r = amdgpu_gov_sim_reset(adev);
+		if (r)
+			return r;
+	}
+
+	return single_open(f, amdgpu_gov_sim_show, adev);
+}
+
+static ssize_t amdgpu_gov_sim_write(struct file *f, const char __user *buf,
+				    size_t size, loff_t *pos)
+{
+	struct amdgpu_device *adev = file_inode(f)->i_private;
+	struct amdgpu_governor *gov = &adev->pm.governor;
+	struct amdgpu_gov_sim *sim;
+	char chunk[256];
+	size_t len, i;
+	ssize_t r;
+
+	len = min(size, sizeof(chunk));
+	if (copy_from_user(chunk, buf, len))
+		return -EFAULT;
+
+	mutex_lock(&gov->mutex);
+	sim = gov->sim;
+	r = sim ? len : -EINVAL;
+	for (i = 0; sim && i < len; i++) {
+		if (chunk[i] == '\n') {
+			amdgpu_gov_sim_flush(sim);
+		} else if (sim->line_len < sizeof(sim->line) - 1) {
+			sim->line[sim->line_len++] = chunk[i];
+		} else {
+			sim->error = true;
+			r = -EINVAL;
+			break;
+		}
+	}
+	if (sim && sim->error)
+		r = -EINVAL;
+	mutex_unlock(&gov->mutex);
+
+	if (r > 0)
+		*pos += r;
+	return r;
+}
+
+static const struct file_operations amdgpu_gov_sim_fops = {
+	.owner = THIS_MODULE,
+	.open = amdgpu_gov_sim_open,
+	.read = seq_read,
+	.write = amdgpu_gov_sim_write,
+	.llseek = seq_lseek,
+	.release = single_release,
+};
+
+static int amdgpu_debugfs_gov_trace(struct seq_file *m, void *data)
+{
+	struct drm_info_node *node = (struct drm_info_node *) m->private;
+	struct drm_device *dev = node->minor->dev;
+	struct amdgpu_device *adev = dev->dev_private;
+	struct amdgpu_governor *gov = &adev->pm.governor;
+	struct amdgpu_gov_sample *s;
+	unsigned i, idx;
+
+	mutex_lock(&gov->mutex);
+	seq_printf(m, "# interval_us sclk_util sclk_level mclk_util mclk_level\n");
+	idx = (gov->trace_head + AMDGPU_GOV_TRACE_SIZE - gov->trace_count) %
+		AMDGPU_GOV_TRACE_SIZE;
+	for (i = 0; i < gov->trace_count; i++) {
+		s = &gov->trace[(idx + i) % AMDGPU_GOV_TRACE_SIZE];
+		seq_printf(m, "%u %u %u %u %u\n", s->interval_us,
+			   s->sclk_util, s->sclk_level,
+			   s->mclk_util, s->mclk_level);
+	}
+	mutex_unlock(&gov->mutex);
+
+	return 0;
+}
+
+static const struct drm_info_list amdgpu_gov_debugfs_list[] = {
+	{"amdgpu_pm_governor_trace", amdgpu_debugfs_gov_trace, 0, NULL},
+};
+
+void amdgpu_governor_debugfs_print(struct amdgpu_device *adev,
+				   struct seq_file *m)
+{
+	struct amdgpu_governor *gov = &adev->pm.governor;
+
+	mutex_lock(&gov->mutex);
+	if (gov->enabled)
+		seq_printf(m, "governor: sclk level %u (%llu transitions), mclk level %u (%llu transitions)\n",
+			   gov->sclk.level, gov->sclk.transitions,
+			   gov->mclk.level, gov->mclk.transitions);
+	mutex_unlock(&gov->mutex);
+}
+#endif
+
+int amdgpu_governor_debugfs_init(struct amdgpu_device *adev)
+{
+#if defined(CONFIG_DEBUG_FS)
+	struct drm_minor *minor = adev->ddev->primary;
+	struct dentry *ent;
+	int r;
+
+	r = amdgpu_debugfs_add_files(adev, amdgpu_gov_debugfs_list,
+				     ARRAY_SIZE(amdgpu_gov_debugfs_list));
+	if (r)
+		return r;
+
+	ent = debugfs_create_file("amdgpu_pm_governor_sim",
+				  S_IFREG | S_IRUGO | S_IWUSR,
+				  minor->debugfs_root, adev,
+				  &amdgpu_gov_sim_fops);
+	if (IS_ERR(ent))
+		return PTR_ERR(ent);
+	adev->pm.governor.sim_ent = ent;
+#endif
+	return 0;
+}
@@ -0,0 +1,102 @@
+/*
+ * Copyright 2016 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE COPYRIGHT HOLDER(S) OR AUTHOR(S) BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#ifndef __AMDGPU_GOVERNOR_H__
+#define __AMDGPU_GOVERNOR_H__
+
+/*
+ * Utilization driven dpm governor.  Samples the busy time of the rings and
+ * the TTM move traffic and forces sclk/mclk levels through the manual
+ * performance level interface of powerplay.
+ */
+
+#define AMDGPU_GOV_TRACE_SIZE		1024
+
+struct amdgpu_device;
+struct amdgpu_gov_sim;
+
+struct amdgpu_gov_params {
+	unsigned	interval_ms;	/* sampling period */
+	unsigned	sclk_up;	/* busy % above which sclk is raised */
+	unsigned	sclk_down;	/* busy % below which sclk is lowered */
+	unsigned	mclk_up;
+	unsigned	mclk_down;
+	unsigned	up_hold;	/* samples above up before raising */
+	unsigned	down_hold;	/* samples below down before lowering */
+	unsigned	move_bw;	/* MB/s of TTM moves counted as 100% */
+};
+
+struct amdgpu_gov_domain {
+	struct amd_pp_clocks	levels;	/* 10 kHz, 0 for disabled levels */
+	unsigned		level;
+	unsigned		above;
+	unsigned		below;
+	u64			transitions;
+};
+
+struct amdgpu_gov_sample {
+	u32	interval_us;
+	u8	sclk_util;
+	u8	sclk_level;
+	u8	mclk_util;
+	u8	mclk_level;
+};
+
+struct amdgpu_governor {
+	struct mutex			mutex;
+	struct delayed_work		work;
+	bool				enabled;
+	/* forced levels may have been reset by a power state change */
+	bool				stale;
+	struct amdgpu_gov_params	params;
+	struct amdgpu_gov_domain	sclk;
+	struct amdgpu_gov_domain	mclk;
+
+	/* counters at the previous sample */
+	u64				last_ns;
+	u64				ring_busy[AMDGPU_MAX_RINGS];
+	u64				bytes_moved;
+
+	/* recorded utilization, replayed by the simulator */
+	struct amdgpu_gov_sample	trace[AMDGPU_GOV_TRACE_SIZE];
+	unsigned			trace_head;
+	unsigned			trace_count;
+
+	struct amdgpu_gov_sim		*sim;
+	struct dentry			*sim_ent;
+};
+
+void amdgpu_governor_init(struct amdgpu_device *adev);
+void amdgpu_governor_fini(struct amdgpu_device *adev);
+int amdgpu_governor_start(struct amdgpu_device *adev);
+void amdgpu_governor_stop(struct amdgpu_device *adev);
+void amdgpu_governor_suspend(struct amdgpu_device *adev);
+void amdgpu_governor_resume(struct amdgpu_device *adev);
+void amdgpu_governor_invalidate(struct amdgpu_device *adev);
+ssize_t amdgpu_governor_show_params(struct amdgpu_device *adev, char *buf);
+int amdgpu_governor_set_param(struct amdgpu_device *adev, const char *buf);
+void amdgpu_governor_debugfs_print(struct amdgpu_device *adev,
+				   struct seq_file *m);
+int amdgpu_governor_debugfs_init(struct amdgpu_device *adev);
+
+#endif
@@ -36,7 +36,7 @@ static void amdgpu_job_timedout(struct amd_sched_job *s_job)
 		  job->base.sched->name,
 		  atomic_read(&job->ring->fence_drv.last_seq),
 		  job->ring->fence_drv.sync_seq);
-	amdgpu_gpu_reset(job->adev);
+	amdgpu_gpu_recover(job->adev, job);
 }
 
 int amdgpu_job_alloc(struct amdgpu_device *adev, unsigned num_ibs,
@@ -174,6 +174,22 @@ static struct fence *amdgpu_job_run(struct amd_sched_job *sched_job)
 		return NULL;
 	}
 
+	/*
+	 * Resubmitted after a GPU reset, the VMID must be flushed again.  It
+	 * may have been taken over by another VM since, so use our own page
+	 * directory, and don't run while another ring still uses the VMID.
+	 */
+	if (job->fence && job->vm) {
+		job->vm_pd_addr = job->vm_pd_base;
+		r = amdgpu_vm_wait_resubmit(job->ring, job->vm_id,
+					    &job->base.s_fence->base);
+		if (r) {
+			DRM_ERROR("failed to wait for VMID %u (%d)\n",
+				  job->vm_id, r);
+			return NULL;
+		}
+	}
+
 	trace_amdgpu_sched_run_job(job);
 	r = amdgpu_ib_schedule(job->ring, job->num_ibs, job->ibs,
 			       job->sync.last_vm_update, job, &fence);
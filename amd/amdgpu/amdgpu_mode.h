@@ -538,6 +538,8 @@ struct amdgpu_i2c_adapter {
 
 #define TO_DM_AUX(x) container_of((x), struct amdgpu_dm_dp_aux, aux)
 
+struct amdgpu_dm_mode_cache;
+
 struct amdgpu_connector {
 	struct drm_connector base;
 	uint32_t connector_id;
@@ -583,6 +585,9 @@ struct amdgpu_connector {
 	int max_vfreq ;
 	int pixel_clock_mhz;
 
+	/* mode_valid verdicts for the current sink, allocated on first use */
+	struct amdgpu_dm_mode_cache *mode_cache;
+
 };
 
 /* TODO: start to use this struct and remove same field from base one */
@@ -120,6 +120,9 @@ static ssize_t amdgpu_get_dpm_forced_performance_level(struct device *dev,
 	if (adev->pp_enabled) {
 		enum amd_dpm_forced_level level;
 
+		if (adev->pm.governor.enabled)
+			return snprintf(buf, PAGE_SIZE, "governor\n");
+
 		level = amdgpu_dpm_get_performance_level(adev);
 		return snprintf(buf, PAGE_SIZE, "%s\n",
 				(level == AMD_DPM_FORCED_LEVEL_AUTO) ? "auto" :
@@ -159,11 +162,17 @@ static ssize_t amdgpu_set_dpm_forced_performance_level(struct device *dev,
 		level = AMDGPU_DPM_FORCED_LEVEL_AUTO;
 	} else if (strncmp("manual", buf, strlen("manual")) == 0) {
 		level = AMDGPU_DPM_FORCED_LEVEL_MANUAL;
+	} else if (strncmp("governor", buf, strlen("governor")) == 0) {
+		if (amdgpu_governor_start(adev))
+			count = -EINVAL;
+		goto fail;
 	} else {
 		count = -EINVAL;
 		goto fail;
 	}
 
+	amdgpu_governor_stop(adev);
+
 	if (adev->pp_enabled)
 		amdgpu_dpm_force_performance_level(adev, level);
 	else {
@@ -579,6 +588,30 @@ fail:
 	return count;
 }
 
+static ssize_t amdgpu_get_pp_governor(struct device *dev,
+		struct device_attribute *attr,
+		char *buf)
+{
+	struct drm_device *ddev = dev_get_drvdata(dev);
+	struct amdgpu_device *adev = ddev->dev_private;
+
+	return amdgpu_governor_show_params(adev, buf);
+}
+
+static ssize_t amdgpu_set_pp_governor(struct device *dev,
+		struct device_attribute *attr,
+		const char *buf,
+		size_t count)
+{
+	struct drm_device *ddev = dev_get_drvdata(dev);
+	struct amdgpu_device *adev = ddev->dev_private;
+
+	if (amdgpu_governor_set_param(adev, buf))
+		return -EINVAL;
+
+	return count;
+}
+
 static DEVICE_ATTR(power_dpm_state, S_IRUGO | S_IWUSR, amdgpu_get_dpm_state, amdgpu_set_dpm_state);
 static DEVICE_ATTR(power_dpm_force_performance_level, S_IRUGO | S_IWUSR,
 		   amdgpu_get_dpm_forced_performance_level,
@@ -606,6 +639,9 @@ static DEVICE_ATTR(pp_sclk_od, S_IRUGO | S_IWUSR,
 static DEVICE_ATTR(pp_mclk_od, S_IRUGO | S_IWUSR,
 		amdgpu_get_pp_mclk_od,
 		amdgpu_set_pp_mclk_od);
+static DEVICE_ATTR(pp_governor, S_IRUGO | S_IWUSR,
+		amdgpu_get_pp_governor,
+		amdgpu_set_pp_governor);
 
 static ssize_t amdgpu_hwmon_show_temp(struct device *dev,
 				      struct device_attribute *attr,
@@ -1110,9 +1146,10 @@ force:
 
 void amdgpu_dpm_enable_uvd(struct amdgpu_device *adev, bool enable)
 {
-	if (adev->pp_enabled)
+	if (adev->pp_enabled) {
 		amdgpu_dpm_powergate_uvd(adev, !enable);
-	else {
+		amdgpu_governor_invalidate(adev);
+	} else {
 		if (adev->pm.funcs->powergate_uvd) {
 			mutex_lock(&adev->pm.mutex);
 			/* enable/disable UVD */
@@ -1137,9 +1174,10 @@ void amdgpu_dpm_enable_uvd(struct amdgpu_device *adev, bool enable)
 
 void amdgpu_dpm_enable_vce(struct amdgpu_device *adev, bool enable)
 {
-	if (adev->pp_enabled)
+	if (adev->pp_enabled) {
 		amdgpu_dpm_powergate_vce(adev, !enable);
-	else {
+		amdgpu_governor_invalidate(adev);
+	} else {
 		if (adev->pm.funcs->powergate_vce) {
 			mutex_lock(&adev->pm.mutex);
 			amdgpu_dpm_powergate_vce(adev, !enable);
@@ -1228,6 +1266,11 @@ int amdgpu_pm_sysfs_init(struct amdgpu_device *adev)
 			DRM_ERROR("failed to create device file pp_table\n");
 			return ret;
 		}
+		ret = device_create_file(adev->dev, &dev_attr_pp_governor);
+		if (ret) {
+			DRM_ERROR("failed to create device file pp_governor\n");
+			return ret;
+		}
 	}
 
 	ret = device_create_file(adev->dev, &dev_attr_pp_dpm_sclk);
@@ -1278,6 +1321,7 @@ void amdgpu_pm_sysfs_fini(struct amdgpu_device *adev)
 		device_remove_file(adev->dev, &dev_attr_pp_cur_state);
 		device_remove_file(adev->dev, &dev_attr_pp_force_state);
 		device_remove_file(adev->dev, &dev_attr_pp_table);
+		device_remove_file(adev->dev, &dev_attr_pp_governor);
 	}
 	device_remove_file(adev->dev, &dev_attr_pp_dpm_sclk);
 	device_remove_file(adev->dev, &dev_attr_pp_dpm_mclk);
@@ -1306,6 +1350,7 @@ void amdgpu_pm_compute_clocks(struct amdgpu_device *adev)
 		}
 
 		amdgpu_dpm_dispatch_task(adev, AMD_PP_EVENT_DISPLAY_CONFIG_CHANGE, NULL, NULL);
+		amdgpu_governor_invalidate(adev);
 	} else {
 		mutex_lock(&adev->pm.mutex);
 		adev->pm.dpm.new_active_crtcs = 0;
@@ -1353,6 +1398,7 @@ static int amdgpu_debugfs_pm_info(struct seq_file *m, void *data)
 		seq_printf(m, "PX asic powered off\n");
 	} else if (adev->pp_enabled) {
 		amdgpu_dpm_debugfs_print_current_performance_level(adev, m);
+		amdgpu_governor_debugfs_print(adev, m);
 	} else {
 		mutex_lock(&adev->pm.mutex);
 		if (adev->pm.funcs->debugfs_print_current_performance_level)
@@ -1373,7 +1419,17 @@ static const struct drm_info_list amdgpu_pm_info_list[] = {
 static int amdgpu_debugfs_pm_init(struct amdgpu_device *adev)
 {
 #if defined(CONFIG_DEBUG_FS)
-	return amdgpu_debugfs_add_files(adev, amdgpu_pm_info_list, ARRAY_SIZE(amdgpu_pm_info_list));
+	int r;
+
+	r = amdgpu_debugfs_add_files(adev, amdgpu_pm_info_list, ARRAY_SIZE(amdgpu_pm_info_list));
+	if (r || !adev->pp_enabled)
+		return r;
+
+	r = amdgpu_governor_debugfs_init(adev);
+	if (r)
+		return r;
+
+	return amdgpu_telemetry_debugfs_init(adev);
 #else
 	return 0;
 #endif
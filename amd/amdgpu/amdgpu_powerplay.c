@@ -148,6 +148,11 @@ static int amdgpu_pp_late_init(void *handle)
 	if (adev->pp_enabled && adev->pm.dpm_enabled) {
 		amdgpu_pm_sysfs_init(adev);
 		amdgpu_dpm_dispatch_task(adev, AMD_PP_EVENT_COMPLETE_INIT, NULL, NULL);
+		if (amdgpu_dpm_governor && amdgpu_governor_start(adev))
+			DRM_INFO("dpm governor not supported on this asic\n");
+		if (amdgpu_telemetry_ms &&
+		    amdgpu_telemetry_start(adev, amdgpu_telemetry_ms))
+			DRM_INFO("power telemetry not supported on this asic\n");
 	}
 #endif
 	return ret;
@@ -220,6 +225,8 @@ static void amdgpu_pp_late_fini(void *handle)
 
 #ifdef CONFIG_DRM_AMD_POWERPLAY
 	if (adev->pp_enabled) {
+		amdgpu_telemetry_fini(adev);
+		amdgpu_governor_fini(adev);
 		amdgpu_pm_sysfs_fini(adev);
 		amd_powerplay_fini(adev->powerplay.pp_handle);
 	}
@@ -235,6 +242,11 @@ static int amdgpu_pp_suspend(void *handle)
 	int ret = 0;
 	struct amdgpu_device *adev = (struct amdgpu_device *)handle;
 
+	if (adev->pp_enabled) {
+		amdgpu_telemetry_suspend(adev);
+		amdgpu_governor_suspend(adev);
+	}
+
 	if (adev->powerplay.ip_funcs->suspend)
 		ret = adev->powerplay.ip_funcs->suspend(
 					 adev->powerplay.pp_handle);
@@ -249,6 +261,12 @@ static int amdgpu_pp_resume(void *handle)
 	if (adev->powerplay.ip_funcs->resume)
 		ret = adev->powerplay.ip_funcs->resume(
 					adev->powerplay.pp_handle);
+
+	if (adev->pp_enabled) {
+		amdgpu_governor_resume(adev);
+		amdgpu_telemetry_resume(adev);
+	}
+
 	return ret;
 }
 
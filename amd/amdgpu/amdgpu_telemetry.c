@@ -0,0 +1,569 @@
+/*
+ * Copyright 2016 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE COPYRIGHT HOLDER(S) OR AUTHOR(S) BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+#include <linux/debugfs.h>
+#include <linux/poll.h>
+#include <linux/seq_file.h>
+#include <linux/uaccess.h>
+#include <linux/vmalloc.h>
+#include <drm/drmP.h>
+#include "amdgpu.h"
+
+/*
+ * Telemetry
+ *
+ * The sensors are read once per interval by a single worker no matter how
+ * many consumers there are.  Consumers either mmap the ring and walk the
+ * records themselves, or read() it: the file position is the seq of the
+ * last record returned, each read returns whole records newer than that,
+ * and records overwritten before they were read show up as a gap in seq.
+ */
+
+#define AMDGPU_TELEMETRY_MASK	(AMDGPU_TELEMETRY_RECORDS - 1)
+
+static int amdgpu_telemetry_pp_read(struct amdgpu_device *adev,
+				    struct amd_pp_sensors *sensors)
+{
+	if (!adev->pp_enabled || !adev->pm.dpm_enabled ||
+	    !adev->powerplay.pp_funcs->read_sensors)
+		return -EINVAL;
+
+	return amdgpu_dpm_read_sensors(adev, sensors);
+}
+
+/*
+ * Synthetic sensors for exercising the ring and its consumers without
+ * hardware.  Every field is derived from the seq of the record being
+ * written, so a consumer can check each record it gets.
+ */
+static int amdgpu_telemetry_fake_read(struct amdgpu_device *adev,
+				      struct amd_pp_sensors *sensors)
+{
+	u32 n = lower_32_bits(adev->pm.telemetry.seq + 1);
+
+	sensors->sclk = 30000 + (n % 8) * 10000;
+	sensors->mclk = (n & 1) ? 125000 : 15000;
+	sensors->temperature = (40 + n % 50) * 1000;
+	sensors->fan_percent = n % 101;
+	sensors->fan_rpm = sensors->fan_percent * 30;
+	sensors->power = 20000 + (n % 200) * 1000;
+	sensors->gpu_load = n % 101;
+	sensors->mem_load = 100 - n % 101;
+
+	return 0;
+}
+
+static const struct amdgpu_telemetry_funcs amdgpu_telemetry_sources[] = {
+	{ "pp", amdgpu_telemetry_pp_read },
+	{ "fake", amdgpu_telemetry_fake_read },
+};
+
+static int amdgpu_telemetry_alloc(struct amdgpu_telemetry *tm)
+{
+	struct amdgpu_telemetry_header *header;
+
+	BUILD_BUG_ON(AMDGPU_TELEMETRY_RECORDS & AMDGPU_TELEMETRY_MASK);
+	BUILD_BUG_ON(sizeof(struct amdgpu_telemetry_header) > PAGE_SIZE);
+
+	if (tm->buf)
+		return 0;
+
+	tm->size = PAGE_SIZE + PAGE_ALIGN(AMDGPU_TELEMETRY_RECORDS *
+					  sizeof(struct amdgpu_telemetry_record));
+	tm->buf = vmalloc_user(tm->size);
+	if (!tm->buf)
+		return -ENOMEM;
+
+	header = tm->buf;
+	header->version = AMDGPU_TELEMETRY_VERSION;
+	header->record_size = sizeof(struct amdgpu_telemetry_record);
+	header->nr_records = AMDGPU_TELEMETRY_RECORDS;
+	header->records_offset = PAGE_SIZE;
+	header->interval_ms = tm->interval_ms;
+	header->head = tm->seq;
+
+	tm->header = header;
+	tm->records = tm->buf + PAGE_SIZE;
+
+	return 0;
+}
+
+static void amdgpu_telemetry_sample(struct amdgpu_device *adev)
+{
+	struct amdgpu_telemetry *tm = &adev->pm.telemetry;
+	struct amdgpu_telemetry_record *rec;
+	struct amd_pp_sensors sensors = {0};
+	u64 seq = tm->seq + 1;
+	u64 start, end;
+	u32 sample_us;
+	int r;
+
+	start = ktime_to_ns(ktime_get());
+	r = tm->funcs->read(adev, &sensors);
+	end = ktime_to_ns(ktime_get());
+	sample_us = min_t(u64, div_u64(end - start, NSEC_PER_USEC), U32_MAX);
+
+	rec = &tm->records[(seq - 1) & AMDGPU_TELEMETRY_MASK];
+	ACCESS_ONCE(rec->seq) = 0;
+	smp_wmb();
+
+	rec->timestamp_ns = end;
+	rec->sclk = sensors.sclk;
+	rec->mclk = sensors.mclk;
+	rec->temperature = sensors.temperature;
+	rec->fan_rpm = sensors.fan_rpm;
+	rec->power = sensors.power;
+	rec->fan_percent = min(sensors.fan_percent, 100u);
+	rec->gpu_load = min(sensors.gpu_load, 100u);
+	rec->mem_load = min(sensors.mem_load, 100u);
+	rec->flags = r ? AMDGPU_TELEMETRY_FLAG_ERROR : 0;
+	rec->sample_us = sample_us;
+	rec->pad = 0;
+
+	smp_wmb();
+	ACCESS_ONCE(rec->seq) = seq;
+	smp_wmb();
+	ACCESS_ONCE(tm->header->head) = seq;
+	ACCESS_ONCE(tm->seq) = seq;
+
+	if (r)
+		tm->errors++;
+	tm->sample_ns += end - start;
+	tm->max_sample_us = max(tm->max_sample_us, sample_us);
+
+	wake_up_interruptible(&tm->wait);
+}
+
+static void amdgpu_telemetry_work_handler(struct work_struct *work)
+{
+	struct amdgpu_telemetry *tm =
+		container_of(work, struct amdgpu_telemetry, work.work);
+	struct amdgpu_device *adev =
+		container_of(tm, struct amdgpu_device, pm.telemetry);
+
+	mutex_lock(&tm->mutex);
+	if (!tm->enabled)
+		goto out;
+
+	amdgpu_telemetry_sample(adev);
+
+	schedule_delayed_work(&tm->work, msecs_to_jiffies(tm->interval_ms));
+out:
+	mutex_unlock(&tm->mutex);
+}
+
+/**
+ * amdgpu_telemetry_init - set up the telemetry state
+ *
+ * @adev: amdgpu_device pointer
+ *
+ * Nothing is sampled or allocated until amdgpu_telemetry_start() is called.
+ */
+void amdgpu_telemetry_init(struct amdgpu_device *adev)
+{
+	struct amdgpu_telemetry *tm = &adev->pm.telemetry;
+
+	mutex_init(&tm->mutex);
+	INIT_DELAYED_WORK(&tm->work, amdgpu_telemetry_work_handler);
+	init_waitqueue_head(&tm->wait);
+	tm->interval_ms = 10;
+	tm->funcs = &amdgpu_telemetry_sources[0];
+}
+
+/**
+ * amdgpu_telemetry_fini - tear down the telemetry state
+ *
+ * @adev: amdgpu_device pointer
+ */
+void amdgpu_telemetry_fini(struct amdgpu_device *adev)
+{
+	struct amdgpu_telemetry *tm = &adev->pm.telemetry;
+	unsigned i;
+
+	amdgpu_telemetry_stop(adev);
+
+	for (i = 0; i < ARRAY_SIZE(tm->ent); i++) {
+		debugfs_remove(tm->ent[i]);
+		tm->ent[i] = NULL;
+	}
+
+	/* pages still mapped by userspace are released on munmap */
+	mutex_lock(&tm->mutex);
+	vfree(tm->buf);
+	tm->buf = NULL;
+	tm->header = NULL;
+	tm->records = NULL;
+	mutex_unlock(&tm->mutex);
+
+	wake_up_interruptible(&tm->wait);
+}
+
+static int amdgpu_telemetry_start_locked(struct amdgpu_device *adev,
+					 unsigned interval_ms)
+{
+	struct amdgpu_telemetry *tm = &adev->pm.telemetry;
+	struct amd_pp_sensors sensors;
+	int r;
+
+	if (interval_ms < 1 || interval_ms > 1000)
+		return -EINVAL;
+
+	r = amdgpu_telemetry_alloc(tm);
+	if (r)
+		return r;
+
+	/* refuse a source that cannot read anything on this asic */
+	if (!tm->enabled) {
+		r = tm->funcs->read(adev, &sensors);
+		if (r)
+			return r;
+	}
+
+	tm->interval_ms = interval_ms;
+	tm->header->interval_ms = interval_ms;
+	if (!tm->enabled) {
+		tm->enabled = true;
+		schedule_delayed_work(&tm->work, 0);
+	}
+
+	return 0;
+}
+
+/**
+ * amdgpu_telemetry_start - start sampling the sensors
+ *
+ * @adev: amdgpu_device pointer
+ * @interval_ms: sampling period, 1 to 1000 ms
+ *
+ * Changes the period if the sampler is already running.  The seq keeps
+ * counting across stop and start.  Returns 0 on success, error on failure.
+ */
+int amdgpu_telemetry_start(struct amdgpu_device *adev, unsigned interval_ms)
+{
+	struct amdgpu_telemetry *tm = &adev->pm.telemetry;
+	int r;
+
+	mutex_lock(&tm->mutex);
+	r = amdgpu_telemetry_start_locked(adev, interval_ms);
+	mutex_unlock(&tm->mutex);
+
+	return r;
+}
+
+/**
+ * amdgpu_telemetry_stop - stop sampling the sensors
+ *
+ * @adev: amdgpu_device pointer
+ *
+ * The recorded samples stay readable.
+ */
+void amdgpu_telemetry_stop(struct amdgpu_device *adev)
+{
+	struct amdgpu_telemetry *tm = &adev->pm.telemetry;
+	bool enabled;
+
+	mutex_lock(&tm->mutex);
+	enabled = tm->enabled;
+	tm->enabled = false;
+	mutex_unlock(&tm->mutex);
+
+	if (enabled) {
+		cancel_delayed_work_sync(&tm->work);
+		/* let blocked readers see the end of the stream */
+		wake_up_interruptible(&tm->wait);
+	}
+}
+
+void amdgpu_telemetry_suspend(struct amdgpu_device *adev)
+{
+	cancel_delayed_work_sync(&adev->pm.telemetry.work);
+}
+
+void amdgpu_telemetry_resume(struct amdgpu_device *adev)
+{
+	struct amdgpu_telemetry *tm = &adev->pm.telemetry;
+
+	mutex_lock(&tm->mutex);
+	if (tm->enabled)
+		schedule_delayed_work(&tm->work,
+				      msecs_to_jiffies(tm->interval_ms));
+	mutex_unlock(&tm->mutex);
+}
+
+/*
+ * Debugfs info
+ */
+#if defined(CONFIG_DEBUG_FS)
+
+static int amdgpu_telemetry_open(struct inode *inode, struct file *f)
+{
+	struct amdgpu_device *adev = inode->i_private;
+	struct amdgpu_telemetry *tm = &adev->pm.telemetry;
+	int r;
+
+	mutex_lock(&tm->mutex);
+	r = amdgpu_telemetry_alloc(tm);
+	mutex_unlock(&tm->mutex);
+	if (r)
+		return r;
+
+	f->private_data = adev;
+	return nonseekable_open(inode, f);
+}
+
+/*
+ * Copy one record.  Returns -EAGAIN if the writer already reused the slot
+ * and -ENODEV once the buffer was freed.
+ */
+static int amdgpu_telemetry_copy(struct amdgpu_telemetry *tm, u64 seq,
+				 struct amdgpu_telemetry_record *rec)
+{
+	struct amdgpu_telemetry_record *slot;
+	int r = 0;
+
+	mutex_lock(&tm->mutex);
+	if (!tm->records) {
+		r = -ENODEV;
+		goto out;
+	}
+
+	slot = &tm->records[(seq - 1) & AMDGPU_TELEMETRY_MASK];
+	if (slot->seq != seq)
+		r = -EAGAIN;
+	else
+		*rec = *slot;
+out:
+	mutex_unlock(&tm->mutex);
+	return r;
+}
+
+static ssize_t amdgpu_telemetry_read(struct file *f, char __user *buf,
+				     size_t size, loff_t *pos)
+{
+	struct amdgpu_device *adev = f->private_data;
+	struct amdgpu_telemetry *tm = &adev->pm.telemetry;
+	struct amdgpu_telemetry_record rec;
+	u64 next = *pos + 1, head;
+	ssize_t result = 0;
+	int r;
+
+	if (size < sizeof(rec))
+		return -EINVAL;
+
+	while (!result) {
+		while (ACCESS_ONCE(tm->seq) < next) {
+			if (!ACCESS_ONCE(tm->enabled))
+				return 0;
+			if (f->f_flags & O_NONBLOCK)
+				return -EAGAIN;
+			r = wait_event_interruptible(tm->wait,
+					ACCESS_ONCE(tm->seq) >= next ||
+					!ACCESS_ONCE(tm->enabled));
+			if (r)
+				return r;
+		}
+
+		while (size >= sizeof(rec)) {
+			head = ACCESS_ONCE(tm->seq);
+			smp_rmb();
+			if (next > head)
+				break;
+			/* skip what the writer already overwrote */
+			if (head - next >= AMDGPU_TELEMETRY_RECORDS)
+				next = head - AMDGPU_TELEMETRY_RECORDS + 1;
+			r = amdgpu_telemetry_copy(tm, next, &rec);
+			if (r == -EAGAIN) {
+				/* the slot was rewritten, the record is lost */
+				*pos = next++;
+				continue;
+			}
+			if (r)
+				return result ? result : r;
+
+			if (copy_to_user(buf, &rec, sizeof(rec)))
+				return result ? result : -EFAULT;
+
+			*pos = next++;
+			buf += sizeof(rec);
+			size -= sizeof(rec);
+			result += sizeof(rec);
+		}
+	}
+
+	return result;
+}
+
+static unsigned int amdgpu_telemetry_poll(struct file *f, poll_table *wait)
+{
+	struct amdgpu_device *adev = f->private_data;
+	struct amdgpu_telemetry *tm = &adev->pm.telemetry;
+	unsigned int mask = 0;
+
+	poll_wait(f, &tm->wait, wait);
+
+	mutex_lock(&tm->mutex);
+	if (!tm->records)
+		mask = POLLERR;
+	else if (tm->seq > f->f_pos)
+		mask = POLLIN | POLLRDNORM;
+	mutex_unlock(&tm->mutex);
+
+	return mask;
+}
+
+static int amdgpu_telemetry_mmap(struct file *f, struct vm_area_struct *vma)
+{
+	struct amdgpu_device *adev = f->private_data;
+	struct amdgpu_telemetry *tm = &adev->pm.telemetry;
+	int r;
+
+	if (vma->vm_flags & VM_WRITE)
+		return -EPERM;
+	vma->vm_flags &= ~VM_MAYWRITE;
+
+	mutex_lock(&tm->mutex);
+	if (tm->buf)
+		r = remap_vmalloc_range(vma, tm->buf, vma->vm_pgoff);
+	else
+		r = -ENODEV;
+	mutex_unlock(&tm->mutex);
+
+	return r;
+}
+
+static const struct file_operations amdgpu_telemetry_fops = {
+	.owner = THIS_MODULE,
+	.open = amdgpu_telemetry_open,
+	.read = amdgpu_telemetry_read,
+	.poll = amdgpu_telemetry_poll,
+	.mmap = amdgpu_telemetry_mmap,
+	.llseek = no_llseek,
+};
+
+static int amdgpu_telemetry_ctl_show(struct seq_file *m, void *data)
+{
+	struct amdgpu_device *adev = m->private;
+	struct amdgpu_telemetry *tm = &adev->pm.telemetry;
+	u64 samples;
+
+	mutex_lock(&tm->mutex);
+	samples = tm->seq;
+	seq_printf(m, "state: %s\n", tm->enabled ? "running" : "stopped");
+	seq_printf(m, "source: %s\n", tm->funcs->name);
+	seq_printf(m, "interval: %u ms\n", tm->interval_ms);
+	seq_printf(m, "records: %llu, errors: %llu\n", samples, tm->errors);
+	seq_printf(m, "sample time: avg %llu us, max %u us\n",
+		   samples ? div64_u64(tm->sample_ns, samples * NSEC_PER_USEC) : 0,
+		   tm->max_sample_us);
+	mutex_unlock(&tm->mutex);
+
+	return 0;
+}
+
+static int amdgpu_telemetry_ctl_open(struct inode *inode, struct file *f)
+{
+	return single_open(f, amdgpu_telemetry_ctl_show, inode->i_private);
+}
+
+/*
+ * Commands: "start [interval_ms]", "stop" and "source <name>", the source
+ * can only be switched while the sampler is stopped.
+ */
+static ssize_t amdgpu_telemetry_ctl_write(struct file *f,
+					  const char __user *buf,
+					  size_t size, loff_t *pos)
+{
+	struct amdgpu_device *adev = file_inode(f)->i_private;
+	struct amdgpu_telemetry *tm = &adev->pm.telemetry;
+	char cmd[32], arg[16];
+	unsigned interval, i;
+	int r = -EINVAL;
+
+	if (size >= sizeof(cmd))
+		return -EINVAL;
+	if (copy_from_user(cmd, buf, size))
+		return -EFAULT;
+	cmd[size] = '\0';
+
+	if (sysfs_streq(cmd, "stop")) {
+		amdgpu_telemetry_stop(adev);
+		return size;
+	}
+
+	mutex_lock(&tm->mutex);
+	if (sscanf(cmd, "start %u", &interval) == 1) {
+		r = amdgpu_telemetry_start_locked(adev, interval);
+	} else if (sysfs_streq(cmd, "start")) {
+		r = amdgpu_telemetry_start_locked(adev, tm->interval_ms);
+	} else if (sscanf(cmd, "source %15s", arg) == 1 && !tm->enabled) {
+		for (i = 0; i < ARRAY_SIZE(amdgpu_telemetry_sources); i++) {
+			if (!strcmp(arg, amdgpu_telemetry_sources[i].name)) {
+				tm->funcs = &amdgpu_telemetry_sources[i];
+				r = 0;
+				break;
+			}
+		}
+	}
+	mutex_unlock(&tm->mutex);
+
+	if (r)
+		return r;
+
+	*pos += size;
+	return size;
+}
+
+static const struct file_operations amdgpu_telemetry_ctl_fops = {
+	.owner = THIS_MODULE,
+	.open = amdgpu_telemetry_ctl_open,
+	.read = seq_read,
+	.write = amdgpu_telemetry_ctl_write,
+	.llseek = seq_lseek,
+	.release = single_release,
+};
+
+#endif
+
+int amdgpu_telemetry_debugfs_init(struct amdgpu_device *adev)
+{
+#if defined(CONFIG_DEBUG_FS)
+	struct amdgpu_telemetry *tm = &adev->pm.telemetry;
+	struct drm_minor *minor = adev->ddev->primary;
+	struct dentry *ent;
+
+	ent = debugfs_create_file("amdgpu_pm_telemetry", S_IFREG | S_IRUSR,
+				  minor->debugfs_root, adev,
+				  &amdgpu_telemetry_fops);
+	if (IS_ERR(ent))
+		return PTR_ERR(ent);
+	tm->ent[0] = ent;
+
+	ent = debugfs_create_file("amdgpu_pm_telemetry_ctl",
+				  S_IFREG | S_IRUGO | S_IWUSR,
+				  minor->debugfs_root, adev,
+				  &amdgpu_telemetry_ctl_fops);
+	if (IS_ERR(ent))
+		return PTR_ERR(ent);
+	tm->ent[1] = ent;
+#endif
+	return 0;
+}
@@ -0,0 +1,111 @@
+/*
+ * Copyright 2016 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE COPYRIGHT HOLDER(S) OR AUTHOR(S) BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#ifndef __AMDGPU_TELEMETRY_H__
+#define __AMDGPU_TELEMETRY_H__
+
+/*
+ * Power and clock telemetry.  A worker samples the sensors at a fixed rate
+ * into a ring of binary records which userspace reads or mmaps through
+ * debugfs, so monitoring does not cost an SMC query per reader.
+ */
+
+#define AMDGPU_TELEMETRY_VERSION	1
+/* must be a power of two */
+#define AMDGPU_TELEMETRY_RECORDS	4096
+
+/*
+ * Layout of the amdgpu_pm_telemetry file.  The header sits at offset 0 and
+ * the records start at records_offset.  Record n (counting from 1) lives in
+ * slot (n - 1) % nr_records; its seq is cleared while the slot is rewritten
+ * and set to n last, so a reader copies a slot and checks seq before and
+ * after the copy.  head is the seq of the newest complete record.
+ */
+struct amdgpu_telemetry_header {
+	u32	version;
+	u32	record_size;
+	u32	nr_records;
+	u32	records_offset;
+	u32	interval_ms;
+	u32	pad;
+	u64	head;
+};
+
+struct amdgpu_telemetry_record {
+	u64	seq;
+	u64	timestamp_ns;	/* CLOCK_MONOTONIC */
+	u32	sclk;		/* 10 kHz */
+	u32	mclk;		/* 10 kHz */
+	s32	temperature;	/* millidegrees Celsius */
+	u32	fan_rpm;
+	u32	power;		/* mW, 0 if not reported */
+	u8	fan_percent;
+	u8	gpu_load;	/* percent */
+	u8	mem_load;	/* percent */
+	u8	flags;
+	u32	sample_us;	/* time spent reading the sensors */
+	u32	pad;
+};
+
+/* the sensors could not be read, only seq and timestamp are valid */
+#define AMDGPU_TELEMETRY_FLAG_ERROR	(1 << 0)
+
+struct amdgpu_device;
+struct amd_pp_sensors;
+
+struct amdgpu_telemetry_funcs {
+	const char	*name;
+	int (*read)(struct amdgpu_device *adev, struct amd_pp_sensors *sensors);
+};
+
+struct amdgpu_telemetry {
+	struct mutex			mutex;
+	struct delayed_work		work;
+	wait_queue_head_t		wait;
+	bool				enabled;
+	unsigned			interval_ms;
+	const struct amdgpu_telemetry_funcs *funcs;
+
+	/* header page followed by the records, vmalloc_user'd */
+	void				*buf;
+	unsigned long			size;
+	struct amdgpu_telemetry_header	*header;
+	struct amdgpu_telemetry_record	*records;
+	u64				seq;
+
+	u64				errors;
+	u64				sample_ns;
+	u32				max_sample_us;
+
+	struct dentry			*ent[2];
+};
+
+void amdgpu_telemetry_init(struct amdgpu_device *adev);
+void amdgpu_telemetry_fini(struct amdgpu_device *adev);
+int amdgpu_telemetry_start(struct amdgpu_device *adev, unsigned interval_ms);
+void amdgpu_telemetry_stop(struct amdgpu_device *adev);
+void amdgpu_telemetry_suspend(struct amdgpu_device *adev);
+void amdgpu_telemetry_resume(struct amdgpu_device *adev);
+int amdgpu_telemetry_debugfs_init(struct amdgpu_device *adev);
+
+#endif
@@ -21,6 +21,7 @@
  *
  */
 
+#include <linux/ctype.h>
 #include <linux/firmware.h>
 #include <linux/slab.h>
 #include <linux/module.h>
@@ -315,3 +316,268 @@ int amdgpu_ucode_fini_bo(struct amdgpu_device *adev)
 
 	return 0;
 }
+
+/*
+ * Firmware cache
+ *
+ * Images are shared by every device in the system, one entry per firmware
+ * name.  An entry is validated once when it is loaded, holds a reference
+ * for each block using it and is freed with the last one.  Loads that
+ * fail are dropped from the cache so that the next request tries again.
+ *
+ * The images an asic is going to ask for are prefetched on the unbound
+ * workqueue as soon as the asic is known, so that the loads overlap with
+ * each other and with the rest of the early init.  The prefetch only
+ * looks at the filesystem; if an image needs the user mode helper it is
+ * loaded again by the request that wants it.
+ */
+struct amdgpu_ucode_entry {
+	struct list_head	list;
+	struct kref		refcount;
+	struct completion	done;
+	struct work_struct	work;
+	struct device		*dev;
+	const struct firmware	*fw;
+	int			err;
+	bool			prefetch;
+	char			name[];
+};
+
+static LIST_HEAD(amdgpu_ucode_cache);
+static DEFINE_MUTEX(amdgpu_ucode_cache_lock);
+
+static const char *amdgpu_ucode_prefetch_names[] = {
+	"pfp", "me", "ce", "rlc", "mec", "mec2", "sdma", "sdma1",
+	"mc", "smc", "smc_sk", "uvd", "vce",
+};
+
+static void amdgpu_ucode_entry_free(struct kref *ref)
+	__releases(&amdgpu_ucode_cache_lock)
+{
+	struct amdgpu_ucode_entry *entry =
+		container_of(ref, struct amdgpu_ucode_entry, refcount);
+
+	list_del(&entry->list);
+	mutex_unlock(&amdgpu_ucode_cache_lock);
+
+	release_firmware(entry->fw);
+	kfree(entry);
+}
+
+static void amdgpu_ucode_put(struct amdgpu_ucode_entry *entry)
+{
+	kref_put_mutex(&entry->refcount, amdgpu_ucode_entry_free,
+		       &amdgpu_ucode_cache_lock);
+}
+
+/* looks up @name, adding a not yet loaded entry if there is none */
+static struct amdgpu_ucode_entry *
+amdgpu_ucode_get(struct device *dev, const char *name, bool prefetch,
+		 bool *created)
+{
+	struct amdgpu_ucode_entry *entry;
+
+	*created = false;
+
+	mutex_lock(&amdgpu_ucode_cache_lock);
+	list_for_each_entry(entry, &amdgpu_ucode_cache, list) {
+		if (!strcmp(entry->name, name)) {
+			kref_get(&entry->refcount);
+			goto out;
+		}
+	}
+
+	entry = kzalloc(sizeof(*entry) + strlen(name) + 1, GFP_KERNEL);
+	if (!entry)
+		goto out;
+
+	kref_init(&entry->refcount);
+	init_completion(&entry->done);
+	entry->dev = dev;
+	entry->prefetch = prefetch;
+	strcpy(entry->name, name);
+	list_add(&entry->list, &amdgpu_ucode_cache);
+	*created = true;
+out:
+	mutex_unlock(&amdgpu_ucode_cache_lock);
+	return entry;
+}
+
+static void amdgpu_ucode_load(struct amdgpu_ucode_entry *entry)
+{
+	const struct firmware *fw = NULL;
+	int r;
+
+	if (entry->prefetch)
+		r = request_firmware_direct(&fw, entry->name, entry->dev);
+	else
+		r = request_firmware(&fw, entry->name, entry->dev);
+
+	if (!r && amdgpu_ucode_validate(fw)) {
+		DRM_ERROR("firmware \"%s\" has an invalid header\n",
+			  entry->name);
+		release_firmware(fw);
+		fw = NULL;
+		r = -EINVAL;
+	}
+
+	mutex_lock(&amdgpu_ucode_cache_lock);
+	entry->fw = fw;
+	entry->err = r;
+	if (r)
+		list_del_init(&entry->list);
+	mutex_unlock(&amdgpu_ucode_cache_lock);
+
+	complete_all(&entry->done);
+}
+
+static void amdgpu_ucode_prefetch_work(struct work_struct *work)
+{
+	amdgpu_ucode_load(container_of(work, struct amdgpu_ucode_entry, work));
+}
+
+/**
+ * amdgpu_ucode_request - get a firmware image through the cache
+ *
+ * @adev: amdgpu_device pointer
+ * @fw: where to store the image
+ * @name: firmware file name
+ *
+ * Drop-in replacement for request_firmware(), the image must be given
+ * back with amdgpu_ucode_release().  Returns 0 on success, error on
+ * failure.
+ */
+int amdgpu_ucode_request(struct amdgpu_device *adev,
+			 const struct firmware **fw, const char *name)
+{
+	struct amdgpu_ucode_entry *entry;
+	bool created, prefetch;
+	int r;
+
+	*fw = NULL;
+
+	do {
+		entry = amdgpu_ucode_get(adev->dev, name, false, &created);
+		if (!entry)
+			return -ENOMEM;
+
+		if (created)
+			amdgpu_ucode_load(entry);
+		else
+			wait_for_completion(&entry->done);
+
+		if (!entry->err) {
+			*fw = entry->fw;
+			return 0;
+		}
+
+		r = entry->err;
+		prefetch = entry->prefetch;
+		amdgpu_ucode_put(entry);
+		/* a failed prefetch is retried with the full loader */
+	} while (prefetch);
+
+	return r;
+}
+
+/**
+ * amdgpu_ucode_release - drop a reference taken by amdgpu_ucode_request
+ *
+ * @fw: firmware image, may be NULL
+ */
+void amdgpu_ucode_release(const struct firmware *fw)
+{
+	struct amdgpu_ucode_entry *entry;
+
+	if (!fw)
+		return;
+
+	mutex_lock(&amdgpu_ucode_cache_lock);
+	list_for_each_entry(entry, &amdgpu_ucode_cache, list) {
+		if (entry->fw == fw) {
+			mutex_unlock(&amdgpu_ucode_cache_lock);
+			amdgpu_ucode_put(entry);
+			return;
+		}
+	}
+	mutex_unlock(&amdgpu_ucode_cache_lock);
+
+	WARN(1, "firmware not from the amdgpu cache\n");
+	release_firmware(fw);
+}
+
+/**
+ * amdgpu_ucode_prefetch - start loading the firmware of an asic
+ *
+ * @adev: amdgpu_device pointer
+ * @chip: asic name
+ *
+ * Queues loads for every image the blocks of the asic may request.  The
+ * prefetched entries are kept until amdgpu_ucode_prefetch_fini(), images
+ * nobody asked for are freed then.
+ */
+void amdgpu_ucode_prefetch(struct amdgpu_device *adev, const char *chip)
+{
+	struct amdgpu_ucode_entry *entry;
+	const char *dir;
+	char chip_name[16], fw_name[30];
+	unsigned i, n = 0;
+	bool created;
+
+	if (adev->firmware.prefetch)
+		return;
+
+	adev->firmware.prefetch = kcalloc(ARRAY_SIZE(amdgpu_ucode_prefetch_names),
+					  sizeof(*adev->firmware.prefetch),
+					  GFP_KERNEL);
+	if (!adev->firmware.prefetch)
+		return;
+
+	for (i = 0; chip[i] && i < sizeof(chip_name) - 1; i++)
+		chip_name[i] = tolower(chip[i]);
+	chip_name[i] = '\0';
+
+	/* CIK parts still use the images shared with radeon */
+	dir = (adev->family == AMDGPU_FAMILY_CI ||
+	       adev->family == AMDGPU_FAMILY_KV) ? "radeon" : "amdgpu";
+
+	for (i = 0; i < ARRAY_SIZE(amdgpu_ucode_prefetch_names); i++) {
+		snprintf(fw_name, sizeof(fw_name), "%s/%s_%s.bin", dir,
+			 chip_name, amdgpu_ucode_prefetch_names[i]);
+
+		entry = amdgpu_ucode_get(adev->dev, fw_name, true, &created);
+		if (!entry)
+			break;
+
+		adev->firmware.prefetch[n++] = entry;
+		if (created) {
+			INIT_WORK(&entry->work, amdgpu_ucode_prefetch_work);
+			queue_work(system_unbound_wq, &entry->work);
+		}
+	}
+	adev->firmware.num_prefetch = n;
+}
+
+/**
+ * amdgpu_ucode_prefetch_fini - drop the references held by the prefetch
+ *
+ * @adev: amdgpu_device pointer
+ *
+ * Called once all blocks have requested their firmware.
+ */
+void amdgpu_ucode_prefetch_fini(struct amdgpu_device *adev)
+{
+	struct amdgpu_ucode_entry *entry;
+	unsigned i;
+
+	for (i = 0; i < adev->firmware.num_prefetch; i++) {
+		entry = adev->firmware.prefetch[i];
+		/* the load may still be running on the entry */
+		wait_for_completion(&entry->done);
+		amdgpu_ucode_put(entry);
+	}
+
+	kfree(adev->firmware.prefetch);
+	adev->firmware.prefetch = NULL;
+	adev->firmware.num_prefetch = 0;
+}
@@ -172,5 +172,10 @@ bool amdgpu_ucode_hdr_version(union amdgpu_firmware_header *hdr,
 				uint16_t hdr_major, uint16_t hdr_minor);
 int amdgpu_ucode_init_bo(struct amdgpu_device *adev);
 int amdgpu_ucode_fini_bo(struct amdgpu_device *adev);
+int amdgpu_ucode_request(struct amdgpu_device *adev,
+			 const struct firmware **fw, const char *name);
+void amdgpu_ucode_release(const struct firmware *fw);
+void amdgpu_ucode_prefetch(struct amdgpu_device *adev, const char *chip);
+void amdgpu_ucode_prefetch_fini(struct amdgpu_device *adev);
 
 #endif
@@ -128,7 +128,7 @@ int amdgpu_vce_sw_init(struct amdgpu_device *adev, unsigned long size)
 		return -EINVAL;
 	}
 
-	r = request_firmware(&adev->vce.fw, fw_name, adev->dev);
+	r = amdgpu_ucode_request(adev, &adev->vce.fw, fw_name);
 	if (r) {
 		dev_err(adev->dev, "amdgpu_vce: Can't load firmware \"%s\"\n",
 			fw_name);
@@ -139,7 +139,7 @@ int amdgpu_vce_sw_init(struct amdgpu_device *adev, unsigned long size)
 	if (r) {
 		dev_err(adev->dev, "amdgpu_vce: Can't validate firmware \"%s\"\n",
 			fw_name);
-		release_firmware(adev->vce.fw);
+		amdgpu_ucode_release(adev->vce.fw);
 		adev->vce.fw = NULL;
 		return r;
 	}
@@ -219,7 +219,7 @@ int amdgpu_vce_sw_fini(struct amdgpu_device *adev)
 	amdgpu_ring_fini(&adev->vce.ring[0]);
 	amdgpu_ring_fini(&adev->vce.ring[1]);
 
-	release_firmware(adev->vce.fw);
+	amdgpu_ucode_release(adev->vce.fw);
 
 	return 0;
 }
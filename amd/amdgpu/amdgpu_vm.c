@@ -398,6 +398,50 @@ void amdgpu_vm_reset_id(struct amdgpu_device *adev, unsigned vm_id)
 	id->oa_size = 0;
 }
 
+/**
+ * amdgpu_vm_wait_resubmit - serialize resubmitted jobs sharing a VMID
+ *
+ * @ring: ring the job is resubmitted to
+ * @vm_id: vmid of the job
+ * @fence: fence of the resubmitted job
+ *
+ * Jobs resubmitted after a GPU reset flush their VMID again with their own
+ * page directory, and the fences that kept them apart were force completed.
+ * Wait for the job resubmitted last with the same VMID on another ring, so
+ * two VMs never run on one VMID at the same time.
+ * Returns 0 on success, -ETIME if that job doesn't finish in time.
+ */
+int amdgpu_vm_wait_resubmit(struct amdgpu_ring *ring, unsigned vm_id,
+			    struct fence *fence)
+{
+	struct amdgpu_device *adev = ring->adev;
+	struct amdgpu_vm_id *id = &adev->vm_manager.ids[vm_id];
+	uint32_t reset_count = atomic_read(&adev->gpu_reset_counter);
+	struct fence *prev = NULL;
+	long r;
+
+	mutex_lock(&adev->vm_manager.lock);
+	if (id->last_resubmit && id->last_resubmit_ring != ring &&
+	    id->last_resubmit_count == reset_count)
+		prev = fence_get(id->last_resubmit);
+
+	fence_put(id->last_resubmit);
+	id->last_resubmit = fence_get(fence);
+	id->last_resubmit_ring = ring;
+	id->last_resubmit_count = reset_count;
+	mutex_unlock(&adev->vm_manager.lock);
+
+	if (!prev)
+		return 0;
+
+	r = kcl_fence_wait_timeout(prev, false, ring->sched.timeout);
+	fence_put(prev);
+	if (r < 0)
+		return r;
+
+	return r ? 0 : -ETIME;
+}
+
 /**
  * amdgpu_vm_bo_find - find the bo_va for a specific vm & bo
  *
@@ -1603,5 +1647,6 @@ void amdgpu_vm_manager_fini(struct amdgpu_device *adev)
 		fence_put(adev->vm_manager.ids[i].first);
 		amdgpu_sync_free(&adev->vm_manager.ids[i].active);
 		fence_put(id->flushed_updates);
+		fence_put(id->last_resubmit);
 	}
 }
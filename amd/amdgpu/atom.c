@@ -25,6 +25,7 @@
 #include <linux/module.h>
 #include <linux/sched.h>
 #include <linux/slab.h>
+#include <linux/vmalloc.h>
 #include <asm/unaligned.h>
 
 #define ATOM_DEBUG
@@ -52,6 +53,71 @@
 #define PLL_INDEX	2
 #define PLL_DATA	3
 
+/* dwords of workspace shared by a table and the tables it calls */
+#define ATOM_WS_POOL_SIZE	1024
+
+/* asic_init trace entries */
+#define ATOM_TRACE_REG_READ	0
+#define ATOM_TRACE_REG_WRITE	1
+#define ATOM_TRACE_IO_READ	2
+#define ATOM_TRACE_IO_WRITE	3
+#define ATOM_TRACE_PLL_READ	4
+#define ATOM_TRACE_PLL_WRITE	5
+#define ATOM_TRACE_MC_READ	6
+#define ATOM_TRACE_MC_WRITE	7
+#define ATOM_TRACE_FB_READ	8
+#define ATOM_TRACE_FB_WRITE	9
+#define ATOM_TRACE_DELAY	10
+#define ATOM_TRACE_POLL		11
+
+#define ATOM_TRACE_POLL_DELAY	0x01	/* delay before each repeated read */
+#define ATOM_TRACE_POLL_DONE	0x02	/* run ended with a different value */
+
+/* interpreter state a traced run read before setting it itself */
+#define ATOM_TRACE_USE_SHIFT	0x01
+#define ATOM_TRACE_USE_IO_ATTR	0x02
+#define ATOM_TRACE_USE_CS_EQUAL	0x04
+#define ATOM_TRACE_USE_CS_ABOVE	0x08
+
+#define ATOM_TRACE_MAX_ENTRIES	16384
+#define ATOM_TRACE_MAX_MISSES	3
+
+struct atom_trace_entry {
+	uint8_t type;
+	/* ATOM_TRACE_POLL only */
+	uint8_t poll_type;
+	uint8_t flags;
+	uint8_t delay_unit;
+	uint32_t delay_count;
+	uint32_t count;
+	uint32_t pending;
+	/* register, port, PLL/MC or scratch dword index; delay unit */
+	uint32_t addr;
+	/* value read or written; delay count */
+	uint32_t val;
+};
+
+/* global interpreter state a table can leave behind */
+struct atom_trace_state {
+	uint32_t divmul[2];
+	uint16_t data_block;
+	uint32_t fb_base;
+	uint16_t io_attr;
+	uint16_t reg_block;
+	uint8_t shift;
+	int cs_equal, cs_above;
+	int io_mode;
+};
+
+struct atom_init_trace {
+	uint32_t sclk, mclk;
+	struct atom_trace_state entry, exit;
+	unsigned uses, defs;
+	bool overflow;
+	int num_entries, max_entries;
+	struct atom_trace_entry *entries;
+};
+
 typedef struct {
 	struct atom_context *ctx;
 	uint32_t *ps, *ws;
@@ -60,6 +126,8 @@ typedef struct {
 	unsigned last_jump;
 	unsigned long last_jump_jiffies;
 	bool abort;
+	/* byte code offset a decoded table hands over at, 0 if none */
+	int resume;
 } atom_exec_context;
 
 int amdgpu_atom_debug = 0;
@@ -99,6 +167,126 @@ static void debug_print_spaces(int n)
 #define SDEBUG(...) do { } while (0)
 #endif
 
+static bool atom_trace_is_read(int type)
+{
+	switch (type) {
+	case ATOM_TRACE_REG_READ:
+	case ATOM_TRACE_IO_READ:
+	case ATOM_TRACE_PLL_READ:
+	case ATOM_TRACE_MC_READ:
+	case ATOM_TRACE_FB_READ:
+		return true;
+	}
+	return false;
+}
+
+/*
+ * Fold a read into the entry before it (and the delay in between, if any)
+ * when it repeats the same register: that is how tables poll. The entry
+ * becomes a poll that keeps reading while the first value is returned,
+ * finished by the first read returning something else.
+ */
+static bool atom_trace_fold_read(struct atom_trace_entry *prev,
+				 struct atom_trace_entry *delay,
+				 int type, uint32_t addr, uint32_t val)
+{
+	if (prev->type == type && prev->addr == addr) {
+		prev->type = ATOM_TRACE_POLL;
+		prev->poll_type = type;
+		prev->pending = prev->val;
+		prev->count = 1;
+		if (delay) {
+			prev->flags |= ATOM_TRACE_POLL_DELAY;
+			prev->delay_unit = delay->addr;
+			prev->delay_count = delay->val;
+		}
+	} else if (prev->type != ATOM_TRACE_POLL ||
+		   (prev->flags & ATOM_TRACE_POLL_DONE) ||
+		   prev->poll_type != type || prev->addr != addr) {
+		return false;
+	} else if (delay) {
+		if (!(prev->flags & ATOM_TRACE_POLL_DELAY) ||
+		    prev->delay_unit != delay->addr ||
+		    prev->delay_count != delay->val)
+			return false;
+	} else if (prev->flags & ATOM_TRACE_POLL_DELAY) {
+		return false;
+	}
+
+	if (val == prev->pending) {
+		prev->count++;
+	} else {
+		prev->flags |= ATOM_TRACE_POLL_DONE;
+		prev->val = val;
+	}
+	return true;
+}
+
+static void atom_trace_use(struct atom_context *ctx, unsigned what)
+{
+	if (ctx->init_rec)
+		ctx->init_rec->uses |= what & ~ctx->init_rec->defs;
+}
+
+static void atom_trace_def(struct atom_context *ctx, unsigned what)
+{
+	if (ctx->init_rec)
+		ctx->init_rec->defs |= what;
+}
+
+/* record a hardware or scratch access while asic_init is being traced */
+static void atom_trace_add(struct atom_context *ctx, int type, uint32_t addr,
+			   uint32_t val)
+{
+	struct atom_init_trace *trace = ctx->init_rec;
+	struct atom_trace_entry *e, *prev, *delay = NULL;
+	int n;
+
+	if (!trace || trace->overflow)
+		return;
+
+	n = trace->num_entries;
+	if (atom_trace_is_read(type) && n) {
+		prev = &trace->entries[n - 1];
+		if (prev->type == ATOM_TRACE_DELAY && n > 1) {
+			delay = prev;
+			prev = &trace->entries[n - 2];
+		}
+		if (atom_trace_fold_read(prev, delay, type, addr, val)) {
+			if (delay)
+				trace->num_entries--;
+			return;
+		}
+	}
+
+	if (n == trace->max_entries) {
+		if (n == ATOM_TRACE_MAX_ENTRIES) {
+			trace->overflow = true;
+			return;
+		}
+		/* a full trace is a few hundred KB, too much to ask kmalloc for */
+		n = n ? n * 2 : 256;
+		e = vmalloc(n * sizeof(*e));
+		if (!e) {
+			trace->overflow = true;
+			return;
+		}
+		if (trace->entries) {
+			memcpy(e, trace->entries,
+			       trace->num_entries * sizeof(*e));
+			vfree(trace->entries);
+		}
+		trace->entries = e;
+		trace->max_entries = n;
+	}
+
+	e = &trace->entries[trace->num_entries++];
+	memset(e, 0, sizeof(*e));
+	e->type = type;
+	e->addr = addr;
+	e->val = val;
+}
+
 static uint32_t atom_iio_execute(struct atom_context *ctx, int base,
 				 uint32_t index, uint32_t data)
 {
@@ -111,10 +299,14 @@ static uint32_t atom_iio_execute(struct atom_context *ctx, int base,
 			break;
 		case ATOM_IIO_READ:
 			temp = ctx->card->ioreg_read(ctx->card, CU16(base + 1));
+			atom_trace_add(ctx, ATOM_TRACE_IO_READ,
+				       CU16(base + 1), temp);
 			base += 3;
 			break;
 		case ATOM_IIO_WRITE:
 			ctx->card->ioreg_write(ctx->card, CU16(base + 1), temp);
+			atom_trace_add(ctx, ATOM_TRACE_IO_WRITE,
+				       CU16(base + 1), temp);
 			base += 3;
 			break;
 		case ATOM_IIO_CLEAR:
@@ -150,6 +342,7 @@ static uint32_t atom_iio_execute(struct atom_context *ctx, int base,
 			base += 4;
 			break;
 		case ATOM_IIO_MOVE_ATTR:
+			atom_trace_use(ctx, ATOM_TRACE_USE_IO_ATTR);
 			temp &=
 			    ~((0xFFFFFFFF >> (32 - CU8(base + 1))) <<
 			      CU8(base + 3));
@@ -171,117 +364,128 @@ static uint32_t atom_iio_execute(struct atom_context *ctx, int base,
 		}
 }
 
-static uint32_t atom_get_src_int(atom_exec_context *ctx, uint8_t attr,
-				 int *ptr, uint32_t *saved, int print)
+/*
+ * Fetch the raw value of a non-immediate operand once its index has been
+ * decoded. Returns false for the I/O modes the interpreter does not support.
+ */
+static bool atom_read_arg(atom_exec_context *ctx, int arg, uint32_t idx,
+			  uint32_t *val)
 {
-	uint32_t idx, val = 0xCDCDCDCD, align, arg;
 	struct atom_context *gctx = ctx->ctx;
-	arg = attr & 7;
-	align = (attr >> 3) & 7;
+
 	switch (arg) {
 	case ATOM_ARG_REG:
-		idx = U16(*ptr);
-		(*ptr) += 2;
-		if (print)
-			DEBUG("REG[0x%04X]", idx);
 		idx += gctx->reg_block;
 		switch (gctx->io_mode) {
 		case ATOM_IO_MM:
-			val = gctx->card->reg_read(gctx->card, idx);
+			*val = gctx->card->reg_read(gctx->card, idx);
+			atom_trace_add(gctx, ATOM_TRACE_REG_READ, idx, *val);
 			break;
 		case ATOM_IO_PCI:
 			printk(KERN_INFO
 			       "PCI registers are not implemented.\n");
-			return 0;
+			return false;
 		case ATOM_IO_SYSIO:
 			printk(KERN_INFO
 			       "SYSIO registers are not implemented.\n");
-			return 0;
+			return false;
 		default:
 			if (!(gctx->io_mode & 0x80)) {
 				printk(KERN_INFO "Bad IO mode.\n");
-				return 0;
+				return false;
 			}
 			if (!gctx->iio[gctx->io_mode & 0x7F]) {
 				printk(KERN_INFO
 				       "Undefined indirect IO read method %d.\n",
 				       gctx->io_mode & 0x7F);
-				return 0;
+				return false;
 			}
-			val =
+			*val =
 			    atom_iio_execute(gctx,
 					     gctx->iio[gctx->io_mode & 0x7F],
 					     idx, 0);
 		}
 		break;
 	case ATOM_ARG_PS:
-		idx = U8(*ptr);
-		(*ptr)++;
 		/* get_unaligned_le32 avoids unaligned accesses from atombios
 		 * tables, noticed on a DEC Alpha. */
-		val = get_unaligned_le32((u32 *)&ctx->ps[idx]);
-		if (print)
-			DEBUG("PS[0x%02X,0x%04X]", idx, val);
+		*val = get_unaligned_le32((u32 *)&ctx->ps[idx]);
 		break;
 	case ATOM_ARG_WS:
-		idx = U8(*ptr);
-		(*ptr)++;
-		if (print)
-			DEBUG("WS[0x%02X]", idx);
 		switch (idx) {
 		case ATOM_WS_QUOTIENT:
-			val = gctx->divmul[0];
+			*val = gctx->divmul[0];
 			break;
 		case ATOM_WS_REMAINDER:
-			val = gctx->divmul[1];
+			*val = gctx->divmul[1];
 			break;
 		case ATOM_WS_DATAPTR:
-			val = gctx->data_block;
+			*val = gctx->data_block;
 			break;
 		case ATOM_WS_SHIFT:
-			val = gctx->shift;
+			atom_trace_use(gctx, ATOM_TRACE_USE_SHIFT);
+			*val = gctx->shift;
 			break;
 		case ATOM_WS_OR_MASK:
-			val = 1 << gctx->shift;
+			atom_trace_use(gctx, ATOM_TRACE_USE_SHIFT);
+			*val = 1 << gctx->shift;
 			break;
 		case ATOM_WS_AND_MASK:
-			val = ~(1 << gctx->shift);
+			atom_trace_use(gctx, ATOM_TRACE_USE_SHIFT);
+			*val = ~(1 << gctx->shift);
 			break;
 		case ATOM_WS_FB_WINDOW:
-			val = gctx->fb_base;
+			*val = gctx->fb_base;
 			break;
 		case ATOM_WS_ATTRIBUTES:
-			val = gctx->io_attr;
+			atom_trace_use(gctx, ATOM_TRACE_USE_IO_ATTR);
+			*val = gctx->io_attr;
 			break;
 		case ATOM_WS_REGPTR:
-			val = gctx->reg_block;
+			*val = gctx->reg_block;
 			break;
 		default:
-			val = ctx->ws[idx];
+			*val = ctx->ws[idx];
 		}
 		break;
 	case ATOM_ARG_ID:
-		idx = U16(*ptr);
-		(*ptr) += 2;
-		if (print) {
-			if (gctx->data_block)
-				DEBUG("ID[0x%04X+%04X]", idx, gctx->data_block);
-			else
-				DEBUG("ID[0x%04X]", idx);
-		}
-		val = U32(idx + gctx->data_block);
+		*val = U32(idx + gctx->data_block);
 		break;
 	case ATOM_ARG_FB:
-		idx = U8(*ptr);
-		(*ptr)++;
 		if ((gctx->fb_base + (idx * 4)) > gctx->scratch_size_bytes) {
 			DRM_ERROR("ATOM: fb read beyond scratch region: %d vs. %d\n",
 				  gctx->fb_base + (idx * 4), gctx->scratch_size_bytes);
-			val = 0;
-		} else
-			val = gctx->scratch[(gctx->fb_base / 4) + idx];
-		if (print)
-			DEBUG("FB[0x%02X]", idx);
+			*val = 0;
+		} else {
+			idx += gctx->fb_base / 4;
+			*val = gctx->scratch[idx];
+			atom_trace_add(gctx, ATOM_TRACE_FB_READ, idx, *val);
+		}
+		break;
+	case ATOM_ARG_PLL:
+		*val = gctx->card->pll_read(gctx->card, idx);
+		atom_trace_add(gctx, ATOM_TRACE_PLL_READ, idx, *val);
+		break;
+	case ATOM_ARG_MC:
+		*val = gctx->card->mc_read(gctx->card, idx);
+		atom_trace_add(gctx, ATOM_TRACE_MC_READ, idx, *val);
+		break;
+	}
+	return true;
+}
+
+static uint32_t atom_get_src_int(atom_exec_context *ctx, uint8_t attr,
+				 int *ptr, uint32_t *saved, int print)
+{
+	uint32_t idx, val = 0xCDCDCDCD, align, arg;
+	struct atom_context *gctx = ctx->ctx;
+	arg = attr & 7;
+	align = (attr >> 3) & 7;
+	switch (arg) {
+	case ATOM_ARG_REG:
+	case ATOM_ARG_ID:
+		idx = U16(*ptr);
+		(*ptr) += 2;
 		break;
 	case ATOM_ARG_IMM:
 		switch (align) {
@@ -310,21 +514,39 @@ static uint32_t atom_get_src_int(atom_exec_context *ctx, uint8_t attr,
 			return val;
 		}
 		return 0;
-	case ATOM_ARG_PLL:
-		idx = U8(*ptr);
-		(*ptr)++;
-		if (print)
-			DEBUG("PLL[0x%02X]", idx);
-		val = gctx->card->pll_read(gctx->card, idx);
-		break;
-	case ATOM_ARG_MC:
+	default:
 		idx = U8(*ptr);
 		(*ptr)++;
-		if (print)
-			DEBUG("MC[0x%02X]", idx);
-		val = gctx->card->mc_read(gctx->card, idx);
 		break;
 	}
+	if (print)
+		switch (arg) {
+		case ATOM_ARG_REG:
+			DEBUG("REG[0x%04X]", idx);
+			break;
+		case ATOM_ARG_WS:
+			DEBUG("WS[0x%02X]", idx);
+			break;
+		case ATOM_ARG_ID:
+			if (gctx->data_block)
+				DEBUG("ID[0x%04X+%04X]", idx, gctx->data_block);
+			else
+				DEBUG("ID[0x%04X]", idx);
+			break;
+		case ATOM_ARG_FB:
+			DEBUG("FB[0x%02X]", idx);
+			break;
+		case ATOM_ARG_PLL:
+			DEBUG("PLL[0x%02X]", idx);
+			break;
+		case ATOM_ARG_MC:
+			DEBUG("MC[0x%02X]", idx);
+			break;
+		}
+	if (!atom_read_arg(ctx, arg, idx, &val))
+		return 0;
+	if (print && arg == ATOM_ARG_PS)
+		DEBUG("PS[0x%02X,0x%04X]", idx, val);
 	if (saved)
 		*saved = val;
 	val &= atom_arg_mask[align];
@@ -442,65 +664,52 @@ static void atom_skip_dst(atom_exec_context *ctx, int arg, uint8_t attr, int *pt
 								 3] << 3, ptr);
 }
 
-static void atom_put_dst(atom_exec_context *ctx, int arg, uint8_t attr,
-			 int *ptr, uint32_t val, uint32_t saved)
+/*
+ * Store an already merged value to a decoded operand. Returns false for the
+ * I/O modes the interpreter does not support.
+ */
+static bool atom_write_arg(atom_exec_context *ctx, int arg, uint32_t idx,
+			   uint32_t val)
 {
-	uint32_t align =
-	    atom_dst_to_src[(attr >> 3) & 7][(attr >> 6) & 3], old_val =
-	    val, idx;
 	struct atom_context *gctx = ctx->ctx;
-	old_val &= atom_arg_mask[align] >> atom_arg_shift[align];
-	val <<= atom_arg_shift[align];
-	val &= atom_arg_mask[align];
-	saved &= ~atom_arg_mask[align];
-	val |= saved;
+
 	switch (arg) {
 	case ATOM_ARG_REG:
-		idx = U16(*ptr);
-		(*ptr) += 2;
-		DEBUG("REG[0x%04X]", idx);
 		idx += gctx->reg_block;
 		switch (gctx->io_mode) {
 		case ATOM_IO_MM:
 			if (idx == 0)
-				gctx->card->reg_write(gctx->card, idx,
-						      val << 2);
-			else
-				gctx->card->reg_write(gctx->card, idx, val);
+				val <<= 2;
+			gctx->card->reg_write(gctx->card, idx, val);
+			atom_trace_add(gctx, ATOM_TRACE_REG_WRITE, idx, val);
 			break;
 		case ATOM_IO_PCI:
 			printk(KERN_INFO
 			       "PCI registers are not implemented.\n");
-			return;
+			return false;
 		case ATOM_IO_SYSIO:
 			printk(KERN_INFO
 			       "SYSIO registers are not implemented.\n");
-			return;
+			return false;
 		default:
 			if (!(gctx->io_mode & 0x80)) {
 				printk(KERN_INFO "Bad IO mode.\n");
-				return;
+				return false;
 			}
 			if (!gctx->iio[gctx->io_mode & 0xFF]) {
 				printk(KERN_INFO
 				       "Undefined indirect IO write method %d.\n",
 				       gctx->io_mode & 0x7F);
-				return;
+				return false;
 			}
 			atom_iio_execute(gctx, gctx->iio[gctx->io_mode & 0xFF],
 					 idx, val);
 		}
 		break;
 	case ATOM_ARG_PS:
-		idx = U8(*ptr);
-		(*ptr)++;
-		DEBUG("PS[0x%02X]", idx);
 		ctx->ps[idx] = cpu_to_le32(val);
 		break;
 	case ATOM_ARG_WS:
-		idx = U8(*ptr);
-		(*ptr)++;
-		DEBUG("WS[0x%02X]", idx);
 		switch (idx) {
 		case ATOM_WS_QUOTIENT:
 			gctx->divmul[0] = val;
@@ -512,6 +721,7 @@ static void atom_put_dst(atom_exec_context *ctx, int arg, uint8_t attr,
 			gctx->data_block = val;
 			break;
 		case ATOM_WS_SHIFT:
+			atom_trace_def(gctx, ATOM_TRACE_USE_SHIFT);
 			gctx->shift = val;
 			break;
 		case ATOM_WS_OR_MASK:
@@ -521,6 +731,7 @@ static void atom_put_dst(atom_exec_context *ctx, int arg, uint8_t attr,
 			gctx->fb_base = val;
 			break;
 		case ATOM_WS_ATTRIBUTES:
+			atom_trace_def(gctx, ATOM_TRACE_USE_IO_ATTR);
 			gctx->io_attr = val;
 			break;
 		case ATOM_WS_REGPTR:
@@ -531,28 +742,67 @@ static void atom_put_dst(atom_exec_context *ctx, int arg, uint8_t attr,
 		}
 		break;
 	case ATOM_ARG_FB:
-		idx = U8(*ptr);
-		(*ptr)++;
 		if ((gctx->fb_base + (idx * 4)) > gctx->scratch_size_bytes) {
 			DRM_ERROR("ATOM: fb write beyond scratch region: %d vs. %d\n",
 				  gctx->fb_base + (idx * 4), gctx->scratch_size_bytes);
-		} else
-			gctx->scratch[(gctx->fb_base / 4) + idx] = val;
-		DEBUG("FB[0x%02X]", idx);
+		} else {
+			idx += gctx->fb_base / 4;
+			gctx->scratch[idx] = val;
+			atom_trace_add(gctx, ATOM_TRACE_FB_WRITE, idx, val);
+		}
 		break;
 	case ATOM_ARG_PLL:
-		idx = U8(*ptr);
-		(*ptr)++;
-		DEBUG("PLL[0x%02X]", idx);
 		gctx->card->pll_write(gctx->card, idx, val);
+		atom_trace_add(gctx, ATOM_TRACE_PLL_WRITE, idx, val);
 		break;
 	case ATOM_ARG_MC:
+		gctx->card->mc_write(gctx->card, idx, val);
+		atom_trace_add(gctx, ATOM_TRACE_MC_WRITE, idx, val);
+		break;
+	}
+	return true;
+}
+
+static void atom_put_dst(atom_exec_context *ctx, int arg, uint8_t attr,
+			 int *ptr, uint32_t val, uint32_t saved)
+{
+	uint32_t align =
+	    atom_dst_to_src[(attr >> 3) & 7][(attr >> 6) & 3], old_val =
+	    val, idx;
+	old_val &= atom_arg_mask[align] >> atom_arg_shift[align];
+	val <<= atom_arg_shift[align];
+	val &= atom_arg_mask[align];
+	saved &= ~atom_arg_mask[align];
+	val |= saved;
+	if (arg == ATOM_ARG_REG) {
+		idx = U16(*ptr);
+		(*ptr) += 2;
+	} else {
 		idx = U8(*ptr);
 		(*ptr)++;
+	}
+	switch (arg) {
+	case ATOM_ARG_REG:
+		DEBUG("REG[0x%04X]", idx);
+		break;
+	case ATOM_ARG_PS:
+		DEBUG("PS[0x%02X]", idx);
+		break;
+	case ATOM_ARG_WS:
+		DEBUG("WS[0x%02X]", idx);
+		break;
+	case ATOM_ARG_FB:
+		DEBUG("FB[0x%02X]", idx);
+		break;
+	case ATOM_ARG_PLL:
+		DEBUG("PLL[0x%02X]", idx);
+		break;
+	case ATOM_ARG_MC:
 		DEBUG("MC[0x%02X]", idx);
-		gctx->card->mc_write(gctx->card, idx, val);
-		return;
+		break;
 	}
+	if (!atom_write_arg(ctx, arg, idx, val))
+		return;
 	switch (align) {
 	case ATOM_SRC_DWORD:
 		DEBUG(".[31:0] <- 0x%08X\n", old_val);
@@ -614,15 +864,10 @@ static void atom_op_beep(atom_exec_context *ctx, int *ptr, int arg)
 	printk("ATOM BIOS beeped!\n");
 }
 
-static void atom_op_calltable(atom_exec_context *ctx, int *ptr, int arg)
+static void atom_call_table(atom_exec_context *ctx, int idx)
 {
-	int idx = U8((*ptr)++);
 	int r = 0;
 
-	if (idx < ATOM_TABLE_NAMES_CNT)
-		SDEBUG("   table: %d (%s)\n", idx, atom_table_names[idx]);
-	else
-		SDEBUG("   table: %d\n", idx);
 	if (U16(ctx->ctx->cmd_table + 4 + 2 * idx))
 		r = amdgpu_atom_execute_table_locked(ctx->ctx, idx, ctx->ps + ctx->ps_shift);
 	if (r) {
@@ -630,6 +875,17 @@ static void atom_op_calltable(atom_exec_context *ctx, int *ptr, int arg)
 	}
 }
 
+static void atom_op_calltable(atom_exec_context *ctx, int *ptr, int arg)
+{
+	int idx = U8((*ptr)++);
+
+	if (idx < ATOM_TABLE_NAMES_CNT)
+		SDEBUG("   table: %d (%s)\n", idx, atom_table_names[idx]);
+	else
+		SDEBUG("   table: %d\n", idx);
+	atom_call_table(ctx, idx);
+}
+
 static void atom_op_clear(atom_exec_context *ctx, int *ptr, int arg)
 {
 	uint8_t attr = U8((*ptr)++);
@@ -650,17 +906,18 @@ static void atom_op_compare(atom_exec_context *ctx, int *ptr, int arg)
 	dst = atom_get_dst(ctx, arg, attr, ptr, NULL, 1);
 	SDEBUG("   src2: ");
 	src = atom_get_src(ctx, attr, ptr);
+	atom_trace_def(ctx->ctx,
+		       ATOM_TRACE_USE_CS_EQUAL | ATOM_TRACE_USE_CS_ABOVE);
 	ctx->ctx->cs_equal = (dst == src);
 	ctx->ctx->cs_above = (dst > src);
 	SDEBUG("   result: %s %s\n", ctx->ctx->cs_equal ? "EQ" : "NE",
 	       ctx->ctx->cs_above ? "GT" : "LE");
 }
 
-static void atom_op_delay(atom_exec_context *ctx, int *ptr, int arg)
+static void atom_delay(struct atom_context *gctx, unsigned count, int unit)
 {
-	unsigned count = U8((*ptr)++);
-	SDEBUG("   count: %d\n", count);
-	if (arg == ATOM_UNIT_MICROSEC)
+	atom_trace_add(gctx, ATOM_TRACE_DELAY, unit, count);
+	if (unit == ATOM_UNIT_MICROSEC)
 		udelay(count);
 	else if (!drm_can_sleep())
 		mdelay(count);
@@ -668,6 +925,40 @@ static void atom_op_delay(atom_exec_context *ctx, int *ptr, int arg)
 		msleep(count);
 }
 
+static void atom_op_delay(atom_exec_context *ctx, int *ptr, int arg)
+{
+	unsigned count = U8((*ptr)++);
+	SDEBUG("   count: %d\n", count);
+	atom_delay(ctx->ctx, count, arg);
+}
+
+static void atom_div(struct atom_context *gctx, uint32_t dst, uint32_t src)
+{
+	if (src != 0) {
+		gctx->divmul[0] = dst / src;
+		gctx->divmul[1] = dst % src;
+	} else {
+		gctx->divmul[0] = 0;
+		gctx->divmul[1] = 0;
+	}
+}
+
+static void atom_div32(struct atom_context *gctx, uint32_t dst, uint32_t src)
+{
+	uint64_t val64;
+
+	if (src != 0) {
+		val64 = dst;
+		val64 |= ((uint64_t)gctx->divmul[1]) << 32;
+		do_div(val64, src);
+		gctx->divmul[0] = lower_32_bits(val64);
+		gctx->divmul[1] = upper_32_bits(val64);
+	} else {
+		gctx->divmul[0] = 0;
+		gctx->divmul[1] = 0;
+	}
+}
+
 static void atom_op_div(atom_exec_context *ctx, int *ptr, int arg)
 {
 	uint8_t attr = U8((*ptr)++);
@@ -676,34 +967,18 @@ static void atom_op_div(atom_exec_context *ctx, int *ptr, int arg)
 	dst = atom_get_dst(ctx, arg, attr, ptr, NULL, 1);
 	SDEBUG("   src2: ");
 	src = atom_get_src(ctx, attr, ptr);
-	if (src != 0) {
-		ctx->ctx->divmul[0] = dst / src;
-		ctx->ctx->divmul[1] = dst % src;
-	} else {
-		ctx->ctx->divmul[0] = 0;
-		ctx->ctx->divmul[1] = 0;
-	}
+	atom_div(ctx->ctx, dst, src);
 }
 
 static void atom_op_div32(atom_exec_context *ctx, int *ptr, int arg)
 {
-	uint64_t val64;
 	uint8_t attr = U8((*ptr)++);
 	uint32_t dst, src;
 	SDEBUG("   src1: ");
 	dst = atom_get_dst(ctx, arg, attr, ptr, NULL, 1);
 	SDEBUG("   src2: ");
 	src = atom_get_src(ctx, attr, ptr);
-	if (src != 0) {
-		val64 = dst;
-		val64 |= ((uint64_t)ctx->ctx->divmul[1]) << 32;
-		do_div(val64, src);
-		ctx->ctx->divmul[0] = lower_32_bits(val64);
-		ctx->ctx->divmul[1] = upper_32_bits(val64);
-	} else {
-		ctx->ctx->divmul[0] = 0;
-		ctx->ctx->divmul[1] = 0;
-	}
+	atom_div32(ctx->ctx, dst, src);
 }
 
 static void atom_op_eot(atom_exec_context *ctx, int *ptr, int arg)
@@ -711,55 +986,69 @@ static void atom_op_eot(atom_exec_context *ctx, int *ptr, int arg)
 	/* functionally, a nop */
 }
 
-static void atom_op_jump(atom_exec_context *ctx, int *ptr, int arg)
+static int atom_jump_taken(atom_exec_context *ctx, int arg)
 {
-	int execute = 0, target = U16(*ptr);
-	unsigned long cjiffies;
-
-	(*ptr) += 2;
 	switch (arg) {
 	case ATOM_COND_ABOVE:
-		execute = ctx->ctx->cs_above;
-		break;
+		atom_trace_use(ctx->ctx, ATOM_TRACE_USE_CS_ABOVE);
+		return ctx->ctx->cs_above;
 	case ATOM_COND_ABOVEOREQUAL:
-		execute = ctx->ctx->cs_above || ctx->ctx->cs_equal;
-		break;
+		atom_trace_use(ctx->ctx, ATOM_TRACE_USE_CS_EQUAL |
+					 ATOM_TRACE_USE_CS_ABOVE);
+		return ctx->ctx->cs_above || ctx->ctx->cs_equal;
 	case ATOM_COND_ALWAYS:
-		execute = 1;
-		break;
+		return 1;
 	case ATOM_COND_BELOW:
-		execute = !(ctx->ctx->cs_above || ctx->ctx->cs_equal);
-		break;
+		atom_trace_use(ctx->ctx, ATOM_TRACE_USE_CS_EQUAL |
+					 ATOM_TRACE_USE_CS_ABOVE);
+		return !(ctx->ctx->cs_above || ctx->ctx->cs_equal);
 	case ATOM_COND_BELOWOREQUAL:
-		execute = !ctx->ctx->cs_above;
-		break;
+		atom_trace_use(ctx->ctx, ATOM_TRACE_USE_CS_ABOVE);
+		return !ctx->ctx->cs_above;
 	case ATOM_COND_EQUAL:
-		execute = ctx->ctx->cs_equal;
-		break;
+		atom_trace_use(ctx->ctx, ATOM_TRACE_USE_CS_EQUAL);
+		return ctx->ctx->cs_equal;
 	case ATOM_COND_NOTEQUAL:
-		execute = !ctx->ctx->cs_equal;
-		break;
+		atom_trace_use(ctx->ctx, ATOM_TRACE_USE_CS_EQUAL);
+		return !ctx->ctx->cs_equal;
 	}
-	if (arg != ATOM_COND_ALWAYS)
-		SDEBUG("   taken: %s\n", execute ? "yes" : "no");
-	SDEBUG("   target: 0x%04X\n", target);
-	if (execute) {
-		if (ctx->last_jump == (ctx->start + target)) {
-			cjiffies = jiffies;
-			if (time_after(cjiffies, ctx->last_jump_jiffies)) {
-				cjiffies -= ctx->last_jump_jiffies;
-				if ((jiffies_to_msecs(cjiffies) > 5000)) {
-					DRM_ERROR("atombios stuck in loop for more than 5secs aborting\n");
-					ctx->abort = true;
-				}
-			} else {
-				/* jiffies wrap around we will just wait a little longer */
-				ctx->last_jump_jiffies = jiffies;
+	return 0;
+}
+
+/* abort tables that keep jumping to the same target for more than 5s */
+static void atom_jump_check_loop(atom_exec_context *ctx, int target)
+{
+	unsigned long cjiffies;
+
+	if (ctx->last_jump == (ctx->start + target)) {
+		cjiffies = jiffies;
+		if (time_after(cjiffies, ctx->last_jump_jiffies)) {
+			cjiffies -= ctx->last_jump_jiffies;
+			if ((jiffies_to_msecs(cjiffies) > 5000)) {
+				DRM_ERROR("atombios stuck in loop for more than 5secs aborting\n");
+				ctx->abort = true;
 			}
 		} else {
-			ctx->last_jump = ctx->start + target;
+			/* jiffies wrap around we will just wait a little longer */
 			ctx->last_jump_jiffies = jiffies;
 		}
+	} else {
+		ctx->last_jump = ctx->start + target;
+		ctx->last_jump_jiffies = jiffies;
+	}
+}
+
+static void atom_op_jump(atom_exec_context *ctx, int *ptr, int arg)
+{
+	int execute, target = U16(*ptr);
+
+	(*ptr) += 2;
+	execute = atom_jump_taken(ctx, arg);
+	if (arg != ATOM_COND_ALWAYS)
+		SDEBUG("   taken: %s\n", execute ? "yes" : "no");
+	SDEBUG("   target: 0x%04X\n", target);
+	if (execute) {
+		atom_jump_check_loop(ctx, target);
 		*ptr = ctx->start + target;
 	}
 }
@@ -809,18 +1098,23 @@ static void atom_op_mul(atom_exec_context *ctx, int *ptr, int arg)
 	ctx->ctx->divmul[0] = dst * src;
 }
 
+static void atom_mul32(struct atom_context *gctx, uint32_t dst, uint32_t src)
+{
+	uint64_t val64 = (uint64_t)dst * (uint64_t)src;
+
+	gctx->divmul[0] = lower_32_bits(val64);
+	gctx->divmul[1] = upper_32_bits(val64);
+}
+
 static void atom_op_mul32(atom_exec_context *ctx, int *ptr, int arg)
 {
-	uint64_t val64;
 	uint8_t attr = U8((*ptr)++);
 	uint32_t dst, src;
 	SDEBUG("   src1: ");
 	dst = atom_get_dst(ctx, arg, attr, ptr, NULL, 1);
 	SDEBUG("   src2: ");
 	src = atom_get_src(ctx, attr, ptr);
-	val64 = (uint64_t)dst * (uint64_t)src;
-	ctx->ctx->divmul[0] = lower_32_bits(val64);
-	ctx->ctx->divmul[1] = upper_32_bits(val64);
+	atom_mul32(ctx->ctx, dst, src);
 }
 
 static void atom_op_nop(atom_exec_context *ctx, int *ptr, int arg)
@@ -1037,6 +1331,7 @@ static void atom_op_test(atom_exec_context *ctx, int *ptr, int arg)
 	dst = atom_get_dst(ctx, arg, attr, ptr, NULL, 1);
 	SDEBUG("   src2: ");
 	src = atom_get_src(ctx, attr, ptr);
+	atom_trace_def(ctx->ctx, ATOM_TRACE_USE_CS_EQUAL);
 	ctx->ctx->cs_equal = ((dst & src) == 0);
 	SDEBUG("   result: %s\n", ctx->ctx->cs_equal ? "EQ" : "NE");
 }
@@ -1202,12 +1497,755 @@ static struct {
 	atom_op_div32, ATOM_ARG_WS},
 };
 
+/*
+ * Pre-decoded command tables
+ *
+ * The first time a command table runs it is decoded into an array of
+ * atom_insn with the attribute bytes, operand indices and immediates already
+ * resolved and jump and case targets turned into instruction pointers. Later
+ * runs dispatch through insn->func and only touch the BIOS image for ID
+ * operands. Whatever the decoder does not handle (jumps into the middle of an
+ * instruction, malformed switches, running off the end of the table) becomes
+ * an atom_dop_bytecode stub which continues in the byte code loop at that
+ * offset, so both paths execute exactly the same register accesses.
+ */
+
+struct atom_operand {
+	uint8_t arg;
+	uint8_t align;
+	/* index, ID offset or immediate value */
+	uint32_t val;
+};
+
+struct atom_insn;
+
+struct atom_case {
+	uint32_t val;
+	uint16_t offset;
+	const struct atom_insn *target;
+};
+
+struct atom_insn {
+	const struct atom_insn *(*func)(atom_exec_context *ctx,
+					const struct atom_insn *insn);
+	/* of the opcode, relative to the table start */
+	uint16_t offset;
+	uint16_t count;
+	int arg;
+	struct atom_operand dst, src;
+	uint32_t imm;
+	const struct atom_insn *target;
+	struct atom_case *cases;
+};
+
+struct atom_decoded_table {
+	int num_insns;
+	struct atom_insn *insns;
+	struct atom_case *cases;
+};
+
+static uint32_t atom_get_operand(atom_exec_context *ctx,
+				 const struct atom_operand *op, uint32_t *saved)
+{
+	uint32_t val = 0xCDCDCDCD;
+
+	if (op->arg == ATOM_ARG_IMM)
+		return op->val;
+	if (!atom_read_arg(ctx, op->arg, op->val, &val))
+		return 0;
+	if (saved)
+		*saved = val;
+	val &= atom_arg_mask[op->align];
+	val >>= atom_arg_shift[op->align];
+	return val;
+}
+
+static void atom_put_operand(atom_exec_context *ctx,
+			     const struct atom_operand *op, uint32_t val,
+			     uint32_t saved)
+{
+	val <<= atom_arg_shift[op->align];
+	val &= atom_arg_mask[op->align];
+	saved &= ~atom_arg_mask[op->align];
+	val |= saved;
+	atom_write_arg(ctx, op->arg, op->val, val);
+}
+
+static const struct atom_insn *atom_dop_add(atom_exec_context *ctx,
+					    const struct atom_insn *insn)
+{
+	uint32_t dst, saved;
+
+	dst = atom_get_operand(ctx, &insn->dst, &saved);
+	dst += atom_get_operand(ctx, &insn->src, NULL);
+	atom_put_operand(ctx, &insn->dst, dst, saved);
+	return insn + 1;
+}
+
+static const struct atom_insn *atom_dop_and(atom_exec_context *ctx,
+					    const struct atom_insn *insn)
+{
+	uint32_t dst, saved;
+
+	dst = atom_get_operand(ctx, &insn->dst, &saved);
+	dst &= atom_get_operand(ctx, &insn->src, NULL);
+	atom_put_operand(ctx, &insn->dst, dst, saved);
+	return insn + 1;
+}
+
+static const struct atom_insn *atom_dop_or(atom_exec_context *ctx,
+					   const struct atom_insn *insn)
+{
+	uint32_t dst, saved;
+
+	dst = atom_get_operand(ctx, &insn->dst, &saved);
+	dst |= atom_get_operand(ctx, &insn->src, NULL);
+	atom_put_operand(ctx, &insn->dst, dst, saved);
+	return insn + 1;
+}
+
+static const struct atom_insn *atom_dop_sub(atom_exec_context *ctx,
+					    const struct atom_insn *insn)
+{
+	uint32_t dst, saved;
+
+	dst = atom_get_operand(ctx, &insn->dst, &saved);
+	dst -= atom_get_operand(ctx, &insn->src, NULL);
+	atom_put_operand(ctx, &insn->dst, dst, saved);
+	return insn + 1;
+}
+
+static const struct atom_insn *atom_dop_xor(atom_exec_context *ctx,
+					    const struct atom_insn *insn)
+{
+	uint32_t dst, saved;
+
+	dst = atom_get_operand(ctx, &insn->dst, &saved);
+	dst ^= atom_get_operand(ctx, &insn->src, NULL);
+	atom_put_operand(ctx, &insn->dst, dst, saved);
+	return insn + 1;
+}
+
+static const struct atom_insn *atom_dop_mask(atom_exec_context *ctx,
+					     const struct atom_insn *insn)
+{
+	uint32_t dst, saved;
+
+	dst = atom_get_operand(ctx, &insn->dst, &saved);
+	dst &= insn->imm;
+	dst |= atom_get_operand(ctx, &insn->src, NULL);
+	atom_put_operand(ctx, &insn->dst, dst, saved);
+	return insn + 1;
+}
+
+static const struct atom_insn *atom_dop_move(atom_exec_context *ctx,
+					     const struct atom_insn *insn)
+{
+	uint32_t saved = 0xCDCDCDCD;
+
+	if (insn->src.align != ATOM_SRC_DWORD)
+		atom_get_operand(ctx, &insn->dst, &saved);
+	atom_put_operand(ctx, &insn->dst,
+			 atom_get_operand(ctx, &insn->src, NULL), saved);
+	return insn + 1;
+}
+
+static const struct atom_insn *atom_dop_clear(atom_exec_context *ctx,
+					      const struct atom_insn *insn)
+{
+	uint32_t saved;
+
+	atom_get_operand(ctx, &insn->dst, &saved);
+	atom_put_operand(ctx, &insn->dst, 0, saved);
+	return insn + 1;
+}
+
+static const struct atom_insn *atom_dop_shift_left(atom_exec_context *ctx,
+						   const struct atom_insn *insn)
+{
+	uint32_t dst, saved;
+
+	dst = atom_get_operand(ctx, &insn->dst, &saved);
+	dst <<= insn->imm;
+	atom_put_operand(ctx, &insn->dst, dst, saved);
+	return insn + 1;
+}
+
+static const struct atom_insn *atom_dop_shift_right(atom_exec_context *ctx,
+						    const struct atom_insn *insn)
+{
+	uint32_t dst, saved;
+
+	dst = atom_get_operand(ctx, &insn->dst, &saved);
+	dst >>= insn->imm;
+	atom_put_operand(ctx, &insn->dst, dst, saved);
+	return insn + 1;
+}
+
+static const struct atom_insn *atom_dop_shl(atom_exec_context *ctx,
+					    const struct atom_insn *insn)
+{
+	uint32_t dst, saved;
+	uint8_t shift;
+
+	atom_get_operand(ctx, &insn->dst, &saved);
+	/* op needs to full dst value */
+	dst = saved;
+	shift = atom_get_operand(ctx, &insn->src, NULL);
+	dst <<= shift;
+	dst &= atom_arg_mask[insn->dst.align];
+	dst >>= atom_arg_shift[insn->dst.align];
+	atom_put_operand(ctx, &insn->dst, dst, saved);
+	return insn + 1;
+}
+
+static const struct atom_insn *atom_dop_shr(atom_exec_context *ctx,
+					    const struct atom_insn *insn)
+{
+	uint32_t dst, saved;
+	uint8_t shift;
+
+	atom_get_operand(ctx, &insn->dst, &saved);
+	/* op needs to full dst value */
+	dst = saved;
+	shift = atom_get_operand(ctx, &insn->src, NULL);
+	dst >>= shift;
+	dst &= atom_arg_mask[insn->dst.align];
+	dst >>= atom_arg_shift[insn->dst.align];
+	atom_put_operand(ctx, &insn->dst, dst, saved);
+	return insn + 1;
+}
+
+static const struct atom_insn *atom_dop_compare(atom_exec_context *ctx,
+						const struct atom_insn *insn)
+{
+	uint32_t dst, src;
+
+	dst = atom_get_operand(ctx, &insn->dst, NULL);
+	src = atom_get_operand(ctx, &insn->src, NULL);
+	atom_trace_def(ctx->ctx,
+		       ATOM_TRACE_USE_CS_EQUAL | ATOM_TRACE_USE_CS_ABOVE);
+	ctx->ctx->cs_equal = (dst == src);
+	ctx->ctx->cs_above = (dst > src);
+	return insn + 1;
+}
+
+static const struct atom_insn *atom_dop_test(atom_exec_context *ctx,
+					     const struct atom_insn *insn)
+{
+	uint32_t dst, src;
+
+	dst = atom_get_operand(ctx, &insn->dst, NULL);
+	src = atom_get_operand(ctx, &insn->src, NULL);
+	atom_trace_def(ctx->ctx, ATOM_TRACE_USE_CS_EQUAL);
+	ctx->ctx->cs_equal = ((dst & src) == 0);
+	return insn + 1;
+}
+
+static const struct atom_insn *atom_dop_mul(atom_exec_context *ctx,
+					    const struct atom_insn *insn)
+{
+	uint32_t dst, src;
+
+	dst = atom_get_operand(ctx, &insn->dst, NULL);
+	src = atom_get_operand(ctx, &insn->src, NULL);
+	ctx->ctx->divmul[0] = dst * src;
+	return insn + 1;
+}
+
+static const struct atom_insn *atom_dop_mul32(atom_exec_context *ctx,
+					      const struct atom_insn *insn)
+{
+	uint32_t dst, src;
+
+	dst = atom_get_operand(ctx, &insn->dst, NULL);
+	src = atom_get_operand(ctx, &insn->src, NULL);
+	atom_mul32(ctx->ctx, dst, src);
+	return insn + 1;
+}
+
+static const struct atom_insn *atom_dop_div(atom_exec_context *ctx,
+					    const struct atom_insn *insn)
+{
+	uint32_t dst, src;
+
+	dst = atom_get_operand(ctx, &insn->dst, NULL);
+	src = atom_get_operand(ctx, &insn->src, NULL);
+	atom_div(ctx->ctx, dst, src);
+	return insn + 1;
+}
+
+static const struct atom_insn *atom_dop_div32(atom_exec_context *ctx,
+					      const struct atom_insn *insn)
+{
+	uint32_t dst, src;
+
+	dst = atom_get_operand(ctx, &insn->dst, NULL);
+	src = atom_get_operand(ctx, &insn->src, NULL);
+	atom_div32(ctx->ctx, dst, src);
+	return insn + 1;
+}
+
+static const struct atom_insn *atom_dop_setfbbase(atom_exec_context *ctx,
+						  const struct atom_insn *insn)
+{
+	ctx->ctx->fb_base = atom_get_operand(ctx, &insn->src, NULL);
+	return insn + 1;
+}
+
+static const struct atom_insn *atom_dop_setport(atom_exec_context *ctx,
+						const struct atom_insn *insn)
+{
+	ctx->ctx->io_mode = insn->imm;
+	return insn + 1;
+}
+
+static const struct atom_insn *atom_dop_setregblock(atom_exec_context *ctx,
+						    const struct atom_insn *insn)
+{
+	ctx->ctx->reg_block = insn->imm;
+	return insn + 1;
+}
+
+static const struct atom_insn *atom_dop_setdatablock(atom_exec_context *ctx,
+						     const struct atom_insn *insn)
+{
+	ctx->ctx->data_block = insn->imm;
+	return insn + 1;
+}
+
+static const struct atom_insn *atom_dop_switch(atom_exec_context *ctx,
+					       const struct atom_insn *insn)
+{
+	uint32_t src = atom_get_operand(ctx, &insn->src, NULL);
+	int i;
+
+	for (i = 0; i < insn->count; i++)
+		if (insn->cases[i].val == src)
+			return insn->cases[i].target;
+	return insn + 1;
+}
+
+static const struct atom_insn *atom_dop_jump(atom_exec_context *ctx,
+					     const struct atom_insn *insn)
+{
+	if (!atom_jump_taken(ctx, insn->arg))
+		return insn + 1;
+	atom_jump_check_loop(ctx, insn->imm);
+	return insn->target;
+}
+
+static const struct atom_insn *atom_dop_delay(atom_exec_context *ctx,
+					      const struct atom_insn *insn)
+{
+	atom_delay(ctx->ctx, insn->imm, insn->arg);
+	return insn + 1;
+}
+
+static const struct atom_insn *atom_dop_calltable(atom_exec_context *ctx,
+						  const struct atom_insn *insn)
+{
+	atom_call_table(ctx, insn->imm);
+	return insn + 1;
+}
+
+static const struct atom_insn *atom_dop_beep(atom_exec_context *ctx,
+					     const struct atom_insn *insn)
+{
+	printk("ATOM BIOS beeped!\n");
+	return insn + 1;
+}
+
+static const struct atom_insn *atom_dop_unimplemented(atom_exec_context *ctx,
+						      const struct atom_insn *insn)
+{
+	printk(KERN_INFO "unimplemented!\n");
+	return insn + 1;
+}
+
+static const struct atom_insn *atom_dop_nop(atom_exec_context *ctx,
+					    const struct atom_insn *insn)
+{
+	return insn + 1;
+}
+
+static const struct atom_insn *atom_dop_eot(atom_exec_context *ctx,
+					    const struct atom_insn *insn)
+{
+	return NULL;
+}
+
+static const struct atom_insn *atom_dop_bytecode(atom_exec_context *ctx,
+						 const struct atom_insn *insn)
+{
+	ctx->resume = ctx->start + insn->offset;
+	return NULL;
+}
+
+enum atom_dop_form {
+	ATOM_DOP_NONE,		/* opcode only */
+	ATOM_DOP_BYTE,		/* byte immediate */
+	ATOM_DOP_WORD,		/* word immediate */
+	ATOM_DOP_DST_SRC,	/* attr, dst, src */
+	ATOM_DOP_DST,		/* attr with default dst alignment, dst */
+	ATOM_DOP_DST_SHIFT,	/* as ATOM_DOP_DST plus a shift count byte */
+	ATOM_DOP_DST_MASK_SRC,	/* attr, dst, mask, src */
+	ATOM_DOP_SRC,		/* attr, src */
+	ATOM_DOP_SWITCH,
+	ATOM_DOP_JUMP,
+	ATOM_DOP_PORT,
+	ATOM_DOP_DATABLOCK,
+	ATOM_DOP_PROCESSDS,
+};
+
+static const struct {
+	void (*op) (atom_exec_context *, int *, int);
+	const struct atom_insn *(*dop)(atom_exec_context *,
+				       const struct atom_insn *);
+	enum atom_dop_form form;
+} atom_dop_table[] = {
+	{ atom_op_move, atom_dop_move, ATOM_DOP_DST_SRC },
+	{ atom_op_and, atom_dop_and, ATOM_DOP_DST_SRC },
+	{ atom_op_or, atom_dop_or, ATOM_DOP_DST_SRC },
+	{ atom_op_shift_left, atom_dop_shift_left, ATOM_DOP_DST_SHIFT },
+	{ atom_op_shift_right, atom_dop_shift_right, ATOM_DOP_DST_SHIFT },
+	{ atom_op_mul, atom_dop_mul, ATOM_DOP_DST_SRC },
+	{ atom_op_div, atom_dop_div, ATOM_DOP_DST_SRC },
+	{ atom_op_add, atom_dop_add, ATOM_DOP_DST_SRC },
+	{ atom_op_sub, atom_dop_sub, ATOM_DOP_DST_SRC },
+	{ atom_op_setport, atom_dop_setport, ATOM_DOP_PORT },
+	{ atom_op_setregblock, atom_dop_setregblock, ATOM_DOP_WORD },
+	{ atom_op_setfbbase, atom_dop_setfbbase, ATOM_DOP_SRC },
+	{ atom_op_compare, atom_dop_compare, ATOM_DOP_DST_SRC },
+	{ atom_op_switch, atom_dop_switch, ATOM_DOP_SWITCH },
+	{ atom_op_jump, atom_dop_jump, ATOM_DOP_JUMP },
+	{ atom_op_test, atom_dop_test, ATOM_DOP_DST_SRC },
+	{ atom_op_delay, atom_dop_delay, ATOM_DOP_BYTE },
+	{ atom_op_calltable, atom_dop_calltable, ATOM_DOP_BYTE },
+	{ atom_op_repeat, atom_dop_unimplemented, ATOM_DOP_NONE },
+	{ atom_op_clear, atom_dop_clear, ATOM_DOP_DST },
+	{ atom_op_nop, atom_dop_nop, ATOM_DOP_NONE },
+	{ atom_op_eot, atom_dop_eot, ATOM_DOP_NONE },
+	{ atom_op_mask, atom_dop_mask, ATOM_DOP_DST_MASK_SRC },
+	{ atom_op_postcard, atom_dop_nop, ATOM_DOP_BYTE },
+	{ atom_op_beep, atom_dop_beep, ATOM_DOP_NONE },
+	{ atom_op_savereg, atom_dop_unimplemented, ATOM_DOP_NONE },
+	{ atom_op_restorereg, atom_dop_unimplemented, ATOM_DOP_NONE },
+	{ atom_op_setdatablock, atom_dop_setdatablock, ATOM_DOP_DATABLOCK },
+	{ atom_op_xor, atom_dop_xor, ATOM_DOP_DST_SRC },
+	{ atom_op_shl, atom_dop_shl, ATOM_DOP_DST_SRC },
+	{ atom_op_shr, atom_dop_shr, ATOM_DOP_DST_SRC },
+	{ atom_op_debug, atom_dop_nop, ATOM_DOP_BYTE },
+	{ atom_op_processds, atom_dop_nop, ATOM_DOP_PROCESSDS },
+	{ atom_op_mul32, atom_dop_mul32, ATOM_DOP_DST_SRC },
+	{ atom_op_div32, atom_dop_div32, ATOM_DOP_DST_SRC },
+};
+
+static int atom_decode_operand(struct atom_context *ctx, int arg, int align,
+			       int ptr, struct atom_operand *op)
+{
+	op->arg = arg;
+	op->align = align;
+	switch (arg) {
+	case ATOM_ARG_REG:
+	case ATOM_ARG_ID:
+		op->val = CU16(ptr);
+		return ptr + 2;
+	case ATOM_ARG_IMM:
+		switch (align) {
+		case ATOM_SRC_DWORD:
+			op->val = CU32(ptr);
+			return ptr + 4;
+		case ATOM_SRC_WORD0:
+		case ATOM_SRC_WORD8:
+		case ATOM_SRC_WORD16:
+			op->val = CU16(ptr);
+			return ptr + 2;
+		}
+		/* fall through */
+	default:
+		op->val = CU8(ptr);
+		return ptr + 1;
+	}
+}
+
+static int atom_decode_dst(struct atom_context *ctx, int arg, uint8_t attr,
+			   int ptr, struct atom_operand *op)
+{
+	return atom_decode_operand(ctx, arg,
+				   atom_dst_to_src[(attr >> 3) & 7][(attr >> 6) & 3],
+				   ptr, op);
+}
+
+static int atom_decode_src(struct atom_context *ctx, uint8_t attr, int ptr,
+			   struct atom_operand *op)
+{
+	return atom_decode_operand(ctx, attr & 7, (attr >> 3) & 7, ptr, op);
+}
+
+/*
+ * Decode the cases of a switch starting at ptr. Returns the offset past
+ * ATOM_CASE_END, or 0 if the list is malformed or runs past end.
+ */
+static int atom_decode_cases(struct atom_context *ctx, uint8_t attr, int ptr,
+			     int end, struct atom_case *cases, uint16_t *count)
+{
+	struct atom_operand val;
+
+	*count = 0;
+	while (ptr + 2 <= end && CU16(ptr) != ATOM_CASE_END) {
+		if (CU8(ptr) != ATOM_CASE_MAGIC)
+			return 0;
+		ptr = atom_decode_operand(ctx, ATOM_ARG_IMM, (attr >> 3) & 7,
+					  ptr + 1, &val);
+		if (ptr + 2 > end)
+			return 0;
+		if (cases) {
+			cases[*count].val = val.val;
+			cases[*count].offset = CU16(ptr);
+		}
+		ptr += 2;
+		(*count)++;
+	}
+	if (ptr + 2 > end)
+		return 0;
+	return ptr + 2;
+}
+
+/*
+ * Decode the instruction at ptr into insn and return the offset of the next
+ * one. Returns 0 once decoding of the table has to stop; insn is then either
+ * an end of table or a stub handing over to the byte code loop.
+ */
+static int atom_decode_insn(struct atom_context *ctx, int base, int ptr,
+			    int end, struct atom_insn *insn,
+			    struct atom_case *cases)
+{
+	struct atom_operand mask;
+	uint8_t attr;
+	int op, i, port, idx;
+
+	memset(insn, 0, sizeof(*insn));
+	insn->offset = ptr - base;
+	insn->func = atom_dop_bytecode;
+	if (ptr >= end)
+		return 0;
+
+	op = CU8(ptr++);
+	if (op <= 0 || op >= ATOM_OP_CNT) {
+		insn->func = atom_dop_eot;
+		return 0;
+	}
+	for (i = 0; i < ARRAY_SIZE(atom_dop_table); i++)
+		if (atom_dop_table[i].op == opcode_table[op].func)
+			break;
+	if (i == ARRAY_SIZE(atom_dop_table))
+		return 0;
+	insn->arg = opcode_table[op].arg;
+
+	switch (atom_dop_table[i].form) {
+	case ATOM_DOP_NONE:
+		break;
+	case ATOM_DOP_BYTE:
+		insn->imm = CU8(ptr);
+		ptr++;
+		break;
+	case ATOM_DOP_WORD:
+		insn->imm = CU16(ptr);
+		ptr += 2;
+		break;
+	case ATOM_DOP_DST_SRC:
+		attr = CU8(ptr++);
+		ptr = atom_decode_dst(ctx, insn->arg, attr, ptr, &insn->dst);
+		ptr = atom_decode_src(ctx, attr, ptr, &insn->src);
+		break;
+	case ATOM_DOP_DST:
+	case ATOM_DOP_DST_SHIFT:
+		attr = CU8(ptr++);
+		attr &= 0x38;
+		attr |= atom_def_dst[attr >> 3] << 6;
+		ptr = atom_decode_dst(ctx, insn->arg, attr, ptr, &insn->dst);
+		if (atom_dop_table[i].form == ATOM_DOP_DST_SHIFT) {
+			insn->imm = CU8(ptr);
+			ptr++;
+		}
+		break;
+	case ATOM_DOP_DST_MASK_SRC:
+		attr = CU8(ptr++);
+		ptr = atom_decode_dst(ctx, insn->arg, attr, ptr, &insn->dst);
+		ptr = atom_decode_operand(ctx, ATOM_ARG_IMM, (attr >> 3) & 7,
+					  ptr, &mask);
+		insn->imm = mask.val;
+		ptr = atom_decode_src(ctx, attr, ptr, &insn->src);
+		break;
+	case ATOM_DOP_SRC:
+		attr = CU8(ptr++);
+		ptr = atom_decode_src(ctx, attr, ptr, &insn->src);
+		break;
+	case ATOM_DOP_SWITCH:
+		attr = CU8(ptr++);
+		ptr = atom_decode_src(ctx, attr, ptr, &insn->src);
+		if (ptr > end)
+			break;
+		if (!atom_decode_cases(ctx, attr, ptr, end, NULL, &insn->count)) {
+			insn->func = atom_dop_bytecode;
+			return 0;
+		}
+		insn->cases = cases;
+		ptr = atom_decode_cases(ctx, attr, ptr, end, cases,
+					&insn->count);
+		break;
+	case ATOM_DOP_JUMP:
+		insn->imm = CU16(ptr);
+		ptr += 2;
+		break;
+	case ATOM_DOP_PORT:
+		switch (insn->arg) {
+		case ATOM_PORT_ATI:
+			port = CU16(ptr);
+			insn->imm = port ? (ATOM_IO_IIO | port) : ATOM_IO_MM;
+			ptr += 2;
+			break;
+		case ATOM_PORT_PCI:
+			insn->imm = ATOM_IO_PCI;
+			ptr++;
+			break;
+		case ATOM_PORT_SYSIO:
+			insn->imm = ATOM_IO_SYSIO;
+			ptr++;
+			break;
+		}
+		break;
+	case ATOM_DOP_DATABLOCK:
+		idx = CU8(ptr);
+		ptr++;
+		if (!idx)
+			insn->imm = 0;
+		else if (idx == 255)
+			insn->imm = base;
+		else
+			insn->imm = CU16(ctx->data_table + 4 + 2 * idx);
+		break;
+	case ATOM_DOP_PROCESSDS:
+		ptr += CU16(ptr) + 2;
+		break;
+	}
+
+	if (ptr > end) {
+		insn->func = atom_dop_bytecode;
+		return 0;
+	}
+	insn->func = atom_dop_table[i].dop;
+	return ptr;
+}
+
+/*
+ * Map a jump or case target to its decoded instruction. Targets that do not
+ * start an instruction get a byte code stub appended after the table.
+ */
+static const struct atom_insn *atom_resolve_target(struct atom_decoded_table *table,
+						   uint16_t offset, int *num_stubs)
+{
+	int lo = 0, hi = table->num_insns - 1, mid;
+	struct atom_insn *stub;
+
+	while (lo <= hi) {
+		mid = (lo + hi) / 2;
+		if (table->insns[mid].offset == offset)
+			return &table->insns[mid];
+		if (table->insns[mid].offset < offset)
+			lo = mid + 1;
+		else
+			hi = mid - 1;
+	}
+
+	stub = &table->insns[table->num_insns + (*num_stubs)++];
+	stub->func = atom_dop_bytecode;
+	stub->offset = offset;
+	return stub;
+}
+
+static struct atom_decoded_table *atom_decode_table(struct atom_context *ctx,
+						    int base)
+{
+	struct atom_decoded_table *table;
+	struct atom_insn insn, *cur;
+	struct atom_case *cases;
+	int end = base + CU16(base + ATOM_CT_SIZE_PTR);
+	int code = base + ATOM_CT_CODE_PTR;
+	int num_insns = 0, num_targets = 0, num_cases = 0, num_stubs = 0;
+	int ptr, i, j;
+
+	/* size the table */
+	ptr = code;
+	do {
+		ptr = atom_decode_insn(ctx, base, ptr, end, &insn, NULL);
+		num_insns++;
+		if (insn.func == atom_dop_jump)
+			num_targets++;
+		else if (insn.func == atom_dop_switch)
+			num_cases += insn.count;
+	} while (ptr);
+
+	table = kzalloc(sizeof(*table) +
+			(num_insns + num_targets + num_cases) * sizeof(insn) +
+			num_cases * sizeof(*cases), GFP_KERNEL);
+	if (!table)
+		return NULL;
+
+	table->num_insns = num_insns;
+	table->insns = (struct atom_insn *)(table + 1);
+	table->cases = (struct atom_case *)
+		(table->insns + num_insns + num_targets + num_cases);
+
+	cases = table->cases;
+	ptr = code;
+	for (i = 0; i < num_insns; i++) {
+		cur = &table->insns[i];
+		ptr = atom_decode_insn(ctx, base, ptr, end, cur, cases);
+		if (cur->func == atom_dop_switch)
+			cases += cur->count;
+	}
+
+	for (i = 0; i < num_insns; i++) {
+		cur = &table->insns[i];
+		if (cur->func == atom_dop_jump)
+			cur->target = atom_resolve_target(table, cur->imm,
+							  &num_stubs);
+		else if (cur->func == atom_dop_switch)
+			for (j = 0; j < cur->count; j++)
+				cur->cases[j].target =
+					atom_resolve_target(table,
+							    cur->cases[j].offset,
+							    &num_stubs);
+	}
+
+	return table;
+}
+
+static struct atom_decoded_table *atom_get_decoded_table(struct atom_context *ctx,
+							 int index, int base)
+{
+	/* keep the byte code loop when tracing so every operand is printed */
+	if (amdgpu_atom_debug || !ctx->decoded_tables ||
+	    index >= ctx->num_cmd_tables)
+		return NULL;
+
+	if (!ctx->decoded_tables[index])
+		ctx->decoded_tables[index] = atom_decode_table(ctx, base);
+
+	return ctx->decoded_tables[index];
+}
+
 static int amdgpu_atom_execute_table_locked(struct atom_context *ctx, int index, uint32_t * params)
 {
 	int base = CU16(ctx->cmd_table + 4 + 2 * index);
 	int len, ws, ps, ptr;
 	unsigned char op;
 	atom_exec_context ectx;
+	struct atom_decoded_table *table;
+	const struct atom_insn *insn;
+	bool ws_pooled = false;
 	int ret = 0;
 
 	if (!base)
@@ -1226,13 +2264,35 @@ static int amdgpu_atom_execute_table_locked(struct atom_context *ctx, int index,
 	ectx.ps = params;
 	ectx.abort = false;
 	ectx.last_jump = 0;
-	if (ws)
+	ectx.resume = 0;
+	if (ws && ctx->ws_pool &&
+	    ctx->ws_pool_used + ws <= ATOM_WS_POOL_SIZE) {
+		/* nested tables take consecutive slices of the pool */
+		ectx.ws = ctx->ws_pool + ctx->ws_pool_used;
+		memset(ectx.ws, 0, 4 * ws);
+		ctx->ws_pool_used += ws;
+		ws_pooled = true;
+	} else if (ws)
 		ectx.ws = kzalloc(4 * ws, GFP_KERNEL);
 	else
 		ectx.ws = NULL;
 
 	debug_depth++;
-	while (1) {
+
+	table = atom_get_decoded_table(ctx, index, base);
+	if (table) {
+		insn = table->insns;
+		while (insn && !ectx.abort)
+			insn = insn->func(&ectx, insn);
+		/* an abort is reported, and a stub continued, by the byte
+		 * code loop below */
+		if (insn)
+			ptr = base + insn->offset;
+		else
+			ptr = ectx.resume;
+	}
+
+	while (ptr) {
 		op = CU8(ptr++);
 		if (op < ATOM_OP_NAMES_CNT)
 			SDEBUG("%s @ 0x%04X\n", atom_op_names[op], ptr - 1);
@@ -1258,16 +2318,15 @@ static int amdgpu_atom_execute_table_locked(struct atom_context *ctx, int index,
 	SDEBUG("<<\n");
 
 free:
-	if (ws)
+	if (ws_pooled)
+		ctx->ws_pool_used -= ws;
+	else if (ws)
 		kfree(ectx.ws);
 	return ret;
 }
 
-int amdgpu_atom_execute_table(struct atom_context *ctx, int index, uint32_t * params)
+static void atom_reset_exec_state(struct atom_context *ctx)
 {
-	int r;
-
-	mutex_lock(&ctx->mutex);
 	/* reset data block */
 	ctx->data_block = 0;
 	/* reset reg block */
@@ -1279,6 +2338,14 @@ int amdgpu_atom_execute_table(struct atom_context *ctx, int index, uint32_t * pa
 	/* reset divmul */
 	ctx->divmul[0] = 0;
 	ctx->divmul[1] = 0;
+}
+
+int amdgpu_atom_execute_table(struct atom_context *ctx, int index, uint32_t * params)
+{
+	int r;
+
+	mutex_lock(&ctx->mutex);
+	atom_reset_exec_state(ctx);
 	r = amdgpu_atom_execute_table_locked(ctx, index, params);
 	mutex_unlock(&ctx->mutex);
 	return r;
@@ -1345,6 +2412,17 @@ struct atom_context *amdgpu_atom_parse(struct card_info *card, void *bios)
 		return NULL;
 	}
 
+	/* both are optional, tables fall back to the byte code loop and
+	 * per call workspace allocations without them */
+	if (CU16(ctx->cmd_table) > 4) {
+		ctx->num_cmd_tables = (CU16(ctx->cmd_table) - 4) / 2;
+		ctx->decoded_tables = kcalloc(ctx->num_cmd_tables,
+					      sizeof(*ctx->decoded_tables),
+					      GFP_KERNEL);
+	}
+	ctx->ws_pool = kcalloc(ATOM_WS_POOL_SIZE, sizeof(uint32_t),
+			       GFP_KERNEL);
+
 	str = CSTR(CU16(base + ATOM_ROM_MSG_PTR));
 	while (*str && ((*str == '\n') || (*str == '\r')))
 		str++;
@@ -1361,9 +2439,167 @@ struct atom_context *amdgpu_atom_parse(struct card_info *card, void *bios)
 	return ctx;
 }
 
+static void atom_trace_save_state(struct atom_context *ctx,
+				  struct atom_trace_state *state)
+{
+	state->divmul[0] = ctx->divmul[0];
+	state->divmul[1] = ctx->divmul[1];
+	state->data_block = ctx->data_block;
+	state->fb_base = ctx->fb_base;
+	state->io_attr = ctx->io_attr;
+	state->reg_block = ctx->reg_block;
+	state->shift = ctx->shift;
+	state->cs_equal = ctx->cs_equal;
+	state->cs_above = ctx->cs_above;
+	state->io_mode = ctx->io_mode;
+}
+
+static void atom_trace_restore_state(struct atom_context *ctx,
+				     struct atom_trace_state *state)
+{
+	ctx->divmul[0] = state->divmul[0];
+	ctx->divmul[1] = state->divmul[1];
+	ctx->data_block = state->data_block;
+	ctx->fb_base = state->fb_base;
+	ctx->io_attr = state->io_attr;
+	ctx->reg_block = state->reg_block;
+	ctx->shift = state->shift;
+	ctx->cs_equal = state->cs_equal;
+	ctx->cs_above = state->cs_above;
+	ctx->io_mode = state->io_mode;
+}
+
+/* whether the state a recorded run depended on is the same this time */
+static bool atom_trace_entry_matches(struct atom_context *ctx,
+				     struct atom_init_trace *trace)
+{
+	unsigned uses = trace->uses;
+
+	if ((uses & ATOM_TRACE_USE_SHIFT) && ctx->shift != trace->entry.shift)
+		return false;
+	if ((uses & ATOM_TRACE_USE_IO_ATTR) &&
+	    ctx->io_attr != trace->entry.io_attr)
+		return false;
+	if ((uses & ATOM_TRACE_USE_CS_EQUAL) &&
+	    ctx->cs_equal != trace->entry.cs_equal)
+		return false;
+	if ((uses & ATOM_TRACE_USE_CS_ABOVE) &&
+	    ctx->cs_above != trace->entry.cs_above)
+		return false;
+	return true;
+}
+
+static void atom_init_trace_free(struct atom_init_trace *trace)
+{
+	if (!trace)
+		return;
+	vfree(trace->entries);
+	kfree(trace);
+}
+
+static uint32_t atom_trace_read(struct atom_context *ctx, int type,
+				uint32_t addr)
+{
+	switch (type) {
+	case ATOM_TRACE_REG_READ:
+		return ctx->card->reg_read(ctx->card, addr);
+	case ATOM_TRACE_IO_READ:
+		return ctx->card->ioreg_read(ctx->card, addr);
+	case ATOM_TRACE_PLL_READ:
+		return ctx->card->pll_read(ctx->card, addr);
+	case ATOM_TRACE_MC_READ:
+		return ctx->card->mc_read(ctx->card, addr);
+	default:
+		return ctx->scratch[addr];
+	}
+}
+
+/*
+ * Replay a poll. While the recorded pending value keeps coming back the
+ * table would have taken the same path again, so keep reading for as long
+ * as the interpreter's own loop guard would let it.
+ */
+static bool atom_trace_poll(struct atom_context *ctx,
+			    struct atom_trace_entry *e)
+{
+	unsigned long start = jiffies;
+	uint32_t i, val;
+
+	for (i = 0; ; i++) {
+		if (i && (e->flags & ATOM_TRACE_POLL_DELAY))
+			atom_delay(ctx, e->delay_count, e->delay_unit);
+		val = atom_trace_read(ctx, e->poll_type, e->addr);
+		if (val != e->pending)
+			return (e->flags & ATOM_TRACE_POLL_DONE) &&
+			       val == e->val;
+		if (!(e->flags & ATOM_TRACE_POLL_DONE)) {
+			if (i + 1 == e->count)
+				return true;
+		} else if (jiffies_to_msecs(jiffies - start) > 5000) {
+			return false;
+		}
+	}
+}
+
+/*
+ * Issue the recorded accesses of the last asic_init instead of interpreting
+ * it again. Returns false as soon as a read differs from the recording; the
+ * caller then runs the table from the start.
+ */
+static bool atom_init_replay(struct atom_context *ctx, uint32_t *ps)
+{
+	struct atom_init_trace *trace = ctx->init_trace;
+	struct atom_trace_entry *e;
+	int i;
+
+	if (trace->sclk != ps[0] || trace->mclk != ps[1] ||
+	    !atom_trace_entry_matches(ctx, trace))
+		return false;
+
+	for (i = 0; i < trace->num_entries; i++) {
+		e = &trace->entries[i];
+		switch (e->type) {
+		case ATOM_TRACE_REG_WRITE:
+			ctx->card->reg_write(ctx->card, e->addr, e->val);
+			break;
+		case ATOM_TRACE_IO_WRITE:
+			ctx->card->ioreg_write(ctx->card, e->addr, e->val);
+			break;
+		case ATOM_TRACE_PLL_WRITE:
+			ctx->card->pll_write(ctx->card, e->addr, e->val);
+			break;
+		case ATOM_TRACE_MC_WRITE:
+			ctx->card->mc_write(ctx->card, e->addr, e->val);
+			break;
+		case ATOM_TRACE_FB_WRITE:
+			ctx->scratch[e->addr] = e->val;
+			break;
+		case ATOM_TRACE_DELAY:
+			atom_delay(ctx, e->val, e->addr);
+			break;
+		case ATOM_TRACE_POLL:
+			if (!atom_trace_poll(ctx, e))
+				goto diverged;
+			break;
+		default:
+			if (atom_trace_read(ctx, e->type, e->addr) != e->val)
+				goto diverged;
+		}
+	}
+
+	atom_trace_restore_state(ctx, &trace->exit);
+	return true;
+
+diverged:
+	DRM_INFO("atombios asic_init replay diverged at %d/%d, interpreting\n",
+		 i, trace->num_entries);
+	return false;
+}
+
 int amdgpu_atom_asic_init(struct atom_context *ctx)
 {
 	int hwi = CU16(ctx->data_table + ATOM_DATA_FWI_PTR);
+	struct atom_init_trace *trace = NULL;
 	uint32_t ps[16];
 	int ret;
 
@@ -1376,7 +2612,45 @@ int amdgpu_atom_asic_init(struct atom_context *ctx)
 
 	if (!CU16(ctx->cmd_table + 4 + 2 * ATOM_CMD_INIT))
 		return 1;
-	ret = amdgpu_atom_execute_table(ctx, ATOM_CMD_INIT, ps);
+
+	mutex_lock(&ctx->mutex);
+	atom_reset_exec_state(ctx);
+	if (ctx->init_trace && !amdgpu_atom_debug) {
+		if (atom_init_replay(ctx, ps)) {
+			ctx->init_replay_misses = 0;
+			mutex_unlock(&ctx->mutex);
+			return 0;
+		}
+		atom_init_trace_free(ctx->init_trace);
+		ctx->init_trace = NULL;
+		ctx->init_replay_misses++;
+		atom_reset_exec_state(ctx);
+	}
+
+	/* record this run for the next one, unless the recordings keep
+	 * going stale */
+	if (!amdgpu_atom_debug &&
+	    ctx->init_replay_misses < ATOM_TRACE_MAX_MISSES)
+		trace = kzalloc(sizeof(*trace), GFP_KERNEL);
+	if (trace) {
+		trace->sclk = ps[0];
+		trace->mclk = ps[1];
+		atom_trace_save_state(ctx, &trace->entry);
+		ctx->init_rec = trace;
+	}
+
+	ret = amdgpu_atom_execute_table_locked(ctx, ATOM_CMD_INIT, ps);
+
+	if (trace) {
+		ctx->init_rec = NULL;
+		if (!ret && !trace->overflow) {
+			atom_trace_save_state(ctx, &trace->exit);
+			ctx->init_trace = trace;
+		} else {
+			atom_init_trace_free(trace);
+		}
+	}
+	mutex_unlock(&ctx->mutex);
 	if (ret)
 		return ret;
 
@@ -1387,6 +2661,14 @@ int amdgpu_atom_asic_init(struct atom_context *ctx)
 
 void amdgpu_atom_destroy(struct atom_context *ctx)
 {
+	int i;
+
+	if (ctx->decoded_tables)
+		for (i = 0; i < ctx->num_cmd_tables; i++)
+			kfree(ctx->decoded_tables[i]);
+	kfree(ctx->decoded_tables);
+	kfree(ctx->ws_pool);
+	atom_init_trace_free(ctx->init_trace);
 	kfree(ctx->iio);
 	kfree(ctx);
 }
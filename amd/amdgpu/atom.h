@@ -122,6 +122,9 @@ struct card_info {
 	uint32_t (* pll_read)(struct card_info *, uint32_t);          /*  filled by driver */
 };
 
+struct atom_decoded_table;
+struct atom_init_trace;
+
 struct atom_context {
 	struct card_info *card;
 	struct mutex mutex;
@@ -139,6 +142,16 @@ struct atom_context {
 	int io_mode;
 	uint32_t *scratch;
 	int scratch_size_bytes;
+	/* command tables decoded on first execution, by index */
+	struct atom_decoded_table **decoded_tables;
+	int num_cmd_tables;
+	uint32_t *ws_pool;
+	int ws_pool_used;
+	/* hardware accesses of the last successful asic_init, replayed on
+	 * the next one */
+	struct atom_init_trace *init_trace;
+	struct atom_init_trace *init_rec;
+	int init_replay_misses;
 };
 
 extern int amdgpu_atom_debug;
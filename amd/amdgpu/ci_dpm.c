@@ -5779,7 +5779,7 @@ static int ci_dpm_init_microcode(struct amdgpu_device *adev)
 	}
 
 	snprintf(fw_name, sizeof(fw_name), "radeon/%s_smc.bin", chip_name);
-	err = request_firmware(&adev->pm.fw, fw_name, adev->dev);
+	err = amdgpu_ucode_request(adev, &adev->pm.fw, fw_name);
 	if (err)
 		goto out;
 	err = amdgpu_ucode_validate(adev->pm.fw);
@@ -5789,7 +5789,7 @@ out:
 		printk(KERN_ERR
 		       "cik_smc: Failed to load firmware \"%s\"\n",
 		       fw_name);
-		release_firmware(adev->pm.fw);
+		amdgpu_ucode_release(adev->pm.fw);
 		adev->pm.fw = NULL;
 	}
 	return err;
@@ -6235,7 +6235,7 @@ static int ci_dpm_sw_fini(void *handle)
 	ci_dpm_fini(adev);
 	mutex_unlock(&adev->pm.mutex);
 
-	release_firmware(adev->pm.fw);
+	amdgpu_ucode_release(adev->pm.fw);
 	adev->pm.fw = NULL;
 
 	return 0;
@@ -1658,6 +1658,7 @@ static const struct amdgpu_ip_block_version bonaire_ip_blocks_dal[] =
 		.minor = 0,
 		.rev = 0,
 		.funcs = &gmc_v7_0_ip_funcs,
+		.deps = AMDGPU_IP_DEP(COMMON),
 	},
 	{
 		.type = AMD_IP_BLOCK_TYPE_IH,
@@ -1665,6 +1666,7 @@ static const struct amdgpu_ip_block_version bonaire_ip_blocks_dal[] =
 		.minor = 0,
 		.rev = 0,
 		.funcs = &cik_ih_ip_funcs,
+		.deps = AMDGPU_IP_DEP(COMMON) | AMDGPU_IP_DEP(GMC),
 	},
 	{
 		.type = AMD_IP_BLOCK_TYPE_SMC,
@@ -1672,6 +1674,7 @@ static const struct amdgpu_ip_block_version bonaire_ip_blocks_dal[] =
 		.minor = 0,
 		.rev = 0,
 		.funcs = &amdgpu_pp_ip_funcs,
+		.deps = AMDGPU_IP_DEPS_BASE,
 	},
 	{
 		.type = AMD_IP_BLOCK_TYPE_DCE,
@@ -1679,6 +1682,7 @@ static const struct amdgpu_ip_block_version bonaire_ip_blocks_dal[] =
 		.minor = 0,
 		.rev = 0,
 		.funcs = &amdgpu_dm_funcs,
+		.deps = AMDGPU_IP_DEPS_DISPLAY,
 	},
 	{
 		.type = AMD_IP_BLOCK_TYPE_GFX,
@@ -1686,6 +1690,7 @@ static const struct amdgpu_ip_block_version bonaire_ip_blocks_dal[] =
 		.minor = 2,
 		.rev = 0,
 		.funcs = &gfx_v7_0_ip_funcs,
+		.deps = AMDGPU_IP_DEPS_ENGINE,
 	},
 	{
 		.type = AMD_IP_BLOCK_TYPE_SDMA,
@@ -1693,6 +1698,7 @@ static const struct amdgpu_ip_block_version bonaire_ip_blocks_dal[] =
 		.minor = 0,
 		.rev = 0,
 		.funcs = &cik_sdma_ip_funcs,
+		.deps = AMDGPU_IP_DEPS_ENGINE,
 	},
 	{
 		.type = AMD_IP_BLOCK_TYPE_UVD,
@@ -1700,6 +1706,7 @@ static const struct amdgpu_ip_block_version bonaire_ip_blocks_dal[] =
 		.minor = 2,
 		.rev = 0,
 		.funcs = &uvd_v4_2_ip_funcs,
+		.deps = AMDGPU_IP_DEPS_ENGINE,
 	},
 	{
 		.type = AMD_IP_BLOCK_TYPE_VCE,
@@ -1707,6 +1714,7 @@ static const struct amdgpu_ip_block_version bonaire_ip_blocks_dal[] =
 		.minor = 0,
 		.rev = 0,
 		.funcs = &vce_v2_0_ip_funcs,
+		.deps = AMDGPU_IP_DEPS_ENGINE,
 	},
 };
 #endif
@@ -1727,6 +1735,7 @@ static const struct amdgpu_ip_block_version bonaire_ip_blocks[] =
 		.minor = 0,
 		.rev = 0,
 		.funcs = &gmc_v7_0_ip_funcs,
+		.deps = AMDGPU_IP_DEP(COMMON),
 	},
 	{
 		.type = AMD_IP_BLOCK_TYPE_IH,
@@ -1734,6 +1743,7 @@ static const struct amdgpu_ip_block_version bonaire_ip_blocks[] =
 		.minor = 0,
 		.rev = 0,
 		.funcs = &cik_ih_ip_funcs,
+		.deps = AMDGPU_IP_DEP(COMMON) | AMDGPU_IP_DEP(GMC),
 	},
 	{
 		.type = AMD_IP_BLOCK_TYPE_SMC,
@@ -1741,6 +1751,7 @@ static const struct amdgpu_ip_block_version bonaire_ip_blocks[] =
 		.minor = 0,
 		.rev = 0,
 		.funcs = &amdgpu_pp_ip_funcs,
+		.deps = AMDGPU_IP_DEPS_BASE,
 	},
 	{
 		.type = AMD_IP_BLOCK_TYPE_DCE,
@@ -1748,6 +1759,7 @@ static const struct amdgpu_ip_block_version bonaire_ip_blocks[] =
 		.minor = 2,
 		.rev = 0,
 		.funcs = &dce_v8_0_ip_funcs,
+		.deps = AMDGPU_IP_DEPS_DISPLAY,
 	},
 	{
 		.type = AMD_IP_BLOCK_TYPE_GFX,
@@ -1755,6 +1767,7 @@ static const struct amdgpu_ip_block_version bonaire_ip_blocks[] =
 		.minor = 2,
 		.rev = 0,
 		.funcs = &gfx_v7_0_ip_funcs,
+		.deps = AMDGPU_IP_DEPS_ENGINE,
 	},
 	{
 		.type = AMD_IP_BLOCK_TYPE_SDMA,
@@ -1762,6 +1775,7 @@ static const struct amdgpu_ip_block_version bonaire_ip_blocks[] =
 		.minor = 0,
 		.rev = 0,
 		.funcs = &cik_sdma_ip_funcs,
+		.deps = AMDGPU_IP_DEPS_ENGINE,
 	},
 	{
 		.type = AMD_IP_BLOCK_TYPE_UVD,
@@ -1769,6 +1783,7 @@ static const struct amdgpu_ip_block_version bonaire_ip_blocks[] =
 		.minor = 2,
 		.rev = 0,
 		.funcs = &uvd_v4_2_ip_funcs,
+		.deps = AMDGPU_IP_DEPS_ENGINE,
 	},
 	{
 		.type = AMD_IP_BLOCK_TYPE_VCE,
@@ -1776,6 +1791,7 @@ static const struct amdgpu_ip_block_version bonaire_ip_blocks[] =
 		.minor = 0,
 		.rev = 0,
 		.funcs = &vce_v2_0_ip_funcs,
+		.deps = AMDGPU_IP_DEPS_ENGINE,
 	},
 };
 
@@ -1796,6 +1812,7 @@ static const struct amdgpu_ip_block_version hawaii_ip_blocks_dal[] =
 		.minor = 0,
 		.rev = 0,
 		.funcs = &gmc_v7_0_ip_funcs,
+		.deps = AMDGPU_IP_DEP(COMMON),
 	},
 	{
 		.type = AMD_IP_BLOCK_TYPE_IH,
@@ -1803,6 +1820,7 @@ static const struct amdgpu_ip_block_version hawaii_ip_blocks_dal[] =
 		.minor = 0,
 		.rev = 0,
 		.funcs = &cik_ih_ip_funcs,
+		.deps = AMDGPU_IP_DEP(COMMON) | AMDGPU_IP_DEP(GMC),
 	},
 	{
 		.type = AMD_IP_BLOCK_TYPE_SMC,
@@ -1810,6 +1828,7 @@ static const struct amdgpu_ip_block_version hawaii_ip_blocks_dal[] =
 		.minor = 0,
 		.rev = 0,
 		.funcs = &amdgpu_pp_ip_funcs,
+		.deps = AMDGPU_IP_DEPS_BASE,
 	},
 	{
 		.type = AMD_IP_BLOCK_TYPE_DCE,
@@ -1817,6 +1836,7 @@ static const struct amdgpu_ip_block_version hawaii_ip_blocks_dal[] =
 		.minor = 0,
 		.rev = 0,
 		.funcs = &amdgpu_dm_funcs,
+		.deps = AMDGPU_IP_DEPS_DISPLAY,
 	},
 	{
 		.type = AMD_IP_BLOCK_TYPE_GFX,
@@ -1824,6 +1844,7 @@ static const struct amdgpu_ip_block_version hawaii_ip_blocks_dal[] =
 		.minor = 3,
 		.rev = 0,
 		.funcs = &gfx_v7_0_ip_funcs,
+		.deps = AMDGPU_IP_DEPS_ENGINE,
 	},
 	{
 		.type = AMD_IP_BLOCK_TYPE_SDMA,
@@ -1831,6 +1852,7 @@ static const struct amdgpu_ip_block_version hawaii_ip_blocks_dal[] =
 		.minor = 0,
 		.rev = 0,
 		.funcs = &cik_sdma_ip_funcs,
+		.deps = AMDGPU_IP_DEPS_ENGINE,
 	},
 	{
 		.type = AMD_IP_BLOCK_TYPE_UVD,
@@ -1838,6 +1860,7 @@ static const struct amdgpu_ip_block_version hawaii_ip_blocks_dal[] =
 		.minor = 2,
 		.rev = 0,
 		.funcs = &uvd_v4_2_ip_funcs,
+		.deps = AMDGPU_IP_DEPS_ENGINE,
 	},
 	{
 		.type = AMD_IP_BLOCK_TYPE_VCE,
@@ -1845,6 +1868,7 @@ static const struct amdgpu_ip_block_version hawaii_ip_blocks_dal[] =
 		.minor = 0,
 		.rev = 0,
 		.funcs = &vce_v2_0_ip_funcs,
+		.deps = AMDGPU_IP_DEPS_ENGINE,
 	},
 };
 #endif
@@ -1865,6 +1889,7 @@ static const struct amdgpu_ip_block_version hawaii_ip_blocks[] =
 		.minor = 0,
 		.rev = 0,
 		.funcs = &gmc_v7_0_ip_funcs,
+		.deps = AMDGPU_IP_DEP(COMMON),
 	},
 	{
 		.type = AMD_IP_BLOCK_TYPE_IH,
@@ -1872,6 +1897,7 @@ static const struct amdgpu_ip_block_version hawaii_ip_blocks[] =
 		.minor = 0,
 		.rev = 0,
 		.funcs = &cik_ih_ip_funcs,
+		.deps = AMDGPU_IP_DEP(COMMON) | AMDGPU_IP_DEP(GMC),
 	},
 	{
 		.type = AMD_IP_BLOCK_TYPE_SMC,
@@ -1879,6 +1905,7 @@ static const struct amdgpu_ip_block_version hawaii_ip_blocks[] =
 		.minor = 0,
 		.rev = 0,
 		.funcs = &amdgpu_pp_ip_funcs,
+		.deps = AMDGPU_IP_DEPS_BASE,
 	},
 	{
 		.type = AMD_IP_BLOCK_TYPE_DCE,
@@ -1886,6 +1913,7 @@ static const struct amdgpu_ip_block_version hawaii_ip_blocks[] =
 		.minor = 5,
 		.rev = 0,
 		.funcs = &dce_v8_0_ip_funcs,
+		.deps = AMDGPU_IP_DEPS_DISPLAY,
 	},
 	{
 		.type = AMD_IP_BLOCK_TYPE_GFX,
@@ -1893,6 +1921,7 @@ static const struct amdgpu_ip_block_version hawaii_ip_blocks[] =
 		.minor = 3,
 		.rev = 0,
 		.funcs = &gfx_v7_0_ip_funcs,
+		.deps = AMDGPU_IP_DEPS_ENGINE,
 	},
 	{
 		.type = AMD_IP_BLOCK_TYPE_SDMA,
@@ -1900,6 +1929,7 @@ static const struct amdgpu_ip_block_version hawaii_ip_blocks[] =
 		.minor = 0,
 		.rev = 0,
 		.funcs = &cik_sdma_ip_funcs,
+		.deps = AMDGPU_IP_DEPS_ENGINE,
 	},
 	{
 		.type = AMD_IP_BLOCK_TYPE_UVD,
@@ -1907,6 +1937,7 @@ static const struct amdgpu_ip_block_version hawaii_ip_blocks[] =
 		.minor = 2,
 		.rev = 0,
 		.funcs = &uvd_v4_2_ip_funcs,
+		.deps = AMDGPU_IP_DEPS_ENGINE,
 	},
 	{
 		.type = AMD_IP_BLOCK_TYPE_VCE,
@@ -1914,6 +1945,7 @@ static const struct amdgpu_ip_block_version hawaii_ip_blocks[] =
 		.minor = 0,
 		.rev = 0,
 		.funcs = &vce_v2_0_ip_funcs,
+		.deps = AMDGPU_IP_DEPS_ENGINE,
 	},
 };
 
@@ -1933,6 +1965,7 @@ static const struct amdgpu_ip_block_version kabini_ip_blocks[] =
 		.minor = 0,
 		.rev = 0,
 		.funcs = &gmc_v7_0_ip_funcs,
+		.deps = AMDGPU_IP_DEP(COMMON),
 	},
 	{
 		.type = AMD_IP_BLOCK_TYPE_IH,
@@ -1940,6 +1973,7 @@ static const struct amdgpu_ip_block_version kabini_ip_blocks[] =
 		.minor = 0,
 		.rev = 0,
 		.funcs = &cik_ih_ip_funcs,
+		.deps = AMDGPU_IP_DEP(COMMON) | AMDGPU_IP_DEP(GMC),
 	},
 	{
 		.type = AMD_IP_BLOCK_TYPE_SMC,
@@ -1947,6 +1981,7 @@ static const struct amdgpu_ip_block_version kabini_ip_blocks[] =
 		.minor = 0,
 		.rev = 0,
 		.funcs = &amdgpu_pp_ip_funcs,
+		.deps = AMDGPU_IP_DEPS_BASE,
 	},
 	{
 		.type = AMD_IP_BLOCK_TYPE_DCE,
@@ -1954,6 +1989,7 @@ static const struct amdgpu_ip_block_version kabini_ip_blocks[] =
 		.minor = 3,
 		.rev = 0,
 		.funcs = &dce_v8_0_ip_funcs,
+		.deps = AMDGPU_IP_DEPS_DISPLAY,
 	},
 	{
 		.type = AMD_IP_BLOCK_TYPE_GFX,
@@ -1961,6 +1997,7 @@ static const struct amdgpu_ip_block_version kabini_ip_blocks[] =
 		.minor = 2,
 		.rev = 0,
 		.funcs = &gfx_v7_0_ip_funcs,
+		.deps = AMDGPU_IP_DEPS_ENGINE,
 	},
 	{
 		.type = AMD_IP_BLOCK_TYPE_SDMA,
@@ -1968,6 +2005,7 @@ static const struct amdgpu_ip_block_version kabini_ip_blocks[] =
 		.minor = 0,
 		.rev = 0,
 		.funcs = &cik_sdma_ip_funcs,
+		.deps = AMDGPU_IP_DEPS_ENGINE,
 	},
 	{
 		.type = AMD_IP_BLOCK_TYPE_UVD,
@@ -1975,6 +2013,7 @@ static const struct amdgpu_ip_block_version kabini_ip_blocks[] =
 		.minor = 2,
 		.rev = 0,
 		.funcs = &uvd_v4_2_ip_funcs,
+		.deps = AMDGPU_IP_DEPS_ENGINE,
 	},
 	{
 		.type = AMD_IP_BLOCK_TYPE_VCE,
@@ -1982,6 +2021,7 @@ static const struct amdgpu_ip_block_version kabini_ip_blocks[] =
 		.minor = 0,
 		.rev = 0,
 		.funcs = &vce_v2_0_ip_funcs,
+		.deps = AMDGPU_IP_DEPS_ENGINE,
 	},
 };
 
@@ -2001,6 +2041,7 @@ static const struct amdgpu_ip_block_version mullins_ip_blocks[] =
 		.minor = 0,
 		.rev = 0,
 		.funcs = &gmc_v7_0_ip_funcs,
+		.deps = AMDGPU_IP_DEP(COMMON),
 	},
 	{
 		.type = AMD_IP_BLOCK_TYPE_IH,
@@ -2008,6 +2049,7 @@ static const struct amdgpu_ip_block_version mullins_ip_blocks[] =
 		.minor = 0,
 		.rev = 0,
 		.funcs = &cik_ih_ip_funcs,
+		.deps = AMDGPU_IP_DEP(COMMON) | AMDGPU_IP_DEP(GMC),
 	},
 	{
 		.type = AMD_IP_BLOCK_TYPE_SMC,
@@ -2015,6 +2057,7 @@ static const struct amdgpu_ip_block_version mullins_ip_blocks[] =
 		.minor = 0,
 		.rev = 0,
 		.funcs = &amdgpu_pp_ip_funcs,
+		.deps = AMDGPU_IP_DEPS_BASE,
 	},
 	{
 		.type = AMD_IP_BLOCK_TYPE_DCE,
@@ -2022,6 +2065,7 @@ static const struct amdgpu_ip_block_version mullins_ip_blocks[] =
 		.minor = 3,
 		.rev = 0,
 		.funcs = &dce_v8_0_ip_funcs,
+		.deps = AMDGPU_IP_DEPS_DISPLAY,
 	},
 	{
 		.type = AMD_IP_BLOCK_TYPE_GFX,
@@ -2029,6 +2073,7 @@ static const struct amdgpu_ip_block_version mullins_ip_blocks[] =
 		.minor = 2,
 		.rev = 0,
 		.funcs = &gfx_v7_0_ip_funcs,
+		.deps = AMDGPU_IP_DEPS_ENGINE,
 	},
 	{
 		.type = AMD_IP_BLOCK_TYPE_SDMA,
@@ -2036,6 +2081,7 @@ static const struct amdgpu_ip_block_version mullins_ip_blocks[] =
 		.minor = 0,
 		.rev = 0,
 		.funcs = &cik_sdma_ip_funcs,
+		.deps = AMDGPU_IP_DEPS_ENGINE,
 	},
 	{
 		.type = AMD_IP_BLOCK_TYPE_UVD,
@@ -2043,6 +2089,7 @@ static const struct amdgpu_ip_block_version mullins_ip_blocks[] =
 		.minor = 2,
 		.rev = 0,
 		.funcs = &uvd_v4_2_ip_funcs,
+		.deps = AMDGPU_IP_DEPS_ENGINE,
 	},
 	{
 		.type = AMD_IP_BLOCK_TYPE_VCE,
@@ -2050,6 +2097,7 @@ static const struct amdgpu_ip_block_version mullins_ip_blocks[] =
 		.minor = 0,
 		.rev = 0,
 		.funcs = &vce_v2_0_ip_funcs,
+		.deps = AMDGPU_IP_DEPS_ENGINE,
 	},
 };
 
@@ -2069,6 +2117,7 @@ static const struct amdgpu_ip_block_version kaveri_ip_blocks[] =
 		.minor = 0,
 		.rev = 0,
 		.funcs = &gmc_v7_0_ip_funcs,
+		.deps = AMDGPU_IP_DEP(COMMON),
 	},
 	{
 		.type = AMD_IP_BLOCK_TYPE_IH,
@@ -2076,6 +2125,7 @@ static const struct amdgpu_ip_block_version kaveri_ip_blocks[] =
 		.minor = 0,
 		.rev = 0,
 		.funcs = &cik_ih_ip_funcs,
+		.deps = AMDGPU_IP_DEP(COMMON) | AMDGPU_IP_DEP(GMC),
 	},
 	{
 		.type = AMD_IP_BLOCK_TYPE_SMC,
@@ -2083,6 +2133,7 @@ static const struct amdgpu_ip_block_version kaveri_ip_blocks[] =
 		.minor = 0,
 		.rev = 0,
 		.funcs = &amdgpu_pp_ip_funcs,
+		.deps = AMDGPU_IP_DEPS_BASE,
 	},
 	{
 		.type = AMD_IP_BLOCK_TYPE_DCE,
@@ -2090,6 +2141,7 @@ static const struct amdgpu_ip_block_version kaveri_ip_blocks[] =
 		.minor = 1,
 		.rev = 0,
 		.funcs = &dce_v8_0_ip_funcs,
+		.deps = AMDGPU_IP_DEPS_DISPLAY,
 	},
 	{
 		.type = AMD_IP_BLOCK_TYPE_GFX,
@@ -2097,6 +2149,7 @@ static const struct amdgpu_ip_block_version kaveri_ip_blocks[] =
 		.minor = 1,
 		.rev = 0,
 		.funcs = &gfx_v7_0_ip_funcs,
+		.deps = AMDGPU_IP_DEPS_ENGINE,
 	},
 	{
 		.type = AMD_IP_BLOCK_TYPE_SDMA,
@@ -2104,6 +2157,7 @@ static const struct amdgpu_ip_block_version kaveri_ip_blocks[] =
 		.minor = 0,
 		.rev = 0,
 		.funcs = &cik_sdma_ip_funcs,
+		.deps = AMDGPU_IP_DEPS_ENGINE,
 	},
 	{
 		.type = AMD_IP_BLOCK_TYPE_UVD,
@@ -2111,6 +2165,7 @@ static const struct amdgpu_ip_block_version kaveri_ip_blocks[] =
 		.minor = 2,
 		.rev = 0,
 		.funcs = &uvd_v4_2_ip_funcs,
+		.deps = AMDGPU_IP_DEPS_ENGINE,
 	},
 	{
 		.type = AMD_IP_BLOCK_TYPE_VCE,
@@ -2118,6 +2173,7 @@ static const struct amdgpu_ip_block_version kaveri_ip_blocks[] =
 		.minor = 0,
 		.rev = 0,
 		.funcs = &vce_v2_0_ip_funcs,
+		.deps = AMDGPU_IP_DEPS_ENGINE,
 	},
 };
 
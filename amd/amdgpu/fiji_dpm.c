@@ -44,7 +44,7 @@ static int fiji_dpm_init_microcode(struct amdgpu_device *adev)
 	char fw_name[30] = "amdgpu/fiji_smc.bin";
 	int err;
 
-	err = request_firmware(&adev->pm.fw, fw_name, adev->dev);
+	err = amdgpu_ucode_request(adev, &adev->pm.fw, fw_name);
 	if (err)
 		goto out;
 	err = amdgpu_ucode_validate(adev->pm.fw);
@@ -52,7 +52,7 @@ static int fiji_dpm_init_microcode(struct amdgpu_device *adev)
 out:
 	if (err) {
 		DRM_ERROR("Failed to load firmware \"%s\"", fw_name);
-		release_firmware(adev->pm.fw);
+		amdgpu_ucode_release(adev->pm.fw);
 		adev->pm.fw = NULL;
 	}
 	return err;
@@ -74,7 +74,7 @@ static int fiji_dpm_sw_fini(void *handle)
 {
 	struct amdgpu_device *adev = (struct amdgpu_device *)handle;
 
-	release_firmware(adev->pm.fw);
+	amdgpu_ucode_release(adev->pm.fw);
 	adev->pm.fw = NULL;
 
 	return 0;
@@ -923,7 +923,7 @@ static int gfx_v7_0_init_microcode(struct amdgpu_device *adev)
 	}
 
 	snprintf(fw_name, sizeof(fw_name), "radeon/%s_pfp.bin", chip_name);
-	err = request_firmware(&adev->gfx.pfp_fw, fw_name, adev->dev);
+	err = amdgpu_ucode_request(adev, &adev->gfx.pfp_fw, fw_name);
 	if (err)
 		goto out;
 	err = amdgpu_ucode_validate(adev->gfx.pfp_fw);
@@ -931,7 +931,7 @@ static int gfx_v7_0_init_microcode(struct amdgpu_device *adev)
 		goto out;
 
 	snprintf(fw_name, sizeof(fw_name), "radeon/%s_me.bin", chip_name);
-	err = request_firmware(&adev->gfx.me_fw, fw_name, adev->dev);
+	err = amdgpu_ucode_request(adev, &adev->gfx.me_fw, fw_name);
 	if (err)
 		goto out;
 	err = amdgpu_ucode_validate(adev->gfx.me_fw);
@@ -939,7 +939,7 @@ static int gfx_v7_0_init_microcode(struct amdgpu_device *adev)
 		goto out;
 
 	snprintf(fw_name, sizeof(fw_name), "radeon/%s_ce.bin", chip_name);
-	err = request_firmware(&adev->gfx.ce_fw, fw_name, adev->dev);
+	err = amdgpu_ucode_request(adev, &adev->gfx.ce_fw, fw_name);
 	if (err)
 		goto out;
 	err = amdgpu_ucode_validate(adev->gfx.ce_fw);
@@ -947,7 +947,7 @@ static int gfx_v7_0_init_microcode(struct amdgpu_device *adev)
 		goto out;
 
 	snprintf(fw_name, sizeof(fw_name), "radeon/%s_mec.bin", chip_name);
-	err = request_firmware(&adev->gfx.mec_fw, fw_name, adev->dev);
+	err = amdgpu_ucode_request(adev, &adev->gfx.mec_fw, fw_name);
 	if (err)
 		goto out;
 	err = amdgpu_ucode_validate(adev->gfx.mec_fw);
@@ -956,7 +956,7 @@ static int gfx_v7_0_init_microcode(struct amdgpu_device *adev)
 
 	if (adev->asic_type == CHIP_KAVERI) {
 		snprintf(fw_name, sizeof(fw_name), "radeon/%s_mec2.bin", chip_name);
-		err = request_firmware(&adev->gfx.mec2_fw, fw_name, adev->dev);
+		err = amdgpu_ucode_request(adev, &adev->gfx.mec2_fw, fw_name);
 		if (err)
 			goto out;
 		err = amdgpu_ucode_validate(adev->gfx.mec2_fw);
@@ -965,7 +965,7 @@ static int gfx_v7_0_init_microcode(struct amdgpu_device *adev)
 	}
 
 	snprintf(fw_name, sizeof(fw_name), "radeon/%s_rlc.bin", chip_name);
-	err = request_firmware(&adev->gfx.rlc_fw, fw_name, adev->dev);
+	err = amdgpu_ucode_request(adev, &adev->gfx.rlc_fw, fw_name);
 	if (err)
 		goto out;
 	err = amdgpu_ucode_validate(adev->gfx.rlc_fw);
@@ -975,17 +975,17 @@ out:
 		printk(KERN_ERR
 		       "gfx7: Failed to load firmware \"%s\"\n",
 		       fw_name);
-		release_firmware(adev->gfx.pfp_fw);
+		amdgpu_ucode_release(adev->gfx.pfp_fw);
 		adev->gfx.pfp_fw = NULL;
-		release_firmware(adev->gfx.me_fw);
+		amdgpu_ucode_release(adev->gfx.me_fw);
 		adev->gfx.me_fw = NULL;
-		release_firmware(adev->gfx.ce_fw);
+		amdgpu_ucode_release(adev->gfx.ce_fw);
 		adev->gfx.ce_fw = NULL;
-		release_firmware(adev->gfx.mec_fw);
+		amdgpu_ucode_release(adev->gfx.mec_fw);
 		adev->gfx.mec_fw = NULL;
-		release_firmware(adev->gfx.mec2_fw);
+		amdgpu_ucode_release(adev->gfx.mec2_fw);
 		adev->gfx.mec2_fw = NULL;
-		release_firmware(adev->gfx.rlc_fw);
+		amdgpu_ucode_release(adev->gfx.rlc_fw);
 		adev->gfx.rlc_fw = NULL;
 	}
 	return err;
@@ -993,17 +993,17 @@ out:
 
 static void gfx_v7_0_free_microcode(struct amdgpu_device *adev)
 {
-	release_firmware(adev->gfx.pfp_fw);
+	amdgpu_ucode_release(adev->gfx.pfp_fw);
 	adev->gfx.pfp_fw = NULL;
-	release_firmware(adev->gfx.me_fw);
+	amdgpu_ucode_release(adev->gfx.me_fw);
 	adev->gfx.me_fw = NULL;
-	release_firmware(adev->gfx.ce_fw);
+	amdgpu_ucode_release(adev->gfx.ce_fw);
 	adev->gfx.ce_fw = NULL;
-	release_firmware(adev->gfx.mec_fw);
+	amdgpu_ucode_release(adev->gfx.mec_fw);
 	adev->gfx.mec_fw = NULL;
-	release_firmware(adev->gfx.mec2_fw);
+	amdgpu_ucode_release(adev->gfx.mec2_fw);
 	adev->gfx.mec2_fw = NULL;
-	release_firmware(adev->gfx.rlc_fw);
+	amdgpu_ucode_release(adev->gfx.rlc_fw);
 	adev->gfx.rlc_fw = NULL;
 }
 
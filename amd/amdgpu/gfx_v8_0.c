@@ -833,19 +833,19 @@ err1:
 
 
 static void gfx_v8_0_free_microcode(struct amdgpu_device *adev) {
-	release_firmware(adev->gfx.pfp_fw);
+	amdgpu_ucode_release(adev->gfx.pfp_fw);
 	adev->gfx.pfp_fw = NULL;
-	release_firmware(adev->gfx.me_fw);
+	amdgpu_ucode_release(adev->gfx.me_fw);
 	adev->gfx.me_fw = NULL;
-	release_firmware(adev->gfx.ce_fw);
+	amdgpu_ucode_release(adev->gfx.ce_fw);
 	adev->gfx.ce_fw = NULL;
-	release_firmware(adev->gfx.rlc_fw);
+	amdgpu_ucode_release(adev->gfx.rlc_fw);
 	adev->gfx.rlc_fw = NULL;
-	release_firmware(adev->gfx.mec_fw);
+	amdgpu_ucode_release(adev->gfx.mec_fw);
 	adev->gfx.mec_fw = NULL;
 	if ((adev->asic_type != CHIP_STONEY) &&
 	    (adev->asic_type != CHIP_TOPAZ))
-		release_firmware(adev->gfx.mec2_fw);
+		amdgpu_ucode_release(adev->gfx.mec2_fw);
 	adev->gfx.mec2_fw = NULL;
 
 	kfree(adev->gfx.rlc.register_list_format);
@@ -891,7 +891,7 @@ static int gfx_v8_0_init_microcode(struct amdgpu_device *adev)
 	}
 
 	snprintf(fw_name, sizeof(fw_name), "amdgpu/%s_pfp.bin", chip_name);
-	err = request_firmware(&adev->gfx.pfp_fw, fw_name, adev->dev);
+	err = amdgpu_ucode_request(adev, &adev->gfx.pfp_fw, fw_name);
 	if (err)
 		goto out;
 	err = amdgpu_ucode_validate(adev->gfx.pfp_fw);
@@ -902,7 +902,7 @@ static int gfx_v8_0_init_microcode(struct amdgpu_device *adev)
 	adev->gfx.pfp_feature_version = le32_to_cpu(cp_hdr->ucode_feature_version);
 
 	snprintf(fw_name, sizeof(fw_name), "amdgpu/%s_me.bin", chip_name);
-	err = request_firmware(&adev->gfx.me_fw, fw_name, adev->dev);
+	err = amdgpu_ucode_request(adev, &adev->gfx.me_fw, fw_name);
 	if (err)
 		goto out;
 	err = amdgpu_ucode_validate(adev->gfx.me_fw);
@@ -913,7 +913,7 @@ static int gfx_v8_0_init_microcode(struct amdgpu_device *adev)
 	adev->gfx.me_feature_version = le32_to_cpu(cp_hdr->ucode_feature_version);
 
 	snprintf(fw_name, sizeof(fw_name), "amdgpu/%s_ce.bin", chip_name);
-	err = request_firmware(&adev->gfx.ce_fw, fw_name, adev->dev);
+	err = amdgpu_ucode_request(adev, &adev->gfx.ce_fw, fw_name);
 	if (err)
 		goto out;
 	err = amdgpu_ucode_validate(adev->gfx.ce_fw);
@@ -924,7 +924,7 @@ static int gfx_v8_0_init_microcode(struct amdgpu_device *adev)
 	adev->gfx.ce_feature_version = le32_to_cpu(cp_hdr->ucode_feature_version);
 
 	snprintf(fw_name, sizeof(fw_name), "amdgpu/%s_rlc.bin", chip_name);
-	err = request_firmware(&adev->gfx.rlc_fw, fw_name, adev->dev);
+	err = amdgpu_ucode_request(adev, &adev->gfx.rlc_fw, fw_name);
 	if (err)
 		goto out;
 	err = amdgpu_ucode_validate(adev->gfx.rlc_fw);
@@ -973,7 +973,7 @@ static int gfx_v8_0_init_microcode(struct amdgpu_device *adev)
 		adev->gfx.rlc.register_restore[i] = le32_to_cpu(tmp[i]);
 
 	snprintf(fw_name, sizeof(fw_name), "amdgpu/%s_mec.bin", chip_name);
-	err = request_firmware(&adev->gfx.mec_fw, fw_name, adev->dev);
+	err = amdgpu_ucode_request(adev, &adev->gfx.mec_fw, fw_name);
 	if (err)
 		goto out;
 	err = amdgpu_ucode_validate(adev->gfx.mec_fw);
@@ -986,7 +986,7 @@ static int gfx_v8_0_init_microcode(struct amdgpu_device *adev)
 	if ((adev->asic_type != CHIP_STONEY) &&
 	    (adev->asic_type != CHIP_TOPAZ)) {
 		snprintf(fw_name, sizeof(fw_name), "amdgpu/%s_mec2.bin", chip_name);
-		err = request_firmware(&adev->gfx.mec2_fw, fw_name, adev->dev);
+		err = amdgpu_ucode_request(adev, &adev->gfx.mec2_fw, fw_name);
 		if (!err) {
 			err = amdgpu_ucode_validate(adev->gfx.mec2_fw);
 			if (err)
@@ -1055,17 +1055,17 @@ out:
 		dev_err(adev->dev,
 			"gfx8: Failed to load firmware \"%s\"\n",
 			fw_name);
-		release_firmware(adev->gfx.pfp_fw);
+		amdgpu_ucode_release(adev->gfx.pfp_fw);
 		adev->gfx.pfp_fw = NULL;
-		release_firmware(adev->gfx.me_fw);
+		amdgpu_ucode_release(adev->gfx.me_fw);
 		adev->gfx.me_fw = NULL;
-		release_firmware(adev->gfx.ce_fw);
+		amdgpu_ucode_release(adev->gfx.ce_fw);
 		adev->gfx.ce_fw = NULL;
-		release_firmware(adev->gfx.rlc_fw);
+		amdgpu_ucode_release(adev->gfx.rlc_fw);
 		adev->gfx.rlc_fw = NULL;
-		release_firmware(adev->gfx.mec_fw);
+		amdgpu_ucode_release(adev->gfx.mec_fw);
 		adev->gfx.mec_fw = NULL;
-		release_firmware(adev->gfx.mec2_fw);
+		amdgpu_ucode_release(adev->gfx.mec2_fw);
 		adev->gfx.mec2_fw = NULL;
 	}
 	return err;
@@ -224,7 +224,7 @@ static int gmc_v8_0_init_microcode(struct amdgpu_device *adev)
 	}
 
 	snprintf(fw_name, sizeof(fw_name), "amdgpu/%s_mc.bin", chip_name);
-	err = request_firmware(&adev->mc.fw, fw_name, adev->dev);
+	err = amdgpu_ucode_request(adev, &adev->mc.fw, fw_name);
 	if (err)
 		goto out;
 	err = amdgpu_ucode_validate(adev->mc.fw);
@@ -234,7 +234,7 @@ out:
 		printk(KERN_ERR
 		       "mc: Failed to load firmware \"%s\"\n",
 		       fw_name);
-		release_firmware(adev->mc.fw);
+		amdgpu_ucode_release(adev->mc.fw);
 		adev->mc.fw = NULL;
 	}
 	return err;
@@ -240,7 +240,7 @@ static void sdma_v3_0_free_microcode(struct amdgpu_device *adev)
 {
 	int i;
 	for (i = 0; i < adev->sdma.num_instances; i++) {
-		release_firmware(adev->sdma.instance[i].fw);
+		amdgpu_ucode_release(adev->sdma.instance[i].fw);
 		adev->sdma.instance[i].fw = NULL;
 	}
 }
@@ -292,7 +292,7 @@ static int sdma_v3_0_init_microcode(struct amdgpu_device *adev)
 			snprintf(fw_name, sizeof(fw_name), "amdgpu/%s_sdma.bin", chip_name);
 		else
 			snprintf(fw_name, sizeof(fw_name), "amdgpu/%s_sdma1.bin", chip_name);
-		err = request_firmware(&adev->sdma.instance[i].fw, fw_name, adev->dev);
+		err = amdgpu_ucode_request(adev, &adev->sdma.instance[i].fw, fw_name);
 		if (err)
 			goto out;
 		err = amdgpu_ucode_validate(adev->sdma.instance[i].fw);
@@ -319,7 +319,7 @@ out:
 		       "sdma_v3_0: Failed to load firmware \"%s\"\n",
 		       fw_name);
 		for (i = 0; i < adev->sdma.num_instances; i++) {
-			release_firmware(adev->sdma.instance[i].fw);
+			amdgpu_ucode_release(adev->sdma.instance[i].fw);
 			adev->sdma.instance[i].fw = NULL;
 		}
 	}
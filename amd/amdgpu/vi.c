@@ -792,6 +792,7 @@ static const struct amdgpu_ip_block_version topaz_ip_blocks[] =
 		.minor = 4,
 		.rev = 0,
 		.funcs = &gmc_v7_0_ip_funcs,
+		.deps = AMDGPU_IP_DEP(COMMON),
 	},
 	{
 		.type = AMD_IP_BLOCK_TYPE_IH,
@@ -799,6 +800,7 @@ static const struct amdgpu_ip_block_version topaz_ip_blocks[] =
 		.minor = 4,
 		.rev = 0,
 		.funcs = &iceland_ih_ip_funcs,
+		.deps = AMDGPU_IP_DEP(COMMON) | AMDGPU_IP_DEP(GMC),
 	},
 	{
 		.type = AMD_IP_BLOCK_TYPE_SMC,
@@ -806,6 +808,7 @@ static const struct amdgpu_ip_block_version topaz_ip_blocks[] =
 		.minor = 1,
 		.rev = 0,
 		.funcs = &amdgpu_pp_ip_funcs,
+		.deps = AMDGPU_IP_DEPS_BASE,
 	},
 	{
 		.type = AMD_IP_BLOCK_TYPE_GFX,
@@ -813,6 +816,7 @@ static const struct amdgpu_ip_block_version topaz_ip_blocks[] =
 		.minor = 0,
 		.rev = 0,
 		.funcs = &gfx_v8_0_ip_funcs,
+		.deps = AMDGPU_IP_DEPS_ENGINE,
 	},
 	{
 		.type = AMD_IP_BLOCK_TYPE_SDMA,
@@ -820,6 +824,7 @@ static const struct amdgpu_ip_block_version topaz_ip_blocks[] =
 		.minor = 4,
 		.rev = 0,
 		.funcs = &sdma_v2_4_ip_funcs,
+		.deps = AMDGPU_IP_DEPS_ENGINE,
 	},
 };
 
@@ -839,6 +844,7 @@ static const struct amdgpu_ip_block_version tonga_ip_blocks[] =
 		.minor = 0,
 		.rev = 0,
 		.funcs = &gmc_v8_0_ip_funcs,
+		.deps = AMDGPU_IP_DEP(COMMON),
 	},
 	{
 		.type = AMD_IP_BLOCK_TYPE_IH,
@@ -846,6 +852,7 @@ static const struct amdgpu_ip_block_version tonga_ip_blocks[] =
 		.minor = 0,
 		.rev = 0,
 		.funcs = &tonga_ih_ip_funcs,
+		.deps = AMDGPU_IP_DEP(COMMON) | AMDGPU_IP_DEP(GMC),
 	},
 	{
 		.type = AMD_IP_BLOCK_TYPE_SMC,
@@ -853,6 +860,7 @@ static const struct amdgpu_ip_block_version tonga_ip_blocks[] =
 		.minor = 1,
 		.rev = 0,
 		.funcs = &amdgpu_pp_ip_funcs,
+		.deps = AMDGPU_IP_DEPS_BASE,
 	},
 	{
 		.type = AMD_IP_BLOCK_TYPE_DCE,
@@ -860,6 +868,7 @@ static const struct amdgpu_ip_block_version tonga_ip_blocks[] =
 		.minor = 0,
 		.rev = 0,
 		.funcs = &dce_v10_0_ip_funcs,
+		.deps = AMDGPU_IP_DEPS_DISPLAY,
 	},
 	{
 		.type = AMD_IP_BLOCK_TYPE_GFX,
@@ -867,6 +876,7 @@ static const struct amdgpu_ip_block_version tonga_ip_blocks[] =
 		.minor = 0,
 		.rev = 0,
 		.funcs = &gfx_v8_0_ip_funcs,
+		.deps = AMDGPU_IP_DEPS_ENGINE,
 	},
 	{
 		.type = AMD_IP_BLOCK_TYPE_SDMA,
@@ -874,6 +884,7 @@ static const struct amdgpu_ip_block_version tonga_ip_blocks[] =
 		.minor = 0,
 		.rev = 0,
 		.funcs = &sdma_v3_0_ip_funcs,
+		.deps = AMDGPU_IP_DEPS_ENGINE,
 	},
 	{
 		.type = AMD_IP_BLOCK_TYPE_UVD,
@@ -881,6 +892,7 @@ static const struct amdgpu_ip_block_version tonga_ip_blocks[] =
 		.minor = 0,
 		.rev = 0,
 		.funcs = &uvd_v5_0_ip_funcs,
+		.deps = AMDGPU_IP_DEPS_ENGINE,
 	},
 	{
 		.type = AMD_IP_BLOCK_TYPE_VCE,
@@ -888,6 +900,7 @@ static const struct amdgpu_ip_block_version tonga_ip_blocks[] =
 		.minor = 0,
 		.rev = 0,
 		.funcs = &vce_v3_0_ip_funcs,
+		.deps = AMDGPU_IP_DEPS_ENGINE,
 	},
 };
 
@@ -907,6 +920,7 @@ static const struct amdgpu_ip_block_version fiji_ip_blocks[] =
 		.minor = 5,
 		.rev = 0,
 		.funcs = &gmc_v8_0_ip_funcs,
+		.deps = AMDGPU_IP_DEP(COMMON),
 	},
 	{
 		.type = AMD_IP_BLOCK_TYPE_IH,
@@ -914,6 +928,7 @@ static const struct amdgpu_ip_block_version fiji_ip_blocks[] =
 		.minor = 0,
 		.rev = 0,
 		.funcs = &tonga_ih_ip_funcs,
+		.deps = AMDGPU_IP_DEP(COMMON) | AMDGPU_IP_DEP(GMC),
 	},
 	{
 		.type = AMD_IP_BLOCK_TYPE_SMC,
@@ -921,6 +936,7 @@ static const struct amdgpu_ip_block_version fiji_ip_blocks[] =
 		.minor = 1,
 		.rev = 0,
 		.funcs = &amdgpu_pp_ip_funcs,
+		.deps = AMDGPU_IP_DEPS_BASE,
 	},
 	{
 		.type = AMD_IP_BLOCK_TYPE_DCE,
@@ -928,6 +944,7 @@ static const struct amdgpu_ip_block_version fiji_ip_blocks[] =
 		.minor = 1,
 		.rev = 0,
 		.funcs = &dce_v10_0_ip_funcs,
+		.deps = AMDGPU_IP_DEPS_DISPLAY,
 	},
 	{
 		.type = AMD_IP_BLOCK_TYPE_GFX,
@@ -935,6 +952,7 @@ static const struct amdgpu_ip_block_version fiji_ip_blocks[] =
 		.minor = 0,
 		.rev = 0,
 		.funcs = &gfx_v8_0_ip_funcs,
+		.deps = AMDGPU_IP_DEPS_ENGINE,
 	},
 	{
 		.type = AMD_IP_BLOCK_TYPE_SDMA,
@@ -942,6 +960,7 @@ static const struct amdgpu_ip_block_version fiji_ip_blocks[] =
 		.minor = 0,
 		.rev = 0,
 		.funcs = &sdma_v3_0_ip_funcs,
+		.deps = AMDGPU_IP_DEPS_ENGINE,
 	},
 	{
 		.type = AMD_IP_BLOCK_TYPE_UVD,
@@ -949,6 +968,7 @@ static const struct amdgpu_ip_block_version fiji_ip_blocks[] =
 		.minor = 0,
 		.rev = 0,
 		.funcs = &uvd_v6_0_ip_funcs,
+		.deps = AMDGPU_IP_DEPS_ENGINE,
 	},
 	{
 		.type = AMD_IP_BLOCK_TYPE_VCE,
@@ -956,6 +976,7 @@ static const struct amdgpu_ip_block_version fiji_ip_blocks[] =
 		.minor = 0,
 		.rev = 0,
 		.funcs = &vce_v3_0_ip_funcs,
+		.deps = AMDGPU_IP_DEPS_ENGINE,
 	},
 };
 
@@ -975,6 +996,7 @@ static const struct amdgpu_ip_block_version polaris11_ip_blocks[] =
 		.minor = 1,
 		.rev = 0,
 		.funcs = &gmc_v8_0_ip_funcs,
+		.deps = AMDGPU_IP_DEP(COMMON),
 	},
 	{
 		.type = AMD_IP_BLOCK_TYPE_IH,
@@ -982,6 +1004,7 @@ static const struct amdgpu_ip_block_version polaris11_ip_blocks[] =
 		.minor = 1,
 		.rev = 0,
 		.funcs = &tonga_ih_ip_funcs,
+		.deps = AMDGPU_IP_DEP(COMMON) | AMDGPU_IP_DEP(GMC),
 	},
 	{
 		.type = AMD_IP_BLOCK_TYPE_SMC,
@@ -989,6 +1012,7 @@ static const struct amdgpu_ip_block_version polaris11_ip_blocks[] =
 		.minor = 2,
 		.rev = 0,
 		.funcs = &amdgpu_pp_ip_funcs,
+		.deps = AMDGPU_IP_DEPS_BASE,
 	},
 	{
 		.type = AMD_IP_BLOCK_TYPE_DCE,
@@ -996,6 +1020,7 @@ static const struct amdgpu_ip_block_version polaris11_ip_blocks[] =
 		.minor = 2,
 		.rev = 0,
 		.funcs = &dce_v11_0_ip_funcs,
+		.deps = AMDGPU_IP_DEPS_DISPLAY,
 	},
 	{
 		.type = AMD_IP_BLOCK_TYPE_GFX,
@@ -1003,6 +1028,7 @@ static const struct amdgpu_ip_block_version polaris11_ip_blocks[] =
 		.minor = 0,
 		.rev = 0,
 		.funcs = &gfx_v8_0_ip_funcs,
+		.deps = AMDGPU_IP_DEPS_ENGINE,
 	},
 	{
 		.type = AMD_IP_BLOCK_TYPE_SDMA,
@@ -1010,6 +1036,7 @@ static const struct amdgpu_ip_block_version polaris11_ip_blocks[] =
 		.minor = 1,
 		.rev = 0,
 		.funcs = &sdma_v3_0_ip_funcs,
+		.deps = AMDGPU_IP_DEPS_ENGINE,
 	},
 	{
 		.type = AMD_IP_BLOCK_TYPE_UVD,
@@ -1017,6 +1044,7 @@ static const struct amdgpu_ip_block_version polaris11_ip_blocks[] =
 		.minor = 3,
 		.rev = 0,
 		.funcs = &uvd_v6_0_ip_funcs,
+		.deps = AMDGPU_IP_DEPS_ENGINE,
 	},
 	{
 		.type = AMD_IP_BLOCK_TYPE_VCE,
@@ -1024,6 +1052,7 @@ static const struct amdgpu_ip_block_version polaris11_ip_blocks[] =
 		.minor = 4,
 		.rev = 0,
 		.funcs = &vce_v3_0_ip_funcs,
+		.deps = AMDGPU_IP_DEPS_ENGINE,
 	},
 };
 
@@ -1043,6 +1072,7 @@ static const struct amdgpu_ip_block_version cz_ip_blocks[] =
 		.minor = 0,
 		.rev = 0,
 		.funcs = &gmc_v8_0_ip_funcs,
+		.deps = AMDGPU_IP_DEP(COMMON),
 	},
 	{
 		.type = AMD_IP_BLOCK_TYPE_IH,
@@ -1050,13 +1080,15 @@ static const struct amdgpu_ip_block_version cz_ip_blocks[] =
 		.minor = 0,
 		.rev = 0,
 		.funcs = &cz_ih_ip_funcs,
+		.deps = AMDGPU_IP_DEP(COMMON) | AMDGPU_IP_DEP(GMC),
 	},
 	{
 		.type = AMD_IP_BLOCK_TYPE_SMC,
 		.major = 8,
 		.minor = 0,
 		.rev = 0,
-		.funcs = &amdgpu_pp_ip_funcs
+		.funcs = &amdgpu_pp_ip_funcs,
+		.deps = AMDGPU_IP_DEPS_BASE,
 	},
 	{
 		.type = AMD_IP_BLOCK_TYPE_DCE,
@@ -1064,6 +1096,7 @@ static const struct amdgpu_ip_block_version cz_ip_blocks[] =
 		.minor = 0,
 		.rev = 0,
 		.funcs = &dce_v11_0_ip_funcs,
+		.deps = AMDGPU_IP_DEPS_DISPLAY,
 	},
 	{
 		.type = AMD_IP_BLOCK_TYPE_GFX,
@@ -1071,6 +1104,7 @@ static const struct amdgpu_ip_block_version cz_ip_blocks[] =
 		.minor = 0,
 		.rev = 0,
 		.funcs = &gfx_v8_0_ip_funcs,
+		.deps = AMDGPU_IP_DEPS_ENGINE,
 	},
 	{
 		.type = AMD_IP_BLOCK_TYPE_SDMA,
@@ -1078,6 +1112,7 @@ static const struct amdgpu_ip_block_version cz_ip_blocks[] =
 		.minor = 0,
 		.rev = 0,
 		.funcs = &sdma_v3_0_ip_funcs,
+		.deps = AMDGPU_IP_DEPS_ENGINE,
 	},
 	{
 		.type = AMD_IP_BLOCK_TYPE_UVD,
@@ -1085,6 +1120,7 @@ static const struct amdgpu_ip_block_version cz_ip_blocks[] =
 		.minor = 0,
 		.rev = 0,
 		.funcs = &uvd_v6_0_ip_funcs,
+		.deps = AMDGPU_IP_DEPS_ENGINE,
 	},
 	{
 		.type = AMD_IP_BLOCK_TYPE_VCE,
@@ -1092,6 +1128,7 @@ static const struct amdgpu_ip_block_version cz_ip_blocks[] =
 		.minor = 0,
 		.rev = 0,
 		.funcs = &vce_v3_0_ip_funcs,
+		.deps = AMDGPU_IP_DEPS_ENGINE,
 	},
 #if defined(CONFIG_DRM_AMD_ACP)
 	{
@@ -1100,6 +1137,7 @@ static const struct amdgpu_ip_block_version cz_ip_blocks[] =
 		.minor = 2,
 		.rev = 0,
 		.funcs = &acp_ip_funcs,
+		.deps = AMDGPU_IP_DEPS_ENGINE,
 	},
 #endif
 };
@@ -1125,6 +1163,7 @@ static const struct amdgpu_ip_block_version cz_ip_blocks_dal[] =
 		.minor = 0,
 		.rev = 0,
 		.funcs = &gmc_v8_0_ip_funcs,
+		.deps = AMDGPU_IP_DEP(COMMON),
 	},
 	{
 		.type = AMD_IP_BLOCK_TYPE_IH,
@@ -1132,6 +1171,7 @@ static const struct amdgpu_ip_block_version cz_ip_blocks_dal[] =
 		.minor = 0,
 		.rev = 0,
 		.funcs = &cz_ih_ip_funcs,
+		.deps = AMDGPU_IP_DEP(COMMON) | AMDGPU_IP_DEP(GMC),
 	},
 	{
 		.type = AMD_IP_BLOCK_TYPE_SMC,
@@ -1139,6 +1179,7 @@ static const struct amdgpu_ip_block_version cz_ip_blocks_dal[] =
 		.minor = 0,
 		.rev = 0,
 		.funcs = &amdgpu_pp_ip_funcs,
+		.deps = AMDGPU_IP_DEPS_BASE,
 	},
 	{
 		.type = AMD_IP_BLOCK_TYPE_DCE,
@@ -1146,6 +1187,7 @@ static const struct amdgpu_ip_block_version cz_ip_blocks_dal[] =
 		.minor = 0,
 		.rev = 0,
 		.funcs = &amdgpu_dm_funcs,
+		.deps = AMDGPU_IP_DEPS_DISPLAY,
 	},
 	{
 		.type = AMD_IP_BLOCK_TYPE_GFX,
@@ -1153,6 +1195,7 @@ static const struct amdgpu_ip_block_version cz_ip_blocks_dal[] =
 		.minor = 0,
 		.rev = 0,
 		.funcs = &gfx_v8_0_ip_funcs,
+		.deps = AMDGPU_IP_DEPS_ENGINE,
 	},
 	{
 		.type = AMD_IP_BLOCK_TYPE_SDMA,
@@ -1160,6 +1203,7 @@ static const struct amdgpu_ip_block_version cz_ip_blocks_dal[] =
 		.minor = 0,
 		.rev = 0,
 		.funcs = &sdma_v3_0_ip_funcs,
+		.deps = AMDGPU_IP_DEPS_ENGINE,
 	},
 	{
 		.type = AMD_IP_BLOCK_TYPE_UVD,
@@ -1167,6 +1211,7 @@ static const struct amdgpu_ip_block_version cz_ip_blocks_dal[] =
 		.minor = 0,
 		.rev = 0,
 		.funcs = &uvd_v6_0_ip_funcs,
+		.deps = AMDGPU_IP_DEPS_ENGINE,
 	},
 	{
 		.type = AMD_IP_BLOCK_TYPE_VCE,
@@ -1174,6 +1219,7 @@ static const struct amdgpu_ip_block_version cz_ip_blocks_dal[] =
 		.minor = 0,
 		.rev = 0,
 		.funcs = &vce_v3_0_ip_funcs,
+		.deps = AMDGPU_IP_DEPS_ENGINE,
 	},
 #if defined(CONFIG_DRM_AMD_ACP)
 	{
@@ -1182,6 +1228,7 @@ static const struct amdgpu_ip_block_version cz_ip_blocks_dal[] =
 		.minor = 2,
 		.rev = 0,
 		.funcs = &acp_ip_funcs,
+		.deps = AMDGPU_IP_DEPS_ENGINE,
 	},
 #endif
 };
@@ -1202,6 +1249,7 @@ static const struct amdgpu_ip_block_version polaris11_ip_blocks_dal[] =
 		.minor = 1,
 		.rev = 0,
 		.funcs = &gmc_v8_0_ip_funcs,
+		.deps = AMDGPU_IP_DEP(COMMON),
 	},
 	{
 		.type = AMD_IP_BLOCK_TYPE_IH,
@@ -1209,6 +1257,7 @@ static const struct amdgpu_ip_block_version polaris11_ip_blocks_dal[] =
 		.minor = 1,
 		.rev = 0,
 		.funcs = &tonga_ih_ip_funcs,
+		.deps = AMDGPU_IP_DEP(COMMON) | AMDGPU_IP_DEP(GMC),
 	},
 	{
 		.type = AMD_IP_BLOCK_TYPE_SMC,
@@ -1217,6 +1266,7 @@ static const struct amdgpu_ip_block_version polaris11_ip_blocks_dal[] =
 		.rev = 0,
 		/* To Do */
 		.funcs = &amdgpu_pp_ip_funcs,
+		.deps = AMDGPU_IP_DEPS_BASE,
 	},
 	{
 		.type = AMD_IP_BLOCK_TYPE_DCE,
@@ -1224,6 +1274,7 @@ static const struct amdgpu_ip_block_version polaris11_ip_blocks_dal[] =
 		.minor = 2,
 		.rev = 0,
 		.funcs = &amdgpu_dm_funcs,
+		.deps = AMDGPU_IP_DEPS_DISPLAY,
 	},
 	{
 		.type = AMD_IP_BLOCK_TYPE_GFX,
@@ -1231,6 +1282,7 @@ static const struct amdgpu_ip_block_version polaris11_ip_blocks_dal[] =
 		.minor = 0,
 		.rev = 0,
 		.funcs = &gfx_v8_0_ip_funcs,
+		.deps = AMDGPU_IP_DEPS_ENGINE,
 	},
 	{
 		.type = AMD_IP_BLOCK_TYPE_SDMA,
@@ -1238,6 +1290,7 @@ static const struct amdgpu_ip_block_version polaris11_ip_blocks_dal[] =
 		.minor = 1,
 		.rev = 0,
 		.funcs = &sdma_v3_0_ip_funcs,
+		.deps = AMDGPU_IP_DEPS_ENGINE,
 	},
 	{
 		.type = AMD_IP_BLOCK_TYPE_UVD,
@@ -1245,6 +1298,7 @@ static const struct amdgpu_ip_block_version polaris11_ip_blocks_dal[] =
 		.minor = 3,
 		.rev = 0,
 		.funcs = &uvd_v6_0_ip_funcs,
+		.deps = AMDGPU_IP_DEPS_ENGINE,
 	},
 	{
 		.type = AMD_IP_BLOCK_TYPE_VCE,
@@ -1252,6 +1306,7 @@ static const struct amdgpu_ip_block_version polaris11_ip_blocks_dal[] =
 		.minor = 4,
 		.rev = 0,
 		.funcs = &vce_v3_0_ip_funcs,
+		.deps = AMDGPU_IP_DEPS_ENGINE,
 	},
 };
 
@@ -1271,6 +1326,7 @@ static const struct amdgpu_ip_block_version tonga_ip_blocks_dal[] =
 		.minor = 0,
 		.rev = 0,
 		.funcs = &gmc_v8_0_ip_funcs,
+		.deps = AMDGPU_IP_DEP(COMMON),
 	},
 	{
 		.type = AMD_IP_BLOCK_TYPE_IH,
@@ -1278,6 +1334,7 @@ static const struct amdgpu_ip_block_version tonga_ip_blocks_dal[] =
 		.minor = 0,
 		.rev = 0,
 		.funcs = &tonga_ih_ip_funcs,
+		.deps = AMDGPU_IP_DEP(COMMON) | AMDGPU_IP_DEP(GMC),
 	},
 	{
 		.type = AMD_IP_BLOCK_TYPE_SMC,
@@ -1285,6 +1342,7 @@ static const struct amdgpu_ip_block_version tonga_ip_blocks_dal[] =
 		.minor = 1,
 		.rev = 0,
 		.funcs = &amdgpu_pp_ip_funcs,
+		.deps = AMDGPU_IP_DEPS_BASE,
 	},
 	{
 		.type = AMD_IP_BLOCK_TYPE_DCE,
@@ -1292,6 +1350,7 @@ static const struct amdgpu_ip_block_version tonga_ip_blocks_dal[] =
 		.minor = 0,
 		.rev = 0,
 		.funcs = &amdgpu_dm_funcs,
+		.deps = AMDGPU_IP_DEPS_DISPLAY,
 	},
 	{
 		.type = AMD_IP_BLOCK_TYPE_GFX,
@@ -1299,6 +1358,7 @@ static const struct amdgpu_ip_block_version tonga_ip_blocks_dal[] =
 		.minor = 0,
 		.rev = 0,
 		.funcs = &gfx_v8_0_ip_funcs,
+		.deps = AMDGPU_IP_DEPS_ENGINE,
 	},
 	{
 		.type = AMD_IP_BLOCK_TYPE_SDMA,
@@ -1306,6 +1366,7 @@ static const struct amdgpu_ip_block_version tonga_ip_blocks_dal[] =
 		.minor = 0,
 		.rev = 0,
 		.funcs = &sdma_v3_0_ip_funcs,
+		.deps = AMDGPU_IP_DEPS_ENGINE,
 	},
 	{
 		.type = AMD_IP_BLOCK_TYPE_UVD,
@@ -1313,6 +1374,7 @@ static const struct amdgpu_ip_block_version tonga_ip_blocks_dal[] =
 		.minor = 0,
 		.rev = 0,
 		.funcs = &uvd_v5_0_ip_funcs,
+		.deps = AMDGPU_IP_DEPS_ENGINE,
 	},
 	{
 		.type = AMD_IP_BLOCK_TYPE_VCE,
@@ -1320,6 +1382,7 @@ static const struct amdgpu_ip_block_version tonga_ip_blocks_dal[] =
 		.minor = 0,
 		.rev = 0,
 		.funcs = &vce_v3_0_ip_funcs,
+		.deps = AMDGPU_IP_DEPS_ENGINE,
 	},
 };
 
@@ -1339,6 +1402,7 @@ static const struct amdgpu_ip_block_version fiji_ip_blocks_dal[] =
 		.minor = 5,
 		.rev = 0,
 		.funcs = &gmc_v8_0_ip_funcs,
+		.deps = AMDGPU_IP_DEP(COMMON),
 	},
 	{
 		.type = AMD_IP_BLOCK_TYPE_IH,
@@ -1346,6 +1410,7 @@ static const struct amdgpu_ip_block_version fiji_ip_blocks_dal[] =
 		.minor = 0,
 		.rev = 0,
 		.funcs = &tonga_ih_ip_funcs,
+		.deps = AMDGPU_IP_DEP(COMMON) | AMDGPU_IP_DEP(GMC),
 	},
 	{
 		.type = AMD_IP_BLOCK_TYPE_SMC,
@@ -1353,6 +1418,7 @@ static const struct amdgpu_ip_block_version fiji_ip_blocks_dal[] =
 		.minor = 1,
 		.rev = 0,
 		.funcs = &amdgpu_pp_ip_funcs,
+		.deps = AMDGPU_IP_DEPS_BASE,
 	},
 	{
 		.type = AMD_IP_BLOCK_TYPE_DCE,
@@ -1360,6 +1426,7 @@ static const struct amdgpu_ip_block_version fiji_ip_blocks_dal[] =
 		.minor = 1,
 		.rev = 0,
 		.funcs = &amdgpu_dm_funcs,
+		.deps = AMDGPU_IP_DEPS_DISPLAY,
 	},
 	{
 		.type = AMD_IP_BLOCK_TYPE_GFX,
@@ -1367,6 +1434,7 @@ static const struct amdgpu_ip_block_version fiji_ip_blocks_dal[] =
 		.minor = 0,
 		.rev = 0,
 		.funcs = &gfx_v8_0_ip_funcs,
+		.deps = AMDGPU_IP_DEPS_ENGINE,
 	},
 	{
 		.type = AMD_IP_BLOCK_TYPE_SDMA,
@@ -1374,6 +1442,7 @@ static const struct amdgpu_ip_block_version fiji_ip_blocks_dal[] =
 		.minor = 0,
 		.rev = 0,
 		.funcs = &sdma_v3_0_ip_funcs,
+		.deps = AMDGPU_IP_DEPS_ENGINE,
 	},
 	{
 		.type = AMD_IP_BLOCK_TYPE_UVD,
@@ -1381,6 +1450,7 @@ static const struct amdgpu_ip_block_version fiji_ip_blocks_dal[] =
 		.minor = 0,
 		.rev = 0,
 		.funcs = &uvd_v6_0_ip_funcs,
+		.deps = AMDGPU_IP_DEPS_ENGINE,
 	},
 	{
 		.type = AMD_IP_BLOCK_TYPE_VCE,
@@ -1388,6 +1458,7 @@ static const struct amdgpu_ip_block_version fiji_ip_blocks_dal[] =
 		.minor = 0,
 		.rev = 0,
 		.funcs = &vce_v3_0_ip_funcs,
+		.deps = AMDGPU_IP_DEPS_ENGINE,
 	},
 };
 #endif
@@ -60,7 +60,17 @@ static void cik_event_interrupt_wq(struct kfd_dev *dev,
 		kfd_signal_hw_exception_event(pasid);
 }
 
+static unsigned int cik_event_interrupt_pasid(struct kfd_dev *dev,
+					const uint32_t *ih_ring_entry)
+{
+	const struct cik_ih_ring_entry *ihre =
+			(const struct cik_ih_ring_entry *)ih_ring_entry;
+
+	return (ihre->ring_id & 0xffff0000) >> 16;
+}
+
 const struct kfd_event_interrupt_class event_interrupt_class_cik = {
 	.interrupt_isr = cik_event_interrupt_isr,
 	.interrupt_wq = cik_event_interrupt_wq,
+	.interrupt_pasid = cik_event_interrupt_pasid,
 };
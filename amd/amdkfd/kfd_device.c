@@ -24,6 +24,8 @@
 #include <linux/bsearch.h>
 #include <linux/pci.h>
 #include <linux/slab.h>
+#include <linux/vmalloc.h>
+#include <linux/log2.h>
 #include "kfd_priv.h"
 #include "kfd_device_queue_manager.h"
 #include "kfd_pm4_headers.h"
@@ -126,6 +128,7 @@ struct kfd_dev *kgd2kfd_probe(struct kgd_dev *kgd,
 	kfd->pdev = pdev;
 	kfd->init_complete = false;
 	kfd->kfd2kgd = f2g;
+	kfd->numa_node = dev_to_node(&pdev->dev);
 
 	mutex_init(&kfd->doorbell_mutex);
 	memset(&kfd->doorbell_available_index, 0,
@@ -232,9 +235,11 @@ bool kgd2kfd_device_init(struct kfd_dev *kfd,
 
 	/*
 	 * calculate max size of runlist packet.
-	 * There can be only 2 packets at once
+	 * There can be only 2 packets at once and the sub-allocator rounds
+	 * them up to a power of two
 	 */
-	size += (KFD_MAX_NUM_OF_PROCESSES * sizeof(struct pm4_map_process) +
+	size += roundup_pow_of_two(KFD_MAX_NUM_OF_PROCESSES *
+			sizeof(struct pm4_map_process) +
 		max_num_of_queues_per_device *
 		sizeof(struct pm4_map_queues) + sizeof(struct pm4_runlist)) * 2;
 
@@ -392,17 +397,59 @@ void kgd2kfd_interrupt(struct kfd_dev *kfd, const void *ih_ring_entry)
 	spin_lock(&kfd->interrupt_lock);
 
 	if (kfd->interrupts_active
-	    && interrupt_is_wanted(kfd, ih_ring_entry)
-	    && enqueue_ih_ring_entry(kfd, ih_ring_entry))
-		schedule_work(&kfd->interrupt_work);
+	    && interrupt_is_wanted(kfd, ih_ring_entry))
+		enqueue_ih_ring_entry(kfd, ih_ring_entry);
 
 	spin_unlock(&kfd->interrupt_lock);
 }
 
+/*
+ * The GTT sub-allocator is a binary buddy allocator over fixed size chunks.
+ * Allocations are rounded up to a power of two number of chunks and served
+ * from the smallest free block that fits, splitting it as needed. Freed
+ * blocks are merged with their buddy while it is free as well. Both take
+ * O(log n) steps, so the lock is held briefly even when the area is
+ * fragmented. kfd_mem_obj descriptors come from a dedicated slab.
+ */
+static struct kmem_cache *kfd_mem_obj_slab;
+
+int kfd_gtt_sa_cache_init(void)
+{
+	kfd_mem_obj_slab = kmem_cache_create("kfd_mem_obj",
+					sizeof(struct kfd_mem_obj), 0,
+					SLAB_HWCACHE_ALIGN, NULL);
+	if (!kfd_mem_obj_slab)
+		return -ENOMEM;
+
+	return 0;
+}
+
+void kfd_gtt_sa_cache_fini(void)
+{
+	kmem_cache_destroy(kfd_mem_obj_slab);
+}
+
+static void kfd_gtt_sa_add_free_block(struct kfd_dev *kfd,
+					unsigned int start,
+					unsigned int order)
+{
+	struct kfd_gtt_sa_block *block = &kfd->gtt_sa_blocks[start];
+
+	block->order = order;
+	block->free = true;
+	list_add(&block->list, &kfd->gtt_sa_free_list[order]);
+}
+
+static void kfd_gtt_sa_remove_free_block(struct kfd_gtt_sa_block *block)
+{
+	block->free = false;
+	list_del(&block->list);
+}
+
 static int kfd_gtt_sa_init(struct kfd_dev *kfd, unsigned int buf_size,
 				unsigned int chunk_size)
 {
-	unsigned int num_of_bits;
+	unsigned int start, order;
 
 	BUG_ON(!kfd);
 	BUG_ON(!kfd->gtt_mem);
@@ -413,16 +460,32 @@ static int kfd_gtt_sa_init(struct kfd_dev *kfd, unsigned int buf_size,
 	kfd->gtt_sa_chunk_size = chunk_size;
 	kfd->gtt_sa_num_of_chunks = buf_size / chunk_size;
 
-	num_of_bits = kfd->gtt_sa_num_of_chunks / BITS_PER_BYTE;
-	BUG_ON(num_of_bits == 0);
+	kfd->gtt_sa_blocks = vzalloc(kfd->gtt_sa_num_of_chunks *
+					sizeof(struct kfd_gtt_sa_block));
+	if (!kfd->gtt_sa_blocks)
+		return -ENOMEM;
 
-	kfd->gtt_sa_bitmap = kzalloc(num_of_bits, GFP_KERNEL);
+	for (order = 0; order <= KFD_GTT_SA_MAX_ORDER; order++)
+		INIT_LIST_HEAD(&kfd->gtt_sa_free_list[order]);
 
-	if (!kfd->gtt_sa_bitmap)
-		return -ENOMEM;
+	/*
+	 * The area is not a power of two number of chunks in general, so
+	 * seed the free lists with the largest naturally aligned blocks that
+	 * cover it.
+	 */
+	for (start = 0; start < kfd->gtt_sa_num_of_chunks;
+			start += 1 << order) {
+		order = start ? min_t(unsigned int, __ffs(start),
+					KFD_GTT_SA_MAX_ORDER) :
+				KFD_GTT_SA_MAX_ORDER;
+		while (start + (1 << order) > kfd->gtt_sa_num_of_chunks)
+			order--;
+
+		kfd_gtt_sa_add_free_block(kfd, start, order);
+	}
 
-	pr_debug("kfd: gtt_sa_num_of_chunks = %d, gtt_sa_bitmap = %p\n",
-			kfd->gtt_sa_num_of_chunks, kfd->gtt_sa_bitmap);
+	pr_debug("kfd: gtt_sa_num_of_chunks = %d, gtt_sa_blocks = %p\n",
+			kfd->gtt_sa_num_of_chunks, kfd->gtt_sa_blocks);
 
 	mutex_init(&kfd->gtt_sa_lock);
 
@@ -433,7 +496,7 @@ static int kfd_gtt_sa_init(struct kfd_dev *kfd, unsigned int buf_size,
 static void kfd_gtt_sa_fini(struct kfd_dev *kfd)
 {
 	mutex_destroy(&kfd->gtt_sa_lock);
-	kfree(kfd->gtt_sa_bitmap);
+	vfree(kfd->gtt_sa_blocks);
 }
 
 static inline uint64_t kfd_gtt_sa_calc_gpu_addr(uint64_t start_addr,
@@ -453,7 +516,8 @@ static inline uint32_t *kfd_gtt_sa_calc_cpu_addr(void *start_addr,
 int kfd_gtt_sa_allocate(struct kfd_dev *kfd, unsigned int size,
 			struct kfd_mem_obj **mem_obj)
 {
-	unsigned int found, start_search, cur_size;
+	struct kfd_gtt_sa_block *block;
+	unsigned int order, cur_order, found;
 
 	BUG_ON(!kfd);
 
@@ -463,31 +527,47 @@ int kfd_gtt_sa_allocate(struct kfd_dev *kfd, unsigned int size,
 	if (size > kfd->gtt_sa_num_of_chunks * kfd->gtt_sa_chunk_size)
 		return -ENOMEM;
 
-	*mem_obj = kmalloc(sizeof(struct kfd_mem_obj), GFP_KERNEL);
+	order = order_base_2(DIV_ROUND_UP(size, kfd->gtt_sa_chunk_size));
+	if (order > KFD_GTT_SA_MAX_ORDER)
+		return -ENOMEM;
+
+	*mem_obj = kmem_cache_alloc(kfd_mem_obj_slab, GFP_KERNEL);
 	if ((*mem_obj) == NULL)
 		return -ENOMEM;
 
 	pr_debug("kfd: allocated mem_obj = %p for size = %d\n", *mem_obj, size);
 
-	start_search = 0;
-
 	mutex_lock(&kfd->gtt_sa_lock);
 
-kfd_gtt_restart_search:
-	/* Find the first chunk that is free */
-	found = find_next_zero_bit(kfd->gtt_sa_bitmap,
-					kfd->gtt_sa_num_of_chunks,
-					start_search);
-
-	pr_debug("kfd: found = %d\n", found);
+	/* Find the smallest free block that fits */
+	for (cur_order = order; cur_order <= KFD_GTT_SA_MAX_ORDER; cur_order++)
+		if (!list_empty(&kfd->gtt_sa_free_list[cur_order]))
+			break;
 
-	/* If there wasn't any free chunk, bail out */
-	if (found == kfd->gtt_sa_num_of_chunks)
+	/* If there wasn't any free block, bail out */
+	if (cur_order > KFD_GTT_SA_MAX_ORDER)
 		goto kfd_gtt_no_free_chunk;
 
+	block = list_first_entry(&kfd->gtt_sa_free_list[cur_order],
+				struct kfd_gtt_sa_block, list);
+	kfd_gtt_sa_remove_free_block(block);
+	found = block - kfd->gtt_sa_blocks;
+
+	/* Split it, returning the upper halves to the free lists */
+	while (cur_order > order) {
+		cur_order--;
+		kfd_gtt_sa_add_free_block(kfd, found + (1 << cur_order),
+					cur_order);
+	}
+	block->order = order;
+
+	mutex_unlock(&kfd->gtt_sa_lock);
+
+	pr_debug("kfd: found = %d\n", found);
+
 	/* Update fields of mem_obj */
 	(*mem_obj)->range_start = found;
-	(*mem_obj)->range_end = found;
+	(*mem_obj)->range_end = found + (1 << order) - 1;
 	(*mem_obj)->gpu_addr = kfd_gtt_sa_calc_gpu_addr(
 					kfd->gtt_start_gpu_addr,
 					found,
@@ -500,66 +580,23 @@ kfd_gtt_restart_search:
 	pr_debug("kfd: gpu_addr = %p, cpu_addr = %p\n",
 			(uint64_t *) (*mem_obj)->gpu_addr, (*mem_obj)->cpu_ptr);
 
-	/* If we need only one chunk, mark it as allocated and get out */
-	if (size <= kfd->gtt_sa_chunk_size) {
-		pr_debug("kfd: single bit\n");
-		set_bit(found, kfd->gtt_sa_bitmap);
-		goto kfd_gtt_out;
-	}
-
-	/* Otherwise, try to see if we have enough contiguous chunks */
-	cur_size = size - kfd->gtt_sa_chunk_size;
-	do {
-		(*mem_obj)->range_end =
-			find_next_zero_bit(kfd->gtt_sa_bitmap,
-					kfd->gtt_sa_num_of_chunks, ++found);
-		/*
-		 * If next free chunk is not contiguous than we need to
-		 * restart our search from the last free chunk we found (which
-		 * wasn't contiguous to the previous ones
-		 */
-		if ((*mem_obj)->range_end != found) {
-			start_search = found;
-			goto kfd_gtt_restart_search;
-		}
-
-		/*
-		 * If we reached end of buffer, bail out with error
-		 */
-		if (found == kfd->gtt_sa_num_of_chunks)
-			goto kfd_gtt_no_free_chunk;
-
-		/* Check if we don't need another chunk */
-		if (cur_size <= kfd->gtt_sa_chunk_size)
-			cur_size = 0;
-		else
-			cur_size -= kfd->gtt_sa_chunk_size;
-
-	} while (cur_size > 0);
-
 	pr_debug("kfd: range_start = %d, range_end = %d\n",
 		(*mem_obj)->range_start, (*mem_obj)->range_end);
 
-	/* Mark the chunks as allocated */
-	for (found = (*mem_obj)->range_start;
-		found <= (*mem_obj)->range_end;
-		found++)
-		set_bit(found, kfd->gtt_sa_bitmap);
-
-kfd_gtt_out:
-	mutex_unlock(&kfd->gtt_sa_lock);
 	return 0;
 
 kfd_gtt_no_free_chunk:
-	pr_debug("kfd: allocation failed with mem_obj = %p\n", mem_obj);
+	pr_debug("kfd: allocation failed with mem_obj = %p\n", *mem_obj);
 	mutex_unlock(&kfd->gtt_sa_lock);
-	kfree(mem_obj);
+	kmem_cache_free(kfd_mem_obj_slab, *mem_obj);
+	*mem_obj = NULL;
 	return -ENOMEM;
 }
 
 int kfd_gtt_sa_free(struct kfd_dev *kfd, struct kfd_mem_obj *mem_obj)
 {
-	unsigned int bit;
+	struct kfd_gtt_sa_block *buddy;
+	unsigned int start, buddy_start, order;
 
 	BUG_ON(!kfd);
 
@@ -570,16 +607,30 @@ int kfd_gtt_sa_free(struct kfd_dev *kfd, struct kfd_mem_obj *mem_obj)
 	pr_debug("kfd: free mem_obj = %p, range_start = %d, range_end = %d\n",
 			mem_obj, mem_obj->range_start, mem_obj->range_end);
 
+	start = mem_obj->range_start;
+	order = ilog2(mem_obj->range_end - mem_obj->range_start + 1);
+
 	mutex_lock(&kfd->gtt_sa_lock);
 
-	/* Mark the chunks as free */
-	for (bit = mem_obj->range_start;
-		bit <= mem_obj->range_end;
-		bit++)
-		clear_bit(bit, kfd->gtt_sa_bitmap);
+	/* Merge with the buddy for as long as it is free and whole */
+	while (order < KFD_GTT_SA_MAX_ORDER) {
+		buddy_start = start ^ (1 << order);
+		if (buddy_start >= kfd->gtt_sa_num_of_chunks)
+			break;
+
+		buddy = &kfd->gtt_sa_blocks[buddy_start];
+		if (!buddy->free || buddy->order != order)
+			break;
+
+		kfd_gtt_sa_remove_free_block(buddy);
+		start = min(start, buddy_start);
+		order++;
+	}
+
+	kfd_gtt_sa_add_free_block(kfd, start, order);
 
 	mutex_unlock(&kfd->gtt_sa_lock);
 
-	kfree(mem_obj);
+	kmem_cache_free(kfd_mem_obj_slab, mem_obj);
 	return 0;
 }
@@ -60,14 +60,20 @@ struct kfd_event_waiter {
  * do not contain enough spare data bits to identify an event.)
  * We get whole pages from vmalloc and map them to the process VA.
  * Individual signal events are then allocated a slot in a page.
+ *
+ * Pages with free slots are kept on kfd_process.free_signal_pages and pages
+ * are indexed by their mmap page index in kfd_process.signal_page_idr, so
+ * neither allocating a slot nor looking a page up walks all the pages.
  */
 
 struct signal_page {
 	struct list_head event_pages;	/* kfd_process.signal_event_pages */
+	struct list_head free_list;	/* kfd_process.free_signal_pages */
 	uint64_t *kernel_address;
 	uint64_t __user *user_address;
 	uint32_t page_index;		/* Index into the mmap aperture. */
 	unsigned int free_slots;
+	unsigned int next_free_slot;	/* Where to start the next search */
 	unsigned long used_slot_bitmap[0];
 };
 
@@ -85,6 +91,20 @@ struct signal_page {
 #define INTERRUPT_DATA_BITS 8
 #define SIGNAL_EVENT_ID_SLOT_SHIFT 0
 
+/*
+ * All events are kept in kfd_process.event_idr. Signal event IDs are made
+ * from their page and slot and are below KFD_SIGNAL_EVENT_LIMIT, so they are
+ * used as IDR keys directly. Non-signal events get cyclically allocated keys
+ * above that range and their ID is the key with KFD_EVENT_ID_NONSIGNAL_MASK
+ * set, so the two kinds never share a key.
+ */
+#define KFD_FIRST_NONSIGNAL_EVENT_KEY KFD_SIGNAL_EVENT_LIMIT
+
+static int event_id_to_key(u32 id)
+{
+	return (int)(id & ~KFD_EVENT_ID_NONSIGNAL_MASK);
+}
+
 static uint64_t *page_slots(struct signal_page *page)
 {
 	return page->kernel_address;
@@ -95,52 +115,64 @@ static bool allocate_free_slot(struct kfd_process *process,
 				unsigned int *out_slot_index)
 {
 	struct signal_page *page;
+	unsigned int slot;
 
-	list_for_each_entry(page, &process->signal_event_pages, event_pages) {
-		if (page->free_slots > 0) {
-			unsigned int slot =
-				find_first_zero_bit(page->used_slot_bitmap,
-							SLOTS_PER_PAGE);
+	if (list_empty(&process->free_signal_pages)) {
+		pr_debug("No free event signal slots were found for process %p\n",
+				process);
+		return false;
+	}
 
-			__set_bit(slot, page->used_slot_bitmap);
-			page->free_slots--;
+	page = list_first_entry(&process->free_signal_pages,
+				struct signal_page, free_list);
 
-			page_slots(page)[slot] = UNSIGNALED_EVENT_SLOT;
+	slot = find_next_zero_bit(page->used_slot_bitmap, SLOTS_PER_PAGE,
+					page->next_free_slot);
+	if (slot >= SLOTS_PER_PAGE)
+		slot = find_first_zero_bit(page->used_slot_bitmap,
+						SLOTS_PER_PAGE);
 
-			*out_page = page;
-			*out_slot_index = slot;
+	__set_bit(slot, page->used_slot_bitmap);
+	page->next_free_slot = slot + 1;
+	page->free_slots--;
+	if (page->free_slots == 0)
+		list_del_init(&page->free_list);
 
-			pr_debug("allocated event signal slot in page %p, slot %d\n",
-					page, slot);
+	page_slots(page)[slot] = UNSIGNALED_EVENT_SLOT;
 
-			return true;
-		}
-	}
+	*out_page = page;
+	*out_slot_index = slot;
 
-	pr_debug("No free event signal slots were found for process %p\n",
-			process);
+	pr_debug("allocated event signal slot in page %p, slot %d\n",
+			page, slot);
 
-	return false;
+	return true;
 }
 
-#define list_tail_entry(head, type, member) \
-	list_entry((head)->prev, type, member)
-
-static bool allocate_signal_page(struct file *devkfd, struct kfd_process *p)
+/*
+ * Signal pages are written by the GPU and polled by the CPU, so they are
+ * allocated on the CPU NUMA node closest to the GPU the event is created for.
+ */
+static bool allocate_signal_page(struct file *devkfd, struct kfd_process *p,
+				int numa_node)
 {
+	struct page *backing_pages;
 	void *backing_store;
 	struct signal_page *page;
+	int page_index;
 
-	page = kzalloc(SIGNAL_PAGE_SIZE, GFP_KERNEL);
+	page = kzalloc_node(SIGNAL_PAGE_SIZE, GFP_KERNEL, numa_node);
 	if (!page)
 		goto fail_alloc_signal_page;
 
 	page->free_slots = SLOTS_PER_PAGE;
+	INIT_LIST_HEAD(&page->free_list);
 
-	backing_store = (void *) __get_free_pages(GFP_KERNEL | __GFP_ZERO,
+	backing_pages = alloc_pages_node(numa_node, GFP_KERNEL | __GFP_ZERO,
 					get_order(KFD_SIGNAL_EVENT_LIMIT * 8));
-	if (!backing_store)
+	if (!backing_pages)
 		goto fail_alloc_signal_store;
+	backing_store = page_address(backing_pages);
 
 	/* prevent user-mode info leaks */
 	memset(backing_store, (uint8_t) UNSIGNALED_EVENT_SLOT,
@@ -148,21 +180,23 @@ static bool allocate_signal_page(struct file *devkfd, struct kfd_process *p)
 
 	page->kernel_address = backing_store;
 
-	if (list_empty(&p->signal_event_pages))
-		page->page_index = 0;
-	else
-		page->page_index = list_tail_entry(&p->signal_event_pages,
-						   struct signal_page,
-						   event_pages)->page_index + 1;
+	page_index = idr_alloc(&p->signal_page_idr, page, 0, 0, GFP_KERNEL);
+	if (page_index < 0)
+		goto fail_alloc_page_index;
+	page->page_index = page_index;
 
 	pr_debug("allocated new event signal page at %p, for process %p\n",
 			page, p);
 	pr_debug("page index is %d\n", page->page_index);
 
 	list_add(&page->event_pages, &p->signal_event_pages);
+	list_add(&page->free_list, &p->free_signal_pages);
 
 	return true;
 
+fail_alloc_page_index:
+	free_pages((unsigned long)backing_store,
+			get_order(KFD_SIGNAL_EVENT_LIMIT * 8));
 fail_alloc_signal_store:
 	kfree(page);
 fail_alloc_signal_page:
@@ -172,13 +206,14 @@ fail_alloc_signal_page:
 static bool allocate_event_notification_slot(struct file *devkfd,
 					struct kfd_process *p,
 					struct signal_page **page,
-					unsigned int *signal_slot_index)
+					unsigned int *signal_slot_index,
+					int numa_node)
 {
 	bool ret;
 
 	ret = allocate_free_slot(p, page, signal_slot_index);
 	if (!ret) {
-		ret = allocate_signal_page(devkfd, p);
+		ret = allocate_signal_page(devkfd, p, numa_node);
 		if (ret)
 			ret = allocate_free_slot(p, page, signal_slot_index);
 	}
@@ -187,11 +222,13 @@ static bool allocate_event_notification_slot(struct file *devkfd,
 }
 
 /* Assumes that the process's event_mutex is locked. */
-static void release_event_notification_slot(struct signal_page *page,
+static void release_event_notification_slot(struct kfd_process *p,
+						struct signal_page *page,
 						size_t slot_index)
 {
 	__clear_bit(slot_index, page->used_slot_bitmap);
-	page->free_slots++;
+	if (page->free_slots++ == 0)
+		list_add(&page->free_list, &p->free_signal_pages);
 
 	/* We don't free signal pages, they are retained by the process
 	 * and reused until it exits. */
@@ -200,17 +237,11 @@ static void release_event_notification_slot(struct signal_page *page,
 static struct signal_page *lookup_signal_page_by_index(struct kfd_process *p,
 						unsigned int page_index)
 {
-	struct signal_page *page;
-
 	/*
 	 * This is safe because we don't delete signal pages until the
 	 * process exits.
 	 */
-	list_for_each_entry(page, &p->signal_event_pages, event_pages)
-		if (page->page_index == page_index)
-			return page;
-
-	return NULL;
+	return idr_find(&p->signal_page_idr, page_index);
 }
 
 /*
@@ -219,11 +250,10 @@ static struct signal_page *lookup_signal_page_by_index(struct kfd_process *p,
  */
 static struct kfd_event *lookup_event_by_id(struct kfd_process *p, uint32_t id)
 {
-	struct kfd_event *ev;
+	struct kfd_event *ev = idr_find(&p->event_idr, event_id_to_key(id));
 
-	hash_for_each_possible(p->events, ev, events, id)
-		if (ev->event_id == id)
-			return ev;
+	if (ev && ev->event_id == id)
+		return ev;
 
 	return NULL;
 }
@@ -237,45 +267,20 @@ static u32 make_signal_event_id(struct signal_page *page,
 
 /*
  * Produce a kfd event id for a nonsignal event.
- * These are arbitrary numbers, so we do a sequential search through
- * the hash table for an unused number.
+ * These are arbitrary numbers, handed out cyclically by the IDR so that
+ * recently destroyed IDs are not reused right away.
  */
-static u32 make_nonsignal_event_id(struct kfd_process *p)
+static int make_nonsignal_event_id(struct kfd_process *p,
+					struct kfd_event *ev)
 {
-	u32 id;
+	int key = idr_alloc_cyclic(&p->event_idr, ev,
+				KFD_FIRST_NONSIGNAL_EVENT_KEY, 0, GFP_KERNEL);
 
-	for (id = p->next_nonsignal_event_id;
-		id < KFD_LAST_NONSIGNAL_EVENT_ID &&
-		lookup_event_by_id(p, id) != NULL;
-		id++)
-		;
+	if (key < 0)
+		return key;
 
-	if (id < KFD_LAST_NONSIGNAL_EVENT_ID) {
+	ev->event_id = KFD_EVENT_ID_NONSIGNAL_MASK | key;
 
-		/*
-		 * What if id == LAST_NONSIGNAL_EVENT_ID - 1?
-		 * Then next_nonsignal_event_id = LAST_NONSIGNAL_EVENT_ID so
-		 * the first loop fails immediately and we proceed with the
-		 * wraparound loop below.
-		 */
-		p->next_nonsignal_event_id = id + 1;
-
-		return id;
-	}
-
-	for (id = KFD_FIRST_NONSIGNAL_EVENT_ID;
-		id < KFD_LAST_NONSIGNAL_EVENT_ID &&
-		lookup_event_by_id(p, id) != NULL;
-		id++)
-		;
-
-
-	if (id < KFD_LAST_NONSIGNAL_EVENT_ID) {
-		p->next_nonsignal_event_id = id + 1;
-		return id;
-	}
-
-	p->next_nonsignal_event_id = KFD_FIRST_NONSIGNAL_EVENT_ID;
 	return 0;
 }
 
@@ -288,27 +293,40 @@ static struct kfd_event *lookup_event_by_page_slot(struct kfd_process *p,
 
 static int create_signal_event(struct file *devkfd,
 				struct kfd_process *p,
-				struct kfd_event *ev)
+				struct kfd_event *ev,
+				int numa_node)
 {
+	int ret;
+
 	if (p->signal_event_count == KFD_SIGNAL_EVENT_LIMIT) {
 		pr_warn("amdkfd: Signal event wasn't created because limit was reached\n");
 		return -ENOMEM;
 	}
 
 	if (!allocate_event_notification_slot(devkfd, p, &ev->signal_page,
-						&ev->signal_slot_index)) {
+						&ev->signal_slot_index,
+						numa_node)) {
 		pr_warn("amdkfd: Signal event wasn't created because out of kernel memory\n");
 		return -ENOMEM;
 	}
 
+	ev->event_id = make_signal_event_id(ev->signal_page,
+						ev->signal_slot_index);
+
+	ret = idr_alloc(&p->event_idr, ev, event_id_to_key(ev->event_id),
+			event_id_to_key(ev->event_id) + 1, GFP_KERNEL);
+	if (ret < 0) {
+		release_event_notification_slot(p, ev->signal_page,
+						ev->signal_slot_index);
+		ev->signal_page = NULL;
+		return ret;
+	}
+
 	p->signal_event_count++;
 
 	ev->user_signal_address =
 			&ev->signal_page->user_address[ev->signal_slot_index];
 
-	ev->event_id = make_signal_event_id(ev->signal_page,
-						ev->signal_slot_index);
-
 	pr_debug("signal event number %zu created with id %d, address %p\n",
 			p->signal_event_count, ev->event_id,
 			ev->user_signal_address);
@@ -327,26 +345,23 @@ static int create_signal_event(struct file *devkfd,
  */
 static int create_other_event(struct kfd_process *p, struct kfd_event *ev)
 {
-	ev->event_id = make_nonsignal_event_id(p);
-	if (ev->event_id == 0)
-		return -ENOMEM;
-
-	return 0;
+	return make_nonsignal_event_id(p, ev);
 }
 
 void kfd_event_init_process(struct kfd_process *p)
 {
 	mutex_init(&p->event_mutex);
-	hash_init(p->events);
+	idr_init(&p->event_idr);
 	INIT_LIST_HEAD(&p->signal_event_pages);
-	p->next_nonsignal_event_id = KFD_FIRST_NONSIGNAL_EVENT_ID;
+	INIT_LIST_HEAD(&p->free_signal_pages);
+	idr_init(&p->signal_page_idr);
 	p->signal_event_count = 0;
 }
 
 static void destroy_event(struct kfd_process *p, struct kfd_event *ev)
 {
 	if (ev->signal_page != NULL) {
-		release_event_notification_slot(ev->signal_page,
+		release_event_notification_slot(p, ev->signal_page,
 						ev->signal_slot_index);
 		p->signal_event_count--;
 	}
@@ -357,18 +372,19 @@ static void destroy_event(struct kfd_process *p, struct kfd_event *ev)
 	 */
 	list_del(&ev->waiters);
 
-	hash_del(&ev->events);
+	idr_remove(&p->event_idr, event_id_to_key(ev->event_id));
 	kfree(ev);
 }
 
 static void destroy_events(struct kfd_process *p)
 {
 	struct kfd_event *ev;
-	struct hlist_node *tmp;
-	unsigned int hash_bkt;
+	int id;
 
-	hash_for_each_safe(p->events, hash_bkt, tmp, ev, events)
+	idr_for_each_entry(&p->event_idr, ev, id)
 		destroy_event(p, ev);
+
+	idr_destroy(&p->event_idr);
 }
 
 /*
@@ -385,6 +401,8 @@ static void shutdown_signal_pages(struct kfd_process *p)
 				get_order(KFD_SIGNAL_EVENT_LIMIT * 8));
 		kfree(page);
 	}
+
+	idr_destroy(&p->signal_page_idr);
 }
 
 void kfd_event_free_process(struct kfd_process *p)
@@ -411,10 +429,16 @@ int kfd_event_create(struct file *devkfd, struct kfd_process *p,
 {
 	int ret = 0;
 	struct kfd_event *ev = kzalloc(sizeof(*ev), GFP_KERNEL);
+	struct kfd_dev *dev;
+	int numa_node;
 
 	if (!ev)
 		return -ENOMEM;
 
+	dev = (node_id <= U8_MAX) ?
+		kfd_topology_enum_kfd_devices(node_id) : NULL;
+	numa_node = dev ? dev->numa_node : NUMA_NO_NODE;
+
 	ev->type = event_type;
 	ev->auto_reset = auto_reset;
 	ev->signaled = false;
@@ -428,7 +452,7 @@ int kfd_event_create(struct file *devkfd, struct kfd_process *p,
 	switch (event_type) {
 	case KFD_EVENT_TYPE_SIGNAL:
 	case KFD_EVENT_TYPE_DEBUG:
-		ret = create_signal_event(devkfd, p, ev);
+		ret = create_signal_event(devkfd, p, ev, numa_node);
 		if (!ret) {
 			*event_page_offset = (ev->signal_page->page_index |
 					KFD_MMAP_EVENTS_MASK);
@@ -442,8 +466,6 @@ int kfd_event_create(struct file *devkfd, struct kfd_process *p,
 	}
 
 	if (!ret) {
-		hash_add(p->events, &ev->events, ev->event_id);
-
 		*event_id = ev->event_id;
 		*event_trigger_data = ev->event_id;
 	} else {
@@ -858,12 +880,12 @@ static void lookup_events_by_type_and_signal(struct kfd_process *p,
 {
 	struct kfd_hsa_memory_exception_data *ev_data;
 	struct kfd_event *ev;
-	int bkt;
+	int id;
 	bool send_signal = true;
 
 	ev_data = (struct kfd_hsa_memory_exception_data *) event_data;
 
-	hash_for_each(p->events, bkt, ev, events)
+	idr_for_each_entry(&p->event_idr, ev, id)
 		if (ev->type == type) {
 			send_signal = false;
 			dev_dbg(kfd_device,
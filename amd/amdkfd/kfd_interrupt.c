@@ -36,35 +36,120 @@
  * There's no acknowledgment for the interrupts we use. The hardware simply
  * queues a new interrupt each time without waiting.
  *
- * The fixed-size internal queue means that it's possible for us to lose
- * interrupts because we have no back-pressure to the hardware.
+ * Interrupts are spread over several workers by PASID, so the interrupts of
+ * one process are always handled in order by the same worker while different
+ * processes are handled concurrently. Each worker has its own fixed-size
+ * ring and drains it in batches.
+ *
+ * The fixed-size internal rings mean that it's possible for us to lose
+ * interrupts because we have no back-pressure to the hardware. Lost
+ * interrupts and the enqueue to dispatch latency are accounted in
+ * kfd->interrupt_stats, which is exported through the topology node.
  */
 
 #include <linux/slab.h>
 #include <linux/device.h>
+#include <linux/ktime.h>
+#include <linux/cpumask.h>
+#include <linux/sched.h>
+#include <linux/workqueue.h>
 #include "kfd_priv.h"
 
 #define KFD_INTERRUPT_RING_SIZE 1024
+#define KFD_INTERRUPT_BATCH_SIZE 16
+#define KFD_IH_RING_ENTRY_MAX_DWORDS 8
 
 static void interrupt_wq(struct work_struct *);
 
+/*
+ * The rings are allocated on the CPU NUMA node closest to the GPU, and the
+ * workers run on the CPUs of that node.
+ */
+static int kfd_interrupt_worker_init(struct kfd_dev *kfd,
+				struct kfd_interrupt_worker *worker)
+{
+	worker->ring = kmalloc_node(KFD_INTERRUPT_RING_SIZE *
+				kfd->device_info->ih_ring_entry_size,
+				GFP_KERNEL, kfd->numa_node);
+	if (!worker->ring)
+		return -ENOMEM;
+
+	worker->timestamps = kmalloc_node(KFD_INTERRUPT_RING_SIZE *
+					sizeof(ktime_t), GFP_KERNEL,
+					kfd->numa_node);
+	if (!worker->timestamps) {
+		kfree(worker->ring);
+		worker->ring = NULL;
+		return -ENOMEM;
+	}
+
+	worker->dev = kfd;
+	atomic_set(&worker->wptr, 0);
+	atomic_set(&worker->rptr, 0);
+	INIT_WORK(&worker->work, interrupt_wq);
+
+	return 0;
+}
+
+static void kfd_interrupt_worker_fini(struct kfd_interrupt_worker *worker)
+{
+	kfree(worker->timestamps);
+	kfree(worker->ring);
+	worker->timestamps = NULL;
+	worker->ring = NULL;
+}
+
+/*
+ * Work is queued from the ISR, which can neither sleep nor hold off CPU
+ * hotplug, so rather than queueing on a chosen CPU, use an unbound
+ * workqueue limited to the CPUs of the GPU's node. The workqueue falls
+ * back to the other CPUs when none of those is online.
+ */
+static struct workqueue_struct *kfd_interrupt_alloc_wq(struct kfd_dev *kfd)
+{
+	struct workqueue_struct *wq;
+	struct workqueue_attrs *attrs;
+
+	wq = alloc_workqueue("kfd_ih", WQ_HIGHPRI | WQ_UNBOUND,
+			KFD_INTERRUPT_NUM_WORKERS);
+	if (!wq || kfd->numa_node == NUMA_NO_NODE)
+		return wq;
+
+	attrs = alloc_workqueue_attrs(GFP_KERNEL);
+	if (attrs) {
+		attrs->nice = MIN_NICE;
+		cpumask_copy(attrs->cpumask, cpumask_of_node(kfd->numa_node));
+		/* on failure the workers just run on any CPU */
+		apply_workqueue_attrs(wq, attrs);
+		free_workqueue_attrs(attrs);
+	}
+
+	return wq;
+}
+
 int kfd_interrupt_init(struct kfd_dev *kfd)
 {
-	void *interrupt_ring = kmalloc_array(KFD_INTERRUPT_RING_SIZE,
-					kfd->device_info->ih_ring_entry_size,
-					GFP_KERNEL);
-	if (!interrupt_ring)
+	unsigned int i;
+	int retval;
+
+	if (kfd->device_info->ih_ring_entry_size >
+			KFD_IH_RING_ENTRY_MAX_DWORDS * sizeof(uint32_t))
+		return -EINVAL;
+
+	kfd->interrupt_wq = kfd_interrupt_alloc_wq(kfd);
+	if (!kfd->interrupt_wq)
 		return -ENOMEM;
 
-	kfd->interrupt_ring = interrupt_ring;
-	kfd->interrupt_ring_size =
-		KFD_INTERRUPT_RING_SIZE * kfd->device_info->ih_ring_entry_size;
-	atomic_set(&kfd->interrupt_ring_wptr, 0);
-	atomic_set(&kfd->interrupt_ring_rptr, 0);
+	for (i = 0; i < KFD_INTERRUPT_NUM_WORKERS; i++) {
+		retval = kfd_interrupt_worker_init(kfd,
+						&kfd->interrupt_workers[i]);
+		if (retval != 0)
+			goto fail_worker_init;
+	}
 
-	spin_lock_init(&kfd->interrupt_lock);
+	memset(&kfd->interrupt_stats, 0, sizeof(kfd->interrupt_stats));
 
-	INIT_WORK(&kfd->interrupt_work, interrupt_wq);
+	spin_lock_init(&kfd->interrupt_lock);
 
 	kfd->interrupts_active = true;
 
@@ -76,6 +161,13 @@ int kfd_interrupt_init(struct kfd_dev *kfd)
 	smp_wmb();
 
 	return 0;
+
+fail_worker_init:
+	while (i--)
+		kfd_interrupt_worker_fini(&kfd->interrupt_workers[i]);
+	destroy_workqueue(kfd->interrupt_wq);
+	kfd->interrupt_wq = NULL;
+	return retval;
 }
 
 void kfd_interrupt_exit(struct kfd_dev *kfd)
@@ -86,94 +178,150 @@ void kfd_interrupt_exit(struct kfd_dev *kfd)
 	 * after we have unlocked sees interrupts_active = false.
 	 */
 	unsigned long flags;
+	unsigned int i;
 
 	spin_lock_irqsave(&kfd->interrupt_lock, flags);
 	kfd->interrupts_active = false;
 	spin_unlock_irqrestore(&kfd->interrupt_lock, flags);
 
 	/*
-	 * Flush_scheduled_work ensures that there are no outstanding
-	 * work-queue items that will access interrupt_ring. New work items
+	 * destroy_workqueue drains the workqueue, so there are no outstanding
+	 * work-queue items that will access the worker rings. New work items
 	 * can't be created because we stopped interrupt handling above.
 	 */
-	flush_scheduled_work();
+	destroy_workqueue(kfd->interrupt_wq);
+	kfd->interrupt_wq = NULL;
+
+	for (i = 0; i < KFD_INTERRUPT_NUM_WORKERS; i++)
+		kfd_interrupt_worker_fini(&kfd->interrupt_workers[i]);
+}
 
-	kfree(kfd->interrupt_ring);
+static struct kfd_interrupt_worker *select_worker(struct kfd_dev *kfd,
+						const void *ih_ring_entry)
+{
+	unsigned int pasid = kfd->device_info->event_interrupt_class->
+				interrupt_pasid(kfd, ih_ring_entry);
+
+	return &kfd->interrupt_workers[pasid % KFD_INTERRUPT_NUM_WORKERS];
 }
 
 /*
- * This assumes that it can't be called concurrently with itself
- * but only with dequeue_ih_ring_entry.
+ * Copies the entry to the ring of the worker owning its PASID and schedules
+ * that worker. This assumes that it can't be called concurrently with itself
+ * but only with dequeue_ih_ring_entries.
  */
 bool enqueue_ih_ring_entry(struct kfd_dev *kfd,	const void *ih_ring_entry)
 {
-	unsigned int rptr = atomic_read(&kfd->interrupt_ring_rptr);
-	unsigned int wptr = atomic_read(&kfd->interrupt_ring_wptr);
+	struct kfd_interrupt_worker *worker = select_worker(kfd, ih_ring_entry);
+	size_t entry_size = kfd->device_info->ih_ring_entry_size;
+	unsigned int rptr = atomic_read(&worker->rptr);
+	unsigned int wptr = atomic_read(&worker->wptr);
+	unsigned int next = (wptr + 1) % KFD_INTERRUPT_RING_SIZE;
 
-	if ((rptr - wptr) % kfd->interrupt_ring_size ==
-					kfd->device_info->ih_ring_entry_size) {
+	if (next == rptr) {
 		/* This is very bad, the system is likely to hang. */
+		atomic64_inc(&kfd->interrupt_stats.dropped);
 		dev_err_ratelimited(kfd_chardev(),
-			"Interrupt ring overflow, dropping interrupt.\n");
+			"Interrupt ring overflow, dropping interrupt (%lld dropped so far).\n",
+			(long long)atomic64_read(&kfd->interrupt_stats.dropped));
 		return false;
 	}
 
-	memcpy(kfd->interrupt_ring + wptr, ih_ring_entry,
-			kfd->device_info->ih_ring_entry_size);
+	memcpy(worker->ring + wptr * entry_size, ih_ring_entry, entry_size);
+	worker->timestamps[wptr] = ktime_get();
 
-	wptr = (wptr + kfd->device_info->ih_ring_entry_size) %
-			kfd->interrupt_ring_size;
 	smp_wmb(); /* Ensure memcpy'd data is visible before wptr update. */
-	atomic_set(&kfd->interrupt_ring_wptr, wptr);
+	atomic_set(&worker->wptr, next);
+
+	atomic64_inc(&kfd->interrupt_stats.enqueued);
+
+	queue_work(kfd->interrupt_wq, &worker->work);
 
 	return true;
 }
 
+static void update_latency_stats(struct kfd_dev *kfd, ktime_t enqueued)
+{
+	s64 latency = ktime_to_ns(ktime_sub(ktime_get(), enqueued));
+	s64 max = atomic64_read(&kfd->interrupt_stats.latency_max_ns);
+	s64 old;
+
+	atomic64_add(latency, &kfd->interrupt_stats.latency_total_ns);
+
+	while (latency > max) {
+		old = atomic64_cmpxchg(&kfd->interrupt_stats.latency_max_ns,
+					max, latency);
+		if (old == max)
+			break;
+		max = old;
+	}
+}
+
 /*
- * This assumes that it can't be called concurrently with itself
- * but only with enqueue_ih_ring_entry.
+ * Moves up to max_entries entries from the worker ring to ih_ring_entries
+ * and returns how many were moved. This assumes that it can't be called
+ * concurrently with itself for the same worker but only with
+ * enqueue_ih_ring_entry.
  */
-static bool dequeue_ih_ring_entry(struct kfd_dev *kfd, void *ih_ring_entry)
+static unsigned int dequeue_ih_ring_entries(struct kfd_interrupt_worker *worker,
+					void *ih_ring_entries,
+					unsigned int max_entries)
 {
 	/*
 	 * Assume that wait queues have an implicit barrier, i.e. anything that
 	 * happened in the ISR before it queued work is visible.
 	 */
+	struct kfd_dev *kfd = worker->dev;
+	size_t entry_size = kfd->device_info->ih_ring_entry_size;
+	unsigned int wptr = atomic_read(&worker->wptr);
+	unsigned int rptr = atomic_read(&worker->rptr);
+	unsigned int count = 0;
+
+	while (rptr != wptr && count < max_entries) {
+		memcpy(ih_ring_entries + count * entry_size,
+			worker->ring + rptr * entry_size, entry_size);
+		update_latency_stats(kfd, worker->timestamps[rptr]);
+
+		rptr = (rptr + 1) % KFD_INTERRUPT_RING_SIZE;
+		count++;
+	}
 
-	unsigned int wptr = atomic_read(&kfd->interrupt_ring_wptr);
-	unsigned int rptr = atomic_read(&kfd->interrupt_ring_rptr);
-
-	if (rptr == wptr)
-		return false;
-
-	memcpy(ih_ring_entry, kfd->interrupt_ring + rptr,
-			kfd->device_info->ih_ring_entry_size);
-
-	rptr = (rptr + kfd->device_info->ih_ring_entry_size) %
-			kfd->interrupt_ring_size;
+	if (count == 0)
+		return 0;
 
 	/*
 	 * Ensure the rptr write update is not visible until
 	 * memcpy has finished reading.
 	 */
 	smp_mb();
-	atomic_set(&kfd->interrupt_ring_rptr, rptr);
+	atomic_set(&worker->rptr, rptr);
 
-	return true;
+	return count;
 }
 
 static void interrupt_wq(struct work_struct *work)
 {
-	struct kfd_dev *dev = container_of(work, struct kfd_dev,
-						interrupt_work);
-
-	uint32_t ih_ring_entry[DIV_ROUND_UP(
-				dev->device_info->ih_ring_entry_size,
-				sizeof(uint32_t))];
-
-	while (dequeue_ih_ring_entry(dev, ih_ring_entry))
-		dev->device_info->event_interrupt_class->interrupt_wq(dev,
-								ih_ring_entry);
+	struct kfd_interrupt_worker *worker = container_of(work,
+					struct kfd_interrupt_worker, work);
+	struct kfd_dev *dev = worker->dev;
+	size_t entry_dwords = DIV_ROUND_UP(dev->device_info->ih_ring_entry_size,
+					sizeof(uint32_t));
+	uint32_t batch[KFD_INTERRUPT_BATCH_SIZE *
+			KFD_IH_RING_ENTRY_MAX_DWORDS];
+	unsigned int count, i;
+
+	while ((count = dequeue_ih_ring_entries(worker, batch,
+					KFD_INTERRUPT_BATCH_SIZE)) > 0) {
+		/*
+		 * Identical entries are separate signals, e.g. an auto reset
+		 * event needs one wakeup per signal, so each one is handled.
+		 */
+		for (i = 0; i < count; i++)
+			dev->device_info->event_interrupt_class->interrupt_wq(
+					dev, &batch[i * entry_dwords]);
+
+		atomic64_add(count, &dev->interrupt_stats.dispatched);
+	}
 }
 
 bool interrupt_is_wanted(struct kfd_dev *dev, const uint32_t *ih_ring_entry)
@@ -59,6 +59,11 @@ module_param(send_sigterm, int, 0444);
 MODULE_PARM_DESC(send_sigterm,
 	"Send sigterm to HSA process on unhandled exception (0 = disable, 1 = enable)");
 
+int hws_process_quantum = KFD_HWS_PROCESS_QUANTUM_DEFAULT;
+module_param(hws_process_quantum, int, 0444);
+MODULE_PARM_DESC(hws_process_quantum,
+	"Default HWS process quantum, higher priority processes get a multiple of it (1 = Minimum and default, 127 = Maximum)");
+
 static int amdkfd_init_completed;
 
 int kgd2kfd_init(unsigned interface_version, const struct kgd2kfd_calls **g2f)
@@ -102,6 +107,18 @@ static int __init kfd_module_init(void)
 		return -1;
 	}
 
+	/* Verify module parameters */
+	if ((hws_process_quantum < 1) ||
+		(hws_process_quantum > KFD_HWS_PROCESS_QUANTUM_MAX)) {
+		pr_err("kfd: hws_process_quantum must be between 1 to %d\n",
+			KFD_HWS_PROCESS_QUANTUM_MAX);
+		return -1;
+	}
+
+	err = kfd_gtt_sa_cache_init();
+	if (err < 0)
+		goto err_gtt_sa_cache;
+
 	err = kfd_pasid_init();
 	if (err < 0)
 		goto err_pasid;
@@ -127,6 +144,8 @@ err_topology:
 err_ioctl:
 	kfd_pasid_exit();
 err_pasid:
+	kfd_gtt_sa_cache_fini();
+err_gtt_sa_cache:
 	return err;
 }
 
@@ -138,6 +157,7 @@ static void __exit kfd_module_exit(void)
 	kfd_topology_shutdown();
 	kfd_chardev_exit();
 	kfd_pasid_exit();
+	kfd_gtt_sa_cache_fini();
 	dev_info(kfd_device, "Removed module\n");
 }
 
@@ -51,6 +51,61 @@ static unsigned int build_pm4_header(unsigned int opcode, size_t packet_size)
 	return header.u32all;
 }
 
+/*
+ * The process priority is the highest priority of its active user queues.
+ * Kernel queues are not taken into account as they are always mapped first.
+ */
+static uint32_t pm_process_priority(struct qcm_process_device *qpd)
+{
+	struct queue *q;
+	uint32_t priority = 0;
+
+	list_for_each_entry(q, &qpd->queues_list, list)
+		if (q->properties.is_active && q->properties.priority > priority)
+			priority = q->properties.priority;
+
+	return priority;
+}
+
+/*
+ * Higher priority processes get a larger time slice before the HWS switches
+ * to the next process in an over subscribed runlist.
+ */
+static uint32_t pm_process_quantum(struct qcm_process_device *qpd)
+{
+	uint32_t quantum;
+
+	quantum = qpd->process_quantum *
+			(1 + pm_process_priority(qpd) / 4);
+
+	return min_t(uint32_t, max_t(uint32_t, quantum, 1),
+			KFD_HWS_PROCESS_QUANTUM_MAX);
+}
+
+/*
+ * The HWS assigns hardware queue slots in runlist order, so when the runlist
+ * is over subscribed the queues at its head are always mapped while the rest
+ * are time sliced. Report when even the high priority queues do not fit.
+ * Must be called with the dqm lock held.
+ */
+static void pm_count_high_priority_queues(struct list_head *queues)
+{
+	struct device_process_node *cur;
+	struct queue *q;
+	unsigned int high_priority_queues = 0;
+
+	list_for_each_entry(cur, queues, list)
+		list_for_each_entry(q, &cur->qpd->queues_list, list)
+			if (q->properties.is_active &&
+			    q->properties.priority >= KFD_QUEUE_PRIORITY_HIGH)
+				high_priority_queues++;
+
+	if (high_priority_queues >
+			PIPE_PER_ME_CP_SCHEDULING * QUEUES_PER_PIPE)
+		pr_debug("kfd: %u high priority queues exceed the hw queue slots\n",
+			high_priority_queues);
+}
+
 static void pm_calc_rlib_size(struct packet_manager *pm,
 				unsigned int *rlib_size,
 				bool *over_subscription)
@@ -160,7 +215,7 @@ static int pm_create_map_process(struct packet_manager *pm, uint32_t *buffer,
 	packet->header.u32all = build_pm4_header(IT_MAP_PROCESS,
 					sizeof(struct pm4_map_process));
 	packet->bitfields2.diq_enable = (qpd->is_debug) ? 1 : 0;
-	packet->bitfields2.process_quantum = 1;
+	packet->bitfields2.process_quantum = pm_process_quantum(qpd);
 	packet->bitfields2.pasid = qpd->pqm->process->pasid;
 	packet->bitfields3.page_table_base = qpd->page_table_base;
 	packet->bitfields10.gds_size = qpd->gds_size;
@@ -309,104 +364,136 @@ static int pm_create_map_queue(struct packet_manager *pm, uint32_t *buffer,
 	return 0;
 }
 
-static int pm_create_runlist_ib(struct packet_manager *pm,
-				struct list_head *queues,
-				uint64_t *rl_gpu_addr,
-				size_t *rl_size_bytes)
+/*
+ * Add a MAP_PROCESS packet for the process followed by its active kernel
+ * queues and then its active user queues by descending priority. Queues
+ * with the same priority keep their creation order.
+ */
+static int pm_map_process_queues(struct packet_manager *pm,
+				unsigned int *rl_buffer,
+				unsigned int *rl_wptr,
+				unsigned int alloc_size_bytes,
+				struct qcm_process_device *qpd)
 {
-	unsigned int alloc_size_bytes;
-	unsigned int *rl_buffer, rl_wptr, i;
-	int retval, proccesses_mapped;
-	struct device_process_node *cur;
-	struct qcm_process_device *qpd;
-	struct queue *q;
 	struct kernel_queue *kq;
-	bool is_over_subscription;
-
-	BUG_ON(!pm || !queues || !rl_size_bytes || !rl_gpu_addr);
-
-	rl_wptr = retval = proccesses_mapped = 0;
+	struct queue *q;
+	int retval, prio;
 
-	retval = pm_allocate_runlist_ib(pm, &rl_buffer, rl_gpu_addr,
-				&alloc_size_bytes, &is_over_subscription);
+	retval = pm_create_map_process(pm, &rl_buffer[*rl_wptr], qpd);
 	if (retval != 0)
 		return retval;
 
-	*rl_size_bytes = alloc_size_bytes;
-
-	pr_debug("kfd: In func %s\n", __func__);
-	pr_debug("kfd: building runlist ib process count: %d queues count %d\n",
-		pm->dqm->processes_count, pm->dqm->queue_count);
-
-	/* build the run list ib packet */
-	list_for_each_entry(cur, queues, list) {
-		qpd = cur->qpd;
-		/* build map process packet */
-		if (proccesses_mapped >= pm->dqm->processes_count) {
-			pr_debug("kfd: not enough space left in runlist IB\n");
-			pm_release_ib(pm);
-			return -ENOMEM;
-		}
-
-		retval = pm_create_map_process(pm, &rl_buffer[rl_wptr], qpd);
+	inc_wptr(rl_wptr, sizeof(struct pm4_map_process), alloc_size_bytes);
+
+	list_for_each_entry(kq, &qpd->priv_queue_list, list) {
+		if (!kq->queue->properties.is_active)
+			continue;
+
+		pr_debug("kfd: static_queue, mapping kernel q %d, is debug status %d\n",
+			kq->queue->queue, qpd->is_debug);
+
+		if (pm->dqm->dev->device_info->asic_family == CHIP_CARRIZO)
+			retval = pm_create_map_queue_vi(pm,
+					&rl_buffer[*rl_wptr],
+					kq->queue,
+					qpd->is_debug);
+		else
+			retval = pm_create_map_queue(pm,
+					&rl_buffer[*rl_wptr],
+					kq->queue,
+					qpd->is_debug);
 		if (retval != 0)
 			return retval;
 
-		proccesses_mapped++;
-		inc_wptr(&rl_wptr, sizeof(struct pm4_map_process),
+		inc_wptr(rl_wptr, sizeof(struct pm4_map_queues),
 				alloc_size_bytes);
+	}
 
-		list_for_each_entry(kq, &qpd->priv_queue_list, list) {
-			if (!kq->queue->properties.is_active)
+	for (prio = KFD_MAX_QUEUE_PRIORITY; prio >= 0; prio--) {
+		list_for_each_entry(q, &qpd->queues_list, list) {
+			if (!q->properties.is_active ||
+			    min_t(uint32_t, q->properties.priority,
+				  KFD_MAX_QUEUE_PRIORITY) != prio)
 				continue;
 
-			pr_debug("kfd: static_queue, mapping kernel q %d, is debug status %d\n",
-				kq->queue->queue, qpd->is_debug);
+			pr_debug("kfd: static_queue, mapping user queue %d, is debug status %d\n",
+				q->queue, qpd->is_debug);
 
 			if (pm->dqm->dev->device_info->asic_family ==
 					CHIP_CARRIZO)
 				retval = pm_create_map_queue_vi(pm,
-						&rl_buffer[rl_wptr],
-						kq->queue,
+						&rl_buffer[*rl_wptr],
+						q,
 						qpd->is_debug);
 			else
 				retval = pm_create_map_queue(pm,
-						&rl_buffer[rl_wptr],
-						kq->queue,
+						&rl_buffer[*rl_wptr],
+						q,
 						qpd->is_debug);
+
 			if (retval != 0)
 				return retval;
 
-			inc_wptr(&rl_wptr,
-				sizeof(struct pm4_map_queues),
-				alloc_size_bytes);
+			inc_wptr(rl_wptr, sizeof(struct pm4_map_queues),
+					alloc_size_bytes);
 		}
+	}
 
-		list_for_each_entry(q, &qpd->queues_list, list) {
-			if (!q->properties.is_active)
-				continue;
+	return 0;
+}
 
-			pr_debug("kfd: static_queue, mapping user queue %d, is debug status %d\n",
-				q->queue, qpd->is_debug);
+static int pm_create_runlist_ib(struct packet_manager *pm,
+				struct list_head *queues,
+				uint64_t *rl_gpu_addr,
+				size_t *rl_size_bytes)
+{
+	unsigned int alloc_size_bytes;
+	unsigned int *rl_buffer, rl_wptr, i;
+	int retval, proccesses_mapped, prio;
+	struct device_process_node *cur;
+	bool is_over_subscription;
 
-			if (pm->dqm->dev->device_info->asic_family ==
-					CHIP_CARRIZO)
-				retval = pm_create_map_queue_vi(pm,
-						&rl_buffer[rl_wptr],
-						q,
-						qpd->is_debug);
-			else
-				retval = pm_create_map_queue(pm,
-						&rl_buffer[rl_wptr],
-						q,
-						qpd->is_debug);
+	BUG_ON(!pm || !queues || !rl_size_bytes || !rl_gpu_addr);
+
+	rl_wptr = retval = proccesses_mapped = 0;
+
+	retval = pm_allocate_runlist_ib(pm, &rl_buffer, rl_gpu_addr,
+				&alloc_size_bytes, &is_over_subscription);
+	if (retval != 0)
+		return retval;
+
+	*rl_size_bytes = alloc_size_bytes;
+
+	pr_debug("kfd: In func %s\n", __func__);
+	pr_debug("kfd: building runlist ib process count: %d queues count %d\n",
+		pm->dqm->processes_count, pm->dqm->queue_count);
+
+	if (is_over_subscription)
+		pm_count_high_priority_queues(queues);
 
+	/*
+	 * build the run list ib packet, processes by descending priority so
+	 * that their high priority queues come first when over subscribed.
+	 * The dqm and qpd lists themselves are not reordered.
+	 */
+	for (prio = KFD_MAX_QUEUE_PRIORITY; prio >= 0; prio--) {
+		list_for_each_entry(cur, queues, list) {
+			if (min_t(uint32_t, pm_process_priority(cur->qpd),
+				  KFD_MAX_QUEUE_PRIORITY) != prio)
+				continue;
+
+			if (proccesses_mapped >= pm->dqm->processes_count) {
+				pr_debug("kfd: not enough space left in runlist IB\n");
+				pm_release_ib(pm);
+				return -ENOMEM;
+			}
+
+			retval = pm_map_process_queues(pm, rl_buffer, &rl_wptr,
+					alloc_size_bytes, cur->qpd);
 			if (retval != 0)
 				return retval;
 
-			inc_wptr(&rl_wptr,
-				sizeof(struct pm4_map_queues),
-				alloc_size_bytes);
+			proccesses_mapped++;
 		}
 	}
 
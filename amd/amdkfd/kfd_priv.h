@@ -24,12 +24,14 @@
 #define KFD_PRIV_H_INCLUDED
 
 #include <linux/hashtable.h>
+#include <linux/idr.h>
 #include <linux/mmu_notifier.h>
 #include <linux/mutex.h>
 #include <linux/types.h>
 #include <linux/atomic.h>
 #include <linux/workqueue.h>
 #include <linux/spinlock.h>
+#include <linux/ktime.h>
 #include <linux/kfd_ioctl.h>
 #include <kgd_kfd_interface.h>
 
@@ -80,6 +82,23 @@ extern int sched_policy;
  */
 extern int send_sigterm;
 
+/*
+ * Kernel module parameter to specify the default HWS process quantum that is
+ * programmed in the MAP_PROCESS packet of each process
+ */
+extern int hws_process_quantum;
+
+#define KFD_HWS_PROCESS_QUANTUM_DEFAULT 1
+#define KFD_HWS_PROCESS_QUANTUM_MAX 0x7F
+
+/*
+ * Queues with a priority equal or above this level are expected to get a
+ * hardware queue slot. The runlist lists processes by the priority of
+ * their highest priority queue and each process' queues by priority, this
+ * level is only used to report when there are more such queues than slots.
+ */
+#define KFD_QUEUE_PRIORITY_HIGH 0xB
+
 /**
  * enum kfd_sched_policy
  *
@@ -122,6 +141,8 @@ struct kfd_event_interrupt_class {
 				const uint32_t *ih_ring_entry);
 	void (*interrupt_wq)(struct kfd_dev *dev,
 				const uint32_t *ih_ring_entry);
+	unsigned int (*interrupt_pasid)(struct kfd_dev *dev,
+				const uint32_t *ih_ring_entry);
 };
 
 struct kfd_device_info {
@@ -141,6 +162,38 @@ struct kfd_mem_obj {
 	uint32_t *cpu_ptr;
 };
 
+/* Largest block of the GTT sub-allocator is 2^KFD_GTT_SA_MAX_ORDER chunks */
+#define KFD_GTT_SA_MAX_ORDER 20
+
+/* Per chunk state of the GTT sub-allocator, valid for the first chunk of
+ * each block only.
+ */
+struct kfd_gtt_sa_block {
+	struct list_head list;		/* kfd_dev.gtt_sa_free_list[order] */
+	uint8_t order;
+	bool free;
+};
+
+/* Number of workers the interrupts of a device are spread over by PASID */
+#define KFD_INTERRUPT_NUM_WORKERS 4
+
+struct kfd_interrupt_worker {
+	struct kfd_dev *dev;
+	void *ring;
+	ktime_t *timestamps;		/* Enqueue time of each ring entry */
+	atomic_t rptr;
+	atomic_t wptr;
+	struct work_struct work;
+};
+
+struct kfd_interrupt_stats {
+	atomic64_t enqueued;
+	atomic64_t dispatched;
+	atomic64_t dropped;		/* Lost on ring overflow */
+	atomic64_t latency_total_ns;	/* Enqueue to dispatch */
+	atomic64_t latency_max_ns;
+};
+
 struct kfd_dev {
 	struct kgd_dev *kgd;
 
@@ -149,6 +202,10 @@ struct kfd_dev {
 
 	unsigned int id;		/* topology stub index */
 
+	int numa_node;			/* CPU NUMA node closest to the GPU,
+					 * see kfd_topology_find_numa_node
+					 */
+
 	phys_addr_t doorbell_base;	/* Start of actual doorbells used by
 					 * KFD. It is aligned for mapping
 					 * into user mode
@@ -174,17 +231,17 @@ struct kfd_dev {
 	void *gtt_mem;
 	uint64_t gtt_start_gpu_addr;
 	void *gtt_start_cpu_ptr;
-	void *gtt_sa_bitmap;
+	/* Buddy allocator state, see kfd_gtt_sa_allocate */
+	struct kfd_gtt_sa_block *gtt_sa_blocks;
+	struct list_head gtt_sa_free_list[KFD_GTT_SA_MAX_ORDER + 1];
 	struct mutex gtt_sa_lock;
 	unsigned int gtt_sa_chunk_size;
 	unsigned int gtt_sa_num_of_chunks;
 
 	/* Interrupts */
-	void *interrupt_ring;
-	size_t interrupt_ring_size;
-	atomic_t interrupt_ring_rptr;
-	atomic_t interrupt_ring_wptr;
-	struct work_struct interrupt_work;
+	struct workqueue_struct *interrupt_wq;
+	struct kfd_interrupt_worker interrupt_workers[KFD_INTERRUPT_NUM_WORKERS];
+	struct kfd_interrupt_stats interrupt_stats;
 	spinlock_t interrupt_lock;
 
 	/* QCM Device instance */
@@ -193,7 +250,7 @@ struct kfd_dev {
 	bool init_complete;
 	/*
 	 * Interrupts of interest to KFD are copied
-	 * from the HW ring into a SW ring.
+	 * from the HW ring into the SW rings of the interrupt workers.
 	 */
 	bool interrupts_active;
 
@@ -436,6 +493,8 @@ struct qcm_process_device {
 	uint32_t gds_size;
 	uint32_t num_gws;
 	uint32_t num_oac;
+	/* HWS time quantum of this process, see hws_process_quantum */
+	uint32_t process_quantum;
 };
 
 /* Data that is per-process-per device. */
@@ -518,11 +577,14 @@ struct kfd_process {
 
 	/* Event-related data */
 	struct mutex event_mutex;
-	/* All events in process hashed by ID, linked on kfd_event.events. */
-	DECLARE_HASHTABLE(events, 4);
+	/* All events in process indexed by ID, see kfd_events.c */
+	struct idr event_idr;
 	struct list_head signal_event_pages;	/* struct slot_page_header.
 								event_pages */
-	u32 next_nonsignal_event_id;
+	/* Signal pages with free slots, linked on signal_page.free_list */
+	struct list_head free_signal_pages;
+	/* Signal pages indexed by their mmap page index */
+	struct idr signal_page_idr;
 	size_t signal_event_count;
 };
 
@@ -586,6 +648,9 @@ unsigned int kfd_queue_id_to_doorbell(struct kfd_dev *kfd,
 
 /* GTT Sub-Allocator */
 
+int kfd_gtt_sa_cache_init(void);
+void kfd_gtt_sa_cache_fini(void);
+
 int kfd_gtt_sa_allocate(struct kfd_dev *kfd, unsigned int size,
 			struct kfd_mem_obj **mem_obj);
 
@@ -632,6 +632,7 @@ static ssize_t node_show(struct kobject *kobj, struct attribute *attr,
 		char *buffer)
 {
 	struct kfd_topology_device *dev;
+	struct kfd_interrupt_stats *stats;
 	char public_name[KFD_TOPOLOGY_PUBLIC_NAME_SIZE];
 	uint32_t i;
 	uint32_t log_max_watch_addr;
@@ -658,6 +659,26 @@ static ssize_t node_show(struct kobject *kobj, struct attribute *attr,
 		return sysfs_show_str_val(buffer, public_name);
 	}
 
+	if (strcmp(attr->name, "interrupt_stats") == 0) {
+		dev = container_of(attr, struct kfd_topology_device,
+				attr_interrupt_stats);
+		if (!dev->gpu)
+			return 0;
+		stats = &dev->gpu->interrupt_stats;
+		sysfs_show_64bit_prop(buffer, "enqueued",
+			(unsigned long long)atomic64_read(&stats->enqueued));
+		sysfs_show_64bit_prop(buffer, "dispatched",
+			(unsigned long long)atomic64_read(&stats->dispatched));
+		sysfs_show_64bit_prop(buffer, "dropped",
+			(unsigned long long)atomic64_read(&stats->dropped));
+		sysfs_show_64bit_prop(buffer, "latency_total_ns",
+			(unsigned long long)
+				atomic64_read(&stats->latency_total_ns));
+		return sysfs_show_64bit_prop(buffer, "latency_max_ns",
+			(unsigned long long)
+				atomic64_read(&stats->latency_max_ns));
+	}
+
 	dev = container_of(attr, struct kfd_topology_device,
 			attr_props);
 	sysfs_show_32bit_prop(buffer, "cpu_cores_count",
@@ -804,6 +825,7 @@ static void kfd_remove_sysfs_node_entry(struct kfd_topology_device *dev)
 		sysfs_remove_file(dev->kobj_node, &dev->attr_gpuid);
 		sysfs_remove_file(dev->kobj_node, &dev->attr_name);
 		sysfs_remove_file(dev->kobj_node, &dev->attr_props);
+		sysfs_remove_file(dev->kobj_node, &dev->attr_interrupt_stats);
 		kobject_del(dev->kobj_node);
 		kobject_put(dev->kobj_node);
 		dev->kobj_node = NULL;
@@ -858,6 +880,9 @@ static int kfd_build_sysfs_node_entry(struct kfd_topology_device *dev,
 	dev->attr_props.name = "properties";
 	dev->attr_props.mode = KFD_SYSFS_FILE_MODE;
 	sysfs_attr_init(&dev->attr_props);
+	dev->attr_interrupt_stats.name = "interrupt_stats";
+	dev->attr_interrupt_stats.mode = KFD_SYSFS_FILE_MODE;
+	sysfs_attr_init(&dev->attr_interrupt_stats);
 	ret = sysfs_create_file(dev->kobj_node, &dev->attr_gpuid);
 	if (ret < 0)
 		return ret;
@@ -865,6 +890,9 @@ static int kfd_build_sysfs_node_entry(struct kfd_topology_device *dev,
 	if (ret < 0)
 		return ret;
 	ret = sysfs_create_file(dev->kobj_node, &dev->attr_props);
+	if (ret < 0)
+		return ret;
+	ret = sysfs_create_file(dev->kobj_node, &dev->attr_interrupt_stats);
 	if (ret < 0)
 		return ret;
 
@@ -1127,6 +1155,86 @@ static struct kfd_topology_device *kfd_assign_gpu(struct kfd_dev *gpu)
 	return out_dev;
 }
 
+static int kfd_cpu_node_to_numa_node(struct kfd_topology_device *dev)
+{
+	uint32_t cpu = dev->node_props.cpu_core_id_base;
+
+	if (dev->node_props.cpu_cores_count == 0 ||
+			cpu >= nr_cpu_ids || !cpu_possible(cpu))
+		return NUMA_NO_NODE;
+
+	return cpu_to_node(cpu);
+}
+
+static bool kfd_iolink_is_closer(struct kfd_iolink_properties *iolink,
+				struct kfd_iolink_properties *best)
+{
+	if (!best || iolink->min_latency < best->min_latency)
+		return true;
+
+	return iolink->min_latency == best->min_latency &&
+		iolink->max_bandwidth > best->max_bandwidth;
+}
+
+/*
+ * Find the CPU NUMA node closest to the GPU from the CRAT proximity data.
+ * An APU shares its proximity domain with the CPU cores. A dGPU is linked
+ * to CPU domains through IO links, the one with the lowest latency, then
+ * the highest bandwidth, wins. Without CRAT data, fall back to the node of
+ * the PCI device.
+ * kfd_topology_find_numa_node is called when the topology lock is already
+ * acquired
+ */
+static int kfd_topology_find_numa_node(struct kfd_topology_device *gpu_dev)
+{
+	struct kfd_topology_device *dev, *best_dev = NULL;
+	struct kfd_iolink_properties *iolink, *best_link = NULL;
+	uint32_t gpu_domain = 0, domain;
+	int node;
+
+	node = kfd_cpu_node_to_numa_node(gpu_dev);
+	if (node != NUMA_NO_NODE)
+		return node;
+
+	list_for_each_entry(dev, &topology_device_list, list) {
+		if (dev == gpu_dev)
+			break;
+		gpu_domain++;
+	}
+
+	domain = 0;
+	list_for_each_entry(dev, &topology_device_list, list) {
+		if (dev->node_props.cpu_cores_count == 0) {
+			domain++;
+			continue;
+		}
+
+		list_for_each_entry(iolink, &gpu_dev->io_link_props, list)
+			if (iolink->node_to == domain &&
+			    kfd_iolink_is_closer(iolink, best_link)) {
+				best_link = iolink;
+				best_dev = dev;
+			}
+
+		list_for_each_entry(iolink, &dev->io_link_props, list)
+			if (iolink->node_to == gpu_domain &&
+			    kfd_iolink_is_closer(iolink, best_link)) {
+				best_link = iolink;
+				best_dev = dev;
+			}
+
+		domain++;
+	}
+
+	if (best_dev) {
+		node = kfd_cpu_node_to_numa_node(best_dev);
+		if (node != NUMA_NO_NODE)
+			return node;
+	}
+
+	return dev_to_node(&gpu_dev->gpu->pdev->dev);
+}
+
 static void kfd_notify_gpu_change(uint32_t gpu_id, int arrival)
 {
 	/*
@@ -1191,6 +1299,10 @@ int kfd_topology_add_device(struct kfd_dev *gpu)
 		pr_info("amdkfd: adding doorbell packet type capability\n");
 	}
 
+	gpu->numa_node = kfd_topology_find_numa_node(dev);
+	pr_debug("kfd: GPU (ID: 0x%x) is closest to NUMA node %d\n",
+			gpu_id, gpu->numa_node);
+
 	res = 0;
 
 err:
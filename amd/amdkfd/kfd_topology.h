@@ -150,6 +150,7 @@ struct kfd_topology_device {
 	struct attribute		attr_gpuid;
 	struct attribute		attr_name;
 	struct attribute		attr_props;
+	struct attribute		attr_interrupt_stats;
 };
 
 struct kfd_system_properties {
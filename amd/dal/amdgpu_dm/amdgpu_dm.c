@@ -641,6 +641,81 @@ err:
 	return ret;
 }
 
+struct dm_detect_work {
+	struct work_struct work;
+	const struct dc_link *link;
+	bool boot;
+	bool detected;
+	s64 time_us;
+};
+
+static void dm_detect_link_work_func(struct work_struct *work)
+{
+	struct dm_detect_work *detect_work =
+		container_of(work, struct dm_detect_work, work);
+	ktime_t start = ktime_get();
+
+	detect_work->detected =
+		dc_link_detect(detect_work->link, detect_work->boot);
+	detect_work->time_us = ktime_us_delta(ktime_get(), start);
+}
+
+/*
+ * Detect all given links, returning dc_link_detect()'s result for each in
+ * 'detected'. The detections run concurrently; i2caux serializes the
+ * transactions per DDC line, and only the HW DDC buffer and the generic
+ * engines are shared between lines. Links that share a DDC line with an
+ * earlier one are detected after the others finished, as the pins of a
+ * line can only be opened once.
+ */
+static void dm_detect_links(
+	const struct dc_link *links[],
+	bool detected[],
+	int link_count,
+	bool boot)
+{
+	struct dm_detect_work *works;
+	bool queued[AMDGPU_DM_MAX_DISPLAY_INDEX + 1] = { false };
+	int i, j;
+
+	works = kcalloc(link_count, sizeof(*works), GFP_KERNEL);
+
+	for (i = 0; works && i < link_count; i++) {
+		for (j = 0; j < i; j++)
+			if (queued[j] &&
+				links[j]->ddc_hw_inst == links[i]->ddc_hw_inst)
+				break;
+
+		if (j < i)
+			continue;
+
+		works[i].link = links[i];
+		works[i].boot = boot;
+		INIT_WORK(&works[i].work, dm_detect_link_work_func);
+		queue_work(system_unbound_wq, &works[i].work);
+		queued[i] = true;
+	}
+
+	for (i = 0; i < link_count; i++) {
+		if (!queued[i]) {
+			ktime_t start = ktime_get();
+
+			detected[i] = dc_link_detect(links[i], boot);
+			DRM_DEBUG_KMS("link %d detected in %lld us\n",
+					links[i]->link_index,
+					ktime_us_delta(ktime_get(), start));
+			continue;
+		}
+
+		flush_work(&works[i].work);
+		detected[i] = works[i].detected;
+		DRM_DEBUG_KMS("link %d detected in %lld us\n",
+				links[i]->link_index, works[i].time_us);
+	}
+
+	kfree(works);
+}
+
 static int dm_resume(void *handle)
 {
 	struct amdgpu_device *adev = handle;
@@ -660,8 +735,13 @@ int amdgpu_dm_display_resume(struct amdgpu_device *adev )
 	struct drm_device *ddev = adev->ddev;
 	struct amdgpu_display_manager *dm = &adev->dm;
 	struct amdgpu_connector *aconnector;
+	struct amdgpu_connector *aconnectors[AMDGPU_DM_MAX_DISPLAY_INDEX + 1];
+	const struct dc_link *links[AMDGPU_DM_MAX_DISPLAY_INDEX + 1];
+	bool detected[AMDGPU_DM_MAX_DISPLAY_INDEX + 1];
 	struct drm_connector *connector;
+	int link_count = 0;
 	int ret = 0;
+	int i;
 	struct drm_crtc *crtc;
 
 	/* program HPD filter */
@@ -696,9 +776,21 @@ int amdgpu_dm_display_resume(struct amdgpu_device *adev )
 		if (aconnector->mst_port)
 			continue;
 
-		dc_link_detect(aconnector->dc_link, false);
-		aconnector->dc_sink = NULL;
-		amdgpu_dm_update_connector_after_detect(aconnector);
+		if (link_count == ARRAY_SIZE(links)) {
+			DRM_ERROR("DM: Too many links to detect\n");
+			break;
+		}
+
+		aconnectors[link_count] = aconnector;
+		links[link_count] = aconnector->dc_link;
+		link_count++;
+	}
+
+	dm_detect_links(links, detected, link_count, false);
+
+	for (i = 0; i < link_count; i++) {
+		aconnectors[i]->dc_sink = NULL;
+		amdgpu_dm_update_connector_after_detect(aconnectors[i]);
 	}
 
 	drm_modeset_lock_all(ddev);
@@ -787,6 +879,8 @@ void amdgpu_dm_update_connector_after_detect(
 	DRM_INFO("DCHPD: connector_id=%d: Old sink=%p New sink=%p\n",
 		aconnector->connector_id, aconnector->dc_sink, sink);
 
+	amdgpu_dm_connector_mode_cache_invalidate(aconnector);
+
 	mutex_lock(&dev->mode_config.mutex);
 
 	/* 1. Update status of the drm connector
@@ -1166,9 +1260,13 @@ int amdgpu_dm_initialize_drm_device(struct amdgpu_device *adev)
 	struct amdgpu_display_manager *dm = &adev->dm;
 	uint32_t i;
 	struct amdgpu_connector *aconnector;
+	struct amdgpu_connector *aconnectors[AMDGPU_DM_MAX_DISPLAY_INDEX + 1];
+	const struct dc_link *links[AMDGPU_DM_MAX_DISPLAY_INDEX + 1];
+	bool detected[AMDGPU_DM_MAX_DISPLAY_INDEX + 1];
 	struct amdgpu_encoder *aencoder;
 	struct amdgpu_crtc *acrtc;
 	uint32_t link_cnt;
+	uint32_t detect_cnt = 0;
 
 	link_cnt = dm->dc->caps.max_links;
 
@@ -1223,10 +1321,17 @@ int amdgpu_dm_initialize_drm_device(struct amdgpu_device *adev)
 			goto fail_free_connector;
 		}
 
-		if (dc_link_detect(dc_get_link_at_index(dm->dc, i), true))
-			amdgpu_dm_update_connector_after_detect(aconnector);
+		aconnectors[detect_cnt] = aconnector;
+		links[detect_cnt] = dc_get_link_at_index(dm->dc, i);
+		detect_cnt++;
 	}
 
+	dm_detect_links(links, detected, detect_cnt, true);
+
+	for (i = 0; i < detect_cnt; i++)
+		if (detected[i])
+			amdgpu_dm_update_connector_after_detect(aconnectors[i]);
+
 	/* Software is initialized. Now we can register interrupt handlers. */
 	switch (adev->asic_type) {
 	case CHIP_BONAIRE:
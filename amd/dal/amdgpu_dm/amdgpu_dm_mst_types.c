@@ -147,6 +147,7 @@ dm_dp_mst_connector_destroy(struct drm_connector *connector)
 
 	drm_encoder_cleanup(&amdgpu_encoder->base);
 	kfree(amdgpu_encoder);
+	amdgpu_dm_connector_mode_cache_fini(amdgpu_connector);
 	drm_connector_cleanup(connector);
 	kfree(amdgpu_connector);
 }
@@ -312,6 +313,7 @@ static void dm_dp_destroy_mst_connector(
 				aconnector, connector->base.id, aconnector->mst_port);
 
 	aconnector->port = NULL;
+	amdgpu_dm_connector_mode_cache_invalidate(aconnector);
 	if (aconnector->dc_sink) {
 		amdgpu_dm_remove_sink_from_freesync_module(connector);
 		dc_link_remove_remote_sink(aconnector->dc_link, aconnector->dc_sink);
@@ -397,3 +397,24 @@ long dm_get_tgid(void)
 {
 	return current->tgid;
 }
+
+uint64_t dm_get_timestamp(struct dc_context *ctx)
+{
+	return ktime_get_ns();
+}
+
+uint32_t dm_get_cpu_count(void)
+{
+	return nr_cpu_ids;
+}
+
+uint32_t dm_get_cpu(unsigned long *irq_flags)
+{
+	local_irq_save(*irq_flags);
+	return smp_processor_id();
+}
+
+void dm_put_cpu(unsigned long irq_flags)
+{
+	local_irq_restore(irq_flags);
+}
@@ -25,6 +25,8 @@
 
 #include <linux/types.h>
 #include <linux/version.h>
+#include <linux/hashtable.h>
+#include <linux/jhash.h>
 
 #include <drm/drmP.h>
 #include <drm/drm_atomic_helper.h>
@@ -1186,6 +1188,7 @@ void amdgpu_dm_connector_destroy(struct drm_connector *connector)
 
 	}
 #endif
+	amdgpu_dm_connector_mode_cache_fini(aconnector);
 	drm_connector_unregister(connector);
 	drm_connector_cleanup(connector);
 	kfree(connector);
@@ -1334,6 +1337,187 @@ static void handle_edid_mgmt(struct amdgpu_connector *aconnector)
 	create_eml_sink(aconnector);
 }
 
+/*
+ * Validating a mode builds a stream and a target and runs the full resource
+ * validation, for every mode the sink reports. The verdicts only depend on
+ * the sink and the link capabilities, so they are kept per connector until
+ * either changes.
+ */
+#define MODE_CACHE_HASH_BITS 6
+#define MODE_CACHE_MAX_ENTRIES 512
+
+struct mode_cache_key {
+	int clock;
+	int hdisplay;
+	int hsync_start;
+	int hsync_end;
+	int htotal;
+	int hskew;
+	int vdisplay;
+	int vsync_start;
+	int vsync_end;
+	int vtotal;
+	int vscan;
+	unsigned int flags;
+};
+
+struct mode_cache_entry {
+	struct hlist_node node;
+	struct mode_cache_key key;
+	int status;
+};
+
+struct amdgpu_dm_mode_cache {
+	struct mutex lock;
+	const struct dc_sink *sink;
+	struct dc_link_settings link_cap;
+	unsigned int num_entries;
+	DECLARE_HASHTABLE(entries, MODE_CACHE_HASH_BITS);
+};
+
+static void mode_cache_key_init(
+	struct mode_cache_key *key,
+	const struct drm_display_mode *mode)
+{
+	memset(key, 0, sizeof(*key));
+	key->clock = mode->clock;
+	key->hdisplay = mode->hdisplay;
+	key->hsync_start = mode->hsync_start;
+	key->hsync_end = mode->hsync_end;
+	key->htotal = mode->htotal;
+	key->hskew = mode->hskew;
+	key->vdisplay = mode->vdisplay;
+	key->vsync_start = mode->vsync_start;
+	key->vsync_end = mode->vsync_end;
+	key->vtotal = mode->vtotal;
+	key->vscan = mode->vscan;
+	key->flags = mode->flags;
+}
+
+static u32 mode_cache_hash(const struct mode_cache_key *key)
+{
+	return jhash2((const u32 *)key, sizeof(*key) / sizeof(u32), 0);
+}
+
+/* Caller must hold cache->lock */
+static void mode_cache_flush(struct amdgpu_dm_mode_cache *cache)
+{
+	struct mode_cache_entry *entry;
+	struct hlist_node *tmp;
+	int bkt;
+
+	hash_for_each_safe(cache->entries, bkt, tmp, entry, node) {
+		hash_del(&entry->node);
+		kfree(entry);
+	}
+
+	cache->sink = NULL;
+	cache->num_entries = 0;
+}
+
+/*
+ * Returns the cache for the connector, flushed if it was filled for another
+ * sink or link capabilities. Returns with cache->lock held.
+ */
+static struct amdgpu_dm_mode_cache *mode_cache_get(
+	struct amdgpu_connector *aconnector,
+	const struct dc_sink *sink)
+{
+	struct amdgpu_dm_mode_cache *cache = aconnector->mode_cache;
+	const struct dc_link *link = aconnector->dc_link;
+
+	if (!cache) {
+		cache = kzalloc(sizeof(*cache), GFP_KERNEL);
+		if (!cache)
+			return NULL;
+
+		mutex_init(&cache->lock);
+		hash_init(cache->entries);
+		aconnector->mode_cache = cache;
+	}
+
+	mutex_lock(&cache->lock);
+
+	if (cache->sink != sink ||
+		memcmp(&cache->link_cap, &link->verified_link_cap,
+				sizeof(cache->link_cap))) {
+		mode_cache_flush(cache);
+		cache->sink = sink;
+		cache->link_cap = link->verified_link_cap;
+	}
+
+	return cache;
+}
+
+static bool mode_cache_lookup(
+	struct amdgpu_dm_mode_cache *cache,
+	const struct mode_cache_key *key,
+	int *status)
+{
+	struct mode_cache_entry *entry;
+
+	hash_for_each_possible(cache->entries, entry, node,
+			mode_cache_hash(key)) {
+		if (!memcmp(&entry->key, key, sizeof(*key))) {
+			*status = entry->status;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static void mode_cache_insert(
+	struct amdgpu_dm_mode_cache *cache,
+	const struct mode_cache_key *key,
+	int status)
+{
+	struct mode_cache_entry *entry;
+
+	if (cache->num_entries >= MODE_CACHE_MAX_ENTRIES) {
+		const struct dc_sink *sink = cache->sink;
+
+		mode_cache_flush(cache);
+		cache->sink = sink;
+	}
+
+	entry = kmalloc(sizeof(*entry), GFP_KERNEL);
+	if (!entry)
+		return;
+
+	entry->key = *key;
+	entry->status = status;
+	hash_add(cache->entries, &entry->node, mode_cache_hash(key));
+	cache->num_entries++;
+}
+
+void amdgpu_dm_connector_mode_cache_invalidate(
+	struct amdgpu_connector *aconnector)
+{
+	struct amdgpu_dm_mode_cache *cache = aconnector->mode_cache;
+
+	if (!cache)
+		return;
+
+	mutex_lock(&cache->lock);
+	mode_cache_flush(cache);
+	mutex_unlock(&cache->lock);
+}
+
+void amdgpu_dm_connector_mode_cache_fini(
+	struct amdgpu_connector *aconnector)
+{
+	struct amdgpu_dm_mode_cache *cache = aconnector->mode_cache;
+
+	if (!cache)
+		return;
+
+	mode_cache_flush(cache);
+	mutex_destroy(&cache->lock);
+	kfree(cache);
+	aconnector->mode_cache = NULL;
+}
+
 int amdgpu_dm_connector_mode_valid(
 		struct drm_connector *connector,
 		struct drm_display_mode *mode)
@@ -1346,6 +1530,8 @@ int amdgpu_dm_connector_mode_valid(
 	struct dc_stream *streams[1];
 	struct dc_target *target;
 	struct amdgpu_connector *aconnector = to_amdgpu_connector(connector);
+	struct amdgpu_dm_mode_cache *cache;
+	struct mode_cache_key key;
 
 	if ((mode->flags & DRM_MODE_FLAG_INTERLACE) ||
 			(mode->flags & DRM_MODE_FLAG_DBLSCAN))
@@ -1365,14 +1551,20 @@ int amdgpu_dm_connector_mode_valid(
 		goto stream_create_fail;
 	}
 
+	drm_mode_set_crtcinfo(mode, 0);
+
+	mode_cache_key_init(&key, mode);
+	cache = mode_cache_get(aconnector, dc_sink);
+	if (cache && mode_cache_lookup(cache, &key, &result))
+		goto cache_unlock;
+
 	streams[0] = dc_create_stream_for_sink(dc_sink);
 
 	if (NULL == streams[0]) {
 		DRM_ERROR("Failed to create stream for sink!\n");
-		goto stream_create_fail;
+		goto cache_unlock;
 	}
 
-	drm_mode_set_crtcinfo(mode, 0);
 	fill_stream_properties_from_drm_display_mode(streams[0], mode, connector);
 
 	target = dc_create_target_for_streams(streams, 1);
@@ -1391,9 +1583,15 @@ int amdgpu_dm_connector_mode_valid(
 	if (dc_validate_resources(adev->dm.dc, &val_set, 1))
 		result = MODE_OK;
 
+	if (cache)
+		mode_cache_insert(cache, &key, result);
+
 	dc_target_release(target);
 target_create_fail:
 	dc_stream_release(streams[0]);
+cache_unlock:
+	if (cache)
+		mutex_unlock(&cache->lock);
 stream_create_fail:
 	/* TODO: error handling*/
 	return result;
@@ -89,6 +89,12 @@ int amdgpu_dm_connector_mode_valid(
 	struct drm_connector *connector,
 	struct drm_display_mode *mode);
 
+void amdgpu_dm_connector_mode_cache_invalidate(
+	struct amdgpu_connector *aconnector);
+
+void amdgpu_dm_connector_mode_cache_fini(
+	struct amdgpu_connector *aconnector);
+
 void dm_restore_drm_connector_state(struct drm_device *dev, struct drm_connector *connector);
 
 void amdgpu_dm_add_sink_to_freesync_module(
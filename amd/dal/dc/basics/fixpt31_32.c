@@ -66,6 +66,10 @@ static inline uint64_t complete_integer_division_u64(
 #define GET_FRACTIONAL_PART(x) \
 	(FRACTIONAL_PART_MASK & (x))
 
+/* largest remainder that can be shifted by the fractional bits */
+#define MAX_FRACTIONAL_DIVIDEND \
+	(~0ULL >> BITS_PER_FRACTIONAL_PART)
+
 struct fixed31_32 dal_fixed31_32_from_fraction(
 	int64_t numerator,
 	int64_t denominator)
@@ -88,7 +92,15 @@ struct fixed31_32 dal_fixed31_32_from_fraction(
 	ASSERT(res_value <= LONG_MAX);
 
 	/* determine fractional part */
-	{
+	if (remainder <= MAX_FRACTIONAL_DIVIDEND) {
+		/* one division yields the same bits as the loop below */
+		uint64_t fraction = complete_integer_division_u64(
+			remainder << BITS_PER_FRACTIONAL_PART,
+			arg2_value,
+			&remainder);
+
+		res_value = (res_value << BITS_PER_FRACTIONAL_PART) | fraction;
+	} else {
 		uint32_t i = BITS_PER_FRACTIONAL_PART;
 
 		do {
@@ -278,52 +290,87 @@ struct fixed31_32 dal_fixed31_32_mul_int(
 		dal_fixed31_32_from_int(arg2));
 }
 
-struct fixed31_32 dal_fixed31_32_mul(
-	struct fixed31_32 arg1,
-	struct fixed31_32 arg2)
+/*
+ * @brief
+ * result = arg1_value * arg2_value, both unsigned fixed point
+ * Both variants give the same bits, including the rounding term
+ * which comes from the product of the fractional parts alone.
+ */
+#if defined(CONFIG_ARCH_SUPPORTS_INT128) && defined(__SIZEOF_INT128__)
+static inline uint64_t mul_abs(
+	uint64_t arg1_value,
+	uint64_t arg2_value)
 {
-	struct fixed31_32 res;
+	unsigned __int128 res = (unsigned __int128)arg1_value * arg2_value;
 
-	bool arg1_negative = arg1.value < 0;
-	bool arg2_negative = arg2.value < 0;
+	uint64_t summand = GET_FRACTIONAL_PART(arg1_value) *
+		GET_FRACTIONAL_PART(arg2_value) >=
+			(uint64_t)dal_fixed31_32_half.value;
 
-	uint64_t arg1_value = arg1_negative ? -arg1.value : arg1.value;
-	uint64_t arg2_value = arg2_negative ? -arg2.value : arg2.value;
+	res >>= BITS_PER_FRACTIONAL_PART;
 
+	ASSERT(res <= (uint64_t)LLONG_MAX - summand);
+
+	return (uint64_t)res + summand;
+}
+#else
+static inline uint64_t mul_abs(
+	uint64_t arg1_value,
+	uint64_t arg2_value)
+{
 	uint64_t arg1_int = GET_INTEGER_PART(arg1_value);
 	uint64_t arg2_int = GET_INTEGER_PART(arg2_value);
 
 	uint64_t arg1_fra = GET_FRACTIONAL_PART(arg1_value);
 	uint64_t arg2_fra = GET_FRACTIONAL_PART(arg2_value);
 
+	uint64_t res;
 	uint64_t tmp;
 
-	res.value = arg1_int * arg2_int;
+	res = arg1_int * arg2_int;
 
-	ASSERT(res.value <= LONG_MAX);
+	ASSERT(res <= LONG_MAX);
 
-	res.value <<= BITS_PER_FRACTIONAL_PART;
+	res <<= BITS_PER_FRACTIONAL_PART;
 
 	tmp = arg1_int * arg2_fra;
 
-	ASSERT(tmp <= (uint64_t)(LLONG_MAX - res.value));
+	ASSERT(tmp <= (uint64_t)LLONG_MAX - res);
 
-	res.value += tmp;
+	res += tmp;
 
 	tmp = arg2_int * arg1_fra;
 
-	ASSERT(tmp <= (uint64_t)(LLONG_MAX - res.value));
+	ASSERT(tmp <= (uint64_t)LLONG_MAX - res);
 
-	res.value += tmp;
+	res += tmp;
 
 	tmp = arg1_fra * arg2_fra;
 
 	tmp = (tmp >> BITS_PER_FRACTIONAL_PART) +
 		(tmp >= (uint64_t)dal_fixed31_32_half.value);
 
-	ASSERT(tmp <= (uint64_t)(LLONG_MAX - res.value));
+	ASSERT(tmp <= (uint64_t)LLONG_MAX - res);
 
-	res.value += tmp;
+	res += tmp;
+
+	return res;
+}
+#endif
+
+struct fixed31_32 dal_fixed31_32_mul(
+	struct fixed31_32 arg1,
+	struct fixed31_32 arg2)
+{
+	struct fixed31_32 res;
+
+	bool arg1_negative = arg1.value < 0;
+	bool arg2_negative = arg2.value < 0;
+
+	uint64_t arg1_value = arg1_negative ? -arg1.value : arg1.value;
+	uint64_t arg2_value = arg2_negative ? -arg2.value : arg2.value;
+
+	res.value = (int64_t)mul_abs(arg1_value, arg2_value);
 
 	if (arg1_negative ^ arg2_negative)
 		res.value = -res.value;
@@ -290,23 +290,17 @@ static const struct log_major_mask_info log_major_mask_info_tbl[] = {
 static bool construct(struct dc_context *ctx, struct dal_logger *logger)
 {
 	uint32_t i;
-	/* malloc buffer and init offsets */
+	/* malloc per-CPU rings, their buffers come with ENABLE_BUFFER */
 
-	logger->log_buffer_size = DAL_LOGGER_BUFFER_MAX_SIZE;
-	logger->log_buffer = (char *)dm_alloc(logger->log_buffer_size *
-		sizeof(char));
+	logger->ring_count = dm_get_cpu_count();
+	logger->rings = dm_alloc(logger->ring_count *
+		sizeof(struct dal_logger_ring));
 
-	if (!logger->log_buffer)
+	if (!logger->rings)
 		return false;
 
-	/* todo: Fill buffer with \0 if not done by dal_alloc */
-
-	/* Initialize both offsets to start of buffer (empty) */
-	logger->buffer_read_offset = 0;
-	logger->buffer_write_offset = 0;
-
-	logger->write_wrap_count = 0;
-	logger->read_wrap_count = 0;
+	logger->read_line_offset = 0;
+	logger->read_line_size = 0;
 	logger->open_count = 0;
 
 	logger->flags.bits.ENABLE_CONSOLE = 1;
@@ -318,8 +312,11 @@ static bool construct(struct dc_context *ctx, struct dal_logger *logger)
 	logger->log_enable_mask_minors =
 			(uint32_t *)dm_alloc(NUM_ELEMENTS(log_major_mask_info_tbl)
 				* sizeof(uint32_t));
-	if (!logger->log_enable_mask_minors)
+	if (!logger->log_enable_mask_minors) {
+		dm_free(logger->rings);
+		logger->rings = NULL;
 		return false;
+	}
 
 	/* Set default values for mask */
 	for (i = 0; i < NUM_ELEMENTS(log_major_mask_info_tbl); i++) {
@@ -334,9 +331,14 @@ static bool construct(struct dc_context *ctx, struct dal_logger *logger)
 
 static void destruct(struct dal_logger *logger)
 {
-	if (logger->log_buffer) {
-		dm_free(logger->log_buffer);
-		logger->log_buffer = NULL;
+	uint32_t i;
+
+	if (logger->rings) {
+		for (i = 0; i < logger->ring_count; i++)
+			dm_free(logger->rings[i].buf);
+
+		dm_free(logger->rings);
+		logger->rings = NULL;
 	}
 
 	if (logger->log_enable_mask_minors) {
@@ -373,154 +375,247 @@ uint32_t dal_logger_destroy(struct dal_logger **logger)
 
 /* ------------------------------------------------------------------------ */
 
-static void lock(struct dal_logger *logger)
+/* Log records are kept 8 byte aligned in the per-CPU rings. Each record
+ * carries an already formatted line, heading included.
+ */
+struct log_record_header {
+	uint16_t size; /* header, payload and padding */
+	uint8_t major; /* LOG_RECORD_PAD for the filler before a wrap */
+	uint8_t minor;
+	uint32_t length; /* text length */
+	uint64_t timestamp;
+};
+
+#define LOG_RECORD_PAD 0xFF
+#define LOG_RECORD_ALIGN(size) (((size) + 7) & ~7)
+#define LOG_RECORD_HEADER_SIZE LOG_RECORD_ALIGN(sizeof(struct log_record_header))
+
+/* Longest "[Major_Minor]\t" heading */
+#define LOG_HEADING_MAX_SIZE 64
+
+static uint32_t format_to_buffer(
+	char *buffer,
+	uint32_t buffer_size,
+	const char *format,
+	...)
+{
+	va_list args;
+	uint32_t size;
+
+	va_start(args, format);
+	size = dm_log_to_buffer(buffer, buffer_size, format, args);
+	va_end(args);
+
+	/* Clip to what actually landed in the buffer */
+	if (size >= buffer_size)
+		size = buffer_size - 1;
+
+	return size;
+}
+
+/* Reserve 'size' contiguous bytes in the ring, inserting a pad record
+ * when the space left before the end is too short. Returns NULL when the
+ * ring is full, otherwise '*advance' is what ring_commit has to add.
+ */
+static uint8_t *ring_reserve(
+	struct dal_logger_ring *ring,
+	uint32_t size,
+	uint32_t *advance)
 {
-	/* Todo: lock mutex? */
+	uint32_t head = ring->head;
+	uint32_t tail = ring->tail;
+	uint32_t offset = head & (DAL_LOGGER_RING_SIZE - 1);
+	uint32_t pad = 0;
+
+	/* Order the tail read before overwriting what the consumer freed */
+	dm_mem_barrier();
+
+	if (DAL_LOGGER_RING_SIZE - offset < size)
+		pad = DAL_LOGGER_RING_SIZE - offset;
+
+	if (DAL_LOGGER_RING_SIZE - (head - tail) < pad + size)
+		return NULL;
+
+	if (pad) {
+		struct log_record_header *filler =
+			(struct log_record_header *)(ring->buf + offset);
+
+		filler->size = pad;
+		filler->major = LOG_RECORD_PAD;
+		offset = 0;
+	}
+
+	*advance = pad + size;
+	return ring->buf + offset;
 }
 
-static void unlock(struct dal_logger *logger)
+static void ring_commit(struct dal_logger_ring *ring, uint32_t advance)
 {
-	/* Todo: unlock mutex */
+	/* Publish the record before the new head */
+	dm_write_barrier();
+	ring->head += advance;
 }
 
-bool dal_logger_should_log(
-	struct dal_logger *logger,
-	enum log_major major,
-	enum log_minor minor)
+/* Oldest unread record of the ring or NULL. Consumer side only. */
+static struct log_record_header *ring_peek(struct dal_logger_ring *ring)
 {
-	if (major < LOG_MAJOR_COUNT) {
+	while (ring->buf) {
+		struct log_record_header *record;
+		uint32_t head = ring->head;
 
-		uint32_t minor_mask = logger->log_enable_mask_minors[major];
+		if (head == ring->tail)
+			return NULL;
 
-		if ((minor_mask & (1 << minor)) != 0)
-			return true;
+		/* Read the record only after seeing the head covering it */
+		dm_read_barrier();
+
+		record = (struct log_record_header *)(ring->buf +
+			(ring->tail & (DAL_LOGGER_RING_SIZE - 1)));
+
+		if (record->major != LOG_RECORD_PAD)
+			return record;
+
+		dm_mem_barrier();
+		ring->tail += record->size;
 	}
 
-	return false;
+	return NULL;
 }
 
-static void log_to_debug_console(struct log_entry *entry)
+static void ring_release(struct dal_logger_ring *ring, uint32_t size)
 {
-	struct dal_logger *logger = entry->logger;
+	/* Finish reading the record before the producer may reuse it */
+	dm_mem_barrier();
+	ring->tail += size;
+}
 
-	if (logger->flags.bits.ENABLE_CONSOLE == 0)
-		return;
+static bool allocate_rings(struct dal_logger *logger)
+{
+	uint32_t i;
 
-	if (entry->buf_offset) {
-		switch (entry->major) {
-		case LOG_MAJOR_ERROR:
-			dm_error("%s", entry->buf);
-			break;
-		default:
-			dm_output_to_console("%s", entry->buf);
-			break;
-		}
+	for (i = 0; i < logger->ring_count; i++) {
+		struct dal_logger_ring *ring = &logger->rings[i];
+
+		if (ring->buf)
+			continue;
+
+		ring->buf = dm_alloc(DAL_LOGGER_RING_SIZE);
+
+		if (!ring->buf)
+			return false;
 	}
+
+	return true;
 }
 
-/* Print everything unread existing in log_buffer to debug console*/
-static void flush_to_debug_console(struct dal_logger *logger)
+/* Lock free: every CPU only ever writes its own ring, with interrupts
+ * masked while doing so, and dal_logger_read is the only consumer.
+ */
+static void log_to_ring(
+	struct dal_logger *logger,
+	struct log_record_header *header,
+	const void *payload,
+	uint32_t payload_size)
 {
-	int i = logger->buffer_read_offset;
-	char *string_start = &logger->log_buffer[i];
+	struct dal_logger_ring *ring;
+	unsigned long irq_flags;
+	uint32_t cpu;
+	uint32_t advance;
+	uint8_t *record;
 
-	dm_output_to_console(
-		"---------------- FLUSHING LOG BUFFER ----------------\n");
-	while (i < logger->buffer_write_offset)	{
+	header->size = LOG_RECORD_HEADER_SIZE + LOG_RECORD_ALIGN(payload_size);
 
-		if (logger->log_buffer[i] == '\0') {
-			dm_output_to_console("%s", string_start);
-			string_start = (char *)logger->log_buffer + i + 1;
-		}
-		i++;
+	/* Pairs with the barrier in dal_logger_set_flags */
+	dm_read_barrier();
+
+	cpu = dm_get_cpu(&irq_flags);
+
+	if (cpu >= logger->ring_count || !logger->rings[cpu].buf)
+		goto out;
+
+	ring = &logger->rings[cpu];
+	header->timestamp = dm_get_timestamp(logger->ctx);
+
+	record = ring_reserve(ring, header->size, &advance);
+
+	if (!record) {
+		ring->dropped++;
+		goto out;
 	}
-	dm_output_to_console(
-		"-------------- END FLUSHING LOG BUFFER --------------\n\n");
+
+	memmove(record, header, sizeof(*header));
+	memmove(record + LOG_RECORD_HEADER_SIZE, payload, payload_size);
+	ring_commit(ring, advance);
+
+out:
+	dm_put_cpu(irq_flags);
 }
 
-static void log_to_internal_buffer(struct log_entry *entry)
+static void log_text_to_ring(
+	struct dal_logger *logger,
+	enum log_major major,
+	enum log_minor minor,
+	const char *text,
+	uint32_t length)
 {
-
-	uint32_t size = entry->buf_offset;
-	struct dal_logger *logger = entry->logger;
+	struct log_record_header header = { 0 };
 
 	if (logger->flags.bits.ENABLE_BUFFER == 0)
 		return;
 
-	if (logger->log_buffer == NULL)
-		return;
+	header.major = major;
+	header.minor = minor;
+	header.length = length;
 
-	if (size > 0 && size < logger->log_buffer_size) {
-
-		int total_free_space = 0;
-		int space_before_wrap = 0;
-
-		if (logger->buffer_write_offset > logger->buffer_read_offset) {
-			total_free_space = logger->log_buffer_size -
-					logger->buffer_write_offset +
-					logger->buffer_read_offset;
-			space_before_wrap = logger->log_buffer_size -
-					logger->buffer_write_offset;
-		} else if (logger->buffer_write_offset <
-				logger->buffer_read_offset) {
-			total_free_space = logger->log_buffer_size -
-					logger->buffer_read_offset +
-					logger->buffer_write_offset;
-			space_before_wrap = total_free_space;
-		} else if (logger->write_wrap_count !=
-				logger->read_wrap_count) {
-			/* Buffer is completely full already */
-			total_free_space = 0;
-			space_before_wrap = 0;
-		} else {
-			/* Buffer is empty, start writing at beginning */
-			total_free_space = logger->log_buffer_size;
-			space_before_wrap = logger->log_buffer_size;
-			logger->buffer_write_offset = 0;
-			logger->buffer_read_offset = 0;
-		}
+	log_to_ring(logger, &header, text, length);
+}
 
-		if (space_before_wrap > size) {
-			/* No wrap around, copy 'size' bytes
-			 * from 'entry->buf' to 'log_buffer'
-			 */
-			memmove(logger->log_buffer +
-					logger->buffer_write_offset,
-					entry->buf, size);
-			logger->buffer_write_offset += size;
+/* ------------------------------------------------------------------------ */
 
-		} else if (total_free_space > size) {
-			/* We have enough room without flushing,
-			 * but need to wrap around */
+bool dal_logger_should_log(
+	struct dal_logger *logger,
+	enum log_major major,
+	enum log_minor minor)
+{
+	if (major < LOG_MAJOR_COUNT) {
 
-			int space_after_wrap = total_free_space -
-					space_before_wrap;
+		uint32_t minor_mask = logger->log_enable_mask_minors[major];
 
-			memmove(logger->log_buffer +
-					logger->buffer_write_offset,
-					entry->buf, space_before_wrap);
-			memmove(logger->log_buffer, entry->buf +
-					space_before_wrap, space_after_wrap);
+		if ((minor_mask & (1 << minor)) != 0)
+			return true;
+	}
 
-			logger->buffer_write_offset = space_after_wrap;
-			logger->write_wrap_count++;
+	return false;
+}
 
-		} else {
-			/* Not enough room remaining, we should flush
-			 * existing logs */
+static void print_to_debug_console(enum log_major major, const char *text)
+{
+	switch (major) {
+	case LOG_MAJOR_ERROR:
+		dm_error("%s", text);
+		break;
+	default:
+		dm_output_to_console("%s", text);
+		break;
+	}
+}
 
-			/* Flush existing unread logs to console */
-			flush_to_debug_console(logger);
+static void log_to_debug_console(struct log_entry *entry)
+{
+	struct dal_logger *logger = entry->logger;
 
-			/* Start writing to beginning of buffer */
-			memmove(logger->log_buffer, entry->buf, size);
-			logger->buffer_write_offset = size;
-			logger->buffer_read_offset = 0;
-		}
+	if (logger->flags.bits.ENABLE_CONSOLE == 0)
+		return;
 
-	}
+	if (entry->buf_offset)
+		print_to_debug_console(entry->major, entry->buf);
+}
 
-	unlock(logger);
+static void log_to_internal_buffer(struct log_entry *entry)
+{
+	if (entry->buf_offset)
+		log_text_to_ring(entry->logger, entry->major, entry->minor,
+			entry->buf, entry->buf_offset);
 }
 
 static void log_timestamp(struct log_entry *entry)
@@ -528,11 +623,16 @@ static void log_timestamp(struct log_entry *entry)
 /*	dal_logger_append(entry, "00:00:00 ");*/
 }
 
-static void log_major_minor(struct log_entry *entry)
+static uint32_t format_heading(
+	char *buffer,
+	uint32_t buffer_size,
+	enum log_major major,
+	enum log_minor minor)
 {
 	uint32_t i;
-	enum log_major major = entry->major;
-	enum log_minor minor = entry->minor;
+	uint32_t size = 0;
+
+	buffer[0] = '\0';
 
 	for (i = 0; i < NUM_ELEMENTS(log_major_mask_info_tbl); i++) {
 
@@ -541,7 +641,7 @@ static void log_major_minor(struct log_entry *entry)
 
 		if (maj_mask_info->major_info.major == major) {
 
-			dal_logger_append(entry, "[%s_",
+			size += format_to_buffer(buffer, buffer_size, "[%s_",
 					maj_mask_info->major_info.major_name);
 
 			if (maj_mask_info->minor_tbl != NULL) {
@@ -552,13 +652,34 @@ static void log_major_minor(struct log_entry *entry)
 					const struct log_minor_info *min_info = &maj_mask_info->minor_tbl[j];
 
 					if (min_info->minor == minor)
-						dal_logger_append(entry, "%s]\t", min_info->minor_name);
+						size += format_to_buffer(
+							buffer + size,
+							buffer_size - size,
+							"%s]\t",
+							min_info->minor_name);
 				}
 			}
 
 			break;
 		}
 	}
+
+	return size;
+}
+
+static void log_major_minor(struct log_entry *entry)
+{
+	if (!dal_logger_should_log(entry->logger, entry->major, entry->minor))
+		return;
+
+	if (!entry->buf) {
+		BREAK_TO_DEBUGGER();
+		return;
+	}
+
+	entry->buf_offset += format_heading(entry->buf + entry->buf_offset,
+		entry->max_buf_bytes - entry->buf_offset,
+		entry->major, entry->minor);
 }
 
 static void log_heading(struct log_entry *entry,
@@ -598,37 +719,40 @@ void dal_logger_write(
 	const char *msg,
 	...)
 {
+	union logger_flags flags;
+	uint32_t heading_size;
+	uint32_t size;
+	va_list args;
+	char text[LOG_HEADING_MAX_SIZE + DAL_LOGGER_BUFFER_MAX_LOG_LINE_SIZE];
 
-	if (logger && dal_logger_should_log(logger, major, minor)) {
+	if (!logger || !dal_logger_should_log(logger, major, minor))
+		return;
 
-		uint32_t size;
-		va_list args;
-		char buffer[DAL_LOGGER_BUFFER_MAX_LOG_LINE_SIZE];
-		struct log_entry entry;
+	flags = logger->flags;
 
-		va_start(args, msg);
-		dal_logger_open(logger, &entry, major, minor);
+	if (!flags.bits.ENABLE_CONSOLE && !flags.bits.ENABLE_BUFFER)
+		return;
 
-		size = dm_log_to_buffer(
-			buffer, DAL_LOGGER_BUFFER_MAX_LOG_LINE_SIZE, msg, args);
+	va_start(args, msg);
 
-		if (size > 0 && size <
-				DAL_LOGGER_BUFFER_MAX_LOG_LINE_SIZE - 1) {
+	heading_size = format_heading(
+		text, LOG_HEADING_MAX_SIZE, major, minor);
 
-			if (buffer[size] == '\0')
-				size++; /* Add one for null terminator */
+	size = dm_log_to_buffer(text + heading_size,
+		DAL_LOGGER_BUFFER_MAX_LOG_LINE_SIZE, msg, args);
 
-			/* Concatenate onto end of entry buffer */
-			append_entry(&entry, buffer, size);
-		} else {
-			append_entry(&entry,
-				"LOG_ERROR, line too long or null\n", 35);
-		}
+	va_end(args);
 
-		dal_logger_close(&entry);
-		va_end(args);
+	if (size == 0 || size >= DAL_LOGGER_BUFFER_MAX_LOG_LINE_SIZE - 1)
+		size = format_to_buffer(text + heading_size,
+			DAL_LOGGER_BUFFER_MAX_LOG_LINE_SIZE,
+			"LOG_ERROR, line too long or null\n");
 
-	}
+	if (flags.bits.ENABLE_CONSOLE)
+		print_to_debug_console(major, text);
+
+	log_text_to_ring(logger, major, minor, text,
+		heading_size + size);
 }
 
 /* Same as dal_logger_write, except without open() and close(), which must
@@ -670,6 +794,60 @@ void dal_logger_append(
 	}
 }
 
+/* Copy the oldest record across all CPU rings into logger->read_line */
+static bool read_next_line(struct dal_logger *logger)
+{
+	struct dal_logger_ring *oldest_ring = NULL;
+	struct log_record_header *oldest = NULL;
+	uint32_t size;
+	uint32_t i;
+
+	for (i = 0; i < logger->ring_count; i++) {
+		struct dal_logger_ring *ring = &logger->rings[i];
+		struct log_record_header *record;
+		uint32_t dropped = ring->dropped;
+
+		if (dropped != ring->dropped_reported) {
+			logger->read_line_size = format_to_buffer(
+				logger->read_line, sizeof(logger->read_line),
+				"LOG_WARNING, %u records dropped on cpu %u\n",
+				dropped - ring->dropped_reported, i);
+			logger->read_line_offset = 0;
+			ring->dropped_reported = dropped;
+			return true;
+		}
+
+		record = ring_peek(ring);
+
+		if (record && (!oldest ||
+				record->timestamp < oldest->timestamp)) {
+			oldest = record;
+			oldest_ring = ring;
+		}
+	}
+
+	if (!oldest)
+		return false;
+
+	size = oldest->length;
+	if (size >= sizeof(logger->read_line))
+		size = sizeof(logger->read_line) - 1;
+
+	memmove(logger->read_line,
+		(uint8_t *)oldest + LOG_RECORD_HEADER_SIZE, size);
+	logger->read_line[size] = '\0';
+
+	ring_release(oldest_ring, oldest->size);
+
+	logger->read_line_offset = 0;
+	logger->read_line_size = size;
+
+	return true;
+}
+
+/* Must not be called concurrently with itself; writers are never blocked.
+ * Returns non-zero while unread log data remains.
+ */
 uint32_t dal_logger_read(
 	struct dal_logger *logger, /* <[in] */
 	uint32_t output_buffer_size, /* <[in] */
@@ -677,9 +855,9 @@ uint32_t dal_logger_read(
 	uint32_t *bytes_read, /* >[out] */
 	bool single_line)
 {
-	uint32_t bytes_remaining = 0;
+	uint32_t bytes_remaining;
 	uint32_t bytes_read_count = 0;
-	bool keep_reading = true;
+	uint32_t i;
 
 	if (!logger || output_buffer == NULL || output_buffer_size == 0) {
 		BREAK_TO_DEBUGGER();
@@ -687,61 +865,33 @@ uint32_t dal_logger_read(
 		return 0;
 	}
 
-	lock(logger);
-
-	/* Read until null terminator (if single_line==true,
-	 *  max buffer size, or until we've read everything new
-	 */
-
-	do {
-		char cur;
-
-		/* Stop when we've read everything */
-		if (logger->buffer_read_offset ==
-			logger->buffer_write_offset) {
+	while (bytes_read_count < output_buffer_size) {
+		uint32_t size;
 
+		if (logger->read_line_offset == logger->read_line_size &&
+				!read_next_line(logger))
 			break;
-		}
 
-		cur = logger->log_buffer[logger->buffer_read_offset];
-		logger->buffer_read_offset++;
+		size = logger->read_line_size - logger->read_line_offset;
+		if (size > output_buffer_size - bytes_read_count)
+			size = output_buffer_size - bytes_read_count;
 
-		/* Wrap read pointer if at end */
-		if (logger->buffer_read_offset == logger->log_buffer_size) {
+		memmove(output_buffer + bytes_read_count,
+			logger->read_line + logger->read_line_offset, size);
+		bytes_read_count += size;
+		logger->read_line_offset += size;
 
-			logger->buffer_read_offset = 0;
-			logger->read_wrap_count++;
-		}
-
-		/* Don't send null terminators to buffer */
-		if (cur != '\0') {
-			output_buffer[bytes_read_count] = cur;
-			bytes_read_count++;
-		} else if (single_line) {
-			keep_reading = false;
-		}
-
-	} while (bytes_read_count <= output_buffer_size && keep_reading);
-
-	/* We assume that reading can never be ahead of writing */
-	if (logger->write_wrap_count > logger->read_wrap_count) {
-		bytes_remaining = logger->log_buffer_size -
-			logger->buffer_read_offset +
-			logger->buffer_write_offset;
-	} else {
-		bytes_remaining = logger->buffer_write_offset -
-				logger->buffer_read_offset;
+		if (single_line &&
+			logger->read_line_offset == logger->read_line_size)
+			break;
 	}
 
-	/* reset write/read wrap count to 0 if we've read everything */
-	if (bytes_remaining == 0) {
+	bytes_remaining = logger->read_line_size - logger->read_line_offset;
 
-		logger->write_wrap_count = 0;
-		logger->read_wrap_count = 0;
-	}
+	for (i = 0; i < logger->ring_count; i++)
+		bytes_remaining += logger->rings[i].head - logger->rings[i].tail;
 
 	*bytes_read = bytes_read_count;
-	unlock(logger);
 
 	return bytes_remaining;
 }
@@ -879,13 +1029,18 @@ void dal_logger_set_flags(
 		struct dal_logger *logger,
 		union logger_flags flags)
 {
+	if (flags.bits.ENABLE_BUFFER && !allocate_rings(logger))
+		flags.bits.ENABLE_BUFFER = 0;
+
+	/* Rings must be visible before writers can see ENABLE_BUFFER */
+	dm_write_barrier();
 
 	logger->flags = flags;
 }
 
 uint32_t dal_logger_get_buffer_size(struct dal_logger *logger)
 {
-	return DAL_LOGGER_BUFFER_MAX_SIZE;
+	return logger->ring_count * DAL_LOGGER_RING_SIZE;
 }
 
 uint32_t dal_logger_set_buffer_size(
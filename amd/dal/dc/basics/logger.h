@@ -26,8 +26,6 @@
 #ifndef __DAL_LOGGER_H__
 #define __DAL_LOGGER_H__
 
-/* Structure for keeping track of offsets, buffer, etc */
-
 #define DAL_LOGGER_BUFFER_MAX_SIZE 2048
 
 /*Connectivity log needs to output EDID, which needs at lease 256x3 bytes,
@@ -37,27 +35,38 @@
 
 #include "include/logger_types.h"
 
+/* Size of each per-CPU record ring, must be a power of two */
+#define DAL_LOGGER_RING_SIZE 8192
+
+/* Single producer (the owning CPU, interrupts masked) / single consumer
+ * (dal_logger_read) ring of log records. Head and tail are free running
+ * byte counters, the ring holds head - tail bytes.
+ */
+struct dal_logger_ring {
+	uint8_t *buf;
+	uint32_t head; /* written by producer only */
+	uint32_t tail; /* written by consumer only */
+	uint32_t dropped; /* written by producer only */
+	uint32_t dropped_reported; /* written by consumer only */
+};
+
 struct dal_logger {
 
-	/* How far into the circular buffer has been read by dsat
-	 * Read offset should never cross write offset. Write \0's to
-	 * read data just to be sure?
+	/* One record ring per possible CPU, buffers are allocated the
+	 * first time ENABLE_BUFFER is set
 	 */
-	uint32_t buffer_read_offset;
+	struct dal_logger_ring *rings;
+	uint32_t ring_count;
 
-	/* How far into the circular buffer we have written
-	 * Write offset should never cross read offset
+	/* Formatted line handed out by dal_logger_read in pieces when it
+	 * does not fit the caller's buffer
 	 */
-	uint32_t buffer_write_offset;
-
-	uint32_t write_wrap_count;
-	uint32_t read_wrap_count;
+	char read_line[DAL_LOGGER_BUFFER_MAX_SIZE];
+	uint32_t read_line_offset;
+	uint32_t read_line_size;
 
 	uint32_t open_count;
 
-	char *log_buffer;	/* Pointer to malloc'ed buffer */
-	uint32_t log_buffer_size; /* Size of circular buffer */
-
 	uint32_t *log_enable_mask_minors; /*array of masks for major elements*/
 
 	union logger_flags flags;
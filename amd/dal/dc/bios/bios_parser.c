@@ -82,6 +82,10 @@ static uint32_t get_dest_obj_list(struct bios_parser *bp,
 	ATOM_OBJECT *object, uint16_t **id_list);
 static ATOM_OBJECT *get_bios_object(struct bios_parser *bp,
 	struct graphics_object_id id);
+static struct bios_object_index_entry *get_object_index_entry(
+	struct bios_parser *bp,
+	struct graphics_object_id id);
+static bool build_object_index(struct bios_parser *bp);
 static enum bp_result get_gpio_i2c_info(struct bios_parser *bp,
 	ATOM_I2C_RECORD *record,
 	struct graphics_object_i2c_info *info);
@@ -90,9 +94,6 @@ static ATOM_HPD_INT_RECORD *get_hpd_record(struct bios_parser *bp,
 static struct device_id device_type_from_device_id(uint16_t device_id);
 static uint32_t signal_to_ss_id(enum as_signal_type signal);
 static uint32_t get_support_mask_for_device_id(struct device_id device_id);
-static ATOM_ENCODER_CAP_RECORD *get_encoder_cap_record(
-	struct bios_parser *bp,
-	ATOM_OBJECT *object);
 
 #define BIOS_IMAGE_SIZE_OFFSET 2
 #define BIOS_IMAGE_SIZE_UNIT 512
@@ -134,6 +135,9 @@ static void destruct(struct bios_parser *bp)
 {
 	if (bp->bios_local_image)
 		dm_free(bp->bios_local_image);
+
+	if (bp->object_index.entries)
+		dm_free(bp->object_index.entries);
 }
 
 void dal_bios_parser_destroy(struct dc_bios **dcb)
@@ -365,6 +369,7 @@ static enum bp_result bios_parser_get_i2c_info(struct dc_bios *dcb,
 	struct graphics_object_i2c_info *info)
 {
 	uint32_t offset;
+	struct bios_object_index_entry *entry;
 	ATOM_OBJECT *object;
 	ATOM_COMMON_RECORD_HEADER *header;
 	ATOM_I2C_RECORD *record;
@@ -373,7 +378,22 @@ static enum bp_result bios_parser_get_i2c_info(struct dc_bios *dcb,
 	if (!info)
 		return BP_RESULT_BADINPUT;
 
-	object = get_bios_object(bp, id);
+	entry = get_object_index_entry(bp, id);
+
+	if (!entry)
+		return BP_RESULT_BADINPUT;
+
+	/* the first I2C record almost always is the one; only walk the
+	 * list again if it is not usable */
+	if (entry->i2c_record) {
+		record = GET_IMAGE(ATOM_I2C_RECORD, entry->i2c_record);
+
+		if (record &&
+			get_gpio_i2c_info(bp, record, info) == BP_RESULT_OK)
+			return BP_RESULT_OK;
+	}
+
+	object = GET_IMAGE(ATOM_OBJECT, entry->object);
 
 	if (!object)
 		return BP_RESULT_BADINPUT;
@@ -599,18 +619,19 @@ static enum bp_result bios_parser_get_hpd_info(struct dc_bios *dcb,
 	struct graphics_object_hpd_info *info)
 {
 	struct bios_parser *bp = BP_FROM_DCB(dcb);
-	ATOM_OBJECT *object;
+	struct bios_object_index_entry *entry;
 	ATOM_HPD_INT_RECORD *record = NULL;
 
 	if (!info)
 		return BP_RESULT_BADINPUT;
 
-	object = get_bios_object(bp, id);
+	entry = get_object_index_entry(bp, id);
 
-	if (!object)
+	if (!entry)
 		return BP_RESULT_BADINPUT;
 
-	record = get_hpd_record(bp, object);
+	if (entry->hpd_record)
+		record = GET_IMAGE(ATOM_HPD_INT_RECORD, entry->hpd_record);
 
 	if (record != NULL) {
 		info->hpd_int_gpio_uid = record->ucHPDIntGPIOID;
@@ -628,38 +649,16 @@ static uint32_t bios_parser_get_gpio_record(
 	uint32_t record_size)
 {
 	struct bios_parser *bp = BP_FROM_DCB(dcb);
-	ATOM_COMMON_RECORD_HEADER *header = NULL;
 	ATOM_OBJECT_GPIO_CNTL_RECORD *record = NULL;
-	ATOM_OBJECT *object = get_bios_object(bp, id);
-	uint32_t offset;
+	struct bios_object_index_entry *entry = get_object_index_entry(bp, id);
 	uint32_t pins_number;
 	uint32_t i;
 
-	if (!object)
+	if (!entry || !entry->gpio_cntl_record)
 		return 0;
 
-	/* Initialise offset */
-	offset = le16_to_cpu(object->usRecordOffset)
-			+ bp->object_info_tbl_offset;
-
-	for (;;) {
-		/* Get record header */
-		header = GET_IMAGE(ATOM_COMMON_RECORD_HEADER, offset);
-		if (!header || header->ucRecordType == LAST_RECORD_TYPE ||
-			!header->ucRecordSize)
-			break;
-
-		/* If this is gpio control record - stop. We found the record */
-		if (header->ucRecordType == ATOM_OBJECT_GPIO_CNTL_RECORD_TYPE
-			&& header->ucRecordSize
-				>= sizeof(ATOM_OBJECT_GPIO_CNTL_RECORD)) {
-			record = (ATOM_OBJECT_GPIO_CNTL_RECORD *) header;
-			break;
-		}
-
-		/* Advance to next record */
-		offset += header->ucRecordSize;
-	}
+	record = GET_IMAGE(ATOM_OBJECT_GPIO_CNTL_RECORD,
+			entry->gpio_cntl_record);
 
 	/* If we did not find a record - return */
 	if (!record)
@@ -739,7 +738,7 @@ static enum bp_result bios_parser_get_device_tag(
 	struct connector_device_tag_info *info)
 {
 	struct bios_parser *bp = BP_FROM_DCB(dcb);
-	ATOM_OBJECT *object;
+	struct bios_object_index_entry *entry;
 	ATOM_CONNECTOR_DEVICE_TAG_RECORD *record = NULL;
 	ATOM_CONNECTOR_DEVICE_TAG *device_tag;
 
@@ -747,15 +746,18 @@ static enum bp_result bios_parser_get_device_tag(
 		return BP_RESULT_BADINPUT;
 
 	/* getBiosObject will return MXM object */
-	object = get_bios_object(bp, connector_object_id);
+	entry = get_object_index_entry(bp, connector_object_id);
 
-	if (!object) {
+	if (!entry) {
 		BREAK_TO_DEBUGGER(); /* Invalid object id */
 		return BP_RESULT_BADINPUT;
 	}
 
-	if (bios_parser_get_device_tag_record(bp, object, &record)
-		!= BP_RESULT_OK)
+	if (entry->device_tag_record)
+		record = GET_IMAGE(ATOM_CONNECTOR_DEVICE_TAG_RECORD,
+				entry->device_tag_record);
+
+	if (!record)
 		return BP_RESULT_NORECORD;
 
 	if (device_tag_index >= record->ucNumberOfDevice)
@@ -785,6 +787,19 @@ static enum bp_result bios_parser_get_firmware_info(
 	struct firmware_info *info)
 {
 	struct bios_parser *bp = BP_FROM_DCB(dcb);
+
+	if (!info)
+		return BP_RESULT_BADBIOSTABLE;
+
+	*info = bp->fw_info;
+
+	return bp->fw_info_result;
+}
+
+static enum bp_result decode_firmware_info(
+	struct bios_parser *bp,
+	struct firmware_info *info)
+{
 	enum bp_result result = BP_RESULT_BADBIOSTABLE;
 	ATOM_COMMON_TABLE_HEADER *header;
 	struct atom_data_revision revision;
@@ -2062,18 +2077,20 @@ static enum bp_result bios_parser_get_encoder_cap_info(
 	struct bp_encoder_cap_info *info)
 {
 	struct bios_parser *bp = BP_FROM_DCB(dcb);
-	ATOM_OBJECT *object;
+	struct bios_object_index_entry *entry;
 	ATOM_ENCODER_CAP_RECORD *record = NULL;
 
 	if (!info)
 		return BP_RESULT_BADINPUT;
 
-	object = get_bios_object(bp, object_id);
+	entry = get_object_index_entry(bp, object_id);
 
-	if (!object)
+	if (!entry)
 		return BP_RESULT_BADINPUT;
 
-	record = get_encoder_cap_record(bp, object);
+	if (entry->encoder_cap_record)
+		record = GET_IMAGE(ATOM_ENCODER_CAP_RECORD,
+				entry->encoder_cap_record);
 	if (!record)
 		return BP_RESULT_NORECORD;
 
@@ -2082,56 +2099,6 @@ static enum bp_result bios_parser_get_encoder_cap_info(
 	return BP_RESULT_OK;
 }
 
-/**
- * get_encoder_cap_record
- *
- * @brief
- *  Get encoder cap record for the object
- *
- * @param object, ATOM object
- *
- * @return atom encoder cap record
- *
- * @note
- *  search all records to find the ATOM_ENCODER_CAP_RECORD record
- */
-static ATOM_ENCODER_CAP_RECORD *get_encoder_cap_record(
-	struct bios_parser *bp,
-	ATOM_OBJECT *object)
-{
-	ATOM_COMMON_RECORD_HEADER *header;
-	uint32_t offset;
-
-	if (!object) {
-		BREAK_TO_DEBUGGER(); /* Invalid object */
-		return NULL;
-	}
-
-	offset = le16_to_cpu(object->usRecordOffset)
-					+ bp->object_info_tbl_offset;
-
-	for (;;) {
-		header = GET_IMAGE(ATOM_COMMON_RECORD_HEADER, offset);
-
-		if (!header)
-			return NULL;
-
-		offset += header->ucRecordSize;
-
-		if (LAST_RECORD_TYPE == header->ucRecordType ||
-				!header->ucRecordSize)
-			break;
-
-		if (ATOM_ENCODER_CAP_RECORD_TYPE != header->ucRecordType)
-			continue;
-
-		if (sizeof(ATOM_ENCODER_CAP_RECORD) <= header->ucRecordSize)
-			return (ATOM_ENCODER_CAP_RECORD *)header;
-	}
-
-	return NULL;
-}
-
 /**
  * bios_parser_get_din_connector_info
  * @brief
@@ -2150,11 +2117,9 @@ static enum bp_result bios_parser_get_din_connector_info(
 	struct din_connector_info *info)
 {
 	struct bios_parser *bp = BP_FROM_DCB(dcb);
-	ATOM_COMMON_RECORD_HEADER *header;
+	struct bios_object_index_entry *entry;
 	ATOM_CONNECTOR_CVTV_SHARE_DIN_RECORD *record = NULL;
-	ATOM_OBJECT *object;
-	uint32_t offset;
-	enum bp_result result = BP_RESULT_NORECORD;
+	enum bp_result result = BP_RESULT_OK;
 
 	/* no output buffer provided */
 	if (!info) {
@@ -2162,46 +2127,20 @@ static enum bp_result bios_parser_get_din_connector_info(
 		return BP_RESULT_BADINPUT;
 	}
 
-	object = get_bios_object(bp, id);
-	if (!object) {
+	entry = get_object_index_entry(bp, id);
+	if (!entry) {
 		BREAK_TO_DEBUGGER(); /* Invalid object id */;
 		return BP_RESULT_BADINPUT;
 	}
 
-	offset = le16_to_cpu(object->usRecordOffset)
-						+ bp->object_info_tbl_offset;
-
-	for (;;) {
-		header = GET_IMAGE(ATOM_COMMON_RECORD_HEADER, offset);
-
-		if (!header) {
-			result = BP_RESULT_BADBIOSTABLE;
-			break;
-		}
-
-		offset += header->ucRecordSize;
-
-		/* get out of the loop if no more records */
-		if (LAST_RECORD_TYPE == header->ucRecordType ||
-				!header->ucRecordSize)
-			break;
-
-		if (ATOM_CONNECTOR_CVTV_SHARE_DIN_RECORD_TYPE !=
-				header->ucRecordType)
-			continue;
-
-		if (sizeof(ATOM_CONNECTOR_CVTV_SHARE_DIN_RECORD)
-				> header->ucRecordSize)
-			continue;
-
-		record = (ATOM_CONNECTOR_CVTV_SHARE_DIN_RECORD *)header;
-		result = BP_RESULT_OK;
-		break;
-	}
+	if (entry->din_record)
+		record = GET_IMAGE(ATOM_CONNECTOR_CVTV_SHARE_DIN_RECORD,
+				entry->din_record);
 
 	/* return if the record not found */
-	if (result != BP_RESULT_OK)
-		return result;
+	if (!record)
+		return entry->records_truncated ?
+			BP_RESULT_BADBIOSTABLE : BP_RESULT_NORECORD;
 
 	info->gpio_id = record->ucGPIOID;
 	info->gpio_tv_active_state = (record->ucTVActiveState != 0);
@@ -2452,9 +2391,47 @@ static enum bp_result bios_parser_get_gpio_pin_info(
 	struct gpio_pin_info *info)
 {
 	struct bios_parser *bp = BP_FROM_DCB(dcb);
+	ATOM_GPIO_PIN_LUT *header;
+	uint32_t i;
+
+	if (bp->gpio_pin_lut_result != BP_RESULT_OK)
+		return bp->gpio_pin_lut_result;
+
+	if (gpio_id >= BIOS_GPIO_PIN_LUT_INDEX_SIZE ||
+		bp->gpio_pin_lut_index[gpio_id] == BIOS_OBJECT_INDEX_END)
+		return BP_RESULT_NORECORD;
+
+	header = GET_IMAGE(ATOM_GPIO_PIN_LUT, DATA_TABLES(GPIO_Pin_LUT));
+	i = bp->gpio_pin_lut_index[gpio_id];
+
+	info->offset =
+		(uint32_t) le16_to_cpu(header->asGPIO_Pin[i].usGpioPin_AIndex);
+	info->offset_y = info->offset + 2;
+	info->offset_en = info->offset + 1;
+	info->offset_mask = info->offset - 1;
+
+	info->mask = (uint32_t) (1 <<
+		header->asGPIO_Pin[i].ucGpioPinBitShift);
+	info->mask_y = info->mask + 2;
+	info->mask_en = info->mask + 1;
+	info->mask_mask = info->mask - 1;
+
+	return BP_RESULT_OK;
+}
+
+/*
+ * Map each GPIO ID to its first entry in GPIO_Pin_LUT, so that
+ * bios_parser_get_gpio_pin_info() does not have to scan the table.
+ */
+static enum bp_result index_gpio_pin_lut(struct bios_parser *bp)
+{
 	ATOM_GPIO_PIN_LUT *header;
 	uint32_t count = 0;
 	uint32_t i = 0;
+	uint8_t id;
+
+	for (i = 0; i < BIOS_GPIO_PIN_LUT_INDEX_SIZE; ++i)
+		bp->gpio_pin_lut_index[i] = BIOS_OBJECT_INDEX_END;
 
 	if (!DATA_TABLES(GPIO_Pin_LUT))
 		return BP_RESULT_BADBIOSTABLE;
@@ -2473,26 +2450,14 @@ static enum bp_result bios_parser_get_gpio_pin_info(
 	count = (le16_to_cpu(header->sHeader.usStructureSize)
 			- sizeof(ATOM_COMMON_TABLE_HEADER))
 				/ sizeof(ATOM_GPIO_PIN_ASSIGNMENT);
-	for (i = 0; i < count; ++i) {
-		if (header->asGPIO_Pin[i].ucGPIO_ID != gpio_id)
-			continue;
-
-		info->offset =
-			(uint32_t) le16_to_cpu(header->asGPIO_Pin[i].usGpioPin_AIndex);
-		info->offset_y = info->offset + 2;
-		info->offset_en = info->offset + 1;
-		info->offset_mask = info->offset - 1;
+	for (i = 0; i < count && i < BIOS_OBJECT_INDEX_END; ++i) {
+		id = header->asGPIO_Pin[i].ucGPIO_ID;
 
-		info->mask = (uint32_t) (1 <<
-			header->asGPIO_Pin[i].ucGpioPinBitShift);
-		info->mask_y = info->mask + 2;
-		info->mask_en = info->mask + 1;
-		info->mask_mask = info->mask - 1;
-
-		return BP_RESULT_OK;
+		if (bp->gpio_pin_lut_index[id] == BIOS_OBJECT_INDEX_END)
+			bp->gpio_pin_lut_index[id] = i;
 	}
 
-	return BP_RESULT_NORECORD;
+	return BP_RESULT_OK;
 }
 
 static enum bp_result get_gpio_i2c_info(struct bios_parser *bp,
@@ -2570,14 +2535,120 @@ static enum bp_result get_gpio_i2c_info(struct bios_parser *bp,
 	return BP_RESULT_OK;
 }
 
+static uint32_t object_index_hash(struct graphics_object_id id)
+{
+	return (id.id ^ (id.enum_id << 3) ^ (id.type << 1)) &
+		(BIOS_OBJECT_HASH_SIZE - 1);
+}
+
+static struct bios_object_index_entry *get_object_index_entry(
+	struct bios_parser *bp,
+	struct graphics_object_id id)
+{
+	struct bios_object_index *index = &bp->object_index;
+	struct bios_object_index_entry *entry;
+	uint16_t i;
+
+	if (!dal_graphics_object_id_is_valid(id))
+		return NULL;
+
+	for (i = index->hash[object_index_hash(id)];
+		i != BIOS_OBJECT_INDEX_END; i = entry->next) {
+		entry = &index->entries[i];
+
+		if (dal_graphics_object_id_is_equal(entry->id, id))
+			return entry;
+	}
+
+	return NULL;
+}
+
 static ATOM_OBJECT *get_bios_object(struct bios_parser *bp,
 	struct graphics_object_id id)
 {
+	struct bios_object_index_entry *entry =
+		get_object_index_entry(bp, id);
+
+	if (!entry)
+		return NULL;
+
+	return GET_IMAGE(ATOM_OBJECT, entry->object);
+}
+
+/*
+ * Walk the record list of an object once, remembering the first usable
+ * record of each type the queries look up.
+ */
+static void index_object_records(struct bios_parser *bp,
+	struct bios_object_index_entry *entry,
+	ATOM_OBJECT *object)
+{
+	ATOM_COMMON_RECORD_HEADER *header;
 	uint32_t offset;
-	ATOM_OBJECT_TABLE *tbl;
-	uint32_t i;
+	uint8_t size;
+
+	offset = le16_to_cpu(object->usRecordOffset)
+			+ bp->object_info_tbl_offset;
+
+	for (;;) {
+		header = GET_IMAGE(ATOM_COMMON_RECORD_HEADER, offset);
+
+		if (!header) {
+			entry->records_truncated = true;
+			break;
+		}
 
-	switch (id.type) {
+		size = header->ucRecordSize;
+
+		if (LAST_RECORD_TYPE == header->ucRecordType || !size)
+			break;
+
+		switch (header->ucRecordType) {
+		case ATOM_HPD_INT_RECORD_TYPE:
+			if (!entry->hpd_record &&
+				sizeof(ATOM_HPD_INT_RECORD) <= size)
+				entry->hpd_record = offset;
+			break;
+		case ATOM_I2C_RECORD_TYPE:
+			if (!entry->i2c_record &&
+				sizeof(ATOM_I2C_RECORD) <= size)
+				entry->i2c_record = offset;
+			break;
+		case ATOM_ENCODER_CAP_RECORD_TYPE:
+			if (!entry->encoder_cap_record &&
+				sizeof(ATOM_ENCODER_CAP_RECORD) <= size)
+				entry->encoder_cap_record = offset;
+			break;
+		case ATOM_CONNECTOR_DEVICE_TAG_RECORD_TYPE:
+			if (!entry->device_tag_record &&
+				sizeof(ATOM_CONNECTOR_DEVICE_TAG) <= size)
+				entry->device_tag_record = offset;
+			break;
+		case ATOM_OBJECT_GPIO_CNTL_RECORD_TYPE:
+			if (!entry->gpio_cntl_record &&
+				sizeof(ATOM_OBJECT_GPIO_CNTL_RECORD) <= size)
+				entry->gpio_cntl_record = offset;
+			break;
+		case ATOM_CONNECTOR_CVTV_SHARE_DIN_RECORD_TYPE:
+			if (!entry->din_record &&
+				sizeof(ATOM_CONNECTOR_CVTV_SHARE_DIN_RECORD)
+					<= size)
+				entry->din_record = offset;
+			break;
+		default:
+			break;
+		}
+
+		offset += size;
+	}
+}
+
+static ATOM_OBJECT_TABLE *get_object_table(struct bios_parser *bp,
+	enum object_type type)
+{
+	uint32_t offset;
+
+	switch (type) {
 	case OBJECT_TYPE_ENCODER:
 		offset = le16_to_cpu(bp->object_info_tbl.v1_1->usEncoderObjectTableOffset);
 		break;
@@ -2602,17 +2673,80 @@ static ATOM_OBJECT *get_bios_object(struct bios_parser *bp,
 
 	offset += bp->object_info_tbl_offset;
 
-	tbl = GET_IMAGE(ATOM_OBJECT_TABLE, offset);
-	if (!tbl)
-		return NULL;
+	return GET_IMAGE(ATOM_OBJECT_TABLE, offset);
+}
 
-	for (i = 0; i < tbl->ucNumberOfObjects; i++)
-		if (dal_graphics_object_id_is_equal(id,
-				object_id_from_bios_object_id(
-						le16_to_cpu(tbl->asObjects[i].usObjectID))))
-			return &tbl->asObjects[i];
+static const enum object_type indexed_object_types[] = {
+	OBJECT_TYPE_ENCODER,
+	OBJECT_TYPE_CONNECTOR,
+	OBJECT_TYPE_ROUTER,
+	OBJECT_TYPE_GENERIC
+};
 
-	return NULL;
+/*
+ * Index every object of the encoder, connector, router and misc object
+ * tables by object id. Like the table walk it replaces, only objects
+ * whose id matches the table they are in can be found, and the first of
+ * several objects with the same id wins.
+ */
+static bool build_object_index(struct bios_parser *bp)
+{
+	struct bios_object_index *index = &bp->object_index;
+	struct bios_object_index_entry *entry;
+	struct graphics_object_id id;
+	ATOM_OBJECT_TABLE *tbl;
+	uint32_t total = 0;
+	uint32_t i, t, h;
+
+	for (t = 0; t < ARRAY_SIZE(indexed_object_types); t++) {
+		tbl = get_object_table(bp, indexed_object_types[t]);
+		if (tbl)
+			total += tbl->ucNumberOfObjects;
+	}
+
+	if (total > index->capacity) {
+		entry = dm_alloc(total * sizeof(*entry));
+		if (!entry)
+			return false;
+
+		if (index->entries)
+			dm_free(index->entries);
+		index->entries = entry;
+		index->capacity = total;
+	}
+
+	index->count = 0;
+	for (h = 0; h < BIOS_OBJECT_HASH_SIZE; h++)
+		index->hash[h] = BIOS_OBJECT_INDEX_END;
+
+	for (t = 0; t < ARRAY_SIZE(indexed_object_types); t++) {
+		tbl = get_object_table(bp, indexed_object_types[t]);
+		if (!tbl)
+			continue;
+
+		for (i = 0; i < tbl->ucNumberOfObjects; i++) {
+			id = object_id_from_bios_object_id(
+				le16_to_cpu(tbl->asObjects[i].usObjectID));
+
+			if (id.type != indexed_object_types[t] ||
+				!dal_graphics_object_id_is_valid(id) ||
+				get_object_index_entry(bp, id))
+				continue;
+
+			entry = &index->entries[index->count];
+			memset(entry, 0, sizeof(*entry));
+			entry->id = id;
+			entry->object =
+				(uint8_t *)&tbl->asObjects[i] - bp->bios;
+			index_object_records(bp, entry, &tbl->asObjects[i]);
+
+			h = object_index_hash(id);
+			entry->next = index->hash[h];
+			index->hash[h] = index->count++;
+		}
+	}
+
+	return true;
 }
 
 static uint32_t get_dest_obj_list(struct bios_parser *bp,
@@ -3903,6 +4037,10 @@ static void process_ext_display_connection_info(struct bios_parser *bp,
 			++connectors_num;
 		}
 		connector_tbl->ucNumberOfObjects = (uint8_t)connectors_num;
+
+		/* Step 4: Re-index the patched object tables */
+		if (!build_object_index(bp))
+			BREAK_TO_DEBUGGER();
 	}
 }
 
@@ -4522,12 +4660,18 @@ static bool bios_parser_construct(
 	else
 		return false;
 
+	if (!build_object_index(bp))
+		return false;
+
 #if defined(CONFIG_DRM_AMD_DAL_VBIOS_PRESENT)
 	dal_bios_parser_init_bios_helper(bp, dce_version);
 #endif
 	dal_bios_parser_init_cmd_tbl(bp);
 	dal_bios_parser_init_cmd_tbl_helper(&bp->cmd_helper, dce_version);
 
+	bp->fw_info_result = decode_firmware_info(bp, &bp->fw_info);
+	bp->gpio_pin_lut_result = index_gpio_pin_lut(bp);
+
 	return true;
 }
 
@@ -42,6 +42,33 @@ struct object_info_table {
 	};
 };
 
+#define BIOS_OBJECT_HASH_SIZE 32
+#define BIOS_OBJECT_INDEX_END 0xffff
+#define BIOS_GPIO_PIN_LUT_INDEX_SIZE 256
+
+/* Records of one display object, found once when the index is built.
+ * Offsets are into the BIOS image, 0 if the object has no such record. */
+struct bios_object_index_entry {
+	struct graphics_object_id id;
+	uint32_t object;
+	uint32_t hpd_record;
+	uint32_t i2c_record;
+	uint32_t encoder_cap_record;
+	uint32_t device_tag_record;
+	uint32_t gpio_cntl_record;
+	uint32_t din_record;
+	/* the record list ran off the image before its last record */
+	bool records_truncated;
+	uint16_t next;
+};
+
+struct bios_object_index {
+	struct bios_object_index_entry *entries;
+	uint32_t count;
+	uint32_t capacity;
+	uint16_t hash[BIOS_OBJECT_HASH_SIZE];
+};
+
 enum spread_spectrum_id {
 	SS_ID_UNKNOWN = 0,
 	SS_ID_DP1 = 0xf1,
@@ -73,6 +100,16 @@ struct bios_parser {
 
 	bool remap_device_tags;
 	bool headless_no_opm;
+
+	/* built at construction, and again once post_init patched the
+	 * object tables */
+	struct bios_object_index object_index;
+
+	/* decoded once at construction */
+	struct firmware_info fw_info;
+	enum bp_result fw_info_result;
+	enum bp_result gpio_pin_lut_result;
+	uint16_t gpio_pin_lut_index[BIOS_GPIO_PIN_LUT_INDEX_SIZE];
 };
 
 /* Bios Parser from DC Bios */
@@ -3963,14 +3963,8 @@ static bool is_display_configuration_supported(
 	return true;
 }
 
-/**
- * Return:
- *	true -	Display(s) configuration supported.
- *		In this case 'calcs_output' contains data for HW programming
- *	false - Display(s) configuration not supported (not enough bandwidth).
- */
-
-bool bw_calcs(struct dc_context *ctx, const struct bw_calcs_dceip *dceip,
+static bool calculate_bw_output(struct dc_context *ctx,
+	const struct bw_calcs_dceip *dceip,
 	const struct bw_calcs_vbios *vbios,
 	const struct bw_calcs_mode_data *mode_data,
 	struct bw_calcs_output *calcs_output)
@@ -4562,3 +4556,146 @@ bool bw_calcs(struct dc_context *ctx, const struct bw_calcs_dceip *dceip,
 
 	return is_display_configuration_supported(vbios, calcs_output);
 }
+
+/*
+ * Only the displays in use take part in the calculations, so the key is the
+ * header of the mode data plus the used part of displays_data.
+ */
+static uint32_t mode_data_key_size(const struct bw_calcs_mode_data *mode_data)
+{
+	uint32_t number_of_displays = mode_data->number_of_displays;
+
+	if (number_of_displays > BW_CALCS_MAX_NUM_DISPLAYS)
+		number_of_displays = BW_CALCS_MAX_NUM_DISPLAYS;
+
+	return offsetof(struct bw_calcs_mode_data, displays_data) +
+		number_of_displays *
+			sizeof(struct bw_calcs_input_single_display);
+}
+
+/* FNV-1a */
+static uint32_t mode_data_hash(const struct bw_calcs_mode_data *mode_data)
+{
+	const uint8_t *data = (const uint8_t *)mode_data;
+	uint32_t size = mode_data_key_size(mode_data);
+	uint32_t hash = 2166136261u;
+	uint32_t i;
+
+	for (i = 0; i < size; i++) {
+		hash ^= data[i];
+		hash *= 16777619u;
+	}
+
+	return hash;
+}
+
+static void bw_calcs_cache_flush(
+	struct bw_calcs_cache *cache,
+	const struct bw_calcs_dceip *dceip,
+	const struct bw_calcs_vbios *vbios)
+{
+	uint32_t i;
+
+	for (i = 0; i < BW_CALCS_CACHE_SIZE; i++)
+		cache->entries[i].valid = false;
+
+	cache->dceip = *dceip;
+	cache->vbios = *vbios;
+	cache->flushes++;
+}
+
+static struct bw_calcs_cache_entry *bw_calcs_cache_lookup(
+	struct bw_calcs_cache *cache,
+	const struct bw_calcs_mode_data *mode_data,
+	uint32_t hash)
+{
+	uint32_t i;
+
+	for (i = 0; i < BW_CALCS_CACHE_SIZE; i++) {
+		struct bw_calcs_cache_entry *entry = &cache->entries[i];
+
+		if (entry->valid && entry->hash == hash &&
+			!memcmp(&entry->mode_data, mode_data,
+				mode_data_key_size(mode_data)))
+			return entry;
+	}
+
+	return NULL;
+}
+
+static struct bw_calcs_cache_entry *bw_calcs_cache_victim(
+	struct bw_calcs_cache *cache)
+{
+	struct bw_calcs_cache_entry *victim = &cache->entries[0];
+	uint32_t i;
+
+	for (i = 0; i < BW_CALCS_CACHE_SIZE; i++) {
+		struct bw_calcs_cache_entry *entry = &cache->entries[i];
+
+		if (!entry->valid)
+			return entry;
+
+		if (cache->use_counter - entry->last_used >
+				cache->use_counter - victim->last_used)
+			victim = entry;
+	}
+
+	return victim;
+}
+
+/**
+ * Return:
+ *	true -	Display(s) configuration supported.
+ *		In this case 'calcs_output' contains data for HW programming
+ *	false - Display(s) configuration not supported (not enough bandwidth).
+ */
+
+bool bw_calcs(struct dc_context *ctx, const struct bw_calcs_dceip *dceip,
+	const struct bw_calcs_vbios *vbios,
+	const struct bw_calcs_mode_data *mode_data,
+	struct bw_calcs_cache *cache,
+	struct bw_calcs_output *calcs_output)
+{
+	struct bw_calcs_cache_entry *entry;
+	uint32_t hash;
+	bool supported;
+
+	if (!cache)
+		return calculate_bw_output(ctx, dceip, vbios, mode_data,
+				calcs_output);
+
+	mutex_lock(&cache->lock);
+
+	if (memcmp(&cache->dceip, dceip, sizeof(*dceip)) ||
+		memcmp(&cache->vbios, vbios, sizeof(*vbios)))
+		bw_calcs_cache_flush(cache, dceip, vbios);
+
+	cache->use_counter++;
+	hash = mode_data_hash(mode_data);
+
+	entry = bw_calcs_cache_lookup(cache, mode_data, hash);
+	if (entry) {
+		cache->hits++;
+		entry->last_used = cache->use_counter;
+		*calcs_output = entry->output;
+		supported = entry->supported;
+		goto out;
+	}
+
+	cache->misses++;
+	supported = calculate_bw_output(ctx, dceip, vbios, mode_data,
+			calcs_output);
+
+	entry = bw_calcs_cache_victim(cache);
+	entry->valid = true;
+	entry->supported = supported;
+	entry->hash = hash;
+	entry->last_used = cache->use_counter;
+	memmove(&entry->mode_data, mode_data,
+			mode_data_key_size(mode_data));
+	entry->output = *calcs_output;
+
+out:
+	mutex_unlock(&cache->lock);
+	return supported;
+}
@@ -48,6 +48,13 @@
 #define GET_FRACTIONAL_PART(x) \
 	(FRACTIONAL_PART_MASK & (x))
 
+#define HALF \
+	(1ULL << (BITS_PER_FRACTIONAL_PART - 1))
+
+/* largest remainder that can be shifted by the fractional bits */
+#define MAX_FRACTIONAL_DIVIDEND \
+	(~0ULL >> BITS_PER_FRACTIONAL_PART)
+
 static uint64_t abs_i64(int64_t arg)
 {
 	if (arg >= 0)
@@ -100,7 +107,15 @@ struct bw_fixed bw_frc_to_fixed(int64_t numerator, int64_t denominator)
 	ASSERT(res_value <= MAX_I32);
 
 	/* determine fractional part */
-	{
+	if (remainder <= MAX_FRACTIONAL_DIVIDEND) {
+		/* one division yields the same bits as the loop below */
+		uint64_t fraction = div64_u64_rem(
+			remainder << BITS_PER_FRACTIONAL_PART,
+			arg2_value,
+			&remainder);
+
+		res_value = (res_value << BITS_PER_FRACTIONAL_PART) | fraction;
+	} else {
 		uint32_t i = BITS_PER_FRACTIONAL_PART;
 
 		do
@@ -192,50 +207,74 @@ struct bw_fixed bw_sub(const struct bw_fixed arg1, const struct bw_fixed arg2)
 	return res;
 }
 
-struct bw_fixed bw_mul(const struct bw_fixed arg1, const struct bw_fixed arg2)
+/*
+ * Multiply absolute values. Both variants give the same bits, including the
+ * rounding term which comes from the product of the fractional parts alone.
+ */
+#if defined(CONFIG_ARCH_SUPPORTS_INT128) && defined(__SIZEOF_INT128__)
+static uint64_t mul_abs(uint64_t arg1_value, uint64_t arg2_value)
 {
-	struct bw_fixed res;
+	unsigned __int128 res = (unsigned __int128)arg1_value * arg2_value;
 
-	bool arg1_negative = arg1.value < 0;
-	bool arg2_negative = arg2.value < 0;
+	uint64_t summand = GET_FRACTIONAL_PART(arg1_value) *
+		GET_FRACTIONAL_PART(arg2_value) >= HALF;
+
+	res >>= BITS_PER_FRACTIONAL_PART;
 
-	uint64_t arg1_value = abs_i64(arg1.value);
-	uint64_t arg2_value = abs_i64(arg2.value);
+	ASSERT(res <= (uint64_t)MAX_I64 - summand);
 
+	return (uint64_t)res + summand;
+}
+#else
+static uint64_t mul_abs(uint64_t arg1_value, uint64_t arg2_value)
+{
 	uint64_t arg1_int = GET_INTEGER_PART(arg1_value);
 	uint64_t arg2_int = GET_INTEGER_PART(arg2_value);
 
 	uint64_t arg1_fra = GET_FRACTIONAL_PART(arg1_value);
 	uint64_t arg2_fra = GET_FRACTIONAL_PART(arg2_value);
 
+	uint64_t res;
 	uint64_t tmp;
 
-	res.value = arg1_int * arg2_int;
+	res = arg1_int * arg2_int;
 
-	ASSERT(res.value <= MAX_I32);
+	ASSERT(res <= MAX_I32);
 
-	res.value <<= BITS_PER_FRACTIONAL_PART;
+	res <<= BITS_PER_FRACTIONAL_PART;
 
 	tmp = arg1_int * arg2_fra;
 
-	ASSERT(tmp <= (uint64_t)(MAX_I64 - res.value));
+	ASSERT(tmp <= (uint64_t)MAX_I64 - res);
 
-	res.value += tmp;
+	res += tmp;
 
 	tmp = arg2_int * arg1_fra;
 
-	ASSERT(tmp <= (uint64_t)(MAX_I64 - res.value));
+	ASSERT(tmp <= (uint64_t)MAX_I64 - res);
 
-	res.value += tmp;
+	res += tmp;
 
 	tmp = arg1_fra * arg2_fra;
 
-	tmp = (tmp >> BITS_PER_FRACTIONAL_PART) +
-		(tmp >= (uint64_t)(bw_frc_to_fixed(1, 2).value));
+	tmp = (tmp >> BITS_PER_FRACTIONAL_PART) + (tmp >= HALF);
+
+	ASSERT(tmp <= (uint64_t)MAX_I64 - res);
+
+	res += tmp;
+
+	return res;
+}
+#endif
+
+struct bw_fixed bw_mul(const struct bw_fixed arg1, const struct bw_fixed arg2)
+{
+	struct bw_fixed res;
 
-	ASSERT(tmp <= (uint64_t)(MAX_I64 - res.value));
+	bool arg1_negative = arg1.value < 0;
+	bool arg2_negative = arg2.value < 0;
 
-	res.value += tmp;
+	res.value = (int64_t)mul_abs(abs_i64(arg1.value), abs_i64(arg2.value));
 
 	if (arg1_negative ^ arg2_negative)
 		res.value = -res.value;
@@ -792,14 +792,8 @@ static inline struct fixed31_32 calculate_oem_mapped_value(
 }
 
 static void build_regamma_curve(struct pwl_float_data_ex *rgb_regamma,
-		struct pwl_float_data *rgb_oem,
-		struct pixel_gamma_point *coeff128_oem,
-		const struct core_gamma *ramp,
-		const struct core_surface *surface,
 		uint32_t hw_points_num,
-		const struct hw_x_point *coordinate_x,
-		const struct gamma_pixel *axis_x,
-		struct dividers dividers)
+		const struct hw_x_point *coordinate_x)
 {
 	uint32_t i;
 
@@ -966,32 +960,19 @@ static inline void copy_rgb_regamma_to_coordinates_x(
 	}
 }
 
-static bool calculate_interpolated_hardware_curve(
+static void calculate_interpolated_hardware_curve(
 	struct pwl_result_data *rgb,
-	struct pixel_gamma_point *coeff128,
+	const struct pixel_gamma_point *coeff128,
 	struct pwl_float_data *rgb_user,
-	const struct hw_x_point *coordinates_x,
-	const struct gamma_pixel *axis_x_256,
-	uint32_t number_of_points,
-	enum surface_pixel_format pixel_format)
+	uint32_t number_of_points)
 {
 
-	const struct pixel_gamma_point *coeff;
-	struct pixel_gamma_point *coeff_128 = coeff128;
-	uint32_t max_entries = 3 - 1;
+	const struct pixel_gamma_point *coeff = coeff128;
+	uint32_t max_entries = 3 - 1 + RGB_256X3X16;
 	struct pwl_result_data *rgb_resulted = rgb;
 
 	uint32_t i = 0;
 
-	if (!build_oem_custom_gamma_mapping_coefficients(
-			coeff_128, coordinates_x, axis_x_256,
-			number_of_points,
-			pixel_format))
-		return false;
-
-	coeff = coeff128;
-	max_entries += RGB_256X3X16;
-
 	/* TODO: float point case */
 
 	while (i <= number_of_points) {
@@ -1006,34 +987,6 @@ static bool calculate_interpolated_hardware_curve(
 		++rgb_resulted;
 		++i;
 	}
-
-	return true;
-}
-
-static bool map_regamma_hw_to_x_user(
-	struct pixel_gamma_point *coeff128,
-	struct pwl_float_data *rgb_oem,
-	struct pwl_result_data *rgb_resulted,
-	struct pwl_float_data *rgb_user,
-	struct hw_x_point *coords_x,
-	const struct gamma_pixel *axis_x,
-	const struct dc_gamma *gamma,
-	const struct pwl_float_data_ex *rgb_regamma,
-	struct dividers dividers,
-	uint32_t hw_points_num,
-	const struct core_surface *surface)
-{
-	/* setup to spare calculated ideal regamma values */
-
-	struct pixel_gamma_point *coeff = coeff128;
-
-	struct hw_x_point *coords = coords_x;
-
-	copy_rgb_regamma_to_coordinates_x(coords, hw_points_num, rgb_regamma);
-
-	return calculate_interpolated_hardware_curve(
-			rgb_resulted, coeff, rgb_user, coords, axis_x,
-			hw_points_num, surface->public.format);
 }
 
 static void build_new_custom_resulted_curve(
@@ -1284,99 +1237,297 @@ static bool convert_to_custom_float(
 	return true;
 }
 
-bool calculate_regamma_params(struct pwl_params *params,
-		const struct core_gamma *ramp,
-		const struct core_surface *surface)
-{
-	struct gamma_curve *arr_curve_points = params->arr_curve_points;
-	struct curve_points *arr_points = params->arr_points;
-	struct pwl_result_data *rgb_resulted = params->rgb_resulted;
-	struct dividers dividers;
+/*
+ * Everything but the user ramp is fixed: the hw distribution points, the
+ * sRGB regamma curve evaluated at them and the mapping of those onto the
+ * user ramp. Build that once per number of hw points, generating a curve
+ * is then only interpolating the user ramp.
+ */
+struct regamma_table {
+	uint32_t hw_points_requested;
+	uint32_t hw_points_num;
+	struct gamma_curve arr_curve_points[16];
+	struct curve_points arr_points[3];
+	struct hw_x_point coordinates_x[256 + 3];
+	struct gamma_pixel axis_x_256[RGB_256X3X16 + 3];
+	struct pixel_gamma_point coeff128[256 + 3];
+};
 
-	struct hw_x_point *coordinates_x = NULL;
-	struct pwl_float_data *rgb_user = NULL ;
-	struct pwl_float_data_ex *rgb_regamma = NULL;
-	struct pwl_float_data *rgb_oem = NULL;
-	struct gamma_pixel *axix_x_256 = NULL;
-	struct pixel_gamma_point *coeff128_oem = NULL;
-	struct pixel_gamma_point *coeff128 = NULL;
+/* Curves generated for the last few user ramps */
+#define REGAMMA_CACHE_SIZE 4
 
+struct regamma_cache_entry {
+	uint32_t hash;
+	uint32_t last_used;
+	uint32_t hw_points_requested;
+	struct dc_gamma_ramp_rgb256x3x16 ramp;
+	struct pwl_params params;
+};
 
-	bool ret = false;
+struct regamma_cache {
+	struct dc_context *ctx;
+	struct regamma_table *table;
+	uint32_t use_counter;
+	struct regamma_cache_entry *entries[REGAMMA_CACHE_SIZE];
+};
+
+static bool build_regamma_table(
+	struct regamma_table *table,
+	uint32_t hw_points_num)
+{
+	struct pwl_float_data_ex *rgb_regamma;
+	struct dividers dividers;
+	bool ret;
 
-	coordinates_x = dm_alloc(sizeof(*coordinates_x)*(256 + 3));
-	if (!coordinates_x)
-		goto coordinates_x_alloc_fail;
-	rgb_user = dm_alloc(sizeof(*rgb_user) * (FLOAT_GAMMA_RAMP_MAX + 3));
-	if (!rgb_user)
-		goto rgb_user_alloc_fail;
 	rgb_regamma = dm_alloc(sizeof(*rgb_regamma) * (256 + 3));
 	if (!rgb_regamma)
-		goto rgb_regamma_alloc_fail;
-	rgb_oem = dm_alloc(sizeof(*rgb_oem) * (FLOAT_GAMMA_RAMP_MAX + 3));
-	if (!rgb_oem)
-		goto rgb_oem_alloc_fail;
-	axix_x_256 = dm_alloc(sizeof(*axix_x_256) * 256);
-	if (!axix_x_256)
-		goto axix_x_256_alloc_fail;
-	coeff128_oem = dm_alloc(sizeof(*coeff128_oem) * (256 + 3));
-	if (!coeff128_oem)
-		goto coeff128_oem_alloc_fail;
-	coeff128 = dm_alloc(sizeof(*coeff128) * (256 + 3));
-	if (!coeff128)
-		goto coeff128_alloc_fail;
+		return false;
 
 	dividers.divider1 = dal_fixed31_32_from_fraction(3, 2);
 	dividers.divider2 = dal_fixed31_32_from_int(2);
 	dividers.divider3 = dal_fixed31_32_from_fraction(5, 2);
 
 	build_evenly_distributed_points(
-			axix_x_256,
+			table->axis_x_256,
 			256,
 			dal_fixed31_32_one,
 			dividers);
 
-	scale_gamma(rgb_user, ramp, dividers);
+	table->hw_points_requested = hw_points_num;
+	table->hw_points_num = hw_points_num;
+
+	setup_distribution_points(table->arr_curve_points, table->arr_points,
+			&table->hw_points_num, table->coordinates_x);
+
+	build_regamma_curve(rgb_regamma, table->hw_points_num,
+			table->coordinates_x);
+
+	copy_rgb_regamma_to_coordinates_x(table->coordinates_x,
+			table->hw_points_num, rgb_regamma);
+
+	/* pixel format is not used for the mapping yet */
+	ret = build_oem_custom_gamma_mapping_coefficients(
+			table->coeff128, table->coordinates_x,
+			table->axis_x_256, table->hw_points_num,
+			SURFACE_PIXEL_FORMAT_INVALID);
+
+	dm_free(rgb_regamma);
+
+	return ret;
+}
 
-	setup_distribution_points(arr_curve_points, arr_points,
-			&params->hw_points_num, coordinates_x);
+static struct regamma_table *get_regamma_table(
+	struct regamma_cache *cache,
+	uint32_t hw_points_num)
+{
+	if (cache->table &&
+		cache->table->hw_points_requested == hw_points_num)
+		return cache->table;
+
+	if (!cache->table) {
+		cache->table = dm_alloc(sizeof(*cache->table));
+		if (!cache->table)
+			return NULL;
+	}
 
-	build_regamma_curve(rgb_regamma, rgb_oem, coeff128_oem,
-			ramp, surface, params->hw_points_num,
-			coordinates_x, axix_x_256, dividers);
+	if (!build_regamma_table(cache->table, hw_points_num)) {
+		dm_free(cache->table);
+		cache->table = NULL;
+	}
 
-	map_regamma_hw_to_x_user(coeff128, rgb_oem, rgb_resulted, rgb_user,
-			coordinates_x, axix_x_256, &ramp->public, rgb_regamma,
-			dividers, params->hw_points_num, surface);
+	return cache->table;
+}
 
-	build_new_custom_resulted_curve(rgb_resulted, params->hw_points_num);
+/* FNV-1a */
+static uint32_t ramp_hash(const struct dc_gamma_ramp_rgb256x3x16 *ramp)
+{
+	const uint8_t *data = (const uint8_t *)ramp;
+	uint32_t hash = 2166136261u;
+	uint32_t i;
+
+	for (i = 0; i < sizeof(*ramp); i++) {
+		hash ^= data[i];
+		hash *= 16777619u;
+	}
+
+	return hash;
+}
+
+static struct regamma_cache_entry *find_cached_curve(
+	struct regamma_cache *cache,
+	const struct dc_gamma_ramp_rgb256x3x16 *ramp,
+	uint32_t hash,
+	uint32_t hw_points_num)
+{
+	uint32_t i;
+
+	for (i = 0; i < REGAMMA_CACHE_SIZE; i++) {
+		struct regamma_cache_entry *entry = cache->entries[i];
+
+		if (entry && entry->hash == hash &&
+			entry->hw_points_requested == hw_points_num &&
+			!memcmp(&entry->ramp, ramp, sizeof(*ramp)))
+			return entry;
+	}
+
+	return NULL;
+}
+
+static void cache_curve(
+	struct regamma_cache *cache,
+	const struct dc_gamma_ramp_rgb256x3x16 *ramp,
+	uint32_t hash,
+	uint32_t hw_points_num,
+	const struct pwl_params *params)
+{
+	struct regamma_cache_entry **victim = &cache->entries[0];
+	uint32_t i;
+
+	for (i = 0; i < REGAMMA_CACHE_SIZE; i++) {
+		struct regamma_cache_entry **entry = &cache->entries[i];
+
+		if (!*entry) {
+			victim = entry;
+			break;
+		}
+
+		if (cache->use_counter - (*entry)->last_used >
+				cache->use_counter - (*victim)->last_used)
+			victim = entry;
+	}
+
+	if (!*victim) {
+		*victim = dm_alloc(sizeof(**victim));
+
+		/* not fatal, the curve is just not cached */
+		if (!*victim)
+			return;
+	}
+
+	(*victim)->hash = hash;
+	(*victim)->last_used = cache->use_counter;
+	(*victim)->hw_points_requested = hw_points_num;
+	(*victim)->ramp = *ramp;
+	(*victim)->params = *params;
+	(*victim)->params.data = NULL;
+}
+
+struct regamma_cache *regamma_cache_create(struct dc_context *ctx)
+{
+	struct regamma_cache *cache = dm_alloc(sizeof(*cache));
+
+	if (!cache)
+		return NULL;
+
+	cache->ctx = ctx;
+
+	return cache;
+}
+
+void regamma_cache_destroy(struct regamma_cache **cache)
+{
+	uint32_t i;
+
+	if (!cache || !*cache)
+		return;
+
+	for (i = 0; i < REGAMMA_CACHE_SIZE; i++)
+		dm_free((*cache)->entries[i]);
+
+	dm_free((*cache)->table);
+	dm_free(*cache);
+	*cache = NULL;
+}
+
+bool calculate_regamma_params(struct pwl_params *params,
+		const struct core_gamma *ramp,
+		const struct core_surface *surface,
+		struct regamma_cache *cache)
+{
+	const struct dc_gamma_ramp_rgb256x3x16 *user_ramp =
+		&ramp->public.gamma_ramp_rgb256x3x16;
+	bool cacheable = cache &&
+		ramp->public.type == GAMMA_RAMP_RBG256X3X16;
+	uint32_t hw_points_requested = params->hw_points_num;
+	uint32_t hash = 0;
+	struct regamma_cache_entry *entry;
+
+	struct regamma_table *table;
+	struct pwl_float_data *rgb_user = NULL;
+	struct dividers dividers;
+
+	bool ret = false;
+
+	if (cacheable) {
+		cache->use_counter++;
+		hash = ramp_hash(user_ramp);
+
+		entry = find_cached_curve(cache, user_ramp, hash,
+				hw_points_requested);
+		if (entry) {
+			uint32_t *data = params->data;
+
+			entry->last_used = cache->use_counter;
+			*params = entry->params;
+			params->data = data;
+			return true;
+		}
+	}
+
+	if (cache)
+		table = get_regamma_table(cache, hw_points_requested);
+	else {
+		table = dm_alloc(sizeof(*table));
+		if (table && !build_regamma_table(table, hw_points_requested)) {
+			dm_free(table);
+			table = NULL;
+		}
+	}
+
+	if (!table)
+		goto table_fail;
+
+	rgb_user = dm_alloc(sizeof(*rgb_user) * (FLOAT_GAMMA_RAMP_MAX + 3));
+	if (!rgb_user)
+		goto rgb_user_alloc_fail;
+
+	dividers.divider1 = dal_fixed31_32_from_fraction(3, 2);
+	dividers.divider2 = dal_fixed31_32_from_int(2);
+	dividers.divider3 = dal_fixed31_32_from_fraction(5, 2);
+
+	scale_gamma(rgb_user, ramp, dividers);
+
+	memmove(params->arr_curve_points, table->arr_curve_points,
+			sizeof(params->arr_curve_points));
+	memmove(params->arr_points, table->arr_points,
+			sizeof(params->arr_points));
+	params->hw_points_num = table->hw_points_num;
+
+	calculate_interpolated_hardware_curve(params->rgb_resulted,
+			table->coeff128, rgb_user, params->hw_points_num);
+
+	build_new_custom_resulted_curve(params->rgb_resulted,
+			params->hw_points_num);
 
 	rebuild_curve_configuration_magic(
-			arr_points,
-			rgb_resulted,
-			coordinates_x,
+			params->arr_points,
+			params->rgb_resulted,
+			table->coordinates_x,
 			params->hw_points_num);
 
-	convert_to_custom_float(rgb_resulted, arr_points,
+	convert_to_custom_float(params->rgb_resulted, params->arr_points,
 			params->hw_points_num);
 
+	if (cacheable)
+		cache_curve(cache, user_ramp, hash, hw_points_requested,
+				params);
+
 	ret = true;
 
-	dm_free(coeff128);
-coeff128_alloc_fail:
-	dm_free(coeff128_oem);
-coeff128_oem_alloc_fail:
-	dm_free(axix_x_256);
-axix_x_256_alloc_fail:
-	dm_free(rgb_oem);
-rgb_oem_alloc_fail:
-	dm_free(rgb_regamma);
-rgb_regamma_alloc_fail:
 	dm_free(rgb_user);
 rgb_user_alloc_fail:
-	dm_free(coordinates_x);
-coordinates_x_alloc_fail:
+	if (!cache)
+		dm_free(table);
+table_fail:
 	return ret;
-
 }
-
@@ -1587,16 +1587,85 @@ static bool map_sharpness(
 	return true;
 }
 
+/*
+ * @brief
+ * lanczos(x, a2) = sinc(x) * sinc(x * a2),
+ * with sinc(x) taken from the sample table
+ */
 static inline struct fixed31_32 lanczos(
 	struct fixed31_32 x,
+	struct fixed31_32 sinc_x,
 	struct fixed31_32 a2)
 {
 	return dal_fixed31_32_mul(
-		dal_fixed31_32_sinc(x),
+		sinc_x,
 		dal_fixed31_32_sinc(
 			dal_fixed31_32_mul(x, a2)));
 }
 
+/*
+ * @brief
+ * The sample points only depend on taps * phases,
+ * keep them and their sinc between filters
+ */
+static bool generate_sample_table(
+	struct scaler_filter *filter,
+	uint32_t n)
+{
+	uint32_t m;
+
+	if (filter->sample_quantity == n)
+		return true;
+
+	if (filter->sample_points) {
+		dm_free(filter->sample_points);
+
+		filter->sample_points = NULL;
+	}
+
+	if (filter->sample_sinc) {
+		dm_free(filter->sample_sinc);
+
+		filter->sample_sinc = NULL;
+	}
+
+	filter->sample_quantity = 0;
+
+	filter->sample_points = dm_alloc(n * sizeof(struct fixed31_32));
+
+	if (!filter->sample_points) {
+		BREAK_TO_DEBUGGER();
+		return false;
+	}
+
+	filter->sample_sinc = dm_alloc(n * sizeof(struct fixed31_32));
+
+	if (!filter->sample_sinc) {
+		BREAK_TO_DEBUGGER();
+		dm_free(filter->sample_points);
+		filter->sample_points = NULL;
+		return false;
+	}
+
+	m = 0;
+
+	while (m != n) {
+		filter->sample_points[m] = dal_fixed31_32_mul(
+			dal_fixed31_32_pi,
+			dal_fixed31_32_from_fraction(
+				(int64_t)(m << 1) - n, n));
+
+		filter->sample_sinc[m] =
+			dal_fixed31_32_sinc(filter->sample_points[m]);
+
+		++m;
+	}
+
+	filter->sample_quantity = n;
+
+	return true;
+}
+
 static bool generate_filter(
 	struct scaler_filter *filter,
 	const struct scaler_filter_params *params,
@@ -1670,6 +1739,9 @@ static bool generate_filter(
 		++i;
 	}
 
+	if (!generate_sample_table(filter, n))
+		return false;
+
 	m = 0;
 
 	attenby2 = dal_fixed31_32_div_int(
@@ -1681,15 +1753,13 @@ static bool generate_filter(
 		j = 0;
 
 		while (j != params->phases) {
-			struct fixed31_32 x = dal_fixed31_32_mul(
-				dal_fixed31_32_pi,
-				dal_fixed31_32_from_fraction(
-					(int64_t)(m << 1) - n, n));
-
 			uint32_t index =
 				(params->taps - i) * params->phases + j;
 
-			filter->coefficients[index] = lanczos(x, attenby2);
+			filter->coefficients[index] = lanczos(
+				filter->sample_points[m],
+				filter->sample_sinc[m],
+				attenby2);
 
 			++m;
 
@@ -1784,6 +1854,80 @@ static bool generate_filter(
 	return true;
 }
 
+static struct scaler_filter_cache_entry *find_cached_filter(
+	struct scaler_filter *filter,
+	const struct scaler_filter_params *params,
+	struct fixed31_32 attenuation)
+{
+	uint32_t i;
+
+	for (i = 0; i < SCALER_FILTER_CACHE_SIZE; ++i) {
+		struct scaler_filter_cache_entry *entry = &filter->cache[i];
+
+		if (!entry->filter)
+			continue;
+		if (entry->taps != params->taps)
+			continue;
+		if (entry->phases != params->phases)
+			continue;
+		if (!dal_fixed31_32_eq(entry->attenuation, attenuation))
+			continue;
+
+		return entry;
+	}
+
+	return NULL;
+}
+
+static void cache_filter(
+	struct scaler_filter *filter,
+	const struct scaler_filter_params *params,
+	struct fixed31_32 attenuation)
+{
+	struct scaler_filter_cache_entry *entry = &filter->cache[0];
+	uint32_t i;
+
+	/* take an empty entry or the least recently used one */
+	for (i = 0; i < SCALER_FILTER_CACHE_SIZE; ++i) {
+		struct scaler_filter_cache_entry *candidate = &filter->cache[i];
+
+		if (!candidate->filter) {
+			entry = candidate;
+			break;
+		}
+
+		if (filter->cache_use_counter - candidate->last_used >
+			filter->cache_use_counter - entry->last_used)
+			entry = candidate;
+	}
+
+	if (entry->filter_size_allocated < filter->filter_size_effective) {
+		if (entry->filter)
+			dm_free(entry->filter);
+
+		entry->filter_size_allocated = 0;
+
+		entry->filter = dm_alloc(
+			filter->filter_size_effective *
+			sizeof(struct fixed31_32));
+
+		/* not fatal, the filter is just not cached */
+		if (!entry->filter)
+			return;
+
+		entry->filter_size_allocated = filter->filter_size_effective;
+	}
+
+	entry->taps = params->taps;
+	entry->phases = params->phases;
+	entry->attenuation = attenuation;
+	entry->last_used = filter->cache_use_counter;
+	entry->filter_size_effective = filter->filter_size_effective;
+
+	memmove(entry->filter, filter->filter,
+		entry->filter_size_effective * sizeof(struct fixed31_32));
+}
+
 static bool construct_scaler_filter(
 	struct dc_context *ctx,
 	struct scaler_filter *filter)
@@ -1800,6 +1944,10 @@ static bool construct_scaler_filter(
 	filter->coefficients_sum_quantity = 0;
 	filter->downscaling_table = NULL;
 	filter->upscaling_table = NULL;
+	filter->sample_points = NULL;
+	filter->sample_sinc = NULL;
+	filter->sample_quantity = 0;
+	filter->cache_use_counter = 0;
 	filter->ctx = ctx;
 
 	if (!create_downscaling_table(filter)) {
@@ -1819,6 +1967,18 @@ static bool construct_scaler_filter(
 static void destruct_scaler_filter(
 	struct scaler_filter *filter)
 {
+	uint32_t i;
+
+	for (i = 0; i < SCALER_FILTER_CACHE_SIZE; ++i)
+		if (filter->cache[i].filter)
+			dm_free(filter->cache[i].filter);
+
+	if (filter->sample_sinc)
+		dm_free(filter->sample_sinc);
+
+	if (filter->sample_points)
+		dm_free(filter->sample_points);
+
 	if (filter->coefficients_sum)
 		dm_free(filter->coefficients_sum);
 
@@ -1868,6 +2028,8 @@ bool dal_scaler_filter_generate(
 	struct fixed31_32 decibels_at_nyquist;
 	struct fixed31_32 ringing;
 
+	struct scaler_filter_cache_entry *entry;
+
 	if (!params) {
 		BREAK_TO_DEBUGGER();
 		return false;
@@ -1929,9 +2091,23 @@ bool dal_scaler_filter_generate(
 		return false;
 	}
 
-	if (!generate_filter(filter, params, attenuation, &ringing)) {
-		BREAK_TO_DEBUGGER();
-		return false;
+	++filter->cache_use_counter;
+
+	entry = find_cached_filter(filter, params, attenuation);
+
+	if (entry) {
+		entry->last_used = filter->cache_use_counter;
+
+		memmove(filter->filter, entry->filter,
+			entry->filter_size_effective *
+			sizeof(struct fixed31_32));
+	} else {
+		if (!generate_filter(filter, params, attenuation, &ringing)) {
+			BREAK_TO_DEBUGGER();
+			return false;
+		}
+
+		cache_filter(filter, params, attenuation);
 	}
 
 	filter->params = *params;
@@ -38,6 +38,20 @@ struct scaler_filter_params {
 	} flags;
 };
 
+/* number of generated filters kept for reuse */
+#define SCALER_FILTER_CACHE_SIZE 8
+
+/* A generated filter only depends on taps, phases and attenuation */
+struct scaler_filter_cache_entry {
+	uint32_t taps;
+	uint32_t phases;
+	struct fixed31_32 attenuation;
+	uint32_t last_used;
+	struct fixed31_32 *filter;
+	uint32_t filter_size_allocated;
+	uint32_t filter_size_effective;
+};
+
 struct scaler_filter {
 	struct scaler_filter_params params;
 	uint32_t src_size;
@@ -52,6 +66,12 @@ struct scaler_filter {
 	uint32_t coefficients_sum_quantity;
 	struct fixed31_32 ***downscaling_table;
 	struct fixed31_32 ***upscaling_table;
+	/* sample points and their sinc for the last taps * phases */
+	struct fixed31_32 *sample_points;
+	struct fixed31_32 *sample_sinc;
+	uint32_t sample_quantity;
+	struct scaler_filter_cache_entry cache[SCALER_FILTER_CACHE_SIZE];
+	uint32_t cache_use_counter;
 	struct dc_context *ctx;
 };
 
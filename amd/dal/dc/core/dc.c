@@ -37,6 +37,7 @@
 #include "dc_bios_types.h"
 
 #include "bandwidth_calcs.h"
+#include "gamma_calcs.h"
 #include "include/irq_service_interface.h"
 #include "transform.h"
 #include "timing_generator.h"
@@ -304,6 +305,11 @@ static bool construct(struct core_dc *dc,
 		goto val_ctx_fail;
 	}
 
+	/* Bandwidth validation works without a cache, failure is not fatal */
+	dc->bw_cache = dm_alloc(sizeof(*dc->bw_cache));
+	if (dc->bw_cache)
+		mutex_init(&dc->bw_cache->lock);
+
 	dc_ctx->cgs_device = init_params->cgs_device;
 	dc_ctx->driver_context = init_params->driver;
 	dc_ctx->dc = &dc->public;
@@ -320,6 +326,9 @@ static bool construct(struct core_dc *dc,
 	dc->ctx = dc_ctx;
 	dc->ctx->dce_environment = init_params->dce_environment;
 
+	/* Gamma works without a cache, failure is not fatal */
+	dc->regamma_cache = regamma_cache_create(dc_ctx);
+
 
 	dc_version = resource_parse_asic_id(init_params->asic_id);
 
@@ -379,8 +388,10 @@ create_resource_fail:
 	if (as)
 		dal_adapter_service_destroy(&as);
 as_fail:
+	regamma_cache_destroy(&dc->regamma_cache);
 	dal_logger_destroy(&dc_ctx->logger);
 logger_fail:
+	dm_free(dc->bw_cache);
 	dm_free(dc->current_context);
 val_ctx_fail:
 	dm_free(dc_ctx);
@@ -393,6 +404,11 @@ static void destruct(struct core_dc *dc)
 	resource_validate_ctx_destruct(dc->current_context);
 	dm_free(dc->current_context);
 	dc->current_context = NULL;
+	dm_free(dc->spare_context);
+	dc->spare_context = NULL;
+	dm_free(dc->bw_cache);
+	dc->bw_cache = NULL;
+	regamma_cache_destroy(&dc->regamma_cache);
 	destroy_links(dc);
 	dc->res_pool->funcs->destroy(&dc->res_pool);
 	dal_logger_destroy(&dc->ctx->logger);
@@ -548,16 +564,21 @@ static void program_timing_sync(
 	int group_index = 0;
 	int pipe_count = ctx->res_ctx.pool->pipe_count;
 	struct pipe_ctx *unsynced_pipes[MAX_PIPES] = { NULL };
+	bool pipe_changed[MAX_PIPES] = { false };
 
 	for (i = 0; i < pipe_count; i++) {
 		if (!ctx->res_ctx.pipe_ctx[i].stream)
 			continue;
 
 		unsynced_pipes[i] = &ctx->res_ctx.pipe_ctx[i];
+		pipe_changed[i] = !resource_is_pipe_unchanged(
+			&core_dc->current_context->res_ctx.pipe_ctx[i],
+			&ctx->res_ctx.pipe_ctx[i]);
 	}
 
 	for (i = 0; i < pipe_count; i++) {
 		int group_size = 1;
+		bool group_changed = pipe_changed[i];
 		struct pipe_ctx *pipe_set[MAX_PIPES];
 
 		if (!unsynced_pipes[i])
@@ -579,10 +600,14 @@ static void program_timing_sync(
 				pipe_set[group_size] = unsynced_pipes[j];
 				unsynced_pipes[j] = NULL;
 				group_size++;
+				group_changed |= pipe_changed[j];
 			}
 		}
 
-		if (group_size > 1) {
+		/* A group of untouched pipes is still in sync, resyncing it
+		 * would only reset running timing generators
+		 */
+		if (group_size > 1 && group_changed) {
 			core_dc->hwss.enable_timing_synchronization(
 				core_dc, group_index, group_size, pipe_set);
 			group_index++;
@@ -779,6 +804,43 @@ void pplib_apply_display_requirements(
 	dm_pp_apply_display_requirements(dc->ctx, pp_display_cfg);
 }
 
+/* Commits run serialized, so a single spare context is enough to avoid
+ * allocating a new validate_context for every one of them.
+ */
+static struct validate_context *commit_context_alloc(struct core_dc *dc)
+{
+	struct validate_context *context = dc->spare_context;
+
+	if (!context)
+		return dm_alloc(sizeof(struct validate_context));
+
+	dc->spare_context = NULL;
+	memset(context, 0, sizeof(struct validate_context));
+
+	return context;
+}
+
+static void commit_context_free(
+		struct core_dc *dc,
+		struct validate_context *context)
+{
+	if (!dc->spare_context) {
+		dc->spare_context = context;
+		return;
+	}
+
+	dm_free(context);
+}
+
+static void commit_context_swap(
+		struct core_dc *dc,
+		struct validate_context *context)
+{
+	resource_validate_ctx_destruct(dc->current_context);
+	commit_context_free(dc, dc->current_context);
+	dc->current_context = context;
+}
+
 bool dc_commit_targets(
 	struct dc *dc,
 	struct dc_target *targets[],
@@ -814,7 +876,7 @@ bool dc_commit_targets(
 
 	}
 
-	context = dm_alloc(sizeof(struct validate_context));
+	context = commit_context_alloc(core_dc);
 	if (context == NULL)
 		goto context_alloc_fail;
 
@@ -862,15 +924,12 @@ bool dc_commit_targets(
 	pplib_apply_display_requirements(core_dc,
 			context, &context->pp_display_cfg);
 
-	resource_validate_ctx_destruct(core_dc->current_context);
-
-	dm_free(core_dc->current_context);
-	core_dc->current_context = context;
+	commit_context_swap(core_dc, context);
 
 	return (result == DC_OK);
 
 fail:
-	dm_free(context);
+	commit_context_free(core_dc, context);
 
 context_alloc_fail:
 	return (result == DC_OK);
@@ -900,7 +959,7 @@ bool dc_commit_surfaces_to_target(
 		return false;
 
 
-	context = dm_alloc(sizeof(struct validate_context));
+	context = commit_context_alloc(core_dc);
 
 	if (!context) {
 		dm_error("%s: failed to create validate ctx\n", __func__);
@@ -980,7 +1039,7 @@ bool dc_commit_surfaces_to_target(
 			goto unexpected_fail;
 		}
 		resource_validate_ctx_destruct(context);
-		dm_free(context);
+		commit_context_free(core_dc, context);
 		context = temp_context;
 	}
 
@@ -1005,15 +1064,13 @@ bool dc_commit_surfaces_to_target(
 						&context->pp_display_cfg);
 	}
 
-	resource_validate_ctx_destruct(core_dc->current_context);
-	dm_free(core_dc->current_context);
-	core_dc->current_context = context;
+	commit_context_swap(core_dc, context);
 
 	return true;
 
 unexpected_fail:
 	resource_validate_ctx_destruct(context);
-	dm_free(context);
+	commit_context_free(core_dc, context);
 val_ctx_fail:
 
 	return false;
@@ -577,6 +577,9 @@ bool dc_link_detect(const struct dc_link *dc_link, bool boot)
 		return false;
 	}
 
+	/* a different sink may be behind the connector after any HPD */
+	dal_ddc_service_invalidate_dpcd_cache(link->ddc);
+
 	link_disconnect_sink(link);
 
 	if (new_connection_type != dc_connection_none) {
@@ -297,6 +297,14 @@ static bool construct(
 		connector_id == CONNECTOR_ID_LVDS;
 
 	ddc_service->wa.raw = 0;
+
+	ddc_service->dpcd_cache[0].address = DPCD_ADDRESS_DPCD_REV;
+	ddc_service->dpcd_cache[1].address = DPCD_ADDRESS_DWN_STRM_PORT0_CAPS;
+	ddc_service->dpcd_cache[2].address =
+		DPCD_ADDRESS_BRANCH_DEVICE_ID_START;
+	ddc_service->dpcd_cache[3].address = DPCD_ADDRESS_DP13_DPCD_REV;
+	dal_ddc_service_invalidate_dpcd_cache(ddc_service);
+
 	return true;
 }
 
@@ -448,71 +456,63 @@ static uint8_t aux_read_edid_block(
 	uint8_t index,
 	uint8_t *buf)
 {
+	uint8_t offset =
+		(index % DDC_EDID_BLOCKS_PER_SEGMENT) * DDC_EDID_BLOCK_SIZE;
+	uint8_t segment = index / DDC_EDID_BLOCKS_PER_SEGMENT;
+
+	struct aux_payload payloads[3] = {
+		{
+		.i2c_over_aux = true,
+		.write = true,
+		.address = DDC_EDID_SEGMENT_ADDRESS,
+		.length = 1,
+		.data = &segment },
+		{
+		.i2c_over_aux = true,
+		.write = true,
+		.address = address,
+		.length = 1,
+		.data = &offset },
+		{
+		.i2c_over_aux = true,
+		.write = false,
+		.address = address,
+		.length = DDC_EDID_BLOCK_SIZE,
+		.data = buf } };
+
 	struct aux_command cmd = {
 		.payloads = NULL,
 		.number_of_payloads = 0,
 		.defer_delay = get_defer_delay(ddc),
 		.max_defer_write_retry = 0 };
 
-	uint8_t retrieved = 0;
-	uint8_t base_offset =
-		(index % DDC_EDID_BLOCKS_PER_SEGMENT) * DDC_EDID_BLOCK_SIZE;
-	uint8_t segment = index / DDC_EDID_BLOCKS_PER_SEGMENT;
-
-	for (retrieved = 0; retrieved < DDC_EDID_BLOCK_SIZE;
-		retrieved += DEFAULT_AUX_MAX_DATA_SIZE) {
-
-		uint8_t offset = base_offset + retrieved;
+	uint8_t retrieved = DDC_EDID_BLOCK_SIZE;
 
-		struct aux_payload payloads[3] = {
-			{
-			.i2c_over_aux = true,
-			.write = true,
-			.address = DDC_EDID_SEGMENT_ADDRESS,
-			.length = 1,
-			.data = &segment },
-			{
-			.i2c_over_aux = true,
-			.write = true,
-			.address = address,
-			.length = 1,
-			.data = &offset },
-			{
-			.i2c_over_aux = true,
-			.write = false,
-			.address = address,
-			.length = DEFAULT_AUX_MAX_DATA_SIZE,
-			.data = &buf[retrieved] } };
-
-		if (segment == 0) {
-			cmd.payloads = &payloads[1];
-			cmd.number_of_payloads = 2;
-		} else {
-			cmd.payloads = payloads;
-			cmd.number_of_payloads = 3;
-		}
-
-		if (!dal_i2caux_submit_aux_command(
-			dal_adapter_service_get_i2caux(ddc->as),
-			ddc->ddc_pin,
-			&cmd))
-			/* cannot read, break*/
-			break;
+	/* The whole block is read as one command: the AUX engine splits the
+	 * read into DEFAULT_AUX_MAX_DATA_SIZE transactions and issues them
+	 * back to back with MOT set, so the offset is only written once and
+	 * the I2C stop is only sent after the last chunk. */
+	if (segment == 0) {
+		cmd.payloads = &payloads[1];
+		cmd.number_of_payloads = 2;
+	} else {
+		cmd.payloads = payloads;
+		cmd.number_of_payloads = 3;
 	}
 
+	if (!dal_i2caux_submit_aux_command(
+		dal_adapter_service_get_i2caux(ddc->as),
+		ddc->ddc_pin,
+		&cmd))
+		retrieved = 0;
+
 	/* Reset segment to 0. Needed by some panels */
 	if (0 != segment) {
-		struct aux_payload payloads[1] = { {
-			.i2c_over_aux = true,
-			.write = true,
-			.address = DDC_EDID_SEGMENT_ADDRESS,
-			.length = 1,
-			.data = &segment } };
 		bool result = false;
 
 		segment = 0;
 
-		cmd.number_of_payloads = ARRAY_SIZE(payloads);
+		cmd.number_of_payloads = 1;
 		cmd.payloads = payloads;
 
 		result = dal_i2caux_submit_aux_command(
@@ -952,35 +952,93 @@ bool dal_ddc_service_query_ddc_data(
 	return ret;
 }
 
-enum ddc_result dal_ddc_service_read_dpcd_data(
+static bool submit_dpcd_command(
 	struct ddc_service *ddc,
+	bool write,
 	uint32_t address,
 	uint8_t *data,
 	uint32_t len)
 {
-	struct aux_payload read_payload = {
+	struct aux_payload payload = {
 		.i2c_over_aux = false,
-		.write = false,
+		.write = write,
 		.address = address,
 		.length = len,
 		.data = data,
 	};
 	struct aux_command command = {
-		.payloads = &read_payload,
+		.payloads = &payload,
 		.number_of_payloads = 1,
 		.defer_delay = 0,
 		.max_defer_write_retry = 0,
 	};
 
-	if (len > DEFAULT_AUX_MAX_DATA_SIZE) {
+	return dal_i2caux_submit_aux_command(
+		dal_adapter_service_get_i2caux(ddc->as),
+		ddc->ddc_pin,
+		&command);
+}
+
+static struct ddc_dpcd_cache_range *find_dpcd_cache_range(
+	struct ddc_service *ddc,
+	uint32_t address,
+	uint32_t len)
+{
+	uint32_t i;
+
+	for (i = 0; i < DDC_DPCD_CACHE_RANGE_COUNT; i++) {
+		struct ddc_dpcd_cache_range *range = &ddc->dpcd_cache[i];
+
+		if (address >= range->address &&
+			address + len <= range->address +
+				DDC_DPCD_CACHE_RANGE_SIZE)
+			return range;
+	}
+
+	return NULL;
+}
+
+void dal_ddc_service_invalidate_dpcd_cache(struct ddc_service *ddc)
+{
+	uint32_t i;
+
+	for (i = 0; i < DDC_DPCD_CACHE_RANGE_COUNT; i++)
+		ddc->dpcd_cache[i].valid = false;
+}
+
+enum ddc_result dal_ddc_service_read_dpcd_data(
+	struct ddc_service *ddc,
+	uint32_t address,
+	uint8_t *data,
+	uint32_t len)
+{
+	struct ddc_dpcd_cache_range *range;
+
+	/* aux_payload carries an 8-bit length, longer reads are split into
+	 * AUX transactions by the engine */
+	if (len > 0xFF) {
 		BREAK_TO_DEBUGGER();
 		return DDC_RESULT_FAILED_INVALID_OPERATION;
 	}
 
-	if (dal_i2caux_submit_aux_command(
-		dal_adapter_service_get_i2caux(ddc->as),
-		ddc->ddc_pin,
-		&command))
+	range = find_dpcd_cache_range(ddc, address, len);
+
+	if (range && !range->valid)
+		range->valid = submit_dpcd_command(
+			ddc,
+			false,
+			range->address,
+			range->data,
+			DDC_DPCD_CACHE_RANGE_SIZE);
+
+	/* fall back to a direct read if the range could not be filled,
+	 * e.g. the sink NAKs DPCD ranges it does not implement */
+	if (range && range->valid) {
+		memmove(data, &range->data[address - range->address], len);
+		return DDC_RESULT_SUCESSFULL;
+	}
+
+	if (submit_dpcd_command(ddc, false, address, data, len))
 		return DDC_RESULT_SUCESSFULL;
 
 	return DDC_RESULT_FAILED_OPERATION;
@@ -992,29 +1050,28 @@ enum ddc_result dal_ddc_service_write_dpcd_data(
 	const uint8_t *data,
 	uint32_t len)
 {
-	struct aux_payload write_payload = {
-		.i2c_over_aux = false,
-		.write = true,
-		.address = address,
-		.length = len,
-		.data = (uint8_t *)data,
-	};
-	struct aux_command command = {
-		.payloads = &write_payload,
-		.number_of_payloads = 1,
-		.defer_delay = 0,
-		.max_defer_write_retry = 0,
-	};
+	uint32_t i;
 
-	if (len > DEFAULT_AUX_MAX_DATA_SIZE) {
+	if (len > 0xFF) {
 		BREAK_TO_DEBUGGER();
 		return DDC_RESULT_FAILED_INVALID_OPERATION;
 	}
 
-	if (dal_i2caux_submit_aux_command(
-		dal_adapter_service_get_i2caux(ddc->as),
-		ddc->ddc_pin,
-		&command))
+	/* capabilities read while the receiver was powered down may not be
+	 * valid, so a power state change drops the whole cache */
+	if (address <= DPCD_ADDRESS_POWER_STATE &&
+		DPCD_ADDRESS_POWER_STATE < address + len)
+		dal_ddc_service_invalidate_dpcd_cache(ddc);
+
+	for (i = 0; i < DDC_DPCD_CACHE_RANGE_COUNT; i++) {
+		struct ddc_dpcd_cache_range *range = &ddc->dpcd_cache[i];
+
+		if (address < range->address + DDC_DPCD_CACHE_RANGE_SIZE &&
+			range->address < address + len)
+			range->valid = false;
+	}
+
+	if (submit_dpcd_command(ddc, true, address, (uint8_t *)data, len))
 		return DDC_RESULT_SUCESSFULL;
 
 	return DDC_RESULT_FAILED_OPERATION;
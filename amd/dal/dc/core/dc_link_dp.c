@@ -24,6 +24,13 @@ enum {
 	POST_LT_ADJ_REQ_TIMEOUT = 200
 };
 
+enum {
+	/* time each training pattern is sent for in no-AUX-handshake
+	 * training, DP 1.2 section 3.5.1.3
+	 */
+	NO_AUX_HANDSHAKE_TP_TIME_US = 500
+};
+
 enum {
 	LINK_TRAINING_MAX_RETRY_COUNT = 5,
 	/* to avoid infinite loop where-in the receiver
@@ -818,7 +825,6 @@ static bool perform_clock_recovery_sequence(
 {
 	uint32_t retries_cr;
 	uint32_t retry_count;
-	uint32_t lane;
 	struct link_training_settings req_settings;
 	enum dc_lane_count lane_count =
 	lt_settings->link_settings.lane_count;
@@ -828,15 +834,6 @@ static bool perform_clock_recovery_sequence(
 
 	retries_cr = 0;
 	retry_count = 0;
-	/* initial drive setting (VS/PE/PC2)*/
-	for (lane = 0; lane < LANE_COUNT_DP_MAX; lane++) {
-		lt_settings->lane_settings[lane].VOLTAGE_SWING =
-		VOLTAGE_SWING_LEVEL0;
-		lt_settings->lane_settings[lane].PRE_EMPHASIS =
-		PRE_EMPHASIS_DISABLED;
-		lt_settings->lane_settings[lane].POST_CURSOR2 =
-		POST_CURSOR2_DISABLED;
-	}
 
 	dp_set_hw_training_pattern(link, hw_tr_pattern);
 
@@ -964,6 +961,110 @@ static inline bool perform_link_training_int(
 	return status;
 }
 
+static void get_sink_identity(
+	const struct core_link *link,
+	struct link_training_cache *identity)
+{
+	const struct dc_sink *sink = link->public.local_sink;
+
+	identity->sink_dev_id = link->dpcd_caps.sink_dev_id;
+	identity->branch_dev_id = link->dpcd_caps.branch_dev_id;
+
+	if (sink) {
+		identity->manufacturer_id = sink->edid_caps.manufacturer_id;
+		identity->product_id = sink->edid_caps.product_id;
+		identity->serial_number = sink->edid_caps.serial_number;
+	} else {
+		identity->manufacturer_id = 0;
+		identity->product_id = 0;
+		identity->serial_number = 0;
+	}
+}
+
+static const struct link_training_settings *find_cached_lt_settings(
+	const struct core_link *link,
+	const struct dc_link_settings *link_setting)
+{
+	const struct link_training_cache *cache = &link->lt_cache;
+	struct link_training_cache identity;
+
+	if (!cache->valid)
+		return NULL;
+
+	get_sink_identity(link, &identity);
+
+	if (cache->sink_dev_id != identity.sink_dev_id ||
+		cache->branch_dev_id != identity.branch_dev_id ||
+		cache->manufacturer_id != identity.manufacturer_id ||
+		cache->product_id != identity.product_id ||
+		cache->serial_number != identity.serial_number)
+		return NULL;
+
+	if (cache->lt_settings.link_settings.lane_count !=
+			link_setting->lane_count ||
+		cache->lt_settings.link_settings.link_rate !=
+			link_setting->link_rate)
+		return NULL;
+
+	return &cache->lt_settings;
+}
+
+static void cache_lt_settings(
+	struct core_link *link,
+	const struct link_training_settings *lt_settings)
+{
+	get_sink_identity(link, &link->lt_cache);
+	link->lt_cache.lt_settings = *lt_settings;
+	link->lt_cache.valid = true;
+}
+
+/*
+ * Train with the drive settings that worked last time, without the AUX
+ * handshake: the source sends each training pattern for a fixed time and
+ * a single lane status read tells whether the sink locked on.
+ */
+static bool perform_no_aux_handshake_training(
+	struct core_link *link,
+	struct link_training_settings *lt_settings)
+{
+	enum dc_lane_count lane_count = lt_settings->link_settings.lane_count;
+	struct link_training_settings req_settings;
+	union lane_status dpcd_lane_status[LANE_COUNT_DP_MAX] = {{{0}}};
+	union lane_align_status_updated dpcd_lane_status_updated = {{0}};
+
+	dp_set_hw_lane_settings(link, lt_settings);
+
+	dp_set_hw_training_pattern(link, HW_DP_TRAINING_PATTERN_1);
+	udelay(NO_AUX_HANDSHAKE_TP_TIME_US);
+
+	dp_set_hw_training_pattern(link, get_supported_tp(link));
+	udelay(NO_AUX_HANDSHAKE_TP_TIME_US);
+
+	get_lane_status_and_drive_settings(
+		link,
+		lt_settings,
+		dpcd_lane_status,
+		&dpcd_lane_status_updated,
+		&req_settings);
+
+	link->public.cur_lane_setting = lt_settings->lane_settings[0];
+
+	return is_cr_done(lane_count, dpcd_lane_status) &&
+		is_ch_eq_done(lane_count,
+			dpcd_lane_status,
+			&dpcd_lane_status_updated);
+}
+
+static bool perform_training_sequences(
+	struct core_link *link,
+	struct link_training_settings *lt_settings)
+{
+	if (!perform_clock_recovery_sequence(link, lt_settings))
+		return false;
+
+	return perform_channel_equalization_sequence(link, lt_settings);
+}
+
 bool perform_link_training(
 	struct core_link *link,
 	const struct dc_link_settings *link_setting,
@@ -972,6 +1073,7 @@ bool perform_link_training(
 	bool status;
 
 	const int8_t *link_rate = "Unknown";
+	const struct link_training_settings *cached_lt_settings;
 	struct link_training_settings lt_settings;
 
 	status = false;
@@ -996,12 +1098,39 @@ bool perform_link_training(
 
 	/* 2. perform link training (set link training done
 	 *  to false is done as well)*/
-	if (perform_clock_recovery_sequence(link, &lt_settings)) {
+	cached_lt_settings = find_cached_lt_settings(link, link_setting);
 
-		if (perform_channel_equalization_sequence(link, &lt_settings))
-			status = true;
+	if (cached_lt_settings) {
+		/* start from the drive settings this sink trained at
+		 * last time, which usually locks on the first iteration
+		 */
+		memmove(lt_settings.lane_settings,
+			cached_lt_settings->lane_settings,
+			sizeof(lt_settings.lane_settings));
+
+		if (link->dpcd_caps.max_down_spread.bits.
+				NO_AUX_HANDSHAKE_LINK_TRAINING)
+			status = perform_no_aux_handshake_training(
+					link, &lt_settings);
+		else
+			status = perform_training_sequences(
+					link, &lt_settings);
+
+		if (!status) {
+			/* sink changed its mind, do the full training */
+			link->lt_cache.valid = false;
+			memset(lt_settings.lane_settings, '\0',
+				sizeof(lt_settings.lane_settings));
+		}
 	}
 
+	/* initial drive setting (VS/PE/PC2) are all zero */
+	if (!status)
+		status = perform_training_sequences(link, &lt_settings);
+
+	if (status)
+		cache_lt_settings(link, &lt_settings);
+
 	if (status || !skip_video_pattern)
 		status = perform_link_training_int(link, &lt_settings, status);
 
@@ -1552,8 +1681,11 @@ bool dc_link_handle_hpd_rx_irq(const struct dc_link *dc_link)
 
 	if (link->public.type == dc_connection_active_dongle &&
 		hpd_irq_dpcd_data.bytes.sink_cnt.bits.SINK_COUNT
-			!= link->dpcd_sink_count)
+			!= link->dpcd_sink_count) {
+		/* downstream port changed, dongle caps may be stale */
+		dal_ddc_service_invalidate_dpcd_cache(link->ddc);
 		status = true;
+	}
 
 	/* reasons for HPD RX:
 	 * 1. Link Loss - ie Re-train the Link
@@ -1801,3 +1801,63 @@ bool pipe_need_reprogram(
 
 	return false;
 }
+
+/*
+ * Compare everything the back end is programmed from besides what
+ * pipe_need_reprogram() checks: the scaling rects, color space, audio info
+ * and gamut remap of the stream, its bit depth reduction (dither) and
+ * clamping, and the pixel clock, PLL and info frames derived from them.
+ */
+static bool is_stream_state_unchanged(
+		const struct pipe_ctx *pipe_ctx_old,
+		const struct pipe_ctx *pipe_ctx)
+{
+	const struct core_stream *stream_old = pipe_ctx_old->stream;
+	const struct core_stream *stream = pipe_ctx->stream;
+
+	if (memcmp(&stream_old->public, &stream->public,
+			sizeof(struct dc_stream)) != 0)
+		return false;
+
+	if (memcmp(&stream_old->bit_depth_params, &stream->bit_depth_params,
+			sizeof(struct bit_depth_reduction_params)) != 0)
+		return false;
+
+	if (memcmp(&stream_old->clamping, &stream->clamping,
+			sizeof(struct clamping_and_pixel_encoding_params)) != 0)
+		return false;
+
+	if (stream_old->phy_pix_clk != stream->phy_pix_clk)
+		return false;
+
+	if (memcmp(&pipe_ctx_old->pix_clk_params, &pipe_ctx->pix_clk_params,
+			sizeof(struct pixel_clk_params)) != 0)
+		return false;
+
+	if (memcmp(&pipe_ctx_old->pll_settings, &pipe_ctx->pll_settings,
+			sizeof(struct pll_settings)) != 0)
+		return false;
+
+	return memcmp(&pipe_ctx_old->encoder_info_frame,
+			&pipe_ctx->encoder_info_frame,
+			sizeof(struct encoder_info_frame)) == 0;
+}
+
+/*
+ * A pipe that drives the same back end with the same stream state in both
+ * contexts keeps its hw state across a commit, even when the stream object
+ * itself was recreated.
+ */
+bool resource_is_pipe_unchanged(
+		struct pipe_ctx *pipe_ctx_old,
+		struct pipe_ctx *pipe_ctx)
+{
+	if (!pipe_ctx_old->stream || !pipe_ctx->stream)
+		return false;
+
+	if (pipe_ctx_old->top_pipe != NULL || pipe_ctx->top_pipe != NULL)
+		return pipe_ctx_old->stream == pipe_ctx->stream;
+
+	return !pipe_need_reprogram(pipe_ctx_old, pipe_ctx) &&
+		is_stream_state_unchanged(pipe_ctx_old, pipe_ctx);
+}
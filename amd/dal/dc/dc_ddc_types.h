@@ -98,6 +98,17 @@ enum display_dongle_type {
 	DISPLAY_DONGLE_DP_HDMI_MISMATCHED_DONGLE,
 };
 
+#define DDC_DPCD_CACHE_RANGE_SIZE 16
+#define DDC_DPCD_CACHE_RANGE_COUNT 4
+
+/* Copy of a read-mostly (capability) DPCD range, valid until the next HPD
+ * or until a write touches it */
+struct ddc_dpcd_cache_range {
+	uint32_t address;
+	bool valid;
+	uint8_t data[DDC_DPCD_CACHE_RANGE_SIZE];
+};
+
 struct ddc_service {
 	struct ddc *ddc_pin;
 	struct ddc_flags flags;
@@ -111,6 +122,8 @@ struct ddc_service {
 	uint32_t address;
 	uint32_t edid_buf_len;
 	uint8_t edid_buf[MAX_EDID_BUFFER_SIZE];
+
+	struct ddc_dpcd_cache_range dpcd_cache[DDC_DPCD_CACHE_RANGE_COUNT];
 };
 
 #endif /* DC_DDC_TYPES_H_ */
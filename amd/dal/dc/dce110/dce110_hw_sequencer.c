@@ -448,7 +448,8 @@ static bool set_gamma_ramp(
 		ipp->funcs->ipp_program_prescale(ipp, prescale_params);
 	}
 
-	if (ramp && calculate_regamma_params(regamma_params, ramp, surface)) {
+	if (ramp && calculate_regamma_params(regamma_params, ramp, surface,
+			DC_TO_CORE(opp->ctx->dc)->regamma_cache)) {
 
 		opp->funcs->opp_program_regamma_pwl(opp, regamma_params);
 		if (ipp)
@@ -1271,6 +1272,7 @@ static enum dc_status apply_ctx_to_hw(
 	enum dc_status status;
 	int i;
 	bool programmed_audio_dto = false;
+	bool pipes_changed = false;
 
 	/* Reset old context */
 	/* look up the targets that have been removed since last commit */
@@ -1288,9 +1290,11 @@ static enum dc_status apply_ctx_to_hw(
 			continue;
 
 		if (!pipe_ctx->stream ||
-				pipe_need_reprogram(pipe_ctx_old, pipe_ctx))
+				pipe_need_reprogram(pipe_ctx_old, pipe_ctx)) {
 			reset_single_pipe_hw_ctx(
 				dc, pipe_ctx_old, dc->current_context);
+			pipes_changed = true;
+		}
 	}
 
 	/* Skip applying if no targets */
@@ -1309,13 +1313,15 @@ static enum dc_status apply_ctx_to_hw(
 		if (pipe_ctx->stream == NULL)
 			continue;
 
-		if (pipe_ctx->stream == pipe_ctx_old->stream) {
+		if (resource_is_pipe_unchanged(pipe_ctx_old, pipe_ctx)) {
 			if (pipe_ctx_old->clock_source != pipe_ctx->clock_source)
 				dc->hwss.crtc_switch_to_clk_src(
 						pipe_ctx->clock_source, i);
 			continue;
 		}
 
+		pipes_changed = true;
+
 		dcb = dal_adapter_service_get_bios_parser(
 				context->res_ctx.pool->adapter_srv);
 
@@ -1324,6 +1330,16 @@ static enum dc_status apply_ctx_to_hw(
 				PIPE_GATING_CONTROL_DISABLE);
 	}
 
+	/* Nothing to reprogram, heads and watermarks stay as they are */
+	if (!pipes_changed && memcmp(&context->bw_results,
+			&dc->current_context->bw_results,
+			sizeof(struct bw_calcs_output)) == 0) {
+		update_bios_scratch_critical_state(
+			context->res_ctx.pool->adapter_srv, false);
+		switch_dp_clock_sources(dc, &context->res_ctx);
+		return DC_OK;
+	}
+
 	set_safe_displaymarks(&context->res_ctx);
 	/*TODO: when pplib works*/
 	/*dc_set_clocks_and_clock_state(context);*/
@@ -1340,7 +1356,7 @@ static enum dc_status apply_ctx_to_hw(
 		if (pipe_ctx->stream == NULL)
 			continue;
 
-		if (pipe_ctx->stream == pipe_ctx_old->stream)
+		if (resource_is_pipe_unchanged(pipe_ctx_old, pipe_ctx))
 			continue;
 
 		if (pipe_ctx->top_pipe)
@@ -1376,7 +1392,12 @@ static enum dc_status apply_ctx_to_hw(
 			struct pipe_ctx *pipe_ctx = &context->res_ctx.pipe_ctx[i];
 
 			build_audio_output(pipe_ctx, &audio_output);
-			if (AUDIO_RESULT_OK != dal_audio_setup(
+
+			/* Audio of an untouched pipe keeps streaming */
+			if (!resource_is_pipe_unchanged(
+					&dc->current_context->res_ctx.pipe_ctx[i],
+					pipe_ctx) &&
+				AUDIO_RESULT_OK != dal_audio_setup(
 					pipe_ctx->audio,
 					&audio_output,
 					&pipe_ctx->stream->public.audio_info)) {
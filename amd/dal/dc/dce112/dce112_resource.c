@@ -801,6 +801,7 @@ enum dc_status dce112_validate_bandwidth(
 			&dc->bw_dceip,
 			&dc->bw_vbios,
 			&context->bw_mode_data,
+			dc->bw_cache,
 			&context->bw_results))
 		result =  DC_FAIL_BANDWIDTH_VALIDATE;
 	else
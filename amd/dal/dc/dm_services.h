@@ -250,6 +250,26 @@ bool dm_get_platform_info(
 long dm_get_pid(void);
 long dm_get_tgid(void);
 
+/* Monotonic timestamp in nanoseconds, comparable across CPUs */
+uint64_t dm_get_timestamp(struct dc_context *ctx);
+
+/*
+ *
+ * per-CPU services
+ *
+ */
+uint32_t dm_get_cpu_count(void);
+
+/* Returns the current CPU index and keeps the caller on it, with local
+ * interrupts masked, until the matching dm_put_cpu() call.
+ */
+uint32_t dm_get_cpu(unsigned long *irq_flags);
+void dm_put_cpu(unsigned long irq_flags);
+
+#define dm_read_barrier() smp_rmb()
+#define dm_write_barrier() smp_wmb()
+#define dm_mem_barrier() smp_mb()
+
 /*
  *
  * general debug capabilities
@@ -87,6 +87,8 @@ struct gpio_service *dal_gpio_service_create(
 		goto failure_1;
 	}
 
+	spin_lock_init(&service->lock);
+
 	/* allocate and initialize business storage */
 	{
 		const uint32_t bits_per_uint = sizeof(uint32_t) << 3;
@@ -291,6 +293,36 @@ static void set_pin_free(
 		~(1 << (en % bits_per_uint));
 }
 
+/* mark the pin busy, false if it already was */
+static bool reserve_pin(
+	struct gpio_service *service,
+	enum gpio_id id,
+	uint32_t en)
+{
+	unsigned long flags;
+	bool busy;
+
+	spin_lock_irqsave(&service->lock, flags);
+	busy = is_pin_busy(service, id, en);
+	if (!busy)
+		set_pin_busy(service, id, en);
+	spin_unlock_irqrestore(&service->lock, flags);
+
+	return !busy;
+}
+
+static void release_pin(
+	struct gpio_service *service,
+	enum gpio_id id,
+	uint32_t en)
+{
+	unsigned long flags;
+
+	spin_lock_irqsave(&service->lock, flags);
+	set_pin_free(service, id, en);
+	spin_unlock_irqrestore(&service->lock, flags);
+}
+
 enum gpio_result dal_gpio_service_open(
 	struct gpio_service *service,
 	enum gpio_id id,
@@ -306,7 +338,7 @@ enum gpio_result dal_gpio_service_open(
 		return GPIO_RESULT_OPEN_FAILED;
 	}
 
-	if (is_pin_busy(service, id, en)) {
+	if (!reserve_pin(service, id, en)) {
 		ASSERT_CRITICAL(false);
 		return GPIO_RESULT_DEVICE_BUSY;
 	}
@@ -342,11 +374,13 @@ enum gpio_result dal_gpio_service_open(
 	break;
 	default:
 		ASSERT_CRITICAL(false);
+		release_pin(service, id, en);
 		return GPIO_RESULT_NON_SPECIFIC_ERROR;
 	}
 
 	if (!pin) {
 		ASSERT_CRITICAL(false);
+		release_pin(service, id, en);
 		return GPIO_RESULT_NON_SPECIFIC_ERROR;
 	}
 
@@ -356,7 +390,6 @@ enum gpio_result dal_gpio_service_open(
 		return GPIO_RESULT_OPEN_FAILED;
 	}
 
-	set_pin_busy(service, id, en);
 	*ptr = pin;
 	return GPIO_RESULT_OK;
 }
@@ -375,7 +408,7 @@ void dal_gpio_service_close(
 	pin = *ptr;
 
 	if (pin) {
-		set_pin_free(service, pin->id, pin->en);
+		release_pin(service, pin->id, pin->en);
 
 		pin->funcs->close(pin);
 
@@ -40,6 +40,8 @@ struct gpio_service {
 	 * store array of bits (packed into uint32_t slots),
 	 * index individual bit by 'en' value */
 	uint32_t *busyness[GPIO_ID_COUNT];
+	/* protects busyness, a slot is shared by the pins of all lines */
+	spinlock_t lock;
 };
 
 enum gpio_result dal_gpio_service_open(
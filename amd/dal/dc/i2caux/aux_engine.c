@@ -522,20 +522,44 @@ bool dal_aux_engine_submit_request(
 	bool middle_of_transaction)
 {
 	struct aux_engine *aux_engine = FROM_ENGINE(engine);
+	struct i2caux_transaction_request chunk = *request;
+	uint32_t offset = 0;
 
 	bool result;
 	bool mot_used = true;
 
-	switch (request->operation) {
-	case I2CAUX_TRANSACTION_READ:
-		result = read_command(aux_engine, request, mot_used);
-	break;
-	case I2CAUX_TRANSACTION_WRITE:
-		result = write_command(aux_engine, request, mot_used);
-	break;
-	default:
-		result = false;
-	}
+	/* A request longer than one AUX transaction is queued as consecutive
+	 * DEFAULT_AUX_MAX_DATA_SIZE transactions on the engine we already
+	 * hold. I2C-over-AUX chunks keep MOT set so the sink continues at its
+	 * current offset, native AUX chunks advance the DPCD address. */
+	do {
+		chunk.payload.length = request->payload.length - offset;
+
+		if (chunk.payload.length > DEFAULT_AUX_MAX_DATA_SIZE)
+			chunk.payload.length = DEFAULT_AUX_MAX_DATA_SIZE;
+
+		chunk.payload.data = request->payload.data + offset;
+
+		if (request->payload.address_space ==
+			I2CAUX_TRANSACTION_ADDRESS_SPACE_DPCD)
+			chunk.payload.address =
+				request->payload.address + offset;
+
+		switch (request->operation) {
+		case I2CAUX_TRANSACTION_READ:
+			result = read_command(aux_engine, &chunk, mot_used);
+		break;
+		case I2CAUX_TRANSACTION_WRITE:
+			result = write_command(aux_engine, &chunk, mot_used);
+		break;
+		default:
+			result = false;
+		}
+
+		offset += chunk.payload.length;
+	} while (result && offset < request->payload.length);
+
+	request->status = chunk.status;
 
 	/* [tcheng]
 	 * need to send stop for the last transaction to free up the AUX
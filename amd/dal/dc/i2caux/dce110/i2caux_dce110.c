@@ -99,13 +99,17 @@ static struct i2c_engine *acquire_i2c_hw_engine(
 	if (!engine)
 		return NULL;
 
+	mutex_lock(&i2caux_dce110->i2c_hw_buffer_lock);
+
 	if (!i2caux_dce110->i2c_hw_buffer_in_use &&
-		engine->base.funcs->acquire(&engine->base, ddc)) {
+		engine->base.funcs->acquire(&engine->base, ddc))
 		i2caux_dce110->i2c_hw_buffer_in_use = true;
-		return engine;
-	}
+	else
+		engine = NULL;
 
-	return NULL;
+	mutex_unlock(&i2caux_dce110->i2c_hw_buffer_lock);
+
+	return engine;
 }
 
 static void release_engine(
@@ -115,8 +119,11 @@ static void release_engine(
 	struct i2caux_dce110 *i2caux_dce110 = FROM_I2C_AUX(i2caux);
 
 	if (engine->funcs->get_engine_type(engine) ==
-		I2CAUX_ENGINE_TYPE_I2C_DDC_HW)
+		I2CAUX_ENGINE_TYPE_I2C_DDC_HW) {
+		mutex_lock(&i2caux_dce110->i2c_hw_buffer_lock);
 		i2caux_dce110->i2c_hw_buffer_in_use = false;
+		mutex_unlock(&i2caux_dce110->i2c_hw_buffer_lock);
+	}
 
 	dal_i2caux_release_engine(i2caux, engine);
 }
@@ -176,6 +183,7 @@ bool dal_i2caux_dce110_construct(
 
 	i2caux_dce110->base.funcs = &i2caux_funcs;
 	i2caux_dce110->i2c_hw_buffer_in_use = false;
+	mutex_init(&i2caux_dce110->i2c_hw_buffer_lock);
 	/* Create I2C engines (DDC lines per connector)
 	 * different I2C/AUX usage cases, DDC, Generic GPIO, AUX.
 	 */
@@ -83,7 +83,6 @@ static struct i2c_engine *acquire_i2c_hw_engine(
 	struct i2caux_dce80 *i2caux_dce80 = FROM_I2C_AUX(i2caux);
 
 	struct i2c_engine *engine = NULL;
-	bool non_generic;
 
 	if (!ddc)
 		return NULL;
@@ -91,41 +90,39 @@ static struct i2c_engine *acquire_i2c_hw_engine(
 	if (dal_ddc_is_hw_supported(ddc)) {
 		enum gpio_ddc_line line = dal_ddc_get_line(ddc);
 
-		if (line < GPIO_DDC_LINE_COUNT) {
-			non_generic = true;
+		if (line < GPIO_DDC_LINE_COUNT)
 			engine = i2caux->i2c_hw_engines[line];
-		}
-	}
-
-	if (!engine) {
-		non_generic = false;
-		engine = i2caux->i2c_generic_hw_engine;
 	}
 
 	if (!engine)
-		return NULL;
+		return dal_i2caux_acquire_generic_i2c_engine(
+			i2caux, i2caux->i2c_generic_hw_engine, ddc);
 
-	if (non_generic) {
-		if (!i2caux_dce80->i2c_hw_buffer_in_use &&
-			engine->base.funcs->acquire(&engine->base, ddc)) {
-			i2caux_dce80->i2c_hw_buffer_in_use = true;
-			return engine;
-		}
-	} else {
-		if (engine->base.funcs->acquire(&engine->base, ddc))
-			return engine;
-	}
+	mutex_lock(&i2caux_dce80->i2c_hw_buffer_lock);
 
-	return NULL;
+	if (!i2caux_dce80->i2c_hw_buffer_in_use &&
+		engine->base.funcs->acquire(&engine->base, ddc))
+		i2caux_dce80->i2c_hw_buffer_in_use = true;
+	else
+		engine = NULL;
+
+	mutex_unlock(&i2caux_dce80->i2c_hw_buffer_lock);
+
+	return engine;
 }
 
 static void release_engine(
 	struct i2caux *i2caux,
 	struct engine *engine)
 {
+	struct i2caux_dce80 *i2caux_dce80 = FROM_I2C_AUX(i2caux);
+
 	if (engine->funcs->get_engine_type(engine) ==
-		I2CAUX_ENGINE_TYPE_I2C_DDC_HW)
-		FROM_I2C_AUX(i2caux)->i2c_hw_buffer_in_use = false;
+		I2CAUX_ENGINE_TYPE_I2C_DDC_HW) {
+		mutex_lock(&i2caux_dce80->i2c_hw_buffer_lock);
+		i2caux_dce80->i2c_hw_buffer_in_use = false;
+		mutex_unlock(&i2caux_dce80->i2c_hw_buffer_lock);
+	}
 
 	dal_i2caux_release_engine(i2caux, engine);
 }
@@ -185,6 +182,7 @@ static bool construct(
 
 	i2caux_dce80->base.funcs = &i2caux_funcs;
 	i2caux_dce80->i2c_hw_buffer_in_use = false;
+	mutex_init(&i2caux_dce80->i2c_hw_buffer_lock);
 
 	/* Create I2C HW engines (HW + SW pairs)
 	 * for all lines which has assisted HW DDC
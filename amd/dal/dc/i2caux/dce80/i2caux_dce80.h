@@ -30,6 +30,8 @@ struct i2caux_dce80 {
 	struct i2caux base;
 	/* indicate the I2C HW circular buffer is in use */
 	bool i2c_hw_buffer_in_use;
+	/* the buffer is shared by the HW engines of all lines */
+	struct mutex i2c_hw_buffer_lock;
 };
 
 struct i2caux *dal_i2caux_dce80_create(
@@ -108,6 +108,31 @@ struct i2caux *dal_i2caux_create(
 	}
 }
 
+/*
+ * The engines of a DDC line serve one transaction at a time. Lines without
+ * HW DDC support only ever get a generic engine, which
+ * dal_i2caux_acquire_generic_i2c_engine() serializes instead.
+ */
+static void lock_ddc_line(
+	struct i2caux *i2caux,
+	struct ddc *ddc)
+{
+	enum gpio_ddc_line line = dal_ddc_get_line(ddc);
+
+	if (dal_ddc_is_hw_supported(ddc) && line < GPIO_DDC_LINE_COUNT)
+		mutex_lock(&i2caux->ddc_locks[line]);
+}
+
+static void unlock_ddc_line(
+	struct i2caux *i2caux,
+	struct ddc *ddc)
+{
+	enum gpio_ddc_line line = dal_ddc_get_line(ddc);
+
+	if (dal_ddc_is_hw_supported(ddc) && line < GPIO_DDC_LINE_COUNT)
+		mutex_unlock(&i2caux->ddc_locks[line]);
+}
+
 bool dal_i2caux_submit_i2c_command(
 	struct i2caux *i2caux,
 	struct ddc *ddc,
@@ -134,6 +159,8 @@ bool dal_i2caux_submit_i2c_command(
 	 * flag is set to not creating sw i2c engine for every dce except dce80
 	 * currently
 	 */
+	lock_ddc_line(i2caux, ddc);
+
 	switch (cmd->engine) {
 	case I2C_COMMAND_ENGINE_DEFAULT:
 	case I2C_COMMAND_ENGINE_SW:
@@ -156,8 +183,10 @@ bool dal_i2caux_submit_i2c_command(
 				i2caux, ddc);
 	}
 
-	if (!engine)
+	if (!engine) {
+		unlock_ddc_line(i2caux, ddc);
 		return false;
+	}
 
 	engine->funcs->set_speed(engine, cmd->speed);
 
@@ -191,6 +220,7 @@ bool dal_i2caux_submit_i2c_command(
 	}
 
 	i2caux->funcs->release_engine(i2caux, &engine->base);
+	unlock_ddc_line(i2caux, ddc);
 
 	return result;
 }
@@ -214,10 +244,14 @@ bool dal_i2caux_submit_aux_command(
 		return false;
 	}
 
+	lock_ddc_line(i2caux, ddc);
+
 	engine = i2caux->funcs->acquire_aux_engine(i2caux, ddc);
 
-	if (!engine)
+	if (!engine) {
+		unlock_ddc_line(i2caux, ddc);
 		return false;
+	}
 
 	engine->delay = cmd->defer_delay;
 	engine->max_defer_write_retry = cmd->max_defer_write_retry;
@@ -261,6 +295,7 @@ bool dal_i2caux_submit_aux_command(
 	}
 
 	i2caux->funcs->release_engine(i2caux, &engine->base);
+	unlock_ddc_line(i2caux, ddc);
 
 	return result;
 }
@@ -323,12 +358,17 @@ bool dal_i2caux_start_gtc_sync(
 	if (!engine)
 		return false;
 
-	if (!engine->base.funcs->acquire(&engine->base, ddc))
+	mutex_lock(&i2caux->ddc_locks[line]);
+
+	if (!engine->base.funcs->acquire(&engine->base, ddc)) {
+		mutex_unlock(&i2caux->ddc_locks[line]);
 		return false;
+	}
 
 	result = engine->funcs->start_gtc_sync(engine);
 
 	i2caux->funcs->release_engine(i2caux, &engine->base);
+	mutex_unlock(&i2caux->ddc_locks[line]);
 
 	return result;
 }
@@ -349,12 +389,17 @@ bool dal_i2caux_stop_gtc_sync(
 	if (!engine)
 		return false;
 
-	if (!engine->base.funcs->acquire(&engine->base, ddc))
+	mutex_lock(&i2caux->ddc_locks[line]);
+
+	if (!engine->base.funcs->acquire(&engine->base, ddc)) {
+		mutex_unlock(&i2caux->ddc_locks[line]);
 		return false;
+	}
 
 	engine->funcs->stop_gtc_sync(engine);
 
 	i2caux->funcs->release_engine(i2caux, &engine->base);
+	mutex_unlock(&i2caux->ddc_locks[line]);
 
 	return true;
 }
@@ -364,15 +409,19 @@ void dal_i2caux_configure_aux(
 	struct ddc *ddc,
 	union aux_config cfg)
 {
-	struct aux_engine *engine =
-		i2caux->funcs->acquire_aux_engine(i2caux, ddc);
+	struct aux_engine *engine;
 
-	if (!engine)
-		return;
+	lock_ddc_line(i2caux, ddc);
+
+	engine = i2caux->funcs->acquire_aux_engine(i2caux, ddc);
 
-	engine->funcs->configure(engine, cfg);
+	if (engine) {
+		engine->funcs->configure(engine, cfg);
 
-	i2caux->funcs->release_engine(i2caux, &engine->base);
+		i2caux->funcs->release_engine(i2caux, &engine->base);
+	}
+
+	unlock_ddc_line(i2caux, ddc);
 }
 
 void dal_i2caux_destroy(
@@ -438,6 +487,43 @@ enum {
 	SW_AUX_TIMEOUT_PERIOD_MULTIPLIER = 4
 };
 
+/*
+ * A generic engine can be assigned to any line, so it stays locked until
+ * dal_i2caux_release_engine() even when the caller holds a line lock.
+ */
+struct i2c_engine *dal_i2caux_acquire_generic_i2c_engine(
+	struct i2caux *i2caux,
+	struct i2c_engine *engine,
+	struct ddc *ddc)
+{
+	if (!engine)
+		return NULL;
+
+	mutex_lock(&i2caux->generic_engine_lock);
+
+	if (!engine->base.funcs->acquire(&engine->base, ddc)) {
+		mutex_unlock(&i2caux->generic_engine_lock);
+		return NULL;
+	}
+
+	return engine;
+}
+
+static bool is_generic_engine(
+	struct i2caux *i2caux,
+	struct engine *engine)
+{
+	if (i2caux->i2c_generic_sw_engine &&
+		engine == &i2caux->i2c_generic_sw_engine->base)
+		return true;
+
+	if (i2caux->i2c_generic_hw_engine &&
+		engine == &i2caux->i2c_generic_hw_engine->base)
+		return true;
+
+	return false;
+}
+
 struct i2c_engine *dal_i2caux_acquire_i2c_sw_engine(
 	struct i2caux *i2caux,
 	struct ddc *ddc)
@@ -449,10 +535,8 @@ struct i2c_engine *dal_i2caux_acquire_i2c_sw_engine(
 		engine = i2caux->i2c_sw_engines[line];
 
 	if (!engine)
-		engine = i2caux->i2c_generic_sw_engine;
-
-	if (!engine)
-		return NULL;
+		return dal_i2caux_acquire_generic_i2c_engine(
+			i2caux, i2caux->i2c_generic_sw_engine, ddc);
 
 	if (!engine->base.funcs->acquire(&engine->base, ddc))
 		return NULL;
@@ -490,6 +574,9 @@ void dal_i2caux_release_engine(
 	dal_ddc_close(engine->ddc);
 
 	engine->ddc = NULL;
+
+	if (is_generic_engine(i2caux, engine))
+		mutex_unlock(&i2caux->generic_engine_lock);
 }
 
 bool dal_i2caux_construct(
@@ -500,10 +587,12 @@ bool dal_i2caux_construct(
 	uint32_t i = 0;
 
 	i2caux->ctx = ctx;
+	mutex_init(&i2caux->generic_engine_lock);
 	do {
 		i2caux->i2c_sw_engines[i] = NULL;
 		i2caux->i2c_hw_engines[i] = NULL;
 		i2caux->aux_engines[i] = NULL;
+		mutex_init(&i2caux->ddc_locks[i]);
 
 		++i;
 	} while (i < GPIO_DDC_LINE_COUNT);
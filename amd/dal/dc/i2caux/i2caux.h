@@ -88,7 +88,12 @@ struct i2caux {
 	 * Can be assigned dynamically to almost any line per transaction */
 	struct i2c_engine *i2c_generic_hw_engine;
 
-	/* [anaumov] in DAL2, there is a Mutex */
+	/* Per DDC line, held from engine acquire to release, so that links
+	 * on different lines can be detected concurrently */
+	struct mutex ddc_locks[GPIO_DDC_LINE_COUNT];
+
+	/* Held while a generic engine is acquired by some line */
+	struct mutex generic_engine_lock;
 
 	uint32_t aux_timeout_period;
 
@@ -112,6 +117,11 @@ void dal_i2caux_destruct(
 void dal_i2caux_destroy(
 	struct i2caux **ptr);
 
+struct i2c_engine *dal_i2caux_acquire_generic_i2c_engine(
+	struct i2caux *i2caux,
+	struct i2c_engine *engine,
+	struct ddc *ddc);
+
 struct i2c_engine *dal_i2caux_acquire_i2c_sw_engine(
 	struct i2caux *i2caux,
 	struct ddc *ddc);
@@ -504,6 +504,36 @@ struct bw_calcs_output {
 	int32_t required_blackout_duration_us;
 };
 
+/*******************************************************************************
+ * Results cache.
+ * Mode probing and flips validate the same configurations over and over, so
+ * the outputs of the last BW_CALCS_CACHE_SIZE distinct configurations are
+ * kept. Entries are only valid for the dceip/vbios they were computed with,
+ * the cache is flushed whenever either changes.
+ ******************************************************************************/
+#define BW_CALCS_CACHE_SIZE 16
+
+struct bw_calcs_cache_entry {
+	bool valid;
+	bool supported;
+	uint32_t hash;
+	uint32_t last_used;
+	struct bw_calcs_mode_data mode_data;
+	struct bw_calcs_output output;
+};
+
+struct bw_calcs_cache {
+	/* validation runs from commit and from mode_valid on any connector */
+	struct mutex lock;
+	struct bw_calcs_dceip dceip;
+	struct bw_calcs_vbios vbios;
+	uint32_t use_counter;
+	uint32_t hits;
+	uint32_t misses;
+	uint32_t flushes;
+	struct bw_calcs_cache_entry entries[BW_CALCS_CACHE_SIZE];
+};
+
 enum bw_calcs_version {
 	BW_CALCS_VERSION_INVALID,
 	BW_CALCS_VERSION_CARRIZO,
@@ -520,6 +550,8 @@ void bw_calcs_init(
 	enum bw_calcs_version version);
 
 /**
+ * 'cache' is optional, pass NULL to always run the full calculations.
+ *
  * Return:
  *	true -	Display(s) configuration supported.
  *		In this case 'calcs_output' contains data for HW programming
@@ -530,6 +562,7 @@ bool bw_calcs(
 	const struct bw_calcs_dceip *dceip,
 	const struct bw_calcs_vbios *vbios,
 	const struct bw_calcs_mode_data *mode_data,
+	struct bw_calcs_cache *cache,
 	struct bw_calcs_output *calcs_output);
 
 #endif /* __BANDWIDTH_CALCS_H__ */
@@ -11,6 +11,8 @@
 #include "core_types.h"
 #include "hw_sequencer.h"
 
+struct regamma_cache;
+
 #define DC_TO_CORE(dc)\
 	container_of(dc, struct core_dc, public)
 
@@ -23,6 +25,8 @@ struct core_dc {
 
 	/* TODO: determine max number of targets*/
 	struct validate_context *current_context;
+	/* Retired context kept for reuse by the next commit */
+	struct validate_context *spare_context;
 	struct resource_pool *res_pool;
 
 	/*Power State*/
@@ -32,6 +36,10 @@ struct core_dc {
 	/* Inputs into BW and WM calculations. */
 	struct bw_calcs_dceip bw_dceip;
 	struct bw_calcs_vbios bw_vbios;
+	struct bw_calcs_cache *bw_cache;
+
+	/* Regamma curves, built on first use */
+	struct regamma_cache *regamma_cache;
 
 	/* HW functions */
 	struct hw_sequencer_funcs hwss;
@@ -115,6 +115,8 @@ enum ddc_result dal_ddc_service_write_dpcd_data(
 		const uint8_t *data,
 		uint32_t len);
 
+void dal_ddc_service_invalidate_dpcd_cache(struct ddc_service *ddc);
+
 void dal_ddc_service_write_scdc_data(
 		struct ddc_service *ddc_service,
 		uint32_t pix_clk,
@@ -12,8 +12,15 @@
 #include "core_types.h"
 #include "dc.h"
 
+struct regamma_cache;
+
+struct regamma_cache *regamma_cache_create(struct dc_context *ctx);
+void regamma_cache_destroy(struct regamma_cache **cache);
+
+/* 'cache' is optional, pass NULL to build the curve from scratch */
 bool calculate_regamma_params(struct pwl_params *params,
 		const struct core_gamma *ramp,
-		const struct core_surface *surface);
+		const struct core_surface *surface,
+		struct regamma_cache *cache);
 
 #endif /* DRIVERS_GPU_DRM_AMD_DAL_DEV_DC_INC_GAMMA_CALCS_H_ */
@@ -86,6 +86,22 @@ struct link_training_settings {
 	bool allow_invalid_msa_timing_param;
 };
 
+/* Settings of the last successful link training, reused as the starting
+ * point the next time the same sink is trained
+ */
+struct link_training_cache {
+	bool valid;
+
+	/* sink identity */
+	uint32_t sink_dev_id;
+	uint32_t branch_dev_id;
+	uint16_t manufacturer_id;
+	uint16_t product_id;
+	uint32_t serial_number;
+
+	struct link_training_settings lt_settings;
+};
+
 enum hw_dp_training_pattern {
 	HW_DP_TRAINING_PATTERN_1 = 0,
 	HW_DP_TRAINING_PATTERN_2,
@@ -0,0 +1,82 @@
+/*
+ * Copyright 2016 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE COPYRIGHT HOLDER(S) OR AUTHOR(S) BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Authors: AMD
+ *
+ */
+
+/*
+ * Host replacement for the __KERNEL__ half of dm_services_types.h, force
+ * included in front of every DC file the harness builds in user space.
+ */
+
+#ifndef __HOST_SERVICES_H__
+#define __HOST_SERVICES_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define LITTLEENDIAN_CPU
+
+struct mutex {
+	int locked;
+};
+
+#include "cgs_common.h"
+
+#define container_of(ptr, type, member) \
+	((type *)((char *)(ptr) - offsetof(type, member)))
+
+#define ASSERT(expr) ((void)0)
+#define ASSERT_CRITICAL(expr) ((void)0)
+#define BREAK_TO_DEBUGGER() ((void)0)
+
+#define dm_output_to_console(fmt, ...) printf(fmt, ##__VA_ARGS__)
+#define dm_error(fmt, ...) fprintf(stderr, fmt, ##__VA_ARGS__)
+#define dm_debug(fmt, ...) ((void)0)
+
+#define div64_s64(a, b) ((a) / (b))
+#define div_u64(a, b) ((a) / (b))
+
+static inline uint64_t div64_u64_rem(uint64_t dividend, uint64_t divisor,
+		uint64_t *remainder)
+{
+	*remainder = dividend % divisor;
+	return dividend / divisor;
+}
+
+#define GFP_KERNEL 0
+#define kzalloc(size, flags) calloc(1, size)
+#define kfree(ptr) free(ptr)
+
+#define mutex_init(m) ((m)->locked = 0)
+#define mutex_lock(m) ((m)->locked++)
+#define mutex_unlock(m) ((m)->locked--)
+
+#define dm_min(x, y) ((x) < (y) ? (x) : (y))
+#define dm_max(x, y) ((x) > (y) ? (x) : (y))
+
+#endif /* __HOST_SERVICES_H__ */
@@ -0,0 +1,560 @@
+/*
+ * Copyright 2016 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE COPYRIGHT HOLDER(S) OR AUTHOR(S) BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Authors: AMD
+ *
+ */
+
+/*
+ * Host test for the dce110 apply_ctx_to_hw() skip path: the hw objects of a
+ * single pipe are mocked with call counters, the DC externals the sequencer
+ * needs are stubbed out, and every case commits a new context against a
+ * current one that drives a virtual signal.
+ */
+
+#include "dm_services.h"
+#include "dc.h"
+#include "dc_bios_types.h"
+#include "core_types.h"
+#include "core_dc.h"
+#include "resource.h"
+#include "hw_sequencer.h"
+#include "dce110_hw_sequencer.h"
+#include "timing_generator.h"
+#include "mem_input.h"
+#include "opp.h"
+#include "transform.h"
+#include "clock_source.h"
+#include "gamma_calcs.h"
+#include "adapter_service_interface.h"
+#include "audio_interface.h"
+#include "display_clock_interface.h"
+#include "logger_interface.h"
+#include "gpu/dce110/dc_clock_gating_dce110.h"
+#include "bios/dce110/bios_dce110.h"
+
+static struct {
+	int set_blank;
+	int program_timing;
+	int enable_crtc;
+	int disable_crtc;
+	int set_blank_color;
+	int allocate_mem_input;
+	int free_mem_input;
+	int display_marks;
+	int set_dyn_expansion;
+	int program_fmt;
+	int program_pix_clk;
+	int power_gating;
+	int set_displaymarks;
+	int link_enable;
+	int link_disable;
+} calls;
+
+/******************************************************************************
+ * DC externals
+ *****************************************************************************/
+
+static void fake_set_scratch_critical_state(struct dc_bios *bios, bool state)
+{
+}
+
+static const struct dc_vbios_funcs fake_vbios_funcs = {
+	.set_scratch_critical_state = fake_set_scratch_critical_state,
+};
+
+static struct dc_bios fake_bios = {
+	.funcs = &fake_vbios_funcs,
+};
+
+struct dc_bios *dal_adapter_service_get_bios_parser(struct adapter_service *as)
+{
+	return &fake_bios;
+}
+
+bool dal_adapter_service_is_feature_supported(struct adapter_service *as,
+	enum adapter_feature_id feature_id)
+{
+	return false;
+}
+
+void core_link_enable_stream(struct pipe_ctx *pipe_ctx)
+{
+	calls.link_enable++;
+}
+
+void core_link_disable_stream(struct pipe_ctx *pipe_ctx)
+{
+	calls.link_disable++;
+}
+
+enum audio_result dal_audio_power_up(struct audio *audio)
+{
+	return AUDIO_RESULT_OK;
+}
+
+enum audio_result dal_audio_setup(struct audio *audio,
+	struct audio_output *output, struct audio_info *info)
+{
+	return AUDIO_RESULT_OK;
+}
+
+enum audio_result dal_audio_enable_output(struct audio *audio,
+	enum engine_id engine_id, enum signal_type signal)
+{
+	return AUDIO_RESULT_OK;
+}
+
+enum audio_result dal_audio_disable_output(struct audio *audio,
+	enum engine_id engine_id, enum signal_type signal)
+{
+	return AUDIO_RESULT_OK;
+}
+
+enum audio_result dal_audio_mute(struct audio *audio,
+	enum engine_id engine_id, enum signal_type signal)
+{
+	return AUDIO_RESULT_OK;
+}
+
+void dal_audio_setup_audio_wall_dto(struct audio *audio,
+	enum signal_type signal, const struct audio_crtc_info *crtc_info,
+	const struct audio_pll_info *pll_info)
+{
+}
+
+void dal_display_clock_set_clock(struct display_clock *disp_clk,
+	uint32_t requested_clock_khz)
+{
+}
+
+uint32_t dal_display_clock_get_dp_ref_clk_frequency(
+	struct display_clock *disp_clk)
+{
+	return 0;
+}
+
+void dal_dc_clock_gating_dce110_power_up(struct dc_context *ctx, bool enable)
+{
+}
+
+void dce110_set_scratch_acc_mode_change(struct dc_context *ctx)
+{
+}
+
+bool calculate_regamma_params(struct pwl_params *params,
+		const struct core_gamma *ramp,
+		const struct core_surface *surface,
+		struct regamma_cache *cache)
+{
+	return false;
+}
+
+void dal_logger_write(struct dal_logger *logger, enum log_major major,
+		enum log_minor minor, const char *msg, ...)
+{
+}
+
+void dc_surface_retain(const struct dc_surface *dc_surface)
+{
+}
+
+void dc_surface_release(const struct dc_surface *dc_surface)
+{
+}
+
+void dc_target_retain(const struct dc_target *dc_target)
+{
+}
+
+void dc_target_release(const struct dc_target *dc_target)
+{
+}
+
+/******************************************************************************
+ * Mocked hw objects
+ *****************************************************************************/
+
+static bool mock_set_blank(struct timing_generator *tg, bool enable_blanking)
+{
+	calls.set_blank++;
+	return true;
+}
+
+static void mock_program_timing(struct timing_generator *tg,
+		const struct dc_crtc_timing *timing, bool use_vbios)
+{
+	calls.program_timing++;
+}
+
+static bool mock_enable_crtc(struct timing_generator *tg)
+{
+	calls.enable_crtc++;
+	return true;
+}
+
+static bool mock_disable_crtc(struct timing_generator *tg)
+{
+	calls.disable_crtc++;
+	return true;
+}
+
+static void mock_set_blank_color(struct timing_generator *tg,
+		const struct tg_color *color)
+{
+	calls.set_blank_color++;
+}
+
+static const struct timing_generator_funcs mock_tg_funcs = {
+	.set_blank = mock_set_blank,
+	.program_timing = mock_program_timing,
+	.enable_crtc = mock_enable_crtc,
+	.disable_crtc = mock_disable_crtc,
+	.set_blank_color = mock_set_blank_color,
+};
+
+static void mock_program_display_marks(struct mem_input *mem_input,
+		struct bw_watermarks nbp, struct bw_watermarks stutter,
+		struct bw_watermarks urgent, uint32_t total_dest_line_time_ns)
+{
+	calls.display_marks++;
+}
+
+static void mock_allocate_mem_input(struct mem_input *mem_input,
+		uint32_t h_total, uint32_t v_total, uint32_t pix_clk_khz,
+		uint32_t total_streams_num)
+{
+	calls.allocate_mem_input++;
+}
+
+static void mock_free_mem_input(struct mem_input *mem_input,
+		uint32_t paths_num)
+{
+	calls.free_mem_input++;
+}
+
+static struct mem_input_funcs mock_mi_funcs = {
+	.mem_input_program_display_marks = mock_program_display_marks,
+	.allocate_mem_input = mock_allocate_mem_input,
+	.free_mem_input = mock_free_mem_input,
+};
+
+static void mock_set_dyn_expansion(struct output_pixel_processor *opp,
+		enum dc_color_space color_sp, enum dc_color_depth color_dpth,
+		enum signal_type signal)
+{
+	calls.set_dyn_expansion++;
+}
+
+static void mock_program_fmt(struct output_pixel_processor *opp,
+		struct bit_depth_reduction_params *fmt_bit_depth,
+		struct clamping_and_pixel_encoding_params *clamping)
+{
+	calls.program_fmt++;
+}
+
+static const struct opp_funcs mock_opp_funcs = {
+	.opp_set_dyn_expansion = mock_set_dyn_expansion,
+	.opp_program_fmt = mock_program_fmt,
+};
+
+static void mock_set_scaler_bypass(struct transform *xfm,
+		const struct scaler_data *scl_data)
+{
+}
+
+static const struct transform_funcs mock_xfm_funcs = {
+	.transform_set_scaler_bypass = mock_set_scaler_bypass,
+};
+
+static bool mock_cs_power_down(struct clock_source *cs)
+{
+	return true;
+}
+
+static bool mock_program_pix_clk(struct clock_source *cs,
+		struct pixel_clk_params *pix_clk_params,
+		struct pll_settings *pll_settings)
+{
+	calls.program_pix_clk++;
+	return true;
+}
+
+static const struct clock_source_funcs mock_cs_funcs = {
+	.cs_power_down = mock_cs_power_down,
+	.program_pix_clk = mock_program_pix_clk,
+};
+
+static bool mock_power_gating(struct dc_context *ctx, uint8_t controller_id,
+		struct dc_bios *dcb, enum pipe_gating_control power_gating)
+{
+	calls.power_gating++;
+	return true;
+}
+
+static void mock_set_displaymarks(const struct core_dc *dc,
+		struct validate_context *context)
+{
+	calls.set_displaymarks++;
+}
+
+static void mock_switch_to_clk_src(struct clock_source *clk_src,
+		uint8_t pipe_id)
+{
+}
+
+/******************************************************************************
+ * Fixture
+ *****************************************************************************/
+
+struct harness {
+	struct core_dc dc;
+	struct dc_context ctx;
+	struct resource_pool pool;
+	struct timing_generator tg;
+	struct mem_input mi;
+	struct output_pixel_processor opp;
+	struct transform xfm;
+	struct clock_source cs;
+	struct core_sink sink;
+	struct core_stream cur_stream;
+	struct core_stream new_stream;
+	struct validate_context *cur_context;
+	struct validate_context *new_context;
+};
+
+static void build_context(struct harness *h,
+		struct validate_context *context,
+		struct core_stream *stream)
+{
+	struct pipe_ctx *pipe_ctx = &context->res_ctx.pipe_ctx[0];
+
+	context->target_count = 1;
+	context->res_ctx.pool = &h->pool;
+	context->res_ctx.clock_source_ref_count[0] = 1;
+
+	pipe_ctx->stream = stream;
+	pipe_ctx->tg = &h->tg;
+	pipe_ctx->mi = &h->mi;
+	pipe_ctx->opp = &h->opp;
+	pipe_ctx->xfm = &h->xfm;
+	pipe_ctx->clock_source = &h->cs;
+	pipe_ctx->pipe_idx = 0;
+	pipe_ctx->pix_clk_params.requested_pix_clk =
+		stream->public.timing.pix_clk_khz;
+}
+
+/* The new stream starts out as a freshly created copy of the current one */
+static void harness_init(struct harness *h)
+{
+	struct core_stream *stream = &h->cur_stream;
+
+	memset(h, 0, sizeof(*h));
+
+	h->tg.funcs = &mock_tg_funcs;
+	h->mi.funcs = &mock_mi_funcs;
+	h->opp.funcs = &mock_opp_funcs;
+	h->xfm.funcs = &mock_xfm_funcs;
+	h->cs.funcs = &mock_cs_funcs;
+
+	h->pool.pipe_count = 1;
+	h->pool.clock_sources[0] = &h->cs;
+	h->pool.clk_src_count = 1;
+
+	h->dc.ctx = &h->ctx;
+	dce110_hw_sequencer_construct(&h->dc);
+	h->dc.hwss.enable_display_power_gating = mock_power_gating;
+	h->dc.hwss.set_displaymarks = mock_set_displaymarks;
+	h->dc.hwss.crtc_switch_to_clk_src = mock_switch_to_clk_src;
+
+	stream->ctx = &h->ctx;
+	stream->sink = &h->sink;
+	stream->signal = SIGNAL_TYPE_VIRTUAL;
+	stream->public.sink = &h->sink.public;
+	stream->public.timing.h_total = 2200;
+	stream->public.timing.v_total = 1125;
+	stream->public.timing.h_addressable = 1920;
+	stream->public.timing.v_addressable = 1080;
+	stream->public.timing.pix_clk_khz = 148500;
+	stream->public.timing.display_color_depth = COLOR_DEPTH_888;
+	stream->public.output_color_space = COLOR_SPACE_SRGB;
+	stream->public.src.width = 1920;
+	stream->public.src.height = 1080;
+	stream->public.dst = stream->public.src;
+
+	h->new_stream = h->cur_stream;
+
+	h->cur_context = dm_alloc(sizeof(struct validate_context));
+	h->new_context = dm_alloc(sizeof(struct validate_context));
+	build_context(h, h->cur_context, &h->cur_stream);
+	build_context(h, h->new_context, &h->new_stream);
+	h->dc.current_context = h->cur_context;
+}
+
+static void harness_fini(struct harness *h)
+{
+	dm_free(h->cur_context);
+	dm_free(h->new_context);
+}
+
+static enum dc_status harness_apply(struct harness *h)
+{
+	memset(&calls, 0, sizeof(calls));
+
+	return h->dc.hwss.apply_ctx_to_hw(&h->dc, h->new_context);
+}
+
+/******************************************************************************
+ * Tests
+ *****************************************************************************/
+
+static int failures;
+
+#define CHECK_EQ(actual, expected) \
+	do { \
+		if ((actual) != (expected)) { \
+			fprintf(stderr, "%s:%d: %s: %s == %d, expected %d\n", \
+				__FILE__, __LINE__, __func__, #actual, \
+				(int)(actual), (int)(expected)); \
+			failures++; \
+		} \
+	} while (0)
+
+/* Back end left alone, front end of the pipe reprogrammed in place */
+static void check_pipe_reprogrammed(struct harness *h)
+{
+	CHECK_EQ(harness_apply(h), DC_OK);
+	CHECK_EQ(calls.power_gating, 1);
+	CHECK_EQ(calls.program_fmt, 1);
+	CHECK_EQ(calls.set_dyn_expansion, 1);
+	CHECK_EQ(calls.set_blank_color, 1);
+	CHECK_EQ(calls.set_displaymarks, 1);
+	CHECK_EQ(calls.disable_crtc, 0);
+	CHECK_EQ(calls.program_timing, 0);
+	CHECK_EQ(calls.link_disable, 0);
+}
+
+static void test_recreated_stream_is_skipped(void)
+{
+	struct harness h;
+
+	harness_init(&h);
+
+	CHECK_EQ(harness_apply(&h), DC_OK);
+	CHECK_EQ(calls.power_gating, 0);
+	CHECK_EQ(calls.allocate_mem_input, 0);
+	CHECK_EQ(calls.display_marks, 0);
+	CHECK_EQ(calls.program_fmt, 0);
+	CHECK_EQ(calls.set_blank_color, 0);
+	CHECK_EQ(calls.set_displaymarks, 0);
+	CHECK_EQ(calls.disable_crtc, 0);
+
+	harness_fini(&h);
+}
+
+static void test_color_space_change_reprograms(void)
+{
+	struct harness h;
+
+	harness_init(&h);
+	h.new_stream.public.output_color_space = COLOR_SPACE_YCBCR709;
+
+	check_pipe_reprogrammed(&h);
+
+	harness_fini(&h);
+}
+
+static void test_scaling_change_reprograms(void)
+{
+	struct harness h;
+
+	harness_init(&h);
+	h.new_stream.public.dst.x = 64;
+	h.new_stream.public.dst.width = 1792;
+
+	check_pipe_reprogrammed(&h);
+
+	harness_fini(&h);
+}
+
+static void test_dither_change_reprograms(void)
+{
+	struct harness h;
+
+	harness_init(&h);
+	h.new_stream.bit_depth_params.flags.SPATIAL_DITHER_ENABLED = 1;
+
+	check_pipe_reprogrammed(&h);
+
+	harness_fini(&h);
+}
+
+static void test_clamping_change_reprograms(void)
+{
+	struct harness h;
+
+	harness_init(&h);
+	h.new_stream.clamping.c_depth = COLOR_DEPTH_101010;
+
+	check_pipe_reprogrammed(&h);
+
+	harness_fini(&h);
+}
+
+static void test_timing_change_resets_pipe(void)
+{
+	struct harness h;
+
+	harness_init(&h);
+	h.new_stream.public.timing.v_total = 1250;
+
+	CHECK_EQ(harness_apply(&h), DC_OK);
+	CHECK_EQ(calls.link_disable, 1);
+	CHECK_EQ(calls.disable_crtc, 1);
+	CHECK_EQ(calls.free_mem_input, 1);
+	CHECK_EQ(calls.program_pix_clk, 1);
+	CHECK_EQ(calls.program_timing, 1);
+	CHECK_EQ(calls.enable_crtc, 1);
+	CHECK_EQ(calls.program_fmt, 1);
+	CHECK_EQ(calls.link_enable, 1);
+	CHECK_EQ(calls.set_displaymarks, 1);
+
+	harness_fini(&h);
+}
+
+int main(void)
+{
+	test_recreated_stream_is_skipped();
+	test_color_space_change_reprograms();
+	test_scaling_change_reprograms();
+	test_dither_change_reprograms();
+	test_clamping_change_reprograms();
+	test_timing_change_resets_pipe();
+
+	if (failures) {
+		fprintf(stderr, "hwss_apply_test: %d check(s) failed\n",
+			failures);
+		return 1;
+	}
+
+	printf("hwss_apply_test: all tests passed\n");
+	return 0;
+}
@@ -597,6 +597,8 @@ pp_debugfs_print_current_performance_level(void *handle,
 	}
 
 	hwmgr->hwmgr_func->print_current_perforce_level(hwmgr, m);
+
+	smum_print_msg_stats(((struct pp_instance *)handle)->smu_mgr, m);
 }
 
 static int pp_dpm_set_fan_control_mode(void *handle, uint32_t mode)
@@ -898,6 +900,41 @@ static int pp_dpm_set_mclk_od(void *handle, uint32_t value)
 	return hwmgr->hwmgr_func->set_mclk_od(hwmgr, value);
 }
 
+static int pp_dpm_get_clock_levels(void *handle,
+		enum pp_clock_type type, struct amd_pp_clocks *clocks)
+{
+	struct pp_hwmgr *hwmgr;
+
+	if (!handle || !clocks)
+		return -EINVAL;
+
+	hwmgr = ((struct pp_instance *)handle)->hwmgr;
+
+	PP_CHECK_HW(hwmgr);
+
+	if (hwmgr->hwmgr_func->get_clock_levels == NULL)
+		return -EINVAL;
+
+	return hwmgr->hwmgr_func->get_clock_levels(hwmgr, type, clocks);
+}
+
+static int pp_dpm_read_sensors(void *handle, struct amd_pp_sensors *sensors)
+{
+	struct pp_hwmgr *hwmgr;
+
+	if (!handle || !sensors)
+		return -EINVAL;
+
+	hwmgr = ((struct pp_instance *)handle)->hwmgr;
+
+	PP_CHECK_HW(hwmgr);
+
+	if (hwmgr->hwmgr_func->read_sensors == NULL)
+		return -EINVAL;
+
+	return hwmgr->hwmgr_func->read_sensors(hwmgr, sensors);
+}
+
 const struct amd_powerplay_funcs pp_dpm_funcs = {
 	.get_temperature = pp_dpm_get_temperature,
 	.load_firmware = pp_dpm_load_fw,
@@ -924,6 +961,8 @@ const struct amd_powerplay_funcs pp_dpm_funcs = {
 	.set_sclk_od = pp_dpm_set_sclk_od,
 	.get_mclk_od = pp_dpm_get_mclk_od,
 	.set_mclk_od = pp_dpm_set_mclk_od,
+	.get_clock_levels = pp_dpm_get_clock_levels,
+	.read_sensors = pp_dpm_read_sensors,
 };
 
 static int amd_pp_instance_init(struct amd_pp_init *pp_init,
@@ -581,6 +581,13 @@ static int fiji_patch_boot_state(struct pp_hwmgr *hwmgr,
 
 static int fiji_hwmgr_backend_fini(struct pp_hwmgr *hwmgr)
 {
+	struct fiji_hwmgr *data = (struct fiji_hwmgr *)(hwmgr->backend);
+
+	if (data) {
+		smum_free_smc_table(&data->graphics_level_table);
+		smum_free_smc_table(&data->memory_level_table);
+	}
+
 	return phm_hwmgr_backend_fini(hwmgr);
 }
 
@@ -2125,8 +2132,9 @@ static int fiji_populate_all_graphic_levels(struct pp_hwmgr *hwmgr)
 		levels[1].pcieDpmLevel = mid_pcie_level_enabled;
 	}
 	/* level count will send to smc once at init smc table and never change */
-	result = fiji_copy_bytes_to_smc(hwmgr->smumgr, array, (uint8_t *)levels,
-			(uint32_t)array_size, data->sram_end);
+	result = smum_upload_smc_table(hwmgr->smumgr, &data->graphics_level_table,
+			array, (uint8_t *)levels, (uint32_t)array_size,
+			data->sram_end);
 
 	return result;
 }
@@ -2290,8 +2298,9 @@ static int fiji_populate_all_memory_levels(struct pp_hwmgr *hwmgr)
 			PPSMC_DISPLAY_WATERMARK_HIGH;
 
 	/* level count will send to smc once at init smc table and never change */
-	result = fiji_copy_bytes_to_smc(hwmgr->smumgr, array, (uint8_t *)levels,
-			(uint32_t)array_size, data->sram_end);
+	result = smum_upload_smc_table(hwmgr->smumgr, &data->memory_level_table,
+			array, (uint8_t *)levels, (uint32_t)array_size,
+			data->sram_end);
 
 	return result;
 }
@@ -3163,6 +3172,10 @@ static int fiji_init_smc_table(struct pp_hwmgr *hwmgr)
 	PP_ASSERT_WITH_CODE(0 == result,
 			"Failed to upload dpm data to SMC memory!", return result);
 
+	/* the level arrays were rewritten as part of the whole table */
+	smum_invalidate_smc_table(&data->graphics_level_table);
+	smum_invalidate_smc_table(&data->memory_level_table);
+
 	return 0;
 }
 
@@ -3756,7 +3769,7 @@ static int fiji_force_dpm_highest(struct pp_hwmgr *hwmgr)
 			while (tmp >>= 1)
 				level++;
 			if (level)
-				smum_send_msg_to_smc_with_parameter(hwmgr->smumgr,
+				smum_post_msg_to_smc_with_parameter(hwmgr->smumgr,
 						PPSMC_MSG_SCLKDPM_SetEnabledMask,
 						(1 << level));
 		}
@@ -3769,7 +3782,7 @@ static int fiji_force_dpm_highest(struct pp_hwmgr *hwmgr)
 			while (tmp >>= 1)
 				level++;
 			if (level)
-				smum_send_msg_to_smc_with_parameter(hwmgr->smumgr,
+				smum_post_msg_to_smc_with_parameter(hwmgr->smumgr,
 						PPSMC_MSG_MCLKDPM_SetEnabledMask,
 						(1 << level));
 		}
@@ -3782,12 +3795,12 @@ static int fiji_force_dpm_highest(struct pp_hwmgr *hwmgr)
 			while (tmp >>= 1)
 				level++;
 			if (level)
-				smum_send_msg_to_smc_with_parameter(hwmgr->smumgr,
+				smum_post_msg_to_smc_with_parameter(hwmgr->smumgr,
 						PPSMC_MSG_PCIeDPM_ForceLevel,
 						(1 << level));
 		}
 	}
-	return 0;
+	return smum_flush_msgs_to_smc(hwmgr->smumgr);
 }
 
 static int fiji_upload_dpmlevel_enable_mask(struct pp_hwmgr *hwmgr)
@@ -3841,7 +3854,7 @@ static int fiji_force_dpm_lowest(struct pp_hwmgr *hwmgr)
 		if (data->dpm_level_enable_mask.sclk_dpm_enable_mask) {
 			level = fiji_get_lowest_enabled_level(hwmgr,
 							      data->dpm_level_enable_mask.sclk_dpm_enable_mask);
-			smum_send_msg_to_smc_with_parameter(hwmgr->smumgr,
+			smum_post_msg_to_smc_with_parameter(hwmgr->smumgr,
 							    PPSMC_MSG_SCLKDPM_SetEnabledMask,
 							    (1 << level));
 
@@ -3851,7 +3864,7 @@ static int fiji_force_dpm_lowest(struct pp_hwmgr *hwmgr)
 		if (data->dpm_level_enable_mask.mclk_dpm_enable_mask) {
 			level = fiji_get_lowest_enabled_level(hwmgr,
 							      data->dpm_level_enable_mask.mclk_dpm_enable_mask);
-			smum_send_msg_to_smc_with_parameter(hwmgr->smumgr,
+			smum_post_msg_to_smc_with_parameter(hwmgr->smumgr,
 							    PPSMC_MSG_MCLKDPM_SetEnabledMask,
 							    (1 << level));
 		}
@@ -3861,13 +3874,13 @@ static int fiji_force_dpm_lowest(struct pp_hwmgr *hwmgr)
 		if (data->dpm_level_enable_mask.pcie_dpm_enable_mask) {
 			level = fiji_get_lowest_enabled_level(hwmgr,
 							      data->dpm_level_enable_mask.pcie_dpm_enable_mask);
-			smum_send_msg_to_smc_with_parameter(hwmgr->smumgr,
+			smum_post_msg_to_smc_with_parameter(hwmgr->smumgr,
 							    PPSMC_MSG_PCIeDPM_ForceLevel,
 							    (1 << level));
 		}
 	}
 
-	return 0;
+	return smum_flush_msgs_to_smc(hwmgr->smumgr);
 
 }
 static int fiji_dpm_force_dpm_level(struct pp_hwmgr *hwmgr,
@@ -5539,6 +5552,80 @@ static int fiji_set_mclk_od(struct pp_hwmgr *hwmgr, uint32_t value)
 	return 0;
 }
 
+static int fiji_get_clock_levels(struct pp_hwmgr *hwmgr,
+		enum pp_clock_type type, struct amd_pp_clocks *clocks)
+{
+	struct fiji_hwmgr *data = (struct fiji_hwmgr *)(hwmgr->backend);
+	struct fiji_single_dpm_table *dpm_table;
+	uint32_t enable_mask, i;
+
+	switch (type) {
+	case PP_SCLK:
+		dpm_table = &(data->dpm_table.sclk_table);
+		enable_mask = data->dpm_level_enable_mask.sclk_dpm_enable_mask;
+		break;
+	case PP_MCLK:
+		dpm_table = &(data->dpm_table.mclk_table);
+		enable_mask = data->dpm_level_enable_mask.mclk_dpm_enable_mask;
+		break;
+	default:
+		return -EINVAL;
+	}
+
+	/* indices match the force_clock_level mask, disabled levels read 0 */
+	clocks->count = min_t(uint32_t, dpm_table->count, MAX_NUM_CLOCKS);
+	for (i = 0; i < clocks->count; i++)
+		clocks->clock[i] = (enable_mask & (1 << i)) ?
+				dpm_table->dpm_levels[i].value : 0;
+
+	return 0;
+}
+
+static uint32_t fiji_read_activity(struct pp_hwmgr *hwmgr, uint32_t offset)
+{
+	struct fiji_hwmgr *data = (struct fiji_hwmgr *)(hwmgr->backend);
+	uint32_t activity_percent;
+
+	activity_percent = cgs_read_ind_register(hwmgr->device, CGS_IND_REG__SMC,
+			data->soft_regs_start + offset);
+	activity_percent += 0x80;
+	activity_percent >>= 8;
+
+	return activity_percent > 100 ? 100 : activity_percent;
+}
+
+static int fiji_read_sensors(struct pp_hwmgr *hwmgr,
+		struct amd_pp_sensors *sensors)
+{
+	int result;
+
+	memset(sensors, 0, sizeof(*sensors));
+
+	result = smum_send_msg_to_smc_get_argument(hwmgr->smumgr,
+			PPSMC_MSG_API_GetSclkFrequency, &sensors->sclk);
+	PP_ASSERT_WITH_CODE(0 == result,
+			"Failed to read the current SCLK!", return result);
+
+	result = smum_send_msg_to_smc_get_argument(hwmgr->smumgr,
+			PPSMC_MSG_API_GetMclkFrequency, &sensors->mclk);
+	PP_ASSERT_WITH_CODE(0 == result,
+			"Failed to read the current MCLK!", return result);
+
+	sensors->gpu_load = fiji_read_activity(hwmgr,
+			offsetof(SMU73_SoftRegisters, AverageGraphicsActivity));
+	sensors->mem_load = fiji_read_activity(hwmgr,
+			offsetof(SMU73_SoftRegisters, AverageMemoryActivity));
+
+	sensors->temperature = fiji_thermal_get_temperature(hwmgr);
+
+	if (!hwmgr->thermal_controller.fanInfo.bNoFan) {
+		fiji_fan_ctrl_get_fan_speed_percent(hwmgr, &sensors->fan_percent);
+		fiji_fan_ctrl_get_fan_speed_rpm(hwmgr, &sensors->fan_rpm);
+	}
+
+	return 0;
+}
+
 static const struct pp_hwmgr_func fiji_hwmgr_funcs = {
 	.backend_init = &fiji_hwmgr_backend_init,
 	.backend_fini = &fiji_hwmgr_backend_fini,
@@ -5583,6 +5670,8 @@ static const struct pp_hwmgr_func fiji_hwmgr_funcs = {
 	.set_sclk_od = fiji_set_sclk_od,
 	.get_mclk_od = fiji_get_mclk_od,
 	.set_mclk_od = fiji_set_mclk_od,
+	.get_clock_levels = fiji_get_clock_levels,
+	.read_sensors = fiji_read_sensors,
 };
 
 int fiji_hwmgr_init(struct pp_hwmgr *hwmgr)
@@ -228,6 +228,8 @@ struct fiji_hwmgr {
 	uint32_t                             fan_table_start;
 	uint32_t                             arb_table_start;
 	struct SMU73_Discrete_DpmTable       smc_state_table;
+	struct smum_smc_table                graphics_level_table;
+	struct smum_smc_table                memory_level_table;
 	struct SMU73_Discrete_Ulv            ulv_setting;
 
 	/* ---- Stuff originally coming from Evergreen ---- */
@@ -28,6 +28,7 @@
 #include "cgs_common.h"
 #include "power_state.h"
 #include "hwmgr.h"
+#include "smumgr.h"
 #include "pppcielanes.h"
 #include "pp_debug.h"
 #include "ppatomctrl.h"
@@ -181,49 +182,25 @@ int hw_init_power_state_table(struct pp_hwmgr *hwmgr)
 int phm_wait_on_register(struct pp_hwmgr *hwmgr, uint32_t index,
 			 uint32_t value, uint32_t mask)
 {
-	uint32_t i;
-	uint32_t cur_value;
-
 	if (hwmgr == NULL || hwmgr->device == NULL) {
 		printk(KERN_ERR "[ powerplay ] Invalid Hardware Manager!");
 		return -EINVAL;
 	}
 
-	for (i = 0; i < hwmgr->usec_timeout; i++) {
-		cur_value = cgs_read_register(hwmgr->device, index);
-		if ((cur_value & mask) == (value & mask))
-			break;
-		udelay(1);
-	}
-
-	/* timeout means wrong logic*/
-	if (i == hwmgr->usec_timeout)
-		return -1;
-	return 0;
+	return smum_poll_register(hwmgr->device, index, value, mask,
+				true, hwmgr->usec_timeout);
 }
 
 int phm_wait_for_register_unequal(struct pp_hwmgr *hwmgr,
 				uint32_t index, uint32_t value, uint32_t mask)
 {
-	uint32_t i;
-	uint32_t cur_value;
-
 	if (hwmgr == NULL || hwmgr->device == NULL) {
 		printk(KERN_ERR "[ powerplay ] Invalid Hardware Manager!");
 		return -EINVAL;
 	}
 
-	for (i = 0; i < hwmgr->usec_timeout; i++) {
-		cur_value = cgs_read_register(hwmgr->device, index);
-		if ((cur_value & mask) != (value & mask))
-			break;
-		udelay(1);
-	}
-
-	/* timeout means wrong logic*/
-	if (i == hwmgr->usec_timeout)
-		return -1;
-	return 0;
+	return smum_poll_register(hwmgr->device, index, value, mask,
+				false, hwmgr->usec_timeout);
 }
 
 
@@ -1317,8 +1317,9 @@ static int polaris10_populate_all_graphic_levels(struct pp_hwmgr *hwmgr)
 		levels[1].pcieDpmLevel = mid_pcie_level_enabled;
 	}
 	/* level count will send to smc once at init smc table and never change */
-	result = polaris10_copy_bytes_to_smc(hwmgr->smumgr, array, (uint8_t *)levels,
-			(uint32_t)array_size, data->sram_end);
+	result = smum_upload_smc_table(hwmgr->smumgr, &data->graphics_level_table,
+			array, (uint8_t *)levels, (uint32_t)array_size,
+			data->sram_end);
 
 	return result;
 }
@@ -1419,8 +1420,9 @@ static int polaris10_populate_all_memory_levels(struct pp_hwmgr *hwmgr)
 			phm_get_dpm_level_enable_mask_value(&dpm_table->mclk_table);
 
 	/* level count will send to smc once at init smc table and never change */
-	result = polaris10_copy_bytes_to_smc(hwmgr->smumgr, array, (uint8_t *)levels,
-			(uint32_t)array_size, data->sram_end);
+	result = smum_upload_smc_table(hwmgr->smumgr, &data->memory_level_table,
+			array, (uint8_t *)levels, (uint32_t)array_size,
+			data->sram_end);
 
 	return result;
 }
@@ -2245,6 +2247,10 @@ static int polaris10_init_smc_table(struct pp_hwmgr *hwmgr)
 	PP_ASSERT_WITH_CODE(0 == result,
 			"Failed to upload dpm data to SMC memory!", return result);
 
+	/* the level arrays were rewritten as part of the whole table */
+	smum_invalidate_smc_table(&data->graphics_level_table);
+	smum_invalidate_smc_table(&data->memory_level_table);
+
 	return 0;
 }
 
@@ -2769,6 +2775,13 @@ int polaris10_reset_asic_tasks(struct pp_hwmgr *hwmgr)
 
 int polaris10_hwmgr_backend_fini(struct pp_hwmgr *hwmgr)
 {
+	struct polaris10_hwmgr *data = (struct polaris10_hwmgr *)(hwmgr->backend);
+
+	if (data) {
+		smum_free_smc_table(&data->graphics_level_table);
+		smum_free_smc_table(&data->memory_level_table);
+	}
+
 	return phm_hwmgr_backend_fini(hwmgr);
 }
 
@@ -3382,7 +3395,7 @@ static int polaris10_force_dpm_highest(struct pp_hwmgr *hwmgr)
 				level++;
 
 			if (level)
-				smum_send_msg_to_smc_with_parameter(hwmgr->smumgr,
+				smum_post_msg_to_smc_with_parameter(hwmgr->smumgr,
 						PPSMC_MSG_PCIeDPM_ForceLevel, level);
 		}
 	}
@@ -3395,7 +3408,7 @@ static int polaris10_force_dpm_highest(struct pp_hwmgr *hwmgr)
 				level++;
 
 			if (level)
-				smum_send_msg_to_smc_with_parameter(hwmgr->smumgr,
+				smum_post_msg_to_smc_with_parameter(hwmgr->smumgr,
 						PPSMC_MSG_SCLKDPM_SetEnabledMask,
 						(1 << level));
 		}
@@ -3409,13 +3422,13 @@ static int polaris10_force_dpm_highest(struct pp_hwmgr *hwmgr)
 				level++;
 
 			if (level)
-				smum_send_msg_to_smc_with_parameter(hwmgr->smumgr,
+				smum_post_msg_to_smc_with_parameter(hwmgr->smumgr,
 						PPSMC_MSG_MCLKDPM_SetEnabledMask,
 						(1 << level));
 		}
 	}
 
-	return 0;
+	return smum_flush_msgs_to_smc(hwmgr->smumgr);
 }
 
 static int polaris10_upload_dpm_level_enable_mask(struct pp_hwmgr *hwmgr)
@@ -3466,7 +3479,7 @@ static int polaris10_force_dpm_lowest(struct pp_hwmgr *hwmgr)
 		if (data->dpm_level_enable_mask.sclk_dpm_enable_mask) {
 			level = phm_get_lowest_enabled_level(hwmgr,
 							      data->dpm_level_enable_mask.sclk_dpm_enable_mask);
-			smum_send_msg_to_smc_with_parameter(hwmgr->smumgr,
+			smum_post_msg_to_smc_with_parameter(hwmgr->smumgr,
 							    PPSMC_MSG_SCLKDPM_SetEnabledMask,
 							    (1 << level));
 
@@ -3476,7 +3489,7 @@ static int polaris10_force_dpm_lowest(struct pp_hwmgr *hwmgr)
 		if (data->dpm_level_enable_mask.mclk_dpm_enable_mask) {
 			level = phm_get_lowest_enabled_level(hwmgr,
 							      data->dpm_level_enable_mask.mclk_dpm_enable_mask);
-			smum_send_msg_to_smc_with_parameter(hwmgr->smumgr,
+			smum_post_msg_to_smc_with_parameter(hwmgr->smumgr,
 							    PPSMC_MSG_MCLKDPM_SetEnabledMask,
 							    (1 << level));
 		}
@@ -3486,13 +3499,13 @@ static int polaris10_force_dpm_lowest(struct pp_hwmgr *hwmgr)
 		if (data->dpm_level_enable_mask.pcie_dpm_enable_mask) {
 			level = phm_get_lowest_enabled_level(hwmgr,
 							      data->dpm_level_enable_mask.pcie_dpm_enable_mask);
-			smum_send_msg_to_smc_with_parameter(hwmgr->smumgr,
+			smum_post_msg_to_smc_with_parameter(hwmgr->smumgr,
 							    PPSMC_MSG_PCIeDPM_ForceLevel,
 							    (level));
 		}
 	}
 
-	return 0;
+	return smum_flush_msgs_to_smc(hwmgr->smumgr);
 
 }
 static int polaris10_force_dpm_level(struct pp_hwmgr *hwmgr,
@@ -5246,6 +5259,80 @@ static int polaris10_set_mclk_od(struct pp_hwmgr *hwmgr, uint32_t value)
 
 	return 0;
 }
+static int polaris10_get_clock_levels(struct pp_hwmgr *hwmgr,
+		enum pp_clock_type type, struct amd_pp_clocks *clocks)
+{
+	struct polaris10_hwmgr *data = (struct polaris10_hwmgr *)(hwmgr->backend);
+	struct polaris10_single_dpm_table *dpm_table;
+	uint32_t enable_mask, i;
+
+	switch (type) {
+	case PP_SCLK:
+		dpm_table = &(data->dpm_table.sclk_table);
+		enable_mask = data->dpm_level_enable_mask.sclk_dpm_enable_mask;
+		break;
+	case PP_MCLK:
+		dpm_table = &(data->dpm_table.mclk_table);
+		enable_mask = data->dpm_level_enable_mask.mclk_dpm_enable_mask;
+		break;
+	default:
+		return -EINVAL;
+	}
+
+	/* indices match the force_clock_level mask, disabled levels read 0 */
+	clocks->count = min_t(uint32_t, dpm_table->count, MAX_NUM_CLOCKS);
+	for (i = 0; i < clocks->count; i++)
+		clocks->clock[i] = (enable_mask & (1 << i)) ?
+				dpm_table->dpm_levels[i].value : 0;
+
+	return 0;
+}
+
+static uint32_t polaris10_read_activity(struct pp_hwmgr *hwmgr, uint32_t offset)
+{
+	struct polaris10_hwmgr *data = (struct polaris10_hwmgr *)(hwmgr->backend);
+	uint32_t activity_percent;
+
+	activity_percent = cgs_read_ind_register(hwmgr->device, CGS_IND_REG__SMC,
+			data->soft_regs_start + offset);
+	activity_percent += 0x80;
+	activity_percent >>= 8;
+
+	return activity_percent > 100 ? 100 : activity_percent;
+}
+
+static int polaris10_read_sensors(struct pp_hwmgr *hwmgr,
+		struct amd_pp_sensors *sensors)
+{
+	int result;
+
+	memset(sensors, 0, sizeof(*sensors));
+
+	result = smum_send_msg_to_smc_get_argument(hwmgr->smumgr,
+			PPSMC_MSG_API_GetSclkFrequency, &sensors->sclk);
+	PP_ASSERT_WITH_CODE(0 == result,
+			"Failed to read the current SCLK!", return result);
+
+	result = smum_send_msg_to_smc_get_argument(hwmgr->smumgr,
+			PPSMC_MSG_API_GetMclkFrequency, &sensors->mclk);
+	PP_ASSERT_WITH_CODE(0 == result,
+			"Failed to read the current MCLK!", return result);
+
+	sensors->gpu_load = polaris10_read_activity(hwmgr,
+			offsetof(SMU74_SoftRegisters, AverageGraphicsActivity));
+	sensors->mem_load = polaris10_read_activity(hwmgr,
+			offsetof(SMU74_SoftRegisters, AverageMemoryActivity));
+
+	sensors->temperature = polaris10_thermal_get_temperature(hwmgr);
+
+	if (!hwmgr->thermal_controller.fanInfo.bNoFan) {
+		polaris10_fan_ctrl_get_fan_speed_percent(hwmgr, &sensors->fan_percent);
+		polaris10_fan_ctrl_get_fan_speed_rpm(hwmgr, &sensors->fan_rpm);
+	}
+
+	return 0;
+}
+
 static const struct pp_hwmgr_func polaris10_hwmgr_funcs = {
 	.backend_init = &polaris10_hwmgr_backend_init,
 	.backend_fini = &polaris10_hwmgr_backend_fini,
@@ -5291,6 +5378,8 @@ static const struct pp_hwmgr_func polaris10_hwmgr_funcs = {
 	.set_sclk_od = polaris10_set_sclk_od,
 	.get_mclk_od = polaris10_get_mclk_od,
 	.set_mclk_od = polaris10_set_mclk_od,
+	.get_clock_levels = polaris10_get_clock_levels,
+	.read_sensors = polaris10_read_sensors,
 };
 
 int polaris10_hwmgr_init(struct pp_hwmgr *hwmgr)
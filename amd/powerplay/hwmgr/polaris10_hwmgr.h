@@ -174,6 +174,8 @@ struct polaris10_hwmgr {
 	struct polaris10_dpm_table			dpm_table;
 	struct polaris10_dpm_table			golden_dpm_table;
 	SMU74_Discrete_DpmTable				smc_state_table;
+	struct smum_smc_table				graphics_level_table;
+	struct smum_smc_table				memory_level_table;
 	struct SMU74_Discrete_Ulv            ulv_setting;
 
 	struct polaris10_range_table                range_table[NUM_SCLK_RANGE];
@@ -2618,7 +2618,8 @@ static int tonga_populate_all_graphic_levels(struct pp_hwmgr *hwmgr)
 		data->smc_state_table.GraphicsLevel[1].pcieDpmLevel = mid_pcie_level_enabled;
 	}
 	/* level count will send to smc once at init smc table and never change*/
-	result = tonga_copy_bytes_to_smc(hwmgr->smumgr, level_array_adress, (uint8_t *)levels, (uint32_t)level_array_size, data->sram_end);
+	result = smum_upload_smc_table(hwmgr->smumgr, &data->graphics_level_table,
+		level_array_adress, (uint8_t *)levels, (uint32_t)level_array_size, data->sram_end);
 
 	if (0 != result)
 		return result;
@@ -2672,7 +2673,7 @@ static int tonga_populate_all_memory_levels(struct pp_hwmgr *hwmgr)
 	data->smc_state_table.MemoryLevel[dpm_table->mclk_table.count-1].DisplayWatermark = PPSMC_DISPLAY_WATERMARK_HIGH;
 
 	/* level count will send to smc once at init smc table and never change*/
-	result = tonga_copy_bytes_to_smc(hwmgr->smumgr,
+	result = smum_upload_smc_table(hwmgr->smumgr, &data->memory_level_table,
 		level_array_adress, (uint8_t *)levels, (uint32_t)level_array_size, data->sram_end);
 
 	if (0 != result) {
@@ -3122,6 +3123,10 @@ int tonga_init_smc_table(struct pp_hwmgr *hwmgr)
 	PP_ASSERT_WITH_CODE(0 == result,
 		"Failed to upload dpm data to SMC memory!", return result;);
 
+	/* the level arrays were rewritten as part of the whole table */
+	smum_invalidate_smc_table(&data->graphics_level_table);
+	smum_invalidate_smc_table(&data->memory_level_table);
+
 	return result;
 }
 
@@ -4525,6 +4530,13 @@ int tonga_reset_asic_tasks(struct pp_hwmgr *hwmgr)
 
 int tonga_hwmgr_backend_fini(struct pp_hwmgr *hwmgr)
 {
+	tonga_hwmgr *data = (tonga_hwmgr *)(hwmgr->backend);
+
+	if (data) {
+		smum_free_smc_table(&data->graphics_level_table);
+		smum_free_smc_table(&data->memory_level_table);
+	}
+
 	return phm_hwmgr_backend_fini(hwmgr);
 }
 
@@ -6324,6 +6336,80 @@ static int tonga_set_mclk_od(struct pp_hwmgr *hwmgr, uint32_t value)
 	return 0;
 }
 
+static int tonga_get_clock_levels(struct pp_hwmgr *hwmgr,
+		enum pp_clock_type type, struct amd_pp_clocks *clocks)
+{
+	struct tonga_hwmgr *data = (struct tonga_hwmgr *)(hwmgr->backend);
+	struct tonga_single_dpm_table *dpm_table;
+	uint32_t enable_mask, i;
+
+	switch (type) {
+	case PP_SCLK:
+		dpm_table = &(data->dpm_table.sclk_table);
+		enable_mask = data->dpm_level_enable_mask.sclk_dpm_enable_mask;
+		break;
+	case PP_MCLK:
+		dpm_table = &(data->dpm_table.mclk_table);
+		enable_mask = data->dpm_level_enable_mask.mclk_dpm_enable_mask;
+		break;
+	default:
+		return -EINVAL;
+	}
+
+	/* indices match the force_clock_level mask, disabled levels read 0 */
+	clocks->count = min_t(uint32_t, dpm_table->count, MAX_NUM_CLOCKS);
+	for (i = 0; i < clocks->count; i++)
+		clocks->clock[i] = (enable_mask & (1 << i)) ?
+				dpm_table->dpm_levels[i].value : 0;
+
+	return 0;
+}
+
+static uint32_t tonga_read_activity(struct pp_hwmgr *hwmgr, uint32_t offset)
+{
+	struct tonga_hwmgr *data = (struct tonga_hwmgr *)(hwmgr->backend);
+	uint32_t activity_percent;
+
+	activity_percent = cgs_read_ind_register(hwmgr->device, CGS_IND_REG__SMC,
+			data->soft_regs_start + offset);
+	activity_percent += 0x80;
+	activity_percent >>= 8;
+
+	return activity_percent > 100 ? 100 : activity_percent;
+}
+
+static int tonga_read_sensors(struct pp_hwmgr *hwmgr,
+		struct amd_pp_sensors *sensors)
+{
+	int result;
+
+	memset(sensors, 0, sizeof(*sensors));
+
+	result = smum_send_msg_to_smc_get_argument(hwmgr->smumgr,
+			PPSMC_MSG_API_GetSclkFrequency, &sensors->sclk);
+	PP_ASSERT_WITH_CODE(0 == result,
+			"Failed to read the current SCLK!", return result);
+
+	result = smum_send_msg_to_smc_get_argument(hwmgr->smumgr,
+			PPSMC_MSG_API_GetMclkFrequency, &sensors->mclk);
+	PP_ASSERT_WITH_CODE(0 == result,
+			"Failed to read the current MCLK!", return result);
+
+	sensors->gpu_load = tonga_read_activity(hwmgr,
+			offsetof(SMU72_SoftRegisters, AverageGraphicsActivity));
+	sensors->mem_load = tonga_read_activity(hwmgr,
+			offsetof(SMU72_SoftRegisters, AverageMemoryActivity));
+
+	sensors->temperature = tonga_thermal_get_temperature(hwmgr);
+
+	if (!hwmgr->thermal_controller.fanInfo.bNoFan) {
+		tonga_fan_ctrl_get_fan_speed_percent(hwmgr, &sensors->fan_percent);
+		tonga_fan_ctrl_get_fan_speed_rpm(hwmgr, &sensors->fan_rpm);
+	}
+
+	return 0;
+}
+
 static const struct pp_hwmgr_func tonga_hwmgr_funcs = {
 	.backend_init = &tonga_hwmgr_backend_init,
 	.backend_fini = &tonga_hwmgr_backend_fini,
@@ -6369,6 +6455,8 @@ static const struct pp_hwmgr_func tonga_hwmgr_funcs = {
 	.set_sclk_od = tonga_set_sclk_od,
 	.get_mclk_od = tonga_get_mclk_od,
 	.set_mclk_od = tonga_set_mclk_od,
+	.get_clock_levels = tonga_get_clock_levels,
+	.read_sensors = tonga_read_sensors,
 };
 
 int tonga_hwmgr_init(struct pp_hwmgr *hwmgr)
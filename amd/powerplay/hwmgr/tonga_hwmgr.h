@@ -279,6 +279,8 @@ struct tonga_hwmgr {
 	uint32_t                           fan_table_start;          /* The start of the fan table in the SMC SRAM. */
 	uint32_t                           arb_table_start;          /* The start of the ARB setting table in the SMC SRAM. */
 	SMU72_Discrete_DpmTable         smc_state_table;             /* The carbon copy of the SMC state table. */
+	struct smum_smc_table           graphics_level_table;        /* What was last uploaded of the SCLK levels. */
+	struct smum_smc_table           memory_level_table;          /* What was last uploaded of the MCLK levels. */
 	SMU72_Discrete_MCRegisters      mc_reg_table;
 	SMU72_Discrete_Ulv              ulv_setting;                 /* The carbon copy of ULV setting. */
 	/* -------------- Stuff originally coming from Evergreen --------------------*/
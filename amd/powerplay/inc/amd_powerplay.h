@@ -263,6 +263,18 @@ struct amd_pp_clocks {
 	uint32_t clock[MAX_NUM_CLOCKS];
 };
 
+/* one snapshot of the SMC and thermal readings, 0 for unsupported fields */
+struct amd_pp_sensors {
+	uint32_t sclk;		/* current engine clock, 10 kHz */
+	uint32_t mclk;		/* current memory clock, 10 kHz */
+	int temperature;	/* millidegrees Celsius */
+	uint32_t fan_percent;
+	uint32_t fan_rpm;
+	uint32_t power;		/* package power, mW */
+	uint32_t gpu_load;	/* average graphics activity, percent */
+	uint32_t mem_load;	/* average memory activity, percent */
+};
+
 
 enum {
 	PP_GROUP_UNKNOWN = 0,
@@ -347,6 +359,8 @@ struct amd_powerplay_funcs {
 	int (*set_sclk_od)(void *handle, uint32_t value);
 	int (*get_mclk_od)(void *handle);
 	int (*set_mclk_od)(void *handle, uint32_t value);
+	int (*get_clock_levels)(void *handle, enum pp_clock_type type, struct amd_pp_clocks *clocks);
+	int (*read_sensors)(void *handle, struct amd_pp_sensors *sensors);
 };
 
 struct amd_powerplay {
@@ -345,6 +345,8 @@ struct pp_hwmgr_func {
 	int (*set_sclk_od)(struct pp_hwmgr *hwmgr, uint32_t value);
 	int (*get_mclk_od)(struct pp_hwmgr *hwmgr);
 	int (*set_mclk_od)(struct pp_hwmgr *hwmgr, uint32_t value);
+	int (*get_clock_levels)(struct pp_hwmgr *hwmgr, enum pp_clock_type type, struct amd_pp_clocks *clocks);
+	int (*read_sensors)(struct pp_hwmgr *hwmgr, struct amd_pp_sensors *sensors);
 };
 
 struct pp_table_func {
@@ -23,11 +23,14 @@
 #ifndef _SMUMGR_H_
 #define _SMUMGR_H_
 #include <linux/types.h>
+#include <linux/mutex.h>
+#include <linux/ktime.h>
 #include "pp_instance.h"
 #include "amd_powerplay.h"
 
 struct pp_smumgr;
 struct pp_instance;
+struct seq_file;
 
 #define smu_lower_32_bits(n) ((uint32_t)(n))
 #define smu_upper_32_bits(n) ((uint32_t)(((n)>>16)>>16))
@@ -69,6 +72,64 @@ struct pp_smumgr_func {
 	int (*download_pptable_settings)(struct pp_smumgr *smumgr,
 					 void **table);
 	int (*upload_pptable_settings)(struct pp_smumgr *smumgr);
+	int (*copy_bytes_to_smc)(struct pp_smumgr *smumgr,
+				 uint32_t smc_start_address,
+				 const uint8_t *src, uint32_t byte_count,
+				 uint32_t limit);
+};
+
+/* Register waits spin this long before they start sleeping. */
+#define SMUM_POLL_SPIN_USEC		20
+#define SMUM_POLL_SLEEP_MIN_USEC	10
+#define SMUM_POLL_SLEEP_MAX_USEC	1000
+
+#define SMUM_MSG_STATS_SIZE		64
+
+/* smum_mailbox_send() flags */
+#define SMUM_MSG_HAS_PARAMETER		(1 << 0)
+#define SMUM_MSG_POSTED			(1 << 1)
+
+/*
+ * Unchanged runs shorter than this are rewritten rather than split into
+ * two uploads, since starting a new upload costs a few register writes.
+ */
+#define SMUM_SMC_TABLE_MERGE_GAP	8
+
+/*
+ * Shadow of a table in SMC SRAM. While valid it holds what was last
+ * uploaded, so that only the ranges that changed need to be written.
+ */
+struct smum_smc_table {
+	uint8_t *shadow;
+	uint32_t size;
+	bool valid;
+};
+
+struct smum_msg_stats {
+	uint16_t msg;
+	uint32_t count;
+	uint32_t failures;
+	uint64_t total_us;
+	uint32_t max_us;
+};
+
+/*
+ * The SMC mailbox has a single slot: a message register, an argument
+ * register and a response register that reads zero while the SMC is busy
+ * with the last message. A posted message is left in flight and waited
+ * for by whoever uses the mailbox next.
+ */
+struct smum_mailbox {
+	struct mutex lock;
+	uint32_t msg_reg;
+	uint32_t arg_reg;
+	uint32_t resp_reg;
+	uint32_t resp_mask;
+	bool clear_resp;
+	bool pending;
+	uint16_t pending_msg;
+	ktime_t pending_since;
+	struct smum_msg_stats stats[SMUM_MSG_STATS_SIZE];
 };
 
 struct pp_smumgr {
@@ -80,6 +141,10 @@ struct pp_smumgr {
 	uint32_t usec_timeout;
 	bool reload_fw;
 	const struct pp_smumgr_func *smumgr_funcs;
+	struct smum_mailbox mailbox;
+	uint32_t smc_table_uploads;
+	uint64_t smc_table_bytes_written;
+	uint64_t smc_table_bytes_skipped;
 };
 
 
@@ -99,6 +164,39 @@ extern int smum_send_msg_to_smc(struct pp_smumgr *smumgr, uint16_t msg);
 extern int smum_send_msg_to_smc_with_parameter(struct pp_smumgr *smumgr,
 					uint16_t msg, uint32_t parameter);
 
+extern int smum_post_msg_to_smc(struct pp_smumgr *smumgr, uint16_t msg);
+
+extern int smum_post_msg_to_smc_with_parameter(struct pp_smumgr *smumgr,
+					uint16_t msg, uint32_t parameter);
+
+extern int smum_flush_msgs_to_smc(struct pp_smumgr *smumgr);
+
+extern void smum_mailbox_init(struct pp_smumgr *smumgr, uint32_t msg_reg,
+				uint32_t arg_reg, uint32_t resp_reg,
+				uint32_t resp_mask, bool clear_resp);
+
+extern int smum_mailbox_send(struct pp_smumgr *smumgr, uint16_t msg,
+				uint32_t parameter, uint32_t flags);
+
+extern int smum_send_msg_to_smc_get_argument(struct pp_smumgr *smumgr,
+				uint16_t msg, uint32_t *argument);
+
+extern void smum_print_msg_stats(struct pp_smumgr *smumgr,
+				struct seq_file *m);
+
+extern int smum_upload_smc_table(struct pp_smumgr *smumgr,
+				struct smum_smc_table *table,
+				uint32_t smc_start_address, const uint8_t *src,
+				uint32_t byte_count, uint32_t limit);
+
+extern void smum_invalidate_smc_table(struct smum_smc_table *table);
+
+extern void smum_free_smc_table(struct smum_smc_table *table);
+
+extern int smum_poll_register(void *device, uint32_t index,
+				uint32_t value, uint32_t mask, bool equal,
+				uint32_t usec_timeout);
+
 extern int smum_wait_on_register(struct pp_smumgr *smumgr,
 				uint32_t index, uint32_t value, uint32_t mask);
 
@@ -59,43 +59,13 @@ static int cz_smum_get_argument(struct pp_smumgr *smumgr)
 					mmSMU_MP1_SRBM2P_ARG_0);
 }
 
-static int cz_send_msg_to_smc_async(struct pp_smumgr *smumgr,
-								uint16_t msg)
-{
-	int result = 0;
-
-	if (smumgr == NULL || smumgr->device == NULL)
-		return -EINVAL;
-
-	result = SMUM_WAIT_FIELD_UNEQUAL(smumgr,
-					SMU_MP1_SRBM2P_RESP_0, CONTENT, 0);
-	if (result != 0) {
-		printk(KERN_ERR "[ powerplay ] cz_send_msg_to_smc_async failed\n");
-		return result;
-	}
-
-	cgs_write_register(smumgr->device, mmSMU_MP1_SRBM2P_RESP_0, 0);
-	cgs_write_register(smumgr->device, mmSMU_MP1_SRBM2P_MSG_0, msg);
-
-	return 0;
-}
-
 /* Send a message to the SMC, and wait for its response.*/
 static int cz_send_msg_to_smc(struct pp_smumgr *smumgr, uint16_t msg)
 {
-	int result = 0;
-
-	result = cz_send_msg_to_smc_async(smumgr, msg);
-	if (result != 0)
-		return result;
-
-	result = SMUM_WAIT_FIELD_UNEQUAL(smumgr,
-					SMU_MP1_SRBM2P_RESP_0, CONTENT, 0);
-
-	if (result != 0)
-		return result;
+	if (smumgr == NULL || smumgr->device == NULL)
+		return -EINVAL;
 
-	return 0;
+	return smum_mailbox_send(smumgr, msg, 0, 0);
 }
 
 static int cz_set_smc_sram_address(struct pp_smumgr *smumgr,
@@ -140,9 +110,8 @@ static int cz_send_msg_to_smc_with_parameter(struct pp_smumgr *smumgr,
 	if (smumgr == NULL || smumgr->device == NULL)
 		return -EINVAL;
 
-	cgs_write_register(smumgr->device, mmSMU_MP1_SRBM2P_ARG_0, parameter);
-
-	return cz_send_msg_to_smc(smumgr, msg);
+	return smum_mailbox_send(smumgr, msg, parameter,
+				SMUM_MSG_HAS_PARAMETER);
 }
 
 static int cz_request_smu_load_fw(struct pp_smumgr *smumgr)
@@ -877,5 +846,8 @@ int cz_smum_init(struct pp_smumgr *smumgr)
 
 	smumgr->backend = cz_smu;
 	smumgr->smumgr_funcs = &cz_smu_funcs;
+	smum_mailbox_init(smumgr, mmSMU_MP1_SRBM2P_MSG_0,
+			mmSMU_MP1_SRBM2P_ARG_0, mmSMU_MP1_SRBM2P_RESP_0,
+			SMU_MP1_SRBM2P_RESP_0__CONTENT_MASK, true);
 	return 0;
 }
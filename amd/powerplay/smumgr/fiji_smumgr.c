@@ -135,19 +135,29 @@ int fiji_copy_bytes_to_smc(struct pp_smumgr *smumgr,
 
 	PP_ASSERT_WITH_CODE((0 == (3 & smcStartAddress)),
 			"SMC address must be 4 byte aligned.", return -EINVAL;);
-	PP_ASSERT_WITH_CODE((limit > (smcStartAddress + byteCount)),
+	/* the dwords below are written without checking each address */
+	PP_ASSERT_WITH_CODE((byteCount <= limit &&
+			smcStartAddress <= limit - byteCount),
 			"SMC address is beyond the SMC RAM area.", return -EINVAL;);
 
 	addr = smcStartAddress;
 
-	while (byteCount >= 4) {
-		/* Bytes are written into the SMC addres space with the MSB first. */
-		data = src[0] * 0x1000000 + src[1] * 0x10000 + src[2] * 0x100 + src[3];
-
+	/*
+	 * INDEX_0 is shared with the driver's own SMC register accessors,
+	 * so rather than auto-incrementing, program the access mode once
+	 * and only update the index for each dword.
+	 */
+	if (byteCount >= 4) {
 		result = fiji_set_smc_sram_address(smumgr, addr, limit);
 		if (result)
 			return result;
+	}
 
+	while (byteCount >= 4) {
+		/* Bytes are written into the SMC addres space with the MSB first. */
+		data = src[0] * 0x1000000 + src[1] * 0x10000 + src[2] * 0x100 + src[3];
+
+		cgs_write_register(smumgr->device, mmSMC_IND_INDEX_0, addr);
 		cgs_write_register(smumgr->device, mmSMC_IND_DATA_0, data);
 
 		src += 4;
@@ -179,7 +189,7 @@ int fiji_copy_bytes_to_smc(struct pp_smumgr *smumgr,
 		data |= (originalData & ~((~0UL) << extraShift));
 
 		result = fiji_set_smc_sram_address(smumgr, addr, limit);
-		if (!result)
+		if (result)
 			return result;
 
 		cgs_write_register(smumgr->device, mmSMC_IND_DATA_0, data);
@@ -222,15 +232,7 @@ int fiji_send_msg_to_smc(struct pp_smumgr *smumgr, uint16_t msg)
 	if (!fiji_is_smc_ram_running(smumgr))
 		return -1;
 
-	if (1 != SMUM_READ_FIELD(smumgr->device, SMC_RESP_0, SMC_RESP)) {
-		printk(KERN_ERR "Failed to send Previous Message.");
-		SMUM_WAIT_FIELD_UNEQUAL(smumgr, SMC_RESP_0, SMC_RESP, 0);
-	}
-
-	cgs_write_register(smumgr->device, mmSMC_MESSAGE_0, msg);
-	SMUM_WAIT_FIELD_UNEQUAL(smumgr, SMC_RESP_0, SMC_RESP, 0);
-
-	return 0;
+	return smum_mailbox_send(smumgr, msg, 0, 0);
 }
 
 /**
@@ -246,16 +248,8 @@ int fiji_send_msg_to_smc_with_parameter(struct pp_smumgr *smumgr,
 	if (!fiji_is_smc_ram_running(smumgr))
 		return -1;
 
-	if (1 != SMUM_READ_FIELD(smumgr->device, SMC_RESP_0, SMC_RESP)) {
-		printk(KERN_ERR "Failed to send Previous Message.");
-		SMUM_WAIT_FIELD_UNEQUAL(smumgr, SMC_RESP_0, SMC_RESP, 0);
-	}
-
-	cgs_write_register(smumgr->device, mmSMC_MSG_ARG_0, parameter);
-	cgs_write_register(smumgr->device, mmSMC_MESSAGE_0, msg);
-	SMUM_WAIT_FIELD_UNEQUAL(smumgr, SMC_RESP_0, SMC_RESP, 0);
-
-	return 0;
+	return smum_mailbox_send(smumgr, msg, parameter,
+				SMUM_MSG_HAS_PARAMETER);
 }
 
 
@@ -1030,6 +1024,7 @@ static const struct pp_smumgr_func fiji_smu_funcs = {
 	.send_msg_to_smc_with_parameter = &fiji_send_msg_to_smc_with_parameter,
 	.download_pptable_settings = NULL,
 	.upload_pptable_settings = NULL,
+	.copy_bytes_to_smc = fiji_copy_bytes_to_smc,
 };
 
 int fiji_smum_init(struct pp_smumgr *smumgr)
@@ -1043,6 +1038,8 @@ int fiji_smum_init(struct pp_smumgr *smumgr)
 
 	smumgr->backend = fiji_smu;
 	smumgr->smumgr_funcs = &fiji_smu_funcs;
+	smum_mailbox_init(smumgr, mmSMC_MESSAGE_0, mmSMC_MSG_ARG_0,
+			mmSMC_RESP_0, SMC_RESP_0__SMC_RESP_MASK, false);
 
 	return 0;
 }
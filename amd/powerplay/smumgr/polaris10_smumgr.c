@@ -142,19 +142,26 @@ int polaris10_copy_bytes_to_smc(struct pp_smumgr *smumgr, uint32_t smc_start_add
 	uint32_t extra_shift;
 
 	PP_ASSERT_WITH_CODE((0 == (3 & smc_start_address)), "SMC address must be 4 byte aligned.", return -1);
-	PP_ASSERT_WITH_CODE((limit > (smc_start_address + byte_count)), "SMC address is beyond the SMC RAM area.", return -1);
+	/* the dwords below are written without checking each address */
+	PP_ASSERT_WITH_CODE((byte_count <= limit && smc_start_address <= limit - byte_count),
+			"SMC address is beyond the SMC RAM area.", return -1);
 
 	addr = smc_start_address;
 
-	while (byte_count >= 4) {
-	/* Bytes are written into the SMC addres space with the MSB first. */
-		data = src[0] * 0x1000000 + src[1] * 0x10000 + src[2] * 0x100 + src[3];
-
+	/* INDEX_11 is private to powerplay, so stream the dwords through it */
+	if (byte_count >= 4) {
 		result = polaris10_set_smc_sram_address(smumgr, addr, limit);
 
 		if (0 != result)
 			return result;
 
+		SMUM_WRITE_FIELD(smumgr->device, SMC_IND_ACCESS_CNTL, AUTO_INCREMENT_IND_11, 1);
+	}
+
+	while (byte_count >= 4) {
+	/* Bytes are written into the SMC addres space with the MSB first. */
+		data = src[0] * 0x1000000 + src[1] * 0x10000 + src[2] * 0x100 + src[3];
+
 		cgs_write_register(smumgr->device, mmSMC_IND_DATA_11, data);
 
 		src += 4;
@@ -162,6 +169,8 @@ int polaris10_copy_bytes_to_smc(struct pp_smumgr *smumgr, uint32_t smc_start_add
 		addr += 4;
 	}
 
+	SMUM_WRITE_FIELD(smumgr->device, SMC_IND_ACCESS_CNTL, AUTO_INCREMENT_IND_11, 0);
+
 	if (0 != byte_count) {
 
 		data = 0;
@@ -239,29 +248,10 @@ static bool polaris10_is_hw_avfs_present(struct pp_smumgr *smumgr)
 */
 int polaris10_send_msg_to_smc(struct pp_smumgr *smumgr, uint16_t msg)
 {
-	int ret;
-
 	if (!polaris10_is_smc_ram_running(smumgr))
 		return -1;
 
-
-	SMUM_WAIT_FIELD_UNEQUAL(smumgr, SMC_RESP_0, SMC_RESP, 0);
-
-	ret = SMUM_READ_FIELD(smumgr->device, SMC_RESP_0, SMC_RESP);
-
-	if (ret != 1)
-		printk("\n failed to send pre message %x ret is %d \n",  msg, ret);
-
-	cgs_write_register(smumgr->device, mmSMC_MESSAGE_0, msg);
-
-	SMUM_WAIT_FIELD_UNEQUAL(smumgr, SMC_RESP_0, SMC_RESP, 0);
-
-	ret = SMUM_READ_FIELD(smumgr->device, SMC_RESP_0, SMC_RESP);
-
-	if (ret != 1)
-		printk("\n failed to send message %x ret is %d \n",  msg, ret);
-
-	return 0;
+	return smum_mailbox_send(smumgr, msg, 0, 0);
 }
 
 
@@ -293,11 +283,8 @@ int polaris10_send_msg_to_smc_with_parameter(struct pp_smumgr *smumgr, uint16_t
 		return -1;
 	}
 
-	SMUM_WAIT_FIELD_UNEQUAL(smumgr, SMC_RESP_0, SMC_RESP, 0);
-
-	cgs_write_register(smumgr->device, mmSMC_MSG_ARG_0, parameter);
-
-	return polaris10_send_msg_to_smc(smumgr, msg);
+	return smum_mailbox_send(smumgr, msg, parameter,
+				SMUM_MSG_HAS_PARAMETER);
 }
 
 
@@ -989,6 +976,7 @@ static const struct pp_smumgr_func ellsemere_smu_funcs = {
 	.send_msg_to_smc_with_parameter = polaris10_send_msg_to_smc_with_parameter,
 	.download_pptable_settings = NULL,
 	.upload_pptable_settings = NULL,
+	.copy_bytes_to_smc = polaris10_copy_bytes_to_smc,
 };
 
 int polaris10_smum_init(struct pp_smumgr *smumgr)
@@ -1002,6 +990,8 @@ int polaris10_smum_init(struct pp_smumgr *smumgr)
 
 	smumgr->backend = polaris10_smu;
 	smumgr->smumgr_funcs = &ellsemere_smu_funcs;
+	smum_mailbox_init(smumgr, mmSMC_MESSAGE_0, mmSMC_MSG_ARG_0,
+			mmSMC_RESP_0, SMC_RESP_0__SMC_RESP_MASK, false);
 
 	return 0;
 }
@@ -23,6 +23,8 @@
 #include <linux/types.h>
 #include <linux/kernel.h>
 #include <linux/slab.h>
+#include <linux/ktime.h>
+#include <linux/seq_file.h>
 #include <drm/amdgpu_drm.h>
 #include "pp_instance.h"
 #include "smumgr.h"
@@ -50,6 +52,7 @@ int smum_init(struct amd_pp_init *pp_init, struct pp_instance *handle)
 	smumgr->hw_revision = pp_init->rev_id;
 	smumgr->usec_timeout = AMD_MAX_USEC_TIMEOUT;
 	smumgr->reload_fw = 1;
+	mutex_init(&smumgr->mailbox.lock);
 	handle->smu_mgr = smumgr;
 
 	switch (smumgr->chip_family) {
@@ -82,6 +85,7 @@ int smum_init(struct amd_pp_init *pp_init, struct pp_instance *handle)
 
 int smum_fini(struct pp_smumgr *smumgr)
 {
+	mutex_destroy(&smumgr->mailbox.lock);
 	kfree(smumgr->device);
 	kfree(smumgr);
 	return 0;
@@ -89,6 +93,9 @@ int smum_fini(struct pp_smumgr *smumgr)
 
 int smum_get_argument(struct pp_smumgr *smumgr)
 {
+	/* the argument is only valid once the last message completed */
+	smum_flush_msgs_to_smc(smumgr);
+
 	if (NULL != smumgr->smumgr_funcs->get_argument)
 		return smumgr->smumgr_funcs->get_argument(smumgr);
 
@@ -131,57 +138,390 @@ int smum_send_msg_to_smc_with_parameter(struct pp_smumgr *smumgr,
 						smumgr, msg, parameter);
 }
 
+int smum_post_msg_to_smc(struct pp_smumgr *smumgr, uint16_t msg)
+{
+	if (smumgr == NULL || smumgr->device == NULL)
+		return -EINVAL;
+
+	return smum_mailbox_send(smumgr, msg, 0, SMUM_MSG_POSTED);
+}
+
+int smum_post_msg_to_smc_with_parameter(struct pp_smumgr *smumgr,
+					uint16_t msg, uint32_t parameter)
+{
+	if (smumgr == NULL || smumgr->device == NULL)
+		return -EINVAL;
+
+	return smum_mailbox_send(smumgr, msg, parameter,
+				SMUM_MSG_HAS_PARAMETER | SMUM_MSG_POSTED);
+}
+
+static struct smum_msg_stats *smum_get_msg_stats(struct smum_mailbox *mailbox,
+						uint16_t msg)
+{
+	struct smum_msg_stats *stats;
+	uint32_t i, slot;
+
+	for (i = 0; i < SMUM_MSG_STATS_SIZE; i++) {
+		slot = (msg + i) & (SMUM_MSG_STATS_SIZE - 1);
+		stats = &mailbox->stats[slot];
+
+		if (stats->count == 0)
+			stats->msg = msg;
+
+		if (stats->msg == msg)
+			return stats;
+	}
+
+	return NULL;
+}
+
 /*
- * Returns once the part of the register indicated by the mask has
- * reached the given value.
+ * Wait until the SMC is done with the message in the mailbox, and account
+ * for the latency of the message if it was sent through the mailbox.
+ * Called with the mailbox lock held.
  */
-int smum_wait_on_register(struct pp_smumgr *smumgr,
-				uint32_t index,
-				uint32_t value, uint32_t mask)
+static int smum_mailbox_wait(struct pp_smumgr *smumgr)
 {
-	uint32_t i;
-	uint32_t cur_value;
+	struct smum_mailbox *mailbox = &smumgr->mailbox;
+	struct smum_msg_stats *stats;
+	uint32_t resp = 0;
+	uint32_t latency;
+	int ret;
+
+	ret = smum_poll_register(smumgr->device, mailbox->resp_reg,
+				0, mailbox->resp_mask, false,
+				smumgr->usec_timeout);
+
+	if (!mailbox->pending)
+		return ret ? -ETIME : 0;
+
+	mailbox->pending = false;
+	latency = (uint32_t)ktime_us_delta(ktime_get(),
+					mailbox->pending_since);
+
+	if (!ret)
+		resp = cgs_read_register(smumgr->device, mailbox->resp_reg)
+				& mailbox->resp_mask;
+
+	stats = smum_get_msg_stats(mailbox, mailbox->pending_msg);
+	if (stats) {
+		stats->count++;
+		stats->total_us += latency;
+		if (latency > stats->max_us)
+			stats->max_us = latency;
+		if (resp != 1)
+			stats->failures++;
+	}
+
+	if (ret) {
+		printk(KERN_ERR "[ powerplay ] SMC message 0x%x timed out\n",
+				mailbox->pending_msg);
+		return -ETIME;
+	}
+
+	if (resp != 1)
+		printk(KERN_ERR "[ powerplay ] SMC message 0x%x failed, response 0x%x\n",
+				mailbox->pending_msg, resp);
+
+	return 0;
+}
+
+void smum_mailbox_init(struct pp_smumgr *smumgr, uint32_t msg_reg,
+			uint32_t arg_reg, uint32_t resp_reg,
+			uint32_t resp_mask, bool clear_resp)
+{
+	struct smum_mailbox *mailbox = &smumgr->mailbox;
+
+	mailbox->msg_reg = msg_reg;
+	mailbox->arg_reg = arg_reg;
+	mailbox->resp_reg = resp_reg;
+	mailbox->resp_mask = resp_mask;
+	mailbox->clear_resp = clear_resp;
+	mailbox->pending = false;
+}
+
+/*
+ * Send a message through the SMC mailbox. Any message still in flight is
+ * waited for first, since the mailbox only holds one. Unless the message
+ * is posted, wait for the SMC to complete it as well.
+ *
+ * Returns -ETIME if the SMC did not respond in time. An SMC response
+ * other than OK is logged and counted, but not returned.
+ */
+static int __smum_mailbox_send(struct pp_smumgr *smumgr, uint16_t msg,
+			uint32_t parameter, uint32_t flags)
+{
+	struct smum_mailbox *mailbox = &smumgr->mailbox;
+	int ret;
+
+	ret = smum_mailbox_wait(smumgr);
+	if (ret)
+		return ret;
+
+	if (flags & SMUM_MSG_HAS_PARAMETER)
+		cgs_write_register(smumgr->device, mailbox->arg_reg, parameter);
+
+	if (mailbox->clear_resp)
+		cgs_write_register(smumgr->device, mailbox->resp_reg, 0);
+
+	cgs_write_register(smumgr->device, mailbox->msg_reg, msg);
+
+	mailbox->pending = true;
+	mailbox->pending_msg = msg;
+	mailbox->pending_since = ktime_get();
+
+	if (!(flags & SMUM_MSG_POSTED))
+		ret = smum_mailbox_wait(smumgr);
+
+	return ret;
+}
+
+int smum_mailbox_send(struct pp_smumgr *smumgr, uint16_t msg,
+			uint32_t parameter, uint32_t flags)
+{
+	struct smum_mailbox *mailbox = &smumgr->mailbox;
+	int ret;
+
+	mutex_lock(&mailbox->lock);
+	ret = __smum_mailbox_send(smumgr, msg, parameter, flags);
+	mutex_unlock(&mailbox->lock);
+
+	return ret;
+}
+
+/*
+ * Send a message and read back the argument register the SMC answered in.
+ * Both happen under the mailbox lock, so that no other message can replace
+ * the answer in between.
+ */
+int smum_send_msg_to_smc_get_argument(struct pp_smumgr *smumgr, uint16_t msg,
+					uint32_t *argument)
+{
+	struct smum_mailbox *mailbox;
+	int ret;
+
+	if (smumgr == NULL || smumgr->device == NULL || argument == NULL)
+		return -EINVAL;
+
+	mailbox = &smumgr->mailbox;
+
+	mutex_lock(&mailbox->lock);
+	ret = __smum_mailbox_send(smumgr, msg, 0, 0);
+	*argument = ret ? 0 : cgs_read_register(smumgr->device,
+						mailbox->arg_reg);
+	mutex_unlock(&mailbox->lock);
+
+	return ret;
+}
+
+/* Wait for any posted message to complete. */
+int smum_flush_msgs_to_smc(struct pp_smumgr *smumgr)
+{
+	struct smum_mailbox *mailbox;
+	int ret = 0;
 
 	if (smumgr == NULL || smumgr->device == NULL)
 		return -EINVAL;
 
-	for (i = 0; i < smumgr->usec_timeout; i++) {
-		cur_value = cgs_read_register(smumgr->device, index);
-		if ((cur_value & mask) == (value & mask))
+	mailbox = &smumgr->mailbox;
+
+	mutex_lock(&mailbox->lock);
+	if (mailbox->pending)
+		ret = smum_mailbox_wait(smumgr);
+	mutex_unlock(&mailbox->lock);
+
+	return ret;
+}
+
+void smum_invalidate_smc_table(struct smum_smc_table *table)
+{
+	table->valid = false;
+}
+
+void smum_free_smc_table(struct smum_smc_table *table)
+{
+	kfree(table->shadow);
+	table->shadow = NULL;
+	table->size = 0;
+	table->valid = false;
+}
+
+/*
+ * Upload a table to SMC SRAM, writing only the dword ranges that differ
+ * from the last upload. The whole table is written if the shadow is not
+ * valid, e.g. after the SMC has been reinitialized.
+ */
+int smum_upload_smc_table(struct pp_smumgr *smumgr,
+			struct smum_smc_table *table,
+			uint32_t smc_start_address, const uint8_t *src,
+			uint32_t byte_count, uint32_t limit)
+{
+	uint32_t start, end, gap, written = 0;
+	int result = 0;
+
+	if (smumgr == NULL || smumgr->smumgr_funcs->copy_bytes_to_smc == NULL)
+		return -EINVAL;
+
+	if (table->size != byte_count) {
+		kfree(table->shadow);
+		table->shadow = kmalloc(byte_count, GFP_KERNEL);
+		table->size = table->shadow ? byte_count : 0;
+		table->valid = false;
+	}
+
+	if (!table->valid) {
+		result = smumgr->smumgr_funcs->copy_bytes_to_smc(smumgr,
+				smc_start_address, src, byte_count, limit);
+		written = byte_count;
+		goto out;
+	}
+
+	start = 0;
+	while (start < byte_count) {
+		/* find the next dword that changed */
+		while (start < byte_count && !memcmp(table->shadow + start,
+				src + start, min_t(uint32_t, 4, byte_count - start)))
+			start += 4;
+
+		if (start >= byte_count)
+			break;
+
+		/* extend the range over changes and short unchanged runs */
+		end = start;
+		gap = 0;
+		while (end < byte_count && gap < SMUM_SMC_TABLE_MERGE_GAP) {
+			if (memcmp(table->shadow + end, src + end,
+					min_t(uint32_t, 4, byte_count - end)))
+				gap = 0;
+			else
+				gap += 4;
+			end += 4;
+		}
+		end = min_t(uint32_t, end - gap, byte_count);
+
+		result = smumgr->smumgr_funcs->copy_bytes_to_smc(smumgr,
+				smc_start_address + start, src + start,
+				end - start, limit);
+		if (result)
 			break;
-		udelay(1);
+
+		written += end - start;
+		start = end;
 	}
 
-	/* timeout means wrong logic*/
-	if (i == smumgr->usec_timeout)
-		return -1;
+out:
+	if (table->shadow) {
+		if (result) {
+			table->valid = false;
+		} else {
+			memcpy(table->shadow, src, byte_count);
+			table->valid = true;
+		}
+	}
 
-	return 0;
+	if (!result) {
+		smumgr->smc_table_uploads++;
+		smumgr->smc_table_bytes_written += written;
+		smumgr->smc_table_bytes_skipped += byte_count - written;
+	}
+
+	return result;
 }
 
-int smum_wait_for_register_unequal(struct pp_smumgr *smumgr,
-					uint32_t index,
-					uint32_t value, uint32_t mask)
+void smum_print_msg_stats(struct pp_smumgr *smumgr, struct seq_file *m)
 {
+	struct smum_mailbox *mailbox;
+	struct smum_msg_stats *stats;
 	uint32_t i;
-	uint32_t cur_value;
 
 	if (smumgr == NULL)
-		return -EINVAL;
+		return;
 
-	for (i = 0; i < smumgr->usec_timeout; i++) {
-		cur_value = cgs_read_register(smumgr->device,
-									index);
-		if ((cur_value & mask) != (value & mask))
-			break;
-		udelay(1);
+	mailbox = &smumgr->mailbox;
+
+	mutex_lock(&mailbox->lock);
+	seq_printf(m, "SMC messages:\n");
+	for (i = 0; i < SMUM_MSG_STATS_SIZE; i++) {
+		stats = &mailbox->stats[i];
+		if (stats->count == 0)
+			continue;
+
+		seq_printf(m, "\t0x%03x: %u sent, %u failed, avg %llu us, max %u us\n",
+			stats->msg, stats->count, stats->failures,
+			div_u64(stats->total_us, stats->count),
+			stats->max_us);
 	}
+	mutex_unlock(&mailbox->lock);
 
-	/* timeout means wrong logic */
-	if (i == smumgr->usec_timeout)
-		return -1;
+	seq_printf(m, "SMC table uploads: %u, %llu bytes written, %llu bytes unchanged\n",
+		smumgr->smc_table_uploads, smumgr->smc_table_bytes_written,
+		smumgr->smc_table_bytes_skipped);
+}
 
-	return 0;
+/*
+ * Poll a register until the part indicated by the mask equals the given
+ * value, or, if @equal is false, until it differs from it.
+ *
+ * Most SMC handshakes complete within a few microseconds, so spin for a
+ * short while first; after that sleep with an exponentially growing
+ * interval so that slow messages do not burn a CPU. Must be called from
+ * process context.
+ */
+int smum_poll_register(void *device, uint32_t index,
+			uint32_t value, uint32_t mask, bool equal,
+			uint32_t usec_timeout)
+{
+	ktime_t start = ktime_get();
+	uint32_t sleep_us = SMUM_POLL_SLEEP_MIN_USEC;
+	uint32_t cur_value;
+	s64 elapsed;
+
+	for (;;) {
+		cur_value = cgs_read_register(device, index);
+		if (((cur_value & mask) == (value & mask)) == equal)
+			return 0;
+
+		elapsed = ktime_us_delta(ktime_get(), start);
+
+		/* timeout means wrong logic */
+		if (elapsed >= usec_timeout)
+			return -1;
+
+		if (elapsed < SMUM_POLL_SPIN_USEC) {
+			udelay(1);
+		} else {
+			usleep_range(sleep_us, sleep_us * 2);
+			sleep_us = min_t(uint32_t, sleep_us * 2,
+					SMUM_POLL_SLEEP_MAX_USEC);
+		}
+	}
+}
+
+/*
+ * Returns once the part of the register indicated by the mask has
+ * reached the given value.
+ */
+int smum_wait_on_register(struct pp_smumgr *smumgr,
+				uint32_t index,
+				uint32_t value, uint32_t mask)
+{
+	if (smumgr == NULL || smumgr->device == NULL)
+		return -EINVAL;
+
+	return smum_poll_register(smumgr->device, index, value, mask,
+				true, smumgr->usec_timeout);
+}
+
+int smum_wait_for_register_unequal(struct pp_smumgr *smumgr,
+					uint32_t index,
+					uint32_t value, uint32_t mask)
+{
+	if (smumgr == NULL)
+		return -EINVAL;
+
+	return smum_poll_register(smumgr->device, index, value, mask,
+				false, smumgr->usec_timeout);
 }
 
 
@@ -86,12 +86,27 @@ int tonga_copy_bytes_to_smc(struct pp_smumgr *smumgr,
 		"SMC address must be 4 byte aligned.",
 		return 0;);
 
-	PP_ASSERT_WITH_CODE((limit > (smcStartAddress + byteCount)),
+	/* the dwords below are written without checking each address */
+	PP_ASSERT_WITH_CODE((byteCount <= limit &&
+		smcStartAddress <= limit - byteCount),
 		"SMC address is beyond the SMC RAM area.",
 		return 0;);
 
 	addr = smcStartAddress;
 
+	/*
+	 * INDEX_0 is shared with the driver's own SMC register accessors,
+	 * so rather than auto-incrementing, program the access mode once
+	 * and only update the index for each dword.
+	 */
+	if (byteCount >= 4) {
+		result = tonga_set_smc_sram_address(smumgr, addr, limit);
+		if (result)
+			goto out;
+		SMUM_WRITE_FIELD(smumgr->device, SMC_IND_ACCESS_CNTL,
+				AUTO_INCREMENT_IND_0, 0);
+	}
+
 	while (byteCount >= 4) {
 		/*
 		 * Bytes are written into the
@@ -99,11 +114,7 @@ int tonga_copy_bytes_to_smc(struct pp_smumgr *smumgr,
 		 */
 		data = (src[0] << 24) + (src[1] << 16) + (src[2] << 8) + src[3];
 
-		result = tonga_set_smc_sram_address(smumgr, addr, limit);
-
-		if (result)
-			goto out;
-
+		cgs_write_register(smumgr->device, mmSMC_IND_INDEX_0, addr);
 		cgs_write_register(smumgr->device, mmSMC_IND_DATA_0, data);
 
 		src += 4;
@@ -195,21 +206,7 @@ static int tonga_send_msg_to_smc(struct pp_smumgr *smumgr, uint16_t msg)
 	if (!tonga_is_smc_ram_running(smumgr))
 		return -1;
 
-	SMUM_WAIT_FIELD_UNEQUAL(smumgr, SMC_RESP_0, SMC_RESP, 0);
-	PP_ASSERT_WITH_CODE(
-		1 == SMUM_READ_FIELD(smumgr->device, SMC_RESP_0, SMC_RESP),
-		"Failed to send Previous Message.",
-		);
-
-	cgs_write_register(smumgr->device, mmSMC_MESSAGE_0, msg);
-
-	SMUM_WAIT_FIELD_UNEQUAL(smumgr, SMC_RESP_0, SMC_RESP, 0);
-	PP_ASSERT_WITH_CODE(
-		1 == SMUM_READ_FIELD(smumgr->device, SMC_RESP_0, SMC_RESP),
-		"Failed to send Message.",
-		);
-
-	return 0;
+	return smum_mailbox_send(smumgr, msg, 0, 0);
 }
 
 /*
@@ -252,10 +249,8 @@ static int tonga_send_msg_to_smc_with_parameter(struct pp_smumgr *smumgr,
 	if (!tonga_is_smc_ram_running(smumgr))
 		return PPSMC_Result_Failed;
 
-	SMUM_WAIT_FIELD_UNEQUAL(smumgr, SMC_RESP_0, SMC_RESP, 0);
-	cgs_write_register(smumgr->device, mmSMC_MSG_ARG_0, parameter);
-
-	return tonga_send_msg_to_smc(smumgr, msg);
+	return smum_mailbox_send(smumgr, msg, parameter,
+				SMUM_MSG_HAS_PARAMETER);
 }
 
 /*
@@ -808,6 +803,7 @@ static const struct pp_smumgr_func tonga_smu_funcs = {
 	.send_msg_to_smc_with_parameter = &tonga_send_msg_to_smc_with_parameter,
 	.download_pptable_settings = NULL,
 	.upload_pptable_settings = NULL,
+	.copy_bytes_to_smc = tonga_copy_bytes_to_smc,
 };
 
 int tonga_smum_init(struct pp_smumgr *smumgr)
@@ -821,6 +817,8 @@ int tonga_smum_init(struct pp_smumgr *smumgr)
 
 	smumgr->backend = tonga_smu;
 	smumgr->smumgr_funcs = &tonga_smu_funcs;
+	smum_mailbox_init(smumgr, mmSMC_MESSAGE_0, mmSMC_MSG_ARG_0,
+			mmSMC_RESP_0, SMC_RESP_0__SMC_RESP_MASK, false);
 
 	return 0;
 }
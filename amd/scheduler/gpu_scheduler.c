@@ -32,6 +32,7 @@
 
 static bool amd_sched_entity_is_ready(struct amd_sched_entity *entity);
 static void amd_sched_wakeup(struct amd_gpu_scheduler *sched);
+static void amd_sched_process_job(struct fence *f, struct fence_cb *cb);
 
 struct kmem_cache *sched_fence_slab;
 atomic_t sched_fence_slab_ref = ATOMIC_INIT(0);
@@ -319,8 +320,8 @@ static bool amd_sched_entity_in(struct amd_sched_job *sched_job)
 	return added;
 }
 
-/* job_finish is called after hw fence signaled, and
- * the job had already been deleted from ring_mirror_list
+/* job_finish is called after hw fence signaled, it deletes the
+ * job from ring_mirror_list and drops the fence reference of the list
  */
 static void amd_sched_job_finish(struct work_struct *work)
 {
@@ -347,6 +348,7 @@ static void amd_sched_job_finish(struct work_struct *work)
 			schedule_delayed_work(&next->work_tdr, sched->timeout);
 	}
 	spin_unlock_irqrestore(&sched->job_list_lock, flags);
+	fence_put(&s_job->s_fence->base);
 	sched->ops->free_job(s_job);
 }
 
@@ -362,6 +364,8 @@ static void amd_sched_job_begin(struct amd_sched_job *s_job)
 	struct amd_gpu_scheduler *sched = s_job->sched;
 	unsigned long flags;
 
+	/* keep the fence around while the job is on the ring_mirror_list */
+	fence_get(&s_job->s_fence->base);
 	spin_lock_irqsave(&sched->job_list_lock, flags);
 	list_add_tail(&s_job->node, &sched->ring_mirror_list);
 	if (sched->timeout != MAX_SCHEDULE_TIMEOUT &&
@@ -379,6 +383,178 @@ static void amd_sched_job_timedout(struct work_struct *work)
 	job->sched->ops->timedout_job(job);
 }
 
+/**
+ * Check if the entity that submitted a job was found guilty of a hang
+ *
+ * @sched	The scheduler the job ran on
+ * @context	The fence context of the job
+ * @mark	Mark the entity guilty first
+ *
+ * The entity is looked up by its fence context under the run queue lock,
+ * the job itself may outlive the entity that submitted it.
+ */
+static bool amd_sched_context_guilty(struct amd_gpu_scheduler *sched,
+				     uint64_t context, bool mark)
+{
+	struct amd_sched_entity *entity;
+	bool guilty = false;
+	int i;
+
+	for (i = 0; i < AMD_SCHED_MAX_PRIORITY; i++) {
+		struct amd_sched_rq *rq = &sched->sched_rq[i];
+
+		spin_lock(&rq->lock);
+		list_for_each_entry(entity, &rq->entities, list) {
+			if (entity->fence_context != context)
+				continue;
+
+			if (entity->guilty) {
+				if (mark)
+					atomic_set(entity->guilty, 1);
+				guilty = atomic_read(entity->guilty);
+			}
+			spin_unlock(&rq->lock);
+			return guilty;
+		}
+		spin_unlock(&rq->lock);
+	}
+
+	return false;
+}
+
+/**
+ * Detach the jobs on the hardware from their hardware fences
+ *
+ * @sched	The scheduler of the ring that is about to be reset
+ * @bad		The job that timed out on this ring, or NULL
+ *
+ * Called with the scheduler thread parked.  The jobs stay on the
+ * ring_mirror_list until amd_sched_job_recovery runs or drops them.
+ * If @bad is still pending it is not run again and the entity that
+ * submitted it is marked guilty.
+ *
+ * Returns true if @bad was still pending on the hardware.
+ */
+bool amd_sched_hw_job_reset(struct amd_gpu_scheduler *sched,
+			    struct amd_sched_job *bad)
+{
+	struct amd_sched_job *s_job;
+	bool found = false;
+	unsigned long flags;
+
+	spin_lock_irqsave(&sched->job_list_lock, flags);
+	s_job = list_first_entry_or_null(&sched->ring_mirror_list,
+					 struct amd_sched_job, node);
+	if (s_job && sched->timeout != MAX_SCHEDULE_TIMEOUT)
+		cancel_delayed_work(&s_job->work_tdr);
+
+	list_for_each_entry(s_job, &sched->ring_mirror_list, node) {
+		struct amd_sched_fence *s_fence = s_job->s_fence;
+
+		if (!s_fence->parent ||
+		    !fence_remove_callback(s_fence->parent, &s_fence->cb))
+			continue;
+
+		fence_put(s_fence->parent);
+		s_fence->parent = NULL;
+		atomic_dec(&sched->hw_rq_count);
+
+		if (s_job == bad) {
+			s_job->guilty = true;
+			found = true;
+		}
+	}
+	spin_unlock_irqrestore(&sched->job_list_lock, flags);
+
+	if (found)
+		amd_sched_context_guilty(sched, bad->s_fence->base.context,
+					 true);
+
+	return found;
+}
+
+/* the next job after @s_job that has not completed, job_list_lock held */
+static struct amd_sched_job *
+amd_sched_job_next_pending(struct amd_gpu_scheduler *sched,
+			   struct amd_sched_job *s_job)
+{
+	list_for_each_entry_continue(s_job, &sched->ring_mirror_list, node)
+		if (!fence_is_signaled(&s_job->s_fence->base))
+			return s_job;
+
+	return NULL;
+}
+
+/**
+ * Run the jobs detached by amd_sched_hw_job_reset again
+ *
+ * @sched	The scheduler of the ring that was reset
+ * @resubmit	False if the reset failed and nothing can run
+ * @recovery	Counts of resubmitted and dropped jobs are added here
+ *
+ * Jobs are resubmitted in their original order.  Guilty jobs, the other
+ * jobs of a guilty entity and, with @resubmit false, all jobs are
+ * completed without running them, their fences signal with -ECANCELED.
+ * Called before the scheduler thread is unparked.
+ */
+void amd_sched_job_recovery(struct amd_gpu_scheduler *sched, bool resubmit,
+			    struct amd_sched_recovery *recovery)
+{
+	struct amd_sched_job *s_job, *next;
+	unsigned long flags;
+	int r;
+
+	spin_lock_irqsave(&sched->job_list_lock, flags);
+	/*
+	 * A pending job can't complete before it is resubmitted, so the
+	 * next one is safe to use after the lock is dropped.  Completed
+	 * jobs may be freed by amd_sched_job_finish at any time.
+	 */
+	s_job = list_entry(&sched->ring_mirror_list, struct amd_sched_job,
+			   node);
+	s_job = amd_sched_job_next_pending(sched, s_job);
+	while (s_job) {
+		struct amd_sched_fence *s_fence = s_job->s_fence;
+		struct fence *fence = NULL;
+
+		next = amd_sched_job_next_pending(sched, s_job);
+		spin_unlock_irqrestore(&sched->job_list_lock, flags);
+
+		atomic_inc(&sched->hw_rq_count);
+		if (resubmit && !s_job->guilty &&
+		    !amd_sched_context_guilty(sched, s_fence->base.context,
+					      false))
+			fence = sched->ops->run_job(s_job);
+
+		if (fence) {
+			recovery->resubmitted++;
+			s_fence->parent = fence_get(fence);
+			r = fence_add_callback(fence, &s_fence->cb,
+					       amd_sched_process_job);
+			if (r == -ENOENT)
+				amd_sched_process_job(fence, &s_fence->cb);
+			else if (r)
+				DRM_ERROR("fence add callback failed (%d)\n",
+					  r);
+			fence_put(fence);
+		} else {
+			/* tell the waiters the job never ran */
+			s_fence->base.status = -ECANCELED;
+			recovery->dropped++;
+			amd_sched_process_job(NULL, &s_fence->cb);
+		}
+
+		spin_lock_irqsave(&sched->job_list_lock, flags);
+		s_job = next;
+	}
+
+	s_job = list_first_entry_or_null(&sched->ring_mirror_list,
+					 struct amd_sched_job, node);
+	if (s_job && sched->timeout != MAX_SCHEDULE_TIMEOUT)
+		schedule_delayed_work(&s_job->work_tdr, sched->timeout);
+	spin_unlock_irqrestore(&sched->job_list_lock, flags);
+}
+
 /**
  * Submit a job to the job queue
  *
@@ -472,6 +648,19 @@ static void amd_sched_process_job(struct fence *f, struct fence_cb *cb)
 	wake_up_interruptible(&sched->wake_up_worker);
 }
 
+/**
+ * Park the scheduler thread while a GPU reset handles its jobs
+ */
+static bool amd_sched_blocked(struct amd_gpu_scheduler *sched)
+{
+	if (kthread_should_park()) {
+		kthread_parkme();
+		return true;
+	}
+
+	return false;
+}
+
 static int amd_sched_main(void *param)
 {
 	struct sched_param sparam = {.sched_priority = 1};
@@ -487,7 +676,8 @@ static int amd_sched_main(void *param)
 		struct fence *fence;
 
 		wait_event_interruptible(sched->wake_up_worker,
-			(entity = amd_sched_select_entity(sched)) ||
+			(!amd_sched_blocked(sched) &&
+			 (entity = amd_sched_select_entity(sched))) ||
 			kthread_should_stop());
 
 		if (!entity)
@@ -505,6 +695,7 @@ static int amd_sched_main(void *param)
 		fence = sched->ops->run_job(sched_job);
 		amd_sched_fence_scheduled(s_fence);
 		if (fence) {
+			s_fence->parent = fence_get(fence);
 			r = fence_add_callback(fence, &s_fence->cb,
 					       amd_sched_process_job);
 			if (r == -ENOENT)
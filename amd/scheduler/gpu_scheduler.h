@@ -58,6 +58,9 @@ struct amd_sched_entity {
 
 	struct fence			*dependency;
 	struct fence_cb			cb;
+
+	/* set by the owner if a hang caused by the entity is to be reported */
+	atomic_t			*guilty;
 };
 
 /**
@@ -74,6 +77,7 @@ struct amd_sched_rq {
 struct amd_sched_fence {
 	struct fence                    base;
 	struct fence_cb                 cb;
+	struct fence			*parent;
 	struct list_head		scheduled_cb;
 	struct amd_gpu_scheduler	*sched;
 	spinlock_t			lock;
@@ -88,6 +92,8 @@ struct amd_sched_job {
 	struct work_struct		finish_work;
 	struct list_head		node;
 	struct delayed_work		work_tdr;
+	/* the job hung the hardware and is not run again after the reset */
+	bool				guilty;
 };
 
 extern const struct fence_ops amd_sched_fence_ops;
@@ -119,6 +125,15 @@ enum amd_sched_priority {
 	AMD_SCHED_MAX_PRIORITY
 };
 
+/**
+ * Outcome of amd_sched_job_recovery for the jobs that were on the
+ * hardware when it was reset
+*/
+struct amd_sched_recovery {
+	unsigned	resubmitted;
+	unsigned	dropped;
+};
+
 /**
  * One scheduler is implemented for each hardware ring
 */
@@ -140,6 +155,10 @@ int amd_sched_init(struct amd_gpu_scheduler *sched,
 		   const struct amd_sched_backend_ops *ops,
 		   uint32_t hw_submission, long timeout, const char *name);
 void amd_sched_fini(struct amd_gpu_scheduler *sched);
+bool amd_sched_hw_job_reset(struct amd_gpu_scheduler *sched,
+			    struct amd_sched_job *bad);
+void amd_sched_job_recovery(struct amd_gpu_scheduler *sched, bool resubmit,
+			    struct amd_sched_recovery *recovery);
 
 int amd_sched_entity_init(struct amd_gpu_scheduler *sched,
 			  struct amd_sched_entity *entity,
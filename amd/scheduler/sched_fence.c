@@ -109,6 +109,9 @@ static void amd_sched_fence_free(struct rcu_head *rcu)
  */
 static void amd_sched_fence_release(struct fence *f)
 {
+	struct amd_sched_fence *fence = to_amd_sched_fence(f);
+
+	fence_put(fence->parent);
 	call_rcu(&f->rcu, amd_sched_fence_free);
 }
 